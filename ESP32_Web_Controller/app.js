@@ -5,6 +5,10 @@ class ESP32Controller {
         this.baseUrl = '';
         this.isConnected = false;
         this.useHttps = true;
+        this.ws = null;             // WebSocket 控制通道 (/api/ws)
+        this.wsNextId = 1;
+        this.wsPending = new Map(); // 请求号 -> { resolve, startTime, timer }
+        this.events = null;         // 设备状态事件流 (/api/events)
         this.init();
     }
 
@@ -76,11 +80,20 @@ class ESP32Controller {
                 // 更新设备信息
                 document.getElementById('deviceStatus').textContent = '在线';
                 document.getElementById('responseTime').textContent = `${responseTime}ms`;
+
+                // 打开持久的控制通道，LED/GPIO/OLED 命令不再每次新建请求
+                this.openControlChannel(ip, port);
+                // 订阅设备状态事件，在线状态与设备状态由事件流推送，无需轮询
+                this.openEventStream();
             } else {
                 throw new Error(`HTTP ${response.status}`);
             }
         } catch (error) {
             this.isConnected = false;
+            if (this.events) {
+                this.events.close();
+                this.events = null;
+            }
             this.updateConnectionStatus(false);
             this.log(`连接失败: ${error.message}`, 'error');
             
@@ -90,6 +103,121 @@ class ESP32Controller {
         }
     }
 
+    // 打开 WebSocket 控制通道：命令帧为“请求号 命令 参数”，应答带同一请求号，“* ”开头为设备状态通知
+    openControlChannel(ip, port) {
+        if (this.ws) {
+            this.ws.onclose = null;
+            this.ws.close();
+            this.failPending('通道已重新打开');
+        }
+
+        const protocol = this.useHttps ? 'wss' : 'ws';
+        const ws = new WebSocket(`${protocol}://${ip}:${port}/api/ws`);
+        this.ws = ws;
+
+        ws.onopen = () => this.log('控制通道已打开 (WebSocket)', 'success');
+        ws.onmessage = (event) => this.onControlMessage(event.data);
+        ws.onclose = () => {
+            if (this.ws === ws) this.ws = null;
+            this.failPending('通道已关闭');
+            this.log('控制通道已关闭，命令改用 HTTP 请求', 'warning');
+        };
+    }
+
+    // 打开设备状态事件流（SSE）：先收到 state 快照，之后是逐条变化；
+    // 断线后浏览器自动重连并带上 Last-Event-ID，设备从断点续传
+    openEventStream() {
+        if (this.events) this.events.close();
+
+        const events = new EventSource(`${this.baseUrl}/api/events`);
+        this.events = events;
+
+        events.onopen = () => {
+            document.getElementById('deviceStatus').textContent = '在线';
+            this.updateConnectionStatus(true);
+        };
+        events.onerror = () => {
+            if (events.readyState === EventSource.CLOSED) {
+                this.isConnected = false;
+                this.updateConnectionStatus(false);
+                this.log('事件流已关闭，请重新连接', 'error');
+            } else {
+                document.getElementById('deviceStatus').textContent = '重连中';
+            }
+        };
+        events.addEventListener('state', (e) => {
+            const state = JSON.parse(e.data);
+            this.showLed(state.led);
+            document.getElementById('oledState').textContent = state.text === null ? '-' : state.text;
+            this.log(`设备状态: LED ${state.led ? '开' : '关'}, GPIO 电平 ${state.levels} (已设置 ${state.known})`, 'info');
+        });
+        events.addEventListener('led', (e) => this.showLed(e.data === 'on'));
+        events.addEventListener('gpio', (e) => this.log(`设备状态: GPIO ${e.data}`, 'info'));
+        events.addEventListener('text', (e) => {
+            document.getElementById('oledState').textContent = e.data;
+        });
+        events.addEventListener('clear', () => {
+            document.getElementById('oledState').textContent = '-';
+        });
+    }
+
+    // 显示 LED 状态
+    showLed(on) {
+        document.getElementById('ledState').textContent = on ? '开' : '关';
+    }
+
+    // 处理控制通道收到的帧
+    onControlMessage(data) {
+        if (data.startsWith('* ')) {
+            // 事件流打开时状态变化由事件流显示，不重复记录
+            if (!this.events || this.events.readyState !== EventSource.OPEN) {
+                this.log(`设备状态: ${data.substring(2)}`, 'info');
+            }
+            return;
+        }
+
+        const space = data.indexOf(' ');
+        const id = parseInt(data.substring(0, space), 10);
+        const pending = this.wsPending.get(id);
+        if (!pending) return;
+
+        this.wsPending.delete(id);
+        clearTimeout(pending.timer);
+        const responseTime = Date.now() - pending.startTime;
+        const reply = data.substring(space + 1);
+        const success = reply.startsWith('ok');
+        this.log(`${success ? '命令成功' : '命令失败'} (${responseTime}ms): ${reply}`, success ? 'success' : 'error');
+        document.getElementById('responseTime').textContent = `${responseTime}ms`;
+        pending.resolve({ success: success, data: reply });
+    }
+
+    // 结束所有等待应答的命令
+    failPending(reason) {
+        for (const pending of this.wsPending.values()) {
+            clearTimeout(pending.timer);
+            pending.resolve({ success: false, error: reason });
+        }
+        this.wsPending.clear();
+    }
+
+    // 经控制通道发送命令；通道未打开时改用 HTTP 端点
+    async sendControl(frame, endpoint) {
+        if (!this.ws || this.ws.readyState !== WebSocket.OPEN) {
+            return this.sendRequest(endpoint);
+        }
+
+        const id = this.wsNextId++;
+        return new Promise((resolve) => {
+            const timer = setTimeout(() => {
+                this.wsPending.delete(id);
+                this.log(`命令 ${id} 超时`, 'error');
+                resolve({ success: false, error: 'timeout' });
+            }, 5000);
+            this.wsPending.set(id, { resolve, startTime: Date.now(), timer });
+            this.ws.send(`${id} ${frame}`);
+        });
+    }
+
     // 更新连接状态显示
     updateConnectionStatus(connected) {
         const statusIndicator = document.getElementById('statusIndicator');
@@ -107,6 +235,8 @@ class ESP32Controller {
             document.getElementById('connectBtn').className = 'btn btn-primary';
             document.getElementById('deviceStatus').textContent = '-';
             document.getElementById('responseTime').textContent = '-';
+            document.getElementById('ledState').textContent = '-';
+            document.getElementById('oledState').textContent = '-';
         }
     }
 
@@ -193,21 +323,20 @@ const controller = new ESP32Controller();
 // 全局函数供HTML调用
 
 function sendCommand(type, action) {
-    let endpoint = '/';
-    
     switch(type) {
         case 'led':
-            endpoint = `/api/led?action=${action}`;
+            controller.sendControl(`led ${action}`, `/api/led?action=${action}`);
             break;
         case 'joke':
-            endpoint = '/api/joke';
+            controller.sendRequest('/api/joke');
             break;
         case 'oled':
-            endpoint = `/api/oled?action=${action}`;
+            controller.sendControl(action, `/api/oled?action=${action}`);
+            break;
+        default:
+            controller.sendRequest('/');
             break;
     }
-    
-    controller.sendRequest(endpoint);
 }
 
 function setGPIO(level) {
@@ -218,7 +347,7 @@ function setGPIO(level) {
     }
     
     const endpoint = `/api/gpio?pin=${pin}&level=${level}`;
-    controller.sendRequest(endpoint);
+    controller.sendControl(`gpio ${pin} ${level}`, endpoint);
 }
 
 function sendToOLED() {
@@ -229,7 +358,7 @@ function sendToOLED() {
     }
     
     const endpoint = `/api/oled?text=${encodeURIComponent(text)}`;
-    controller.sendRequest(endpoint);
+    controller.sendControl(`text ${text}`, endpoint);
 }
 
 function sendCustomCommand() {
@@ -0,0 +1,341 @@
+/*
+ * Checks the device state event ring behind GET /api/events
+ *
+ * Events must read back in order with their text intact, report "not yet"
+ * past the newest event and "lost" once overwritten, and event ids must
+ * round-trip while ids from another boot, from the future or malformed are
+ * refused. SSE formatting must split the event name from its data, turn
+ * line breaks inside the data into extra data lines and fit the worst case
+ * in CTL_EVENT_SSE_MAX. Finally two producer threads race a reader without
+ * any lock: every event the reader accepts must be whole, and each
+ * producer's events must arrive in order. Events overwritten before the
+ * reader gets to them are only counted.
+ */
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "ctl_events.h"
+
+#define EPOCH           0x1a2b3c4du
+#define RACE_EVENTS     200000
+
+static ctl_events_t ring;
+static int failures = 0;
+
+/* 函数名：push_str
+ *
+ * 函数说明：追加一条字符串事件。
+ * 参数：
+ *   s - 事件文本。
+ * 返回值：
+ *   事件序号。
+ */
+static uint32_t push_str(const char *s)
+{
+    return ctl_events_push(&ring, s, strlen(s));
+}
+
+/* 函数名：event_is
+ *
+ * 函数说明：读取序号为 seq 的事件并与期望文本比较。
+ * 参数：
+ *   seq    - 事件序号。
+ *   expect - 期望文本。
+ * 返回值：
+ *   true 读到且一致。
+ */
+static bool event_is(uint32_t seq, const char *expect)
+{
+    ctl_event_t ev;
+    return ctl_events_get(&ring, seq, &ev) == ESP_OK && ev.seq == seq && ev.len == strlen(expect) &&
+           memcmp(ev.text, expect, ev.len) == 0;
+}
+
+/* 函数名：check_order
+ *
+ * 函数说明：按序读回事件；最新之后为“尚未发布”，写入中的槽位同样如此；
+ *           落后超过槽位数的事件为“已丢失”，最近 CTL_EVENTS_SLOTS 条仍可读。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_order(void)
+{
+    ctl_event_t ev;
+    ctl_events_init(&ring, EPOCH);
+    bool ok = ctl_events_last(&ring) == 0 && ctl_events_get(&ring, 1, &ev) == ESP_ERR_NOT_FOUND &&
+              ctl_events_get(&ring, 0, &ev) == ESP_ERR_NOT_FOUND;
+
+    ok = ok && push_str("* led on") == 1 && push_str("* gpio 4 high") == 2 && push_str("* clear") == 3;
+    ok = ok && event_is(1, "* led on") && event_is(2, "* gpio 4 high") && event_is(3, "* clear") &&
+         ctl_events_get(&ring, 4, &ev) == ESP_ERR_NOT_FOUND;
+
+    /* A claimed slot that is still being written is not readable yet */
+    atomic_fetch_add(&ring.next, 1);
+    ok = ok && ctl_events_get(&ring, 4, &ev) == ESP_ERR_NOT_FOUND;
+    atomic_store(&ring.slots[4 % CTL_EVENTS_SLOTS].state, (4u << 1) | 1u);
+    ok = ok && ctl_events_get(&ring, 4, &ev) == ESP_ERR_NOT_FOUND;
+
+    /* Published but damaged by a late writer: reported lost, not returned */
+    atomic_store(&ring.slots[4 % CTL_EVENTS_SLOTS].state, 4u << 1);
+    ring.slots[4 % CTL_EVENTS_SLOTS].len = 3;
+    ok = ok && ctl_events_get(&ring, 4, &ev) == ESP_ERR_INVALID_STATE;
+
+    char text[32];
+    for (int i = 5; i <= 40; i++) {
+        snprintf(text, sizeof(text), "* gpio %d low", i);
+        push_str(text);
+    }
+    ok = ok && ctl_events_get(&ring, 1, &ev) == ESP_ERR_INVALID_STATE &&
+         ctl_events_get(&ring, 40 - CTL_EVENTS_SLOTS, &ev) == ESP_ERR_INVALID_STATE;
+    for (int i = 40 - CTL_EVENTS_SLOTS + 1; i <= 40; i++) {
+        snprintf(text, sizeof(text), "* gpio %d low", i);
+        ok = ok && event_is((uint32_t)i, text);
+    }
+
+    /* Over-long events are truncated, never overflow the slot */
+    static char big[CTL_EVENT_MAX + 50];
+    memset(big, 'x', sizeof(big));
+    uint32_t seq = ctl_events_push(&ring, big, sizeof(big));
+    ok = ok && ctl_events_get(&ring, seq, &ev) == ESP_OK && ev.len == CTL_EVENT_MAX;
+
+    printf("%s  order and overrun      last %u events readable, older reported lost\n",
+           ok ? "ok  " : "FAIL", (unsigned)CTL_EVENTS_SLOTS);
+    if (!ok) failures++;
+}
+
+/* 函数名：check_ids
+ *
+ * 函数说明：事件号往返解析；其他纪元、超前序号与格式错误的事件号被拒绝。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_ids(void)
+{
+    char id[CTL_EVENT_ID_MAX];
+    uint32_t seq = 0;
+    ctl_events_init(&ring, EPOCH);
+    for (int i = 0; i < 5; i++) push_str("* led off");
+
+    bool ok = ctl_events_format_id(&ring, 3, id, sizeof(id)) == 10 && strcmp(id, "1a2b3c4d-3") == 0 &&
+              ctl_events_parse_id(&ring, id, &seq) && seq == 3 &&
+              ctl_events_parse_id(&ring, "1a2b3c4d-0", &seq) && seq == 0 &&
+              ctl_events_parse_id(&ring, "1a2b3c4d-5", &seq) && seq == 5;
+
+    ctl_events_t other;
+    ctl_events_init(&other, 0xffffffffu);
+    ok = ok && ctl_events_format_id(&other, 4294967295u, id, sizeof(id)) == 19 &&
+         strcmp(id, "ffffffff-4294967295") == 0;
+
+    static const char *bad[] = {
+        "",  "1a2b3c4d", "1a2b3c4d-", "1a2b3c4d-6", "1a2b3c4e-3", "1A2B3C4D-3", "1a2b3c4d-3x",
+        "1a2b3c4d--3", "1a2b3c4d-+3", "1a2b3c4-3", "xa2b3c4d-3", "1a2b3c4d-99999999999999999999",
+    };
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        seq = 77;
+        ok = ok && !ctl_events_parse_id(&ring, bad[i], &seq) && seq == 77;
+    }
+    ok = ok && ctl_events_format_id(&ring, 3, id, 5) == 0;
+
+    printf("%s  event ids              round trip, other boot / future / malformed refused\n",
+           ok ? "ok  " : "FAIL");
+    if (!ok) failures++;
+}
+
+/* 函数名：sse_is
+ *
+ * 函数说明：把事件转为 SSE 消息并与期望比较。
+ * 参数：
+ *   text   - 事件文本。
+ *   expect - 期望的消息（不含 id 行）。
+ * 返回值：
+ *   true 一致。
+ */
+static bool sse_is(const char *text, const char *expect)
+{
+    char buf[CTL_EVENT_SSE_MAX];
+    char want[CTL_EVENT_SSE_MAX];
+    ctl_event_t ev;
+    uint32_t seq = push_str(text);
+
+    if (ctl_events_get(&ring, seq, &ev) != ESP_OK) return false;
+    size_t len = ctl_events_to_sse(&ring, &ev, buf, sizeof(buf));
+    snprintf(want, sizeof(want), "id: 1a2b3c4d-%u\n%s", (unsigned)seq, expect);
+    return len == strlen(want) && strcmp(buf, want) == 0;
+}
+
+/* 函数名：check_sse
+ *
+ * 函数说明：SSE 格式：名称与数据分开，换行拆为多行 data，消息以空行结束；
+ *           最坏情况（全是换行的最长文本）放得下，缓冲不足时返回 0。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_sse(void)
+{
+    ctl_events_init(&ring, EPOCH);
+    bool ok = sse_is("* led on", "event: led\ndata: on\n\n") &&
+              sse_is("* gpio 4 high", "event: gpio\ndata: 4 high\n\n") &&
+              sse_is("* clear", "event: clear\ndata: \n\n") &&
+              sse_is("* text Hello  world", "event: text\ndata: Hello  world\n\n") &&
+              sse_is("* text a\nb\r\nc\rd", "event: text\ndata: a\ndata: b\ndata: c\ndata: d\n\n") &&
+              sse_is("* text 温度 23℃", "event: text\ndata: 温度 23℃\n\n") &&
+              sse_is("", "event: message\ndata: \n\n");
+
+    static char worst[CTL_EVENT_MAX];
+    static char buf[CTL_EVENT_SSE_MAX];
+    ctl_event_t ev;
+    memcpy(worst, "* text ", 7);
+    memset(worst + 7, '\n', sizeof(worst) - 7);
+    uint32_t seq = ctl_events_push(&ring, worst, sizeof(worst));
+    ok = ok && ctl_events_get(&ring, seq, &ev) == ESP_OK;
+    size_t worst_len = ctl_events_to_sse(&ring, &ev, buf, sizeof(buf));
+    ok = ok && worst_len > 0 && worst_len < sizeof(buf) && ctl_events_to_sse(&ring, &ev, buf, 40) == 0;
+
+    printf("%s  SSE format             worst case %u of %u bytes\n", ok ? "ok  " : "FAIL",
+           (unsigned)worst_len, (unsigned)CTL_EVENT_SSE_MAX);
+    if (!ok) failures++;
+}
+
+/* 函数名：producer
+ *
+ * 函数说明：竞争写入线程：每条事件由同一字符填满（生产者号与计数决定），便于读取方发现撕裂；
+ *           每条之间稍作停顿，让读取方大体跟得上、读写真正交错。
+ * 参数：
+ *   arg - 生产者号（0 或 1）。
+ * 返回值：
+ *   NULL。
+ */
+static void *producer(void *arg)
+{
+    int id = (int)(intptr_t)arg;
+    char text[64];
+    for (uint32_t n = 0; n < RACE_EVENTS; n++) {
+        size_t len = 8 + n % 48;
+        text[0] = (char)('0' + id);
+        memcpy(text + 1, &n, sizeof(n));
+        memset(text + 5, 'a' + (int)(n % 26), len - 5);
+        ctl_events_push(&ring, text, len);
+        for (volatile int spin = 0; spin < 200; spin++) {
+            /* pace the writers so the reader mostly keeps up and reads race the writes */
+        }
+    }
+    return NULL;
+}
+
+/* 函数名：check_race
+ *
+ * 函数说明：两个生产者线程与一个读取者无锁竞争：读到的事件都完整（长度与内容一致），
+ *           同一生产者的事件按序到达；丢失的事件只计数。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_race(void)
+{
+    pthread_t threads[2];
+    ctl_event_t ev;
+    uint32_t next = 1;
+    uint32_t read = 0;
+    uint32_t lost = 0;
+    uint32_t torn = 0;
+    int64_t last_n[2] = { -1, -1 };
+    bool ordered = true;
+
+    ctl_events_init(&ring, EPOCH);
+    for (int i = 0; i < 2; i++) {
+        pthread_create(&threads[i], NULL, producer, (void *)(intptr_t)i);
+    }
+    while (next <= 2 * RACE_EVENTS) {
+        esp_err_t ret = ctl_events_get(&ring, next, &ev);
+        if (ret == ESP_ERR_NOT_FOUND) continue;
+        if (ret == ESP_ERR_INVALID_STATE) {
+            /* Resync near the head, like a stream resending state, so reads keep racing the writers */
+            uint32_t head = ctl_events_last(&ring);
+            uint32_t skip_to = head > next + CTL_EVENTS_SLOTS / 2 ? head - CTL_EVENTS_SLOTS / 2 : next + 1;
+            lost += skip_to - next;
+            next = skip_to;
+            continue;
+        }
+        next++;
+        uint32_t n;
+        int id = ev.text[0] - '0';
+        memcpy(&n, ev.text + 1, sizeof(n));
+        bool whole = (id == 0 || id == 1) && ev.len == 8 + n % 48;
+        for (size_t i = 5; whole && i < ev.len; i++) {
+            whole = ev.text[i] == 'a' + (int)(n % 26);
+        }
+        if (!whole) {
+            torn++;
+            continue;
+        }
+        if ((int64_t)n <= last_n[id]) ordered = false;
+        last_n[id] = n;
+        read++;
+    }
+    for (int i = 0; i < 2; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    bool ok = torn == 0 && ordered && read + lost == 2 * RACE_EVENTS && read > 0 &&
+              ctl_events_last(&ring) == 2 * RACE_EVENTS;
+    printf("%s  concurrent writers     %u events read, %u lost or skipped, %u torn\n",
+           ok ? "ok  " : "FAIL", (unsigned)read, (unsigned)lost, (unsigned)torn);
+    if (!ok) failures++;
+}
+
+/* 函数名：check_speed
+ *
+ * 函数说明：输出写入与读取一条典型事件的平均耗时。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_speed(void)
+{
+    const int rounds = 1000000;
+    struct timespec t0, t1, t2;
+    ctl_event_t ev;
+    volatile size_t sink = 0;
+
+    ctl_events_init(&ring, EPOCH);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < rounds; i++) {
+        push_str("* gpio 4 high");
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    for (int i = 0; i < rounds; i++) {
+        ctl_events_get(&ring, (uint32_t)rounds - (uint32_t)(i % CTL_EVENTS_SLOTS), &ev);
+        sink += ev.len;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+    (void)sink;
+
+    double push_ns = ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / rounds;
+    double get_ns = ((t2.tv_sec - t1.tv_sec) * 1e9 + (t2.tv_nsec - t1.tv_nsec)) / rounds;
+    printf("ok    speed                  push %.0f ns, get %.0f ns per event\n", push_ns, get_ns);
+}
+
+int main(void)
+{
+    check_order();
+    check_ids();
+    check_sse();
+    check_race();
+    check_speed();
+
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
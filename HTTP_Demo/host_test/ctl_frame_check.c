@@ -0,0 +1,269 @@
+/*
+ * Checks the control channel frame parser
+ *
+ * Every command form must parse to the expected fields, including text
+ * with spaces and multi-byte UTF-8 right up to the length limit. Malformed
+ * frames (bad or missing request id, unknown command, bad pin or level,
+ * extra arguments, oversized frames or text) must be rejected with a reason
+ * and, where it was readable, the request id so the reply can be matched.
+ * Clipping notification text must never split a multi-byte UTF-8
+ * character. Parsing a typical frame must stay far below the per-command
+ * budget.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "ctl_frame.h"
+
+static int failures = 0;
+
+/* 函数名：parse
+ *
+ * 函数说明：把字符串复制到带余量的缓冲后解析（解析会原地修改帧）。
+ * 参数：
+ *   s     - 帧内容。
+ *   buf   - 缓冲，至少 CTL_FRAME_MAX + 2 字节。
+ *   cmd   - 输出命令。
+ *   error - 输出错误原因。
+ * 返回值：
+ *   ctl_frame_parse 的返回值。
+ */
+static esp_err_t parse(const char *s, char *buf, ctl_cmd_t *cmd, const char **error)
+{
+    size_t len = strlen(s);
+    memcpy(buf, s, len);
+    return ctl_frame_parse(buf, len, cmd, error);
+}
+
+/* 函数名：check_valid
+ *
+ * 函数说明：各命令形式解析出期望的字段。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_valid(void)
+{
+    static char buf[CTL_FRAME_MAX + 2];
+    static const struct {
+        const char *frame;
+        uint32_t id;
+        ctl_cmd_kind_t kind;
+        ctl_led_action_t led;
+        uint8_t pin;
+        uint8_t level;
+        const char *text;
+    } cases[] = {
+        { "7 led on", 7, CTL_CMD_LED, CTL_LED_ON, 0, 0, NULL },
+        { "8 led off", 8, CTL_CMD_LED, CTL_LED_OFF, 0, 0, NULL },
+        { "4294967295 led toggle", 4294967295u, CTL_CMD_LED, CTL_LED_TOGGLE, 0, 0, NULL },
+        { "9 gpio 4 high", 9, CTL_CMD_GPIO, CTL_LED_OFF, 4, 1, NULL },
+        { "10 gpio 63 low", 10, CTL_CMD_GPIO, CTL_LED_OFF, 63, 0, NULL },
+        { "11 gpio 0 1", 11, CTL_CMD_GPIO, CTL_LED_OFF, 0, 1, NULL },
+        { "12 gpio 21 0", 12, CTL_CMD_GPIO, CTL_LED_OFF, 21, 0, NULL },
+        { "13 text hello  world ", 13, CTL_CMD_TEXT, CTL_LED_OFF, 0, 0, "hello  world " },
+        { "14 text 你好，世界", 14, CTL_CMD_TEXT, CTL_LED_OFF, 0, 0, "你好，世界" },
+        { "15 text", 15, CTL_CMD_TEXT, CTL_LED_OFF, 0, 0, "" },
+        { "16 clear", 16, CTL_CMD_CLEAR, CTL_LED_OFF, 0, 0, NULL },
+        { "0 ping", 0, CTL_CMD_PING, CTL_LED_OFF, 0, 0, NULL },
+        { "17 stats", 17, CTL_CMD_STATS, CTL_LED_OFF, 0, 0, NULL },
+    };
+    int bad = 0;
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        ctl_cmd_t cmd;
+        const char *error;
+        bool ok = parse(cases[i].frame, buf, &cmd, &error) == ESP_OK && !error && cmd.id == cases[i].id &&
+                  cmd.kind == cases[i].kind;
+        if (ok && cmd.kind == CTL_CMD_LED) ok = cmd.led == cases[i].led;
+        if (ok && cmd.kind == CTL_CMD_GPIO) ok = cmd.pin == cases[i].pin && cmd.level == cases[i].level;
+        if (ok && cmd.kind == CTL_CMD_TEXT) ok = strcmp(cmd.text, cases[i].text) == 0;
+        if (!ok) {
+            printf("        \"%s\" parsed wrong\n", cases[i].frame);
+            bad++;
+        }
+    }
+
+    /* Longest text: 255 bytes of 3-byte UTF-8 characters, within one frame */
+    char frame[CTL_FRAME_MAX + 1];
+    int n = snprintf(frame, sizeof(frame), "4000000000 text ");
+    for (int i = 0; i < CTL_TEXT_MAX / 3; i++) {
+        memcpy(frame + n, "字", 3);
+        n += 3;
+    }
+    frame[n] = '\0';
+    ctl_cmd_t cmd;
+    const char *error;
+    if (parse(frame, buf, &cmd, &error) != ESP_OK || strlen(cmd.text) != CTL_TEXT_MAX) {
+        printf("        longest text rejected\n");
+        bad++;
+    }
+
+    printf("%s  valid frames           %d of %u parsed wrong\n", bad ? "FAIL" : "ok  ", bad,
+           (unsigned)(sizeof(cases) / sizeof(cases[0]) + 1));
+    if (bad) failures++;
+}
+
+/* 函数名：check_invalid
+ *
+ * 函数说明：格式错误的帧被拒绝，给出原因；请求号可读时一并返回。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_invalid(void)
+{
+    static char buf[CTL_FRAME_MAX + 2];
+    static const struct {
+        const char *frame;
+        uint32_t id;
+        esp_err_t err;
+    } cases[] = {
+        { "", 0, ESP_ERR_INVALID_ARG },
+        { "led on", 0, ESP_ERR_INVALID_ARG },
+        { "-1 led on", 0, ESP_ERR_INVALID_ARG },
+        { "4294967296 led on", 0, ESP_ERR_INVALID_ARG },
+        { " 1 ping", 0, ESP_ERR_INVALID_ARG },
+        { "2", 2, ESP_ERR_INVALID_ARG },
+        { "3 reboot", 3, ESP_ERR_INVALID_ARG },
+        { "4 LED on", 4, ESP_ERR_INVALID_ARG },
+        { "5 led", 5, ESP_ERR_INVALID_ARG },
+        { "6 led dim", 6, ESP_ERR_INVALID_ARG },
+        { "7 gpio 64 high", 7, ESP_ERR_INVALID_ARG },
+        { "8 gpio x high", 8, ESP_ERR_INVALID_ARG },
+        { "9 gpio 4", 9, ESP_ERR_INVALID_ARG },
+        { "10 gpio 4 2", 10, ESP_ERR_INVALID_ARG },
+        { "11 ping now", 11, ESP_ERR_INVALID_ARG },
+    };
+    int bad = 0;
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        ctl_cmd_t cmd;
+        const char *error;
+        if (parse(cases[i].frame, buf, &cmd, &error) != cases[i].err || !error || cmd.id != cases[i].id) {
+            printf("        \"%s\" not rejected as expected\n", cases[i].frame);
+            bad++;
+        }
+    }
+
+    /* Text one byte over the limit, and a frame one byte over the limit */
+    char frame[CTL_FRAME_MAX + 2];
+    ctl_cmd_t cmd;
+    const char *error;
+    int n = snprintf(frame, sizeof(frame), "20 text ");
+    memset(frame + n, 'a', CTL_TEXT_MAX + 1);
+    frame[n + CTL_TEXT_MAX + 1] = '\0';
+    if (parse(frame, buf, &cmd, &error) != ESP_ERR_INVALID_SIZE || cmd.id != 20) {
+        printf("        oversized text accepted\n");
+        bad++;
+    }
+    memset(frame, '1', CTL_FRAME_MAX + 1);
+    frame[CTL_FRAME_MAX + 1] = '\0';
+    if (parse(frame, buf, &cmd, &error) != ESP_ERR_INVALID_SIZE || !error) {
+        printf("        oversized frame accepted\n");
+        bad++;
+    }
+
+    printf("%s  malformed frames       %d of %u accepted or misreported\n", bad ? "FAIL" : "ok  ", bad,
+           (unsigned)(sizeof(cases) / sizeof(cases[0]) + 2));
+    if (bad) failures++;
+}
+
+/* 函数名：check_text_clip
+ *
+ * 函数说明：截断文本时退到 UTF-8 字符边界，短文本原样保留。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_text_clip(void)
+{
+    static const struct {
+        const char *text;
+        size_t max;
+        size_t want;
+    } cases[] = {
+        { "hello", 8, 5 },
+        { "hello", 5, 5 },
+        { "hello", 3, 3 },
+        { "a\xe4\xbd\xa0" "b", 4, 4 },     /* "a你b": cut after the whole character */
+        { "a\xe4\xbd\xa0" "b", 3, 1 },     /* cut inside it backs off to "a" */
+        { "a\xe4\xbd\xa0" "b", 2, 1 },
+        { "\xc3\xa9\xc3\xa9", 3, 2 },   /* "éé" */
+        { "\xf0\x9f\x98\x80", 3, 0 },   /* a 4-byte emoji does not fit at all */
+        { "", 4, 0 },
+    };
+    int bad = 0;
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        size_t got = ctl_text_clip(cases[i].text, cases[i].max);
+        if (got != cases[i].want) {
+            printf("        case %u clipped to %u bytes, want %u\n", (unsigned)i, (unsigned)got,
+                   (unsigned)cases[i].want);
+            bad++;
+        }
+    }
+
+    /* Longest text at the notification limit, then one 3-byte character straddling it */
+    char text[CTL_TEXT_MAX + 4];
+    memset(text, 'a', CTL_TEXT_MAX - 1);
+    memcpy(text + CTL_TEXT_MAX - 1, "\xe4\xbd\xa0", 4);
+    if (ctl_text_clip(text, CTL_TEXT_MAX) != CTL_TEXT_MAX - 1) {
+        printf("        character straddling CTL_TEXT_MAX was split\n");
+        bad++;
+    }
+
+    printf("%s  text clipping          %d of %u wrong\n", bad ? "FAIL" : "ok  ", bad,
+           (unsigned)(sizeof(cases) / sizeof(cases[0]) + 1));
+    if (bad) failures++;
+}
+
+/* 函数名：check_speed
+ *
+ * 函数说明：解析常见命令帧的平均耗时（须远低于每条命令的处理预算）。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_speed(void)
+{
+    static const char *frames[] = { "123456 led toggle", "123457 gpio 4 high", "123458 text Hello from the browser",
+                                    "123459 ping" };
+    static char buf[CTL_FRAME_MAX + 2];
+    const int rounds = 250000;
+    uint32_t sum = 0;
+    struct timespec t0, t1;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < rounds; i++) {
+        ctl_cmd_t cmd;
+        const char *error;
+        parse(frames[i & 3], buf, &cmd, &error);
+        sum += cmd.id + cmd.kind;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double ns = ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / rounds;
+
+    bool ok = sum != 0 && ns < 2000;
+    printf("%s  parse speed            %.0f ns per frame\n", ok ? "ok  " : "FAIL", ns);
+    if (!ok) failures++;
+}
+
+int main(void)
+{
+    check_valid();
+    check_invalid();
+    check_text_clip();
+    check_speed();
+
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
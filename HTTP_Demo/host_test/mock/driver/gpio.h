@@ -0,0 +1,45 @@
+/*
+ * Host build stand-in for ESP-IDF driver/gpio.h
+ *
+ * Output levels are kept per pin so the SPI mock can read the D/C line, and
+ * level changes are counted (e.g. to see the panel reset pulse). GPIO output
+ * register writes (soc/soc.h REG_WRITE) land on the same levels.
+ */
+#ifndef MOCK_GPIO_H
+#define MOCK_GPIO_H
+
+#include <stdint.h>
+#include "esp_err.h"
+
+#define MOCK_GPIO_COUNT     40
+
+typedef int gpio_num_t;
+
+typedef enum {
+    GPIO_MODE_DISABLE,
+    GPIO_MODE_INPUT,
+    GPIO_MODE_OUTPUT,
+} gpio_mode_t;
+
+typedef enum {
+    GPIO_INTR_DISABLE,
+} gpio_int_type_t;
+
+typedef struct {
+    uint64_t pin_bit_mask;
+    gpio_mode_t mode;
+    int pull_up_en;
+    int pull_down_en;
+    gpio_int_type_t intr_type;
+} gpio_config_t;
+
+esp_err_t gpio_config(const gpio_config_t *cfg);
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level);
+int gpio_get_level(gpio_num_t gpio_num);
+
+/* Mock helpers */
+uint32_t mock_gpio_edges(gpio_num_t gpio_num);
+uint32_t mock_gpio_config_calls(void);
+uint32_t mock_reg_writes(void);
+
+#endif /* MOCK_GPIO_H */
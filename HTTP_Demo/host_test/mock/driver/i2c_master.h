@@ -0,0 +1,109 @@
+/*
+ * Host build stand-in for ESP-IDF driver/i2c_master.h
+ *
+ * A device handle points at an emulated SSD1306 controller: every transmit is
+ * decoded (control byte, command stream, data stream) and applied to the
+ * emulated addressing state and GDDRAM, and counted. mock_sh1106_reset()
+ * turns it into an SH1106 instead: 132-column GDDRAM, page addressing only,
+ * and SSD1306-only commands are counted in bad_cmds (the real chip would
+ * misread their arguments as commands, and so does the mock).
+ *
+ * A bus (struct i2c_master_bus_t) hands out its panel from
+ * i2c_master_bus_add_device() and remembers the SCL rate. Transactions then
+ * advance the clock read by esp_timer_get_time() by their bit time at that
+ * rate (or at stretch_hz when the panel cannot keep up), and above
+ * nack_above_hz every MOCK_I2C_NACK_EVERY-th transaction is NACKed, like a
+ * marginal cable.
+ */
+#ifndef MOCK_I2C_MASTER_H
+#define MOCK_I2C_MASTER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#define MOCK_SSD1306_PAGES  8
+#define MOCK_SSD1306_COLS   128
+#define MOCK_SH1106_COLS    132
+#define MOCK_I2C_NACK_EVERY 8
+
+/* Emulated SSD1306 controller state */
+struct i2c_master_dev_t {
+    uint8_t gddram[MOCK_SSD1306_PAGES][MOCK_SH1106_COLS];
+    bool sh1106;
+    uint8_t ram_cols;            /* GDDRAM columns: 128 (SSD1306) or 132 (SH1106) */
+    uint8_t mem_mode;            /* 0 horizontal, 1 vertical, 2 page */
+    uint8_t col, page;           /* current GDDRAM pointers */
+    uint8_t col_start, col_end;  /* SET_COL_ADDR window */
+    uint8_t page_start, page_end;/* SET_PAGE_ADDR window */
+    uint8_t start_line;
+    uint8_t contrast;
+    bool display_on;
+    bool inverted;
+    bool scrolling;
+
+    /* command decoder */
+    uint8_t pending_cmd;
+    uint8_t args[8];
+    uint8_t nargs, need;
+
+    /* bus accounting */
+    uint32_t transactions;
+    uint32_t bytes;
+    uint32_t cmd_bytes;
+    uint32_t data_bytes;
+    uint32_t bad_cmds;           /* commands the emulated controller does not have */
+
+    /* bus timing and faults */
+    uint32_t scl_hz;             /* rate of the added device, 0: transactions take no time */
+    uint32_t stretch_hz;         /* highest rate the panel sustains (clock stretching), 0: no limit */
+    uint32_t nack_above_hz;      /* rates above this NACK now and then, 0: never */
+    uint32_t nacks;
+    struct i2c_master_bus_t *bus;  /* bus it was added to */
+};
+
+typedef enum {
+    I2C_ADDR_BIT_LEN_7 = 0,
+    I2C_ADDR_BIT_LEN_10 = 1,
+} i2c_addr_bit_len_t;
+
+typedef struct {
+    i2c_addr_bit_len_t dev_addr_length;
+    uint16_t device_address;
+    uint32_t scl_speed_hz;
+    uint32_t scl_wait_us;
+} i2c_device_config_t;
+
+/* Emulated bus with one panel */
+struct i2c_master_bus_t {
+    struct i2c_master_dev_t *panel;
+    uint16_t addr;               /* address the panel answers */
+    int devices;                 /* added and not removed */
+};
+
+typedef struct i2c_master_dev_t *i2c_master_dev_handle_t;
+typedef struct i2c_master_bus_t *i2c_master_bus_handle_t;
+
+typedef struct {
+    uint8_t *write_buffer;
+    size_t buffer_size;
+} i2c_master_transmit_multi_buffer_info_t;
+
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t bus, const i2c_device_config_t *dev_config,
+                                    i2c_master_dev_handle_t *ret_handle);
+esp_err_t i2c_master_bus_rm_device(i2c_master_dev_handle_t handle);
+esp_err_t i2c_master_probe(i2c_master_bus_handle_t bus, uint16_t address, int xfer_timeout_ms);
+esp_err_t i2c_master_transmit(i2c_master_dev_handle_t dev, const uint8_t *write_buffer,
+                              size_t write_size, int xfer_timeout_ms);
+esp_err_t i2c_master_multi_buffer_transmit(i2c_master_dev_handle_t dev,
+                                           i2c_master_transmit_multi_buffer_info_t *buffer_info_array,
+                                           size_t array_size, int xfer_timeout_ms);
+
+/* Mock helpers */
+void mock_ssd1306_reset(i2c_master_dev_handle_t dev);
+void mock_ssd1306_reset_counters(i2c_master_dev_handle_t dev);
+void mock_sh1106_reset(i2c_master_dev_handle_t dev);
+void mock_ssd1306_write(i2c_master_dev_handle_t dev, bool is_data, const uint8_t *buf, size_t len);
+
+#endif /* MOCK_I2C_MASTER_H */
@@ -0,0 +1,101 @@
+/*
+ * Host build stand-in for ESP-IDF driver/spi_master.h
+ *
+ * mock_spi_attach() binds an SPI host to an emulated controller (see
+ * driver/i2c_master.h) and a D/C GPIO. Each transaction runs pre_cb, sends
+ * its bytes to the controller as commands or data according to the D/C level,
+ * then runs post_cb, like the real driver's DMA interrupt. In deferred mode
+ * queued transactions stay "on the wire" until mock_spi_run() or a blocking
+ * spi_device_get_trans_result(), so tests can observe a flush in flight.
+ */
+#ifndef MOCK_SPI_MASTER_H
+#define MOCK_SPI_MASTER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "driver/i2c_master.h"
+
+#ifndef portMAX_DELAY
+typedef uint32_t TickType_t;
+#define portMAX_DELAY       0xFFFFFFFFu
+#endif
+
+#define MOCK_SPI_MAX_QUEUE  32
+
+typedef enum {
+    SPI1_HOST,
+    SPI2_HOST,
+    SPI3_HOST,
+    MOCK_SPI_HOSTS,
+} spi_host_device_t;
+
+typedef struct spi_transaction_t spi_transaction_t;
+typedef void (*transaction_cb_t)(spi_transaction_t *trans);
+
+struct spi_transaction_t {
+    uint32_t flags;
+    uint16_t cmd;
+    uint64_t addr;
+    size_t length;              /* bits to send */
+    size_t rxlength;
+    void *user;
+    union {
+        const void *tx_buffer;
+        uint8_t tx_data[4];
+    };
+    union {
+        void *rx_buffer;
+        uint8_t rx_data[4];
+    };
+};
+
+typedef struct {
+    uint8_t command_bits;
+    uint8_t address_bits;
+    uint8_t dummy_bits;
+    uint8_t mode;
+    int clock_speed_hz;
+    int spics_io_num;
+    uint32_t flags;
+    int queue_size;
+    transaction_cb_t pre_cb;
+    transaction_cb_t post_cb;
+} spi_device_interface_config_t;
+
+/* Emulated SPI device */
+struct spi_device_t {
+    i2c_master_dev_handle_t panel;
+    int dc_gpio;
+    bool added;
+    spi_device_interface_config_t cfg;
+    bool deferred;                                  /* hold transactions until mock_spi_run() */
+    spi_transaction_t *queue[MOCK_SPI_MAX_QUEUE];   /* queued, not transferred yet */
+    size_t queued;
+    spi_transaction_t *done[MOCK_SPI_MAX_QUEUE];    /* transferred, result not fetched */
+    size_t ndone;
+
+    /* bus accounting */
+    uint32_t transactions;
+    uint64_t bits;
+    uint32_t max_queued;
+    uint32_t errors;                                /* queue overflows and bad calls */
+};
+
+typedef struct spi_device_t *spi_device_handle_t;
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *dev_config,
+                             spi_device_handle_t *handle);
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle);
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans_desc,
+                                 TickType_t ticks_to_wait);
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans_desc,
+                                      TickType_t ticks_to_wait);
+
+/* Mock helpers */
+spi_device_handle_t mock_spi_attach(spi_host_device_t host, i2c_master_dev_handle_t panel, int dc_gpio);
+size_t mock_spi_run(spi_device_handle_t handle, size_t n);
+void mock_spi_reset_counters(spi_device_handle_t handle);
+
+#endif /* MOCK_SPI_MASTER_H */
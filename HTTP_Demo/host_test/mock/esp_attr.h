@@ -0,0 +1,9 @@
+/*
+ * Host build stand-in for ESP-IDF esp_attr.h
+ */
+#ifndef MOCK_ESP_ATTR_H
+#define MOCK_ESP_ATTR_H
+
+#define IRAM_ATTR
+
+#endif /* MOCK_ESP_ATTR_H */
@@ -0,0 +1,19 @@
+/*
+ * Host build stand-in for ESP-IDF esp_heap_caps.h: all memory is "DMA capable"
+ */
+#ifndef MOCK_ESP_HEAP_CAPS_H
+#define MOCK_ESP_HEAP_CAPS_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_DMA      (1 << 3)
+#define MALLOC_CAP_8BIT     (1 << 2)
+
+static inline void *heap_caps_malloc(size_t size, uint32_t caps)
+{
+    (void)caps;
+    return malloc(size);
+}
+
+#endif /* MOCK_ESP_HEAP_CAPS_H */
@@ -0,0 +1,15 @@
+/*
+ * Host build stand-in for ESP-IDF esp_log.h
+ */
+#ifndef MOCK_ESP_LOG_H
+#define MOCK_ESP_LOG_H
+
+#include <stdio.h>
+#include "esp_err.h"
+
+#define ESP_LOGE(tag, fmt, ...) fprintf(stderr, "E %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) fprintf(stderr, "W %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) ((void)(tag))
+#define ESP_LOGD(tag, fmt, ...) ((void)(tag))
+
+#endif /* MOCK_ESP_LOG_H */
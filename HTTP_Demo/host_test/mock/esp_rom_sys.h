@@ -0,0 +1,14 @@
+/*
+ * Host build stand-in for ESP-IDF esp_rom_sys.h
+ */
+#ifndef MOCK_ESP_ROM_SYS_H
+#define MOCK_ESP_ROM_SYS_H
+
+#include <stdint.h>
+
+static inline void esp_rom_delay_us(uint32_t us)
+{
+    (void)us;
+}
+
+#endif /* MOCK_ESP_ROM_SYS_H */
@@ -0,0 +1,12 @@
+/*
+ * Host build stand-in for ESP-IDF esp_timer.h: esp_timer_get_time() reads the
+ * simulated clock of mock_i2c.c
+ */
+#ifndef MOCK_ESP_TIMER_H
+#define MOCK_ESP_TIMER_H
+
+#include <stdint.h>
+
+int64_t esp_timer_get_time(void);
+
+#endif /* MOCK_ESP_TIMER_H */
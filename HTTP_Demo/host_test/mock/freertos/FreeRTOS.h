@@ -0,0 +1,18 @@
+/*
+ * Host build stand-in for ESP-IDF freertos/FreeRTOS.h
+ *
+ * Only the spinlock API; the host checks are single-threaded, so critical
+ * sections just count nesting to catch unbalanced enter/exit.
+ */
+#ifndef MOCK_FREERTOS_H
+#define MOCK_FREERTOS_H
+
+typedef struct {
+    int depth;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED    { 0 }
+#define portENTER_CRITICAL(mux)         ((mux)->depth++)
+#define portEXIT_CRITICAL(mux)          ((mux)->depth--)
+
+#endif /* MOCK_FREERTOS_H */
@@ -0,0 +1,379 @@
+/*
+ * Mock I2C master backend with an emulated SSD1306 (or SH1106) controller
+ */
+#include <string.h>
+#include "driver/i2c_master.h"
+#include "esp_timer.h"
+
+static int64_t mock_time_us = 0;   /* advanced by timed transactions */
+
+/* 函数名：esp_timer_get_time
+ *
+ * 函数说明：主机环境下的模拟时钟：只随按 SCL 频率计时的 I2C 事务前进。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   模拟时间（微秒）。
+ */
+int64_t esp_timer_get_time(void)
+{
+    return mock_time_us;
+}
+
+/* 函数名：esp_err_to_name
+ *
+ * 函数说明：主机环境下的错误码名称（仅用于日志）。
+ * 参数：
+ *   code - 错误码。
+ * 返回值：
+ *   错误码名称字符串。
+ */
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code) {
+        case ESP_OK:                return "ESP_OK";
+        case ESP_FAIL:              return "ESP_FAIL";
+        case ESP_ERR_NO_MEM:        return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG:   return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_TIMEOUT:       return "ESP_ERR_TIMEOUT";
+        case ESP_ERR_INVALID_VERSION: return "ESP_ERR_INVALID_VERSION";
+        default:                    return "ESP_ERR_UNKNOWN";
+    }
+}
+
+/* 函数名：mock_ssd1306_reset
+ *
+ * 函数说明：恢复控制器上电默认状态。GDDRAM 填充 0xA5 图样，模拟上电时内容未知，
+ *           从而暴露驱动漏发的区域。
+ * 参数：
+ *   dev - 模拟设备句柄。
+ * 返回值：
+ *   无。
+ */
+void mock_ssd1306_reset(i2c_master_dev_handle_t dev)
+{
+    memset(dev, 0, sizeof(*dev));
+    memset(dev->gddram, 0xA5, sizeof(dev->gddram));
+    dev->mem_mode = 2;  /* page addressing after reset */
+    dev->ram_cols = MOCK_SSD1306_COLS;
+    dev->col_end = MOCK_SSD1306_COLS - 1;
+    dev->page_end = MOCK_SSD1306_PAGES - 1;
+    dev->contrast = 0x7F;
+}
+
+/* 函数名：mock_sh1106_reset
+ *
+ * 函数说明：恢复为 SH1106 控制器的上电默认状态：132 列 GDDRAM（可见的 128 列从
+ *           面板的列偏移开始），只有页寻址。
+ * 参数：
+ *   dev - 模拟设备句柄。
+ * 返回值：
+ *   无。
+ */
+void mock_sh1106_reset(i2c_master_dev_handle_t dev)
+{
+    mock_ssd1306_reset(dev);
+    dev->sh1106 = true;
+    dev->ram_cols = MOCK_SH1106_COLS;
+    dev->col_end = MOCK_SH1106_COLS - 1;
+}
+
+/* 函数名：mock_ssd1306_reset_counters
+ *
+ * 函数说明：清零总线计数，保留控制器与 GDDRAM 状态。
+ * 参数：
+ *   dev - 模拟设备句柄。
+ * 返回值：
+ *   无。
+ */
+void mock_ssd1306_reset_counters(i2c_master_dev_handle_t dev)
+{
+    dev->transactions = 0;
+    dev->bytes = 0;
+    dev->cmd_bytes = 0;
+    dev->data_bytes = 0;
+    dev->bad_cmds = 0;
+}
+
+/* 函数名：mock_cmd_arg_count
+ *
+ * 函数说明：返回命令字节后续参数个数。
+ * 参数：
+ *   dev - 模拟设备句柄。
+ *   cmd - 命令字节。
+ * 返回值：
+ *   参数字节数。
+ */
+static uint8_t mock_cmd_arg_count(i2c_master_dev_handle_t dev, uint8_t cmd)
+{
+    if (dev->sh1106) {
+        /* SH1106 has no addressing-mode, window, charge-pump or scroll commands */
+        if (cmd == 0xAD || cmd == 0x81 || cmd == 0xA8 || cmd == 0xD3 ||
+            cmd == 0xD5 || cmd == 0xD9 || cmd == 0xDA || cmd == 0xDB) {
+            return 1;
+        }
+        if ((cmd >= 0x20 && cmd <= 0x2F) || cmd == 0x8D || cmd == 0xA3) {
+            dev->bad_cmds++;
+        }
+        return 0;
+    }
+    switch (cmd) {
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+        case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+            return 1;
+        case 0x21: case 0x22: case 0xA3:
+            return 2;
+        case 0x29: case 0x2A:
+            return 5;
+        case 0x26: case 0x27:
+            return 6;
+        default:
+            return 0;
+    }
+}
+
+/* 函数名：mock_apply_cmd
+ *
+ * 函数说明：执行一条已收齐参数的命令，更新寻址与显示状态。
+ * 参数：
+ *   dev - 模拟设备句柄。
+ *   cmd - 命令字节。
+ *   args - 参数字节。
+ * 返回值：
+ *   无。
+ */
+static void mock_apply_cmd(i2c_master_dev_handle_t dev, uint8_t cmd, const uint8_t *args)
+{
+    if (dev->sh1106 && ((cmd >= 0x20 && cmd <= 0x2F) || cmd == 0x8D || cmd == 0xA3)) {
+        return;  /* not an SH1106 command, counted in mock_cmd_arg_count() */
+    }
+    if (cmd <= 0x0F) {
+        dev->col = (uint8_t)((dev->col & 0xF0) | (cmd & 0x0F));
+    } else if (cmd <= 0x1F) {
+        uint8_t high = dev->sh1106 ? (cmd & 0x0F) : (cmd & 0x07);
+        dev->col = (uint8_t)((dev->col & 0x0F) | (high << 4));
+    } else if (cmd >= 0x40 && cmd <= 0x7F) {
+        dev->start_line = cmd & 0x3F;
+    } else if (cmd >= 0xB0 && cmd <= 0xB7) {
+        dev->page = cmd & 0x07;
+    } else {
+        switch (cmd) {
+            case 0x20: dev->mem_mode = args[0] & 0x03; break;
+            case 0x21:
+                dev->col_start = args[0] & 0x7F;
+                dev->col_end = args[1] & 0x7F;
+                dev->col = dev->col_start;
+                break;
+            case 0x22:
+                dev->page_start = args[0] & 0x07;
+                dev->page_end = args[1] & 0x07;
+                dev->page = dev->page_start;
+                break;
+            case 0x81: dev->contrast = args[0]; break;
+            case 0xA6: dev->inverted = false; break;
+            case 0xA7: dev->inverted = true; break;
+            case 0xAE: dev->display_on = false; break;
+            case 0xAF: dev->display_on = true; break;
+            case 0x2E: dev->scrolling = false; break;
+            case 0x2F: dev->scrolling = true; break;
+            default: break;
+        }
+    }
+}
+
+/* 函数名：mock_feed_cmd
+ *
+ * 函数说明：命令流逐字节解码，收齐参数后执行。
+ * 参数：
+ *   dev - 模拟设备句柄。
+ *   b   - 命令流字节。
+ * 返回值：
+ *   无。
+ */
+static void mock_feed_cmd(i2c_master_dev_handle_t dev, uint8_t b)
+{
+    dev->cmd_bytes++;
+    if (dev->need > 0) {
+        dev->args[dev->nargs++] = b;
+        if (dev->nargs == dev->need) {
+            dev->need = 0;
+            mock_apply_cmd(dev, dev->pending_cmd, dev->args);
+        }
+        return;
+    }
+
+    uint8_t need = mock_cmd_arg_count(dev, b);
+    if (need == 0) {
+        mock_apply_cmd(dev, b, NULL);
+        return;
+    }
+    dev->pending_cmd = b;
+    dev->nargs = 0;
+    dev->need = need;
+}
+
+/* 函数名：mock_feed_data
+ *
+ * 函数说明：写入一个 GDDRAM 字节并按当前寻址模式推进列/页指针。
+ * 参数：
+ *   dev - 模拟设备句柄。
+ *   b   - 数据字节。
+ * 返回值：
+ *   无。
+ */
+static void mock_feed_data(i2c_master_dev_handle_t dev, uint8_t b)
+{
+    dev->data_bytes++;
+    if (dev->col < dev->ram_cols) dev->gddram[dev->page & 0x07][dev->col] = b;
+
+    switch (dev->mem_mode) {
+        case 0:  /* horizontal */
+            if (dev->col >= dev->col_end) {
+                dev->col = dev->col_start;
+                dev->page = dev->page >= dev->page_end ? dev->page_start : (uint8_t)(dev->page + 1);
+            } else {
+                dev->col++;
+            }
+            break;
+        case 1:  /* vertical */
+            if (dev->page >= dev->page_end) {
+                dev->page = dev->page_start;
+                dev->col = dev->col >= dev->col_end ? dev->col_start : (uint8_t)(dev->col + 1);
+            } else {
+                dev->page++;
+            }
+            break;
+        default: /* page */
+            dev->col = dev->col >= dev->ram_cols - 1 ? 0 : (uint8_t)(dev->col + 1);
+            break;
+    }
+}
+
+/* 函数名：mock_transaction
+ *
+ * 函数说明：解码一次 I2C 写事务：控制字节 Co 位为 1 时每个字节前都有控制字节，
+ *           为 0 时其后全部字节按 D/C# 位作为命令或数据。
+ * 参数：
+ *   dev   - 模拟设备句柄。
+ *   segs  - 事务分段。
+ *   nsegs - 分段数量。
+ * 返回值：
+ *   ESP_OK；事务为空时返回 ESP_ERR_INVALID_ARG。
+ */
+static esp_err_t mock_transaction(i2c_master_dev_handle_t dev,
+                                  const i2c_master_transmit_multi_buffer_info_t *segs, size_t nsegs)
+{
+    bool expect_control = true;
+    bool continuation = false;
+    bool is_data = false;
+    size_t total = 0;
+
+    for (size_t s = 0; s < nsegs; s++) {
+        for (size_t i = 0; i < segs[s].buffer_size; i++) {
+            uint8_t b = segs[s].write_buffer[i];
+            total++;
+            if (expect_control) {
+                continuation = (b & 0x80) != 0;
+                is_data = (b & 0x40) != 0;
+                expect_control = false;
+                continue;
+            }
+            if (is_data) {
+                mock_feed_data(dev, b);
+            } else {
+                mock_feed_cmd(dev, b);
+            }
+            if (continuation) expect_control = true;
+        }
+    }
+
+    if (total == 0) return ESP_ERR_INVALID_ARG;
+    dev->transactions++;
+    dev->bytes += (uint32_t)total;
+
+    if (dev->scl_hz) {
+        /* address byte + payload, 9 clocks per byte */
+        uint32_t hz = dev->stretch_hz && dev->stretch_hz < dev->scl_hz ? dev->stretch_hz : dev->scl_hz;
+        mock_time_us += (int64_t)((total + 1) * 9 * 1000000ull / hz);
+    }
+    if (dev->nack_above_hz && dev->scl_hz > dev->nack_above_hz &&
+        dev->transactions % MOCK_I2C_NACK_EVERY == 0) {
+        dev->nacks++;
+        return ESP_ERR_INVALID_STATE;
+    }
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t bus, const i2c_device_config_t *dev_config,
+                                    i2c_master_dev_handle_t *ret_handle)
+{
+    if (!bus || !bus->panel || !dev_config || !ret_handle || dev_config->scl_speed_hz == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    bus->panel->scl_hz = dev_config->scl_speed_hz;
+    bus->panel->bus = bus;
+    bus->devices++;
+    *ret_handle = bus->panel;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_rm_device(i2c_master_dev_handle_t handle)
+{
+    if (!handle || !handle->bus || handle->bus->devices == 0) return ESP_ERR_INVALID_ARG;
+    handle->bus->devices--;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_probe(i2c_master_bus_handle_t bus, uint16_t address, int xfer_timeout_ms)
+{
+    (void)xfer_timeout_ms;
+    if (!bus || !bus->panel) return ESP_ERR_INVALID_ARG;
+    return address == bus->addr ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t i2c_master_transmit(i2c_master_dev_handle_t dev, const uint8_t *write_buffer,
+                              size_t write_size, int xfer_timeout_ms)
+{
+    (void)xfer_timeout_ms;
+    if (!dev || !write_buffer) return ESP_ERR_INVALID_ARG;
+    i2c_master_transmit_multi_buffer_info_t seg = {
+        .write_buffer = (uint8_t *)write_buffer,
+        .buffer_size = write_size,
+    };
+    return mock_transaction(dev, &seg, 1);
+}
+
+esp_err_t i2c_master_multi_buffer_transmit(i2c_master_dev_handle_t dev,
+                                           i2c_master_transmit_multi_buffer_info_t *buffer_info_array,
+                                           size_t array_size, int xfer_timeout_ms)
+{
+    (void)xfer_timeout_ms;
+    if (!dev || !buffer_info_array) return ESP_ERR_INVALID_ARG;
+    return mock_transaction(dev, buffer_info_array, array_size);
+}
+
+/* 函数名：mock_ssd1306_write
+ *
+ * 函数说明：不经过 I2C 控制字节直接向模拟控制器写入一段命令或数据（4 线 SPI 由 D/C
+ *           引脚区分命令与数据，见 mock_spi.c），计为一次事务。
+ * 参数：
+ *   dev     - 模拟设备句柄。
+ *   is_data - true 为数据（D/C 高），false 为命令。
+ *   buf     - 字节。
+ *   len     - 字节数。
+ * 返回值：
+ *   无。
+ */
+void mock_ssd1306_write(i2c_master_dev_handle_t dev, bool is_data, const uint8_t *buf, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        if (is_data) {
+            mock_feed_data(dev, buf[i]);
+        } else {
+            mock_feed_cmd(dev, buf[i]);
+        }
+    }
+    dev->transactions++;
+    dev->bytes += (uint32_t)len;
+}
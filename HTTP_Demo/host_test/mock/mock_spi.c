@@ -0,0 +1,240 @@
+/*
+ * Mock GPIO and SPI master backends; SPI transactions feed the emulated
+ * controller of mock_i2c.c with the D/C line selecting commands or data
+ */
+#include <string.h>
+#include "driver/gpio.h"
+#include "driver/spi_master.h"
+#include "soc/gpio_reg.h"
+
+static uint8_t gpio_levels[MOCK_GPIO_COUNT];
+static uint32_t gpio_edge_count[MOCK_GPIO_COUNT];
+static uint32_t gpio_config_calls;
+static uint32_t reg_write_count;
+static struct spi_device_t spi_devices[MOCK_SPI_HOSTS];
+
+esp_err_t gpio_config(const gpio_config_t *cfg)
+{
+    if (!cfg || cfg->pin_bit_mask >> MOCK_GPIO_COUNT) return ESP_ERR_INVALID_ARG;
+    gpio_config_calls++;
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+    if (gpio_num < 0 || gpio_num >= MOCK_GPIO_COUNT) return ESP_ERR_INVALID_ARG;
+    uint8_t v = level ? 1 : 0;
+    if (gpio_levels[gpio_num] != v) gpio_edge_count[gpio_num]++;
+    gpio_levels[gpio_num] = v;
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num)
+{
+    if (gpio_num < 0 || gpio_num >= MOCK_GPIO_COUNT) return 0;
+    return gpio_levels[gpio_num];
+}
+
+/* 函数名：mock_gpio_edges
+ *
+ * 函数说明：返回引脚电平变化次数（用于检查复位脉冲等）。
+ * 参数：
+ *   gpio_num - 引脚号。
+ * 返回值：
+ *   电平变化次数。
+ */
+uint32_t mock_gpio_edges(gpio_num_t gpio_num)
+{
+    if (gpio_num < 0 || gpio_num >= MOCK_GPIO_COUNT) return 0;
+    return gpio_edge_count[gpio_num];
+}
+
+/* 函数名：mock_gpio_config_calls
+ *
+ * 函数说明：返回成功的 gpio_config() 调用次数。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   调用次数。
+ */
+uint32_t mock_gpio_config_calls(void)
+{
+    return gpio_config_calls;
+}
+
+/* 函数名：mock_reg_write
+ *
+ * 函数说明：REG_WRITE 的替身：GPIO 输出置位/清零寄存器按位置高或拉低模拟引脚电平，
+ *           其余寄存器忽略；每次写入计数。
+ * 参数：
+ *   reg   - 寄存器地址。
+ *   value - 写入值。
+ * 返回值：
+ *   无。
+ */
+void mock_reg_write(uint32_t reg, uint32_t value)
+{
+    int base;
+    int level;
+
+    reg_write_count++;
+    switch (reg) {
+    case GPIO_OUT_W1TS_REG:  base = 0;  level = 1; break;
+    case GPIO_OUT_W1TC_REG:  base = 0;  level = 0; break;
+    case GPIO_OUT1_W1TS_REG: base = 32; level = 1; break;
+    case GPIO_OUT1_W1TC_REG: base = 32; level = 0; break;
+    default: return;
+    }
+    for (int bit = 0; bit < 32 && base + bit < MOCK_GPIO_COUNT; bit++) {
+        if (value & (1u << bit)) gpio_set_level(base + bit, level);
+    }
+}
+
+/* 函数名：mock_reg_writes
+ *
+ * 函数说明：返回 mock_reg_write() 的调用次数。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   寄存器写入次数。
+ */
+uint32_t mock_reg_writes(void)
+{
+    return reg_write_count;
+}
+
+/* 函数名：mock_spi_attach
+ *
+ * 函数说明：把 SPI 主机绑定到模拟控制器与 D/C 引脚，之后 spi_bus_add_device() 返回该设备。
+ *           清空队列与计数，默认立即传输（非延迟模式）。
+ * 参数：
+ *   host   - SPI 主机。
+ *   panel  - 模拟控制器。
+ *   dc_gpio - D/C 引脚。
+ * 返回值：
+ *   模拟设备句柄。
+ */
+spi_device_handle_t mock_spi_attach(spi_host_device_t host, i2c_master_dev_handle_t panel, int dc_gpio)
+{
+    spi_device_handle_t dev = &spi_devices[host];
+    memset(dev, 0, sizeof(*dev));
+    dev->panel = panel;
+    dev->dc_gpio = dc_gpio;
+    return dev;
+}
+
+/* 函数名：mock_spi_reset_counters
+ *
+ * 函数说明：清零总线计数，保留队列。
+ * 参数：
+ *   handle - 模拟设备句柄。
+ * 返回值：
+ *   无。
+ */
+void mock_spi_reset_counters(spi_device_handle_t handle)
+{
+    handle->transactions = 0;
+    handle->bits = 0;
+    handle->max_queued = 0;
+    handle->errors = 0;
+}
+
+/* 函数名：mock_spi_transfer
+ *
+ * 函数说明：完成队首事务：pre_cb（驱动在其中设置 D/C），按 D/C 电平把字节送入模拟控制器，
+ *           post_cb，然后移入结果队列。
+ * 参数：
+ *   handle - 模拟设备句柄。
+ * 返回值：
+ *   无。
+ */
+static void mock_spi_transfer(spi_device_handle_t handle)
+{
+    spi_transaction_t *t = handle->queue[0];
+    memmove(handle->queue, handle->queue + 1, (handle->queued - 1) * sizeof(handle->queue[0]));
+    handle->queued--;
+
+    if (handle->cfg.pre_cb) handle->cfg.pre_cb(t);
+    mock_ssd1306_write(handle->panel, gpio_get_level(handle->dc_gpio) != 0,
+                       (const uint8_t *)t->tx_buffer, t->length / 8);
+    handle->transactions++;
+    handle->bits += t->length;
+    if (handle->cfg.post_cb) handle->cfg.post_cb(t);
+    handle->done[handle->ndone++] = t;
+}
+
+/* 函数名：mock_spi_run
+ *
+ * 函数说明：延迟模式下完成最多 n 个排队的事务（模拟 DMA 在后台推进）。
+ * 参数：
+ *   handle - 模拟设备句柄。
+ *   n      - 最多完成的事务数。
+ * 返回值：
+ *   实际完成的事务数。
+ */
+size_t mock_spi_run(spi_device_handle_t handle, size_t n)
+{
+    size_t ran = 0;
+    while (ran < n && handle->queued > 0) {
+        mock_spi_transfer(handle);
+        ran++;
+    }
+    return ran;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *dev_config,
+                             spi_device_handle_t *handle)
+{
+    if (host >= MOCK_SPI_HOSTS || !dev_config || !handle) return ESP_ERR_INVALID_ARG;
+    if (dev_config->queue_size <= 0 || dev_config->queue_size > MOCK_SPI_MAX_QUEUE) return ESP_ERR_INVALID_ARG;
+    spi_device_handle_t dev = &spi_devices[host];
+    if (!dev->panel || dev->added) return ESP_ERR_INVALID_STATE;
+    dev->cfg = *dev_config;
+    dev->added = true;
+    *handle = dev;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle)
+{
+    if (!handle) return ESP_ERR_INVALID_ARG;
+    if (handle->queued || handle->ndone) return ESP_ERR_INVALID_STATE;
+    handle->added = false;
+    return ESP_OK;
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans_desc,
+                                 TickType_t ticks_to_wait)
+{
+    (void)ticks_to_wait;
+    if (!handle || !trans_desc || !trans_desc->tx_buffer || trans_desc->length % 8) {
+        if (handle) handle->errors++;
+        return ESP_ERR_INVALID_ARG;
+    }
+    /* The real driver blocks here; a full queue means the caller forgot to reap results */
+    if (handle->queued + handle->ndone >= (size_t)handle->cfg.queue_size) {
+        handle->errors++;
+        return ESP_ERR_TIMEOUT;
+    }
+    handle->queue[handle->queued++] = trans_desc;
+    if (handle->queued > handle->max_queued) handle->max_queued = (uint32_t)handle->queued;
+    if (!handle->deferred) mock_spi_transfer(handle);
+    return ESP_OK;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans_desc,
+                                      TickType_t ticks_to_wait)
+{
+    (void)ticks_to_wait;
+    if (!handle || !trans_desc) return ESP_ERR_INVALID_ARG;
+    /* Blocking for a result lets the "DMA" finish the oldest transaction */
+    if (handle->ndone == 0 && handle->queued > 0) mock_spi_transfer(handle);
+    if (handle->ndone == 0) {
+        handle->errors++;
+        return ESP_ERR_TIMEOUT;
+    }
+    *trans_desc = handle->done[0];
+    memmove(handle->done, handle->done + 1, (handle->ndone - 1) * sizeof(handle->done[0]));
+    handle->ndone--;
+    return ESP_OK;
+}
@@ -0,0 +1,8 @@
+/*
+ * Host build stand-in for the generated sdkconfig.h: no CONFIG_* options are
+ * set, so the OLED sources fall back to their built-in defaults
+ */
+#ifndef MOCK_SDKCONFIG_H
+#define MOCK_SDKCONFIG_H
+
+#endif /* MOCK_SDKCONFIG_H */
@@ -0,0 +1,12 @@
+/*
+ * Host build stand-in for ESP-IDF soc/gpio_reg.h (ESP32 addresses)
+ */
+#ifndef MOCK_GPIO_REG_H
+#define MOCK_GPIO_REG_H
+
+#define GPIO_OUT_W1TS_REG       0x3FF44008
+#define GPIO_OUT_W1TC_REG       0x3FF4400C
+#define GPIO_OUT1_W1TS_REG      0x3FF44014
+#define GPIO_OUT1_W1TC_REG      0x3FF44018
+
+#endif /* MOCK_GPIO_REG_H */
@@ -0,0 +1,16 @@
+/*
+ * Host build stand-in for ESP-IDF soc/soc.h
+ *
+ * Register writes go to mock_reg_write() (mock_spi.c), which applies the GPIO
+ * output set/clear registers to the mock pin levels.
+ */
+#ifndef MOCK_SOC_H
+#define MOCK_SOC_H
+
+#include <stdint.h>
+
+void mock_reg_write(uint32_t reg, uint32_t value);
+
+#define REG_WRITE(reg, value)   mock_reg_write((reg), (value))
+
+#endif /* MOCK_SOC_H */
@@ -0,0 +1,13 @@
+/*
+ * Host build stand-in for ESP-IDF soc/soc_caps.h (ESP32 GPIO capabilities)
+ *
+ * GPIO24 and 28~31 do not exist and GPIO34~39 are input-only.
+ */
+#ifndef MOCK_SOC_CAPS_H
+#define MOCK_SOC_CAPS_H
+
+#define SOC_GPIO_PIN_COUNT                  40
+#define SOC_GPIO_VALID_GPIO_MASK            (0xFFFFFFFFFFULL & ~(0ULL | 1ULL << 24 | 0xFULL << 28))
+#define SOC_GPIO_VALID_OUTPUT_GPIO_MASK     (SOC_GPIO_VALID_GPIO_MASK & ~0xFC00000000ULL)
+
+#endif /* MOCK_SOC_CAPS_H */
@@ -0,0 +1,292 @@
+/*
+ * Checks the flash animation player
+ *
+ * A random sprite animation is encoded here as keyframes plus per-page XOR
+ * records (the same format tools/gen_oled_anims.py writes) and played back
+ * with oled_anim_next(); every frame must match the source byte for byte in
+ * the framebuffer and, after ssd1306_show(), in the mock GDDRAM. Looping,
+ * the end of one-shot animations and corrupt data are checked too. The
+ * generated animations are then played at their target frame rate: the bus
+ * bytes of the slowest frame must fit in one frame period at 700 kHz.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306.h"
+#include "oled_anim.h"
+#include "oled_anims.h"
+
+#define FRAME_BYTES     1024
+#define I2C_HZ          700000
+#define TEST_FRAMES     48
+
+static struct i2c_master_dev_t panel;
+static ssd1306_t dev;
+static int failures = 0;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/* 函数名：frame_matches
+ *
+ * 函数说明：帧缓冲与期望帧一致，且刷新后模拟 GDDRAM 也一致（可发现漏标的脏区）。
+ * 参数：
+ *   expect - 期望帧。
+ * 返回值：
+ *   true 一致。
+ */
+static bool frame_matches(const uint8_t *expect)
+{
+    if (memcmp(dev.buffer, expect, FRAME_BYTES) != 0) return false;
+    if (ssd1306_show(&dev) != ESP_OK) return false;
+    for (int page = 0; page < 8; page++) {
+        if (memcmp(panel.gddram[page], expect + page * 128, 128) != 0) return false;
+    }
+    return true;
+}
+
+/* 函数名：encode_frame
+ *
+ * 函数说明：按动画格式编码一帧：每个变化的页一条记录（裁剪到变化的列段），数据以
+ *           PackBits 编码（仅用字面段与重复段的最简单形式）。prev 为 NULL 时编码关键帧。
+ * 参数：
+ *   prev - 上一帧，NULL 表示关键帧。
+ *   cur  - 当前帧。
+ *   out  - 输出缓冲。
+ * 返回值：
+ *   编码长度。
+ */
+static size_t encode_frame(const uint8_t *prev, const uint8_t *cur, uint8_t *out)
+{
+    size_t o = 2;
+    uint8_t records = 0;
+    out[0] = prev ? 0 : OLED_ANIM_KEYFRAME;
+    for (int page = 0; page < 8; page++) {
+        uint8_t x[128];
+        int c0 = -1, c1 = -1;
+        for (int col = 0; col < 128; col++) {
+            x[col] = (uint8_t)(cur[page * 128 + col] ^ (prev ? prev[page * 128 + col] : 0));
+            if (x[col]) {
+                if (c0 < 0) c0 = col;
+                c1 = col;
+            }
+        }
+        if (c0 < 0) continue;
+        out[o++] = (uint8_t)page;
+        out[o++] = (uint8_t)c0;
+        out[o++] = (uint8_t)(c1 - c0 + 1);
+        for (int col = c0; col <= c1;) {
+            int run = 1;
+            while (col + run <= c1 && run < 130 && x[col + run] == x[col]) run++;
+            if (run >= 3) {
+                out[o++] = (uint8_t)(run + 125);
+                out[o++] = x[col];
+            } else {
+                out[o++] = (uint8_t)(run - 1);
+                memcpy(out + o, x + col, (size_t)run);
+                o += (size_t)run;
+            }
+            col += run;
+        }
+        records++;
+    }
+    out[1] = records;
+    return o;
+}
+
+/* 函数名：draw_sprites
+ *
+ * 函数说明：绘制测试动画的一帧：随机静态背景上若干个移动的方块。
+ * 参数：
+ *   canvas - 绘制用设备。
+ *   bg     - 背景帧。
+ *   t      - 帧序号。
+ * 返回值：
+ *   无。
+ */
+static void draw_sprites(ssd1306_t *canvas, const uint8_t *bg, int t)
+{
+    memcpy(canvas->buffer, bg, FRAME_BYTES);
+    for (int s = 0; s < 4; s++) {
+        int x = (s * 29 + t * (s + 1)) % 118, y = (s * 13 + t * (3 - s % 3)) % 54;
+        ssd1306_fill_rect(canvas, (uint16_t)x, (uint16_t)y, 10, 10, (uint8_t)(s & 1));
+    }
+}
+
+/* 函数名：check_roundtrip
+ *
+ * 函数说明：编码一段随机动画（中途插入一个关键帧）并逐帧播放两遍（循环），
+ *           每帧须与源帧一致；单次动画播完后须返回 ESP_ERR_INVALID_STATE。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_roundtrip(void)
+{
+    static uint8_t frames[TEST_FRAMES][FRAME_BYTES], bg[FRAME_BYTES];
+    static uint8_t data[TEST_FRAMES * (FRAME_BYTES * 2)];
+    static struct i2c_master_dev_t canvas_panel;
+    ssd1306_t canvas;
+    size_t len = 0;
+    int bad = 0;
+
+    mock_ssd1306_reset(&canvas_panel);
+    ssd1306_init(&canvas, &canvas_panel, 128, 64, 0x3C, false);
+    for (int i = 0; i < FRAME_BYTES; i++) bg[i] = (uint8_t)(rand() & rand() & rand());
+    for (int t = 0; t < TEST_FRAMES; t++) {
+        draw_sprites(&canvas, bg, t);
+        memcpy(frames[t], canvas.buffer, FRAME_BYTES);
+        bool key = t == 0 || t == TEST_FRAMES / 2;
+        len += encode_frame(key ? NULL : frames[t - 1], frames[t], data + len);
+    }
+    ssd1306_deinit(&canvas);
+
+    oled_anim_t anim = { "test", data, (uint32_t)len, TEST_FRAMES, 128, 64, 25, true };
+    oled_anim_player_t p;
+    ssd1306_fill(&dev, 1);
+    if (oled_anim_start(&p, &anim, &dev) != ESP_OK) bad++;
+    for (int t = 0; t < TEST_FRAMES * 2 && !bad; t++) {
+        if (oled_anim_next(&p, &dev) != ESP_OK || !frame_matches(frames[t % TEST_FRAMES])) bad++;
+    }
+    printf("%s  roundtrip        %d frames x2 (looped), %u B for %u B raw\n",
+           bad ? "FAIL" : "ok  ", TEST_FRAMES, (unsigned)len, (unsigned)(TEST_FRAMES * FRAME_BYTES));
+    if (bad) failures++;
+
+    anim.loop = false;
+    oled_anim_start(&p, &anim, &dev);
+    for (int t = 0; t < TEST_FRAMES; t++) oled_anim_next(&p, &dev);
+    if (!oled_anim_done(&p) || oled_anim_next(&p, &dev) != ESP_ERR_INVALID_STATE ||
+        !frame_matches(frames[TEST_FRAMES - 1])) {
+        printf("FAIL  one-shot         did not stop on the last frame\n");
+        failures++;
+    } else {
+        printf("ok    one-shot         stops on the last frame\n");
+    }
+}
+
+/* 函数名：check_corrupt
+ *
+ * 函数说明：截断、越界记录、解压长度不符、首帧不是关键帧与尺寸不符都须被拒绝。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_corrupt(void)
+{
+    static const uint8_t short_frame[] = { OLED_ANIM_KEYFRAME };
+    static const uint8_t bad_page[] = { OLED_ANIM_KEYFRAME, 1, 8, 0, 1, 0, 0xFF };
+    static const uint8_t past_width[] = { OLED_ANIM_KEYFRAME, 1, 0, 120, 9, 0x84, 0xFF };
+    static const uint8_t overlong[] = { OLED_ANIM_KEYFRAME, 1, 0, 0, 4, 0x83, 0xFF };
+    static const uint8_t truncated[] = { OLED_ANIM_KEYFRAME, 1, 0, 0, 4, 3, 0xFF, 0xFF };
+    static const uint8_t missing[] = { OLED_ANIM_KEYFRAME, 2, 0, 0, 1, 0, 0xFF };
+    static const uint8_t no_key[] = { 0, 1, 0, 0, 1, 0, 0xFF };
+    struct {
+        const char *name;
+        const uint8_t *data;
+        size_t len;
+    } cases[] = {
+        { "short frame", short_frame, sizeof(short_frame) },
+        { "bad page", bad_page, sizeof(bad_page) },
+        { "past width", past_width, sizeof(past_width) },
+        { "overlong run", overlong, sizeof(overlong) },
+        { "truncated data", truncated, sizeof(truncated) },
+        { "missing record", missing, sizeof(missing) },
+        { "no keyframe", no_key, sizeof(no_key) },
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        oled_anim_t anim = { "bad", cases[i].data, (uint32_t)cases[i].len, 1, 128, 64, 10, false };
+        oled_anim_player_t p;
+        esp_err_t err = oled_anim_start(&p, &anim, &dev);
+        if (err == ESP_OK) err = oled_anim_next(&p, &dev);
+        if (err != ESP_ERR_INVALID_SIZE) {
+            printf("FAIL  corrupt      %-16s got 0x%x\n", cases[i].name, err);
+            failures++;
+        } else {
+            printf("ok    corrupt      %-16s rejected\n", cases[i].name);
+        }
+    }
+
+    oled_anim_t small = oled_anim_boot;
+    small.height = 32;
+    oled_anim_player_t p;
+    if (oled_anim_start(&p, &small, &dev) != ESP_ERR_INVALID_SIZE) {
+        printf("FAIL  corrupt      size mismatch accepted\n");
+        failures++;
+    } else {
+        printf("ok    corrupt      size mismatch    rejected\n");
+    }
+}
+
+/* 函数名：bench_generated
+ *
+ * 函数说明：播放每个生成的动画一遍，统计每帧解码耗时与总线字节，最慢一帧的总线时间
+ *           须小于目标帧周期；同时检查按名称查找。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void bench_generated(void)
+{
+    for (size_t i = 0; i < oled_anim_count; i++) {
+        const oled_anim_t *anim = oled_anim_list[i];
+        oled_anim_player_t p;
+        uint64_t decode_ns = 0;
+        uint32_t total = 0, worst = 0;
+        bool ok = oled_anim_find(anim->name) == anim && oled_anim_start(&p, anim, &dev) == ESP_OK;
+
+        ssd1306_clear(&dev);
+        ssd1306_show(&dev);
+        for (uint16_t f = 0; f < anim->frames && ok; f++) {
+            mock_ssd1306_reset_counters(&panel);
+            uint64_t t0 = now_ns();
+            ok = oled_anim_next(&p, &dev) == ESP_OK;
+            decode_ns += now_ns() - t0;
+            ok = ok && ssd1306_show(&dev) == ESP_OK;
+            total += panel.bytes;
+            if (panel.bytes > worst) worst = panel.bytes;
+        }
+
+        double period_us = 1e6 / anim->fps;
+        double worst_us = worst * 9.0 * 1e6 / I2C_HZ;
+        bool fits = worst_us < period_us;
+        printf("%s  anim %-8s %3u frames %4u B flash  bus avg %5.0f B max %5u B (%5.0f us of %5.0f us)  decode %6.0f ns\n",
+               ok && fits ? "ok  " : "FAIL", anim->name, anim->frames, (unsigned)anim->len,
+               (double)total / anim->frames, worst, worst_us, period_us, (double)decode_ns / anim->frames);
+        if (!ok || !fits) failures++;
+    }
+    if (oled_anim_find("no such animation") != NULL) {
+        printf("FAIL  anim lookup      unknown name found\n");
+        failures++;
+    }
+}
+
+int main(void)
+{
+    mock_ssd1306_reset(&panel);
+    if (ssd1306_init(&dev, &panel, 128, 64, 0x3C, false) != ESP_OK) {
+        printf("FAIL  ssd1306_init\n");
+        return 1;
+    }
+    srand(1616);
+
+    check_roundtrip();
+    check_corrupt();
+    bench_generated();
+
+    ssd1306_deinit(&dev);
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,329 @@
+/*
+ * Checks the 1bpp blit API and on-the-fly RLE decoding
+ *
+ * Blits random page-major bitmaps at random (including unaligned and
+ * partially off-screen) positions in every mode and compares the framebuffer
+ * with a per-pixel reference; flushes after each blit and checks the mock
+ * GDDRAM so a missed dirty span shows up as a mismatch. PackBits images must
+ * draw exactly like their raw source, corrupt streams must be rejected
+ * without touching pixels outside the image, and the generated icons must
+ * decode. Also reports the cost of an aligned, unaligned and RLE blit against
+ * drawing the same logo pixel by pixel.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306.h"
+#include "oled_icons.h"
+
+#define MAX_W   40
+#define MAX_H   24
+#define MAX_BYTES   (MAX_W * ((MAX_H + 7) / 8))
+
+static struct i2c_master_dev_t panel;
+static ssd1306_t dev;
+static uint8_t ref[1024];
+static int failures = 0;
+
+static const char *MODE_NAMES[] = { "opaque", "set", "clear", "xor" };
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/* 函数名：pack
+ *
+ * 函数说明：PackBits 压缩（与 gen_oled_icons.py 相同的编码规则）。
+ * 参数：
+ *   src, n - 原始数据。
+ *   out    - 输出缓冲。
+ * 返回值：
+ *   压缩后长度。
+ */
+static size_t pack(const uint8_t *src, size_t n, uint8_t *out)
+{
+    size_t i = 0, o = 0, lit = 0, lit_at = 0;
+    while (i < n) {
+        size_t run = 1;
+        while (i + run < n && run < 130 && src[i + run] == src[i]) run++;
+        if (run >= 3) {
+            if (lit) { out[lit_at] = (uint8_t)(lit - 1); lit = 0; }
+            out[o++] = (uint8_t)(run + 125);
+            out[o++] = src[i];
+            i += run;
+        } else {
+            if (lit == 0) lit_at = o++;
+            out[o++] = src[i++];
+            if (++lit == 128) { out[lit_at] = 127; lit = 0; }
+        }
+    }
+    if (lit) out[lit_at] = (uint8_t)(lit - 1);
+    return o;
+}
+
+/* 函数名：ref_blit
+ *
+ * 函数说明：逐像素参考实现，结果写入 ref。
+ * 参数：
+ *   bitmap - 页格式位图。
+ *   x, y   - 左上坐标。
+ *   w, h   - 位图宽高。
+ *   mode   - 绘制模式。
+ * 返回值：
+ *   无。
+ */
+static void ref_blit(const uint8_t *bitmap, int x, int y, int w, int h, ssd1306_blit_mode_t mode)
+{
+    for (int row = 0; row < h; row++) {
+        for (int col = 0; col < w; col++) {
+            int px = x + col, py = y + row;
+            if (px >= dev.width || py >= dev.height) continue;
+            uint8_t *dst = &ref[(py / 8) * dev.width + px];
+            uint8_t bit = (uint8_t)(1 << (py % 8));
+            bool on = bitmap[(row / 8) * w + col] & (1 << (row % 8));
+            switch (mode) {
+                case SSD1306_BLIT_OPAQUE: *dst = on ? (*dst | bit) : (*dst & ~bit); break;
+                case SSD1306_BLIT_SET:    if (on) *dst |= bit; break;
+                case SSD1306_BLIT_CLEAR:  if (on) *dst &= ~bit; break;
+                case SSD1306_BLIT_XOR:    if (on) *dst ^= bit; break;
+            }
+        }
+    }
+}
+
+/* 函数名：random_bitmap
+ *
+ * 函数说明：生成带连续段的随机位图（让 PackBits 同时出现字面段与重复段）。
+ * 参数：
+ *   out - 输出缓冲。
+ *   n   - 字节数。
+ * 返回值：
+ *   无。
+ */
+static void random_bitmap(uint8_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = (i > 0 && rand() % 3 == 0) ? out[i - 1] : (uint8_t)rand();
+    }
+}
+
+/* 函数名：matches
+ *
+ * 函数说明：比较帧缓冲与参考结果，刷新后再比较模拟 GDDRAM（检查脏区是否漏标）。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   true 一致。
+ */
+static bool matches(void)
+{
+    if (memcmp(dev.buffer, ref, sizeof(ref)) != 0) return false;
+    ssd1306_show(&dev);
+    for (int page = 0; page < 8; page++) {
+        if (memcmp(panel.gddram[page], ref + page * dev.width, dev.width) != 0) return false;
+    }
+    return true;
+}
+
+/* 函数名：check_random_blits
+ *
+ * 函数说明：随机位置、尺寸与模式的原始位图与 RLE 位图都须与参考实现逐像素一致。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_random_blits(void)
+{
+    uint8_t bitmap[MAX_BYTES];
+    uint8_t packed[MAX_BYTES * 2];
+
+    for (int mode = SSD1306_BLIT_OPAQUE; mode <= SSD1306_BLIT_XOR; mode++) {
+        int bad_raw = 0, bad_rle = 0;
+        for (int i = 0; i < 2000; i++) {
+            int w = 1 + rand() % MAX_W, h = 1 + rand() % MAX_H;
+            int x = rand() % (dev.width + 8) - 4, y = rand() % (dev.height + 8) - 4;
+            if (x < 0) x = 0;
+            if (y < 0) y = 0;
+            size_t n = (size_t)w * ((h + 7) / 8);
+            random_bitmap(bitmap, n);
+
+            ssd1306_blit(&dev, bitmap, (uint16_t)x, (uint16_t)y, (uint16_t)w, (uint16_t)h, mode);
+            ref_blit(bitmap, x, y, w, h, mode);
+            if (!matches()) {
+                bad_raw++;
+                memcpy(ref, dev.buffer, sizeof(ref));
+            }
+
+            size_t len = pack(bitmap, n, packed);
+            esp_err_t err = ssd1306_blit_rle(&dev, packed, len, (uint16_t)x, (uint16_t)y,
+                                             (uint16_t)w, (uint16_t)h, mode);
+            ref_blit(bitmap, x, y, w, h, mode);
+            if (err != ESP_OK || !matches()) {
+                bad_rle++;
+                memcpy(ref, dev.buffer, sizeof(ref));
+            }
+        }
+        if (bad_raw || bad_rle) {
+            printf("FAIL  blit %-7s %d raw / %d rle of 2000 differ from the reference\n",
+                   MODE_NAMES[mode], bad_raw, bad_rle);
+            failures++;
+        } else {
+            printf("ok    blit %-7s 2000 raw + 2000 rle blits pixel-exact\n", MODE_NAMES[mode]);
+        }
+    }
+}
+
+/* 函数名：check_corrupt_rle
+ *
+ * 函数说明：截断、过长与段越界的数据流须返回错误，且不得写到图像区域以外。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_corrupt_rle(void)
+{
+    static const uint8_t truncated_literal[] = { 0x05, 0xFF, 0xFF };           /* 6 literals, 2 present */
+    static const uint8_t missing_fill[] = { 0x82 };                            /* repeat without its byte */
+    static const uint8_t overrun[] = { 0xFF, 0xFF };                           /* 130 bytes into a 16 x 8 image */
+    static const uint8_t trailing[] = { 0x8D, 0xFF, 0x00, 0xAA };              /* 16 bytes, then garbage */
+    static const uint8_t short_stream[] = { 0x84, 0xFF };                      /* 7 of 16 bytes */
+    struct {
+        const char *name;
+        const uint8_t *data;
+        size_t len;
+    } cases[] = {
+        { "truncated literal", truncated_literal, sizeof(truncated_literal) },
+        { "missing fill", missing_fill, sizeof(missing_fill) },
+        { "overrun", overrun, sizeof(overrun) },
+        { "trailing bytes", trailing, sizeof(trailing) },
+        { "short stream", short_stream, sizeof(short_stream) },
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        ssd1306_clear(&dev);
+        esp_err_t err = ssd1306_blit_rle(&dev, cases[i].data, cases[i].len, 40, 20, 16, 8, SSD1306_BLIT_SET);
+        bool outside = false;
+        for (int y = 0; y < dev.height; y++) {
+            for (int x = 0; x < dev.width; x++) {
+                bool inside = x >= 40 && x < 56 && y >= 20 && y < 28;
+                if (!inside && (dev.buffer[(y / 8) * dev.width + x] & (1 << (y % 8)))) outside = true;
+            }
+        }
+        if (err != ESP_ERR_INVALID_SIZE || outside) {
+            printf("FAIL  rle %-18s err 0x%x%s\n", cases[i].name, err, outside ? ", wrote outside the image" : "");
+            failures++;
+        } else {
+            printf("ok    rle %-18s rejected\n", cases[i].name);
+        }
+    }
+    ssd1306_clear(&dev);
+    memcpy(ref, dev.buffer, sizeof(ref));
+}
+
+/* 函数名：check_icons
+ *
+ * 函数说明：生成的图标须能完整绘制，XOR 两次应恢复原画面。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_icons(void)
+{
+    const ssd1306_image_t *icons[] = { &oled_icon_wifi, &oled_icon_lock, &oled_icon_warning, &oled_icon_chip };
+    const char *names[] = { "wifi", "lock", "warning", "chip" };
+
+    for (size_t i = 0; i < sizeof(icons) / sizeof(icons[0]); i++) {
+        uint8_t before[1024];
+        ssd1306_clear(&dev);
+        ssd1306_text(&dev, "Server: Port 443", 0, 12, 1, 1);
+        memcpy(before, dev.buffer, sizeof(before));
+        esp_err_t first = ssd1306_image(&dev, icons[i], 3, 9, SSD1306_BLIT_XOR);
+        bool changed = memcmp(before, dev.buffer, sizeof(before)) != 0;
+        esp_err_t second = ssd1306_image(&dev, icons[i], 3, 9, SSD1306_BLIT_XOR);
+        if (first != ESP_OK || second != ESP_OK || !changed || memcmp(before, dev.buffer, sizeof(before)) != 0) {
+            printf("FAIL  icon %-8s did not draw and undo cleanly\n", names[i]);
+            failures++;
+        } else {
+            printf("ok    icon %-8s %2ux%-2u %s, %u bytes\n", names[i], icons[i]->w, icons[i]->h,
+                   icons[i]->rle ? "rle" : "raw", icons[i]->len);
+        }
+    }
+    ssd1306_clear(&dev);
+    memcpy(ref, dev.buffer, sizeof(ref));
+}
+
+/* 函数名：bench_blits
+ *
+ * 函数说明：对比 32x16 标志逐像素绘制与页对齐、非对齐、RLE 位块传送的耗时。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void bench_blits(void)
+{
+    const int iters = 200000;
+    uint8_t logo[32 * 2];
+    const ssd1306_image_t *chip = &oled_icon_chip;
+
+    ssd1306_clear(&dev);
+    ssd1306_image(&dev, chip, 0, 0, SSD1306_BLIT_OPAQUE);
+    memcpy(logo, dev.buffer, 32);
+    memcpy(logo + 32, dev.buffer + dev.width, 32);
+
+    uint64_t t0 = now_ns();
+    for (int i = 0; i < iters; i++) {
+        for (uint16_t row = 0; row < 16; row++) {
+            for (uint16_t col = 0; col < 32; col++) {
+                ssd1306_pixel(&dev, (uint16_t)(48 + col), (uint16_t)(36 + row),
+                              (logo[(row / 8) * 32 + col] >> (row % 8)) & 1);
+            }
+        }
+    }
+    uint64_t t1 = now_ns();
+    for (int i = 0; i < iters; i++) ssd1306_blit(&dev, logo, 48, 40, 32, 16, SSD1306_BLIT_OPAQUE);
+    uint64_t t2 = now_ns();
+    for (int i = 0; i < iters; i++) ssd1306_blit(&dev, logo, 48, 36, 32, 16, SSD1306_BLIT_SET);
+    uint64_t t3 = now_ns();
+    for (int i = 0; i < iters; i++) ssd1306_image(&dev, chip, 48, 36, SSD1306_BLIT_SET);
+    uint64_t t4 = now_ns();
+
+    printf("time  logo per pixel             %8.1f ns\n", (double)(t1 - t0) / iters);
+    printf("time  logo blit page-aligned     %8.1f ns\n", (double)(t2 - t1) / iters);
+    printf("time  logo blit unaligned        %8.1f ns\n", (double)(t3 - t2) / iters);
+    printf("time  logo rle unaligned        %8.1f ns (%u of %u bytes)\n", (double)(t4 - t3) / iters,
+           chip->len, (unsigned)sizeof(logo));
+}
+
+int main(void)
+{
+    mock_ssd1306_reset(&panel);
+    if (ssd1306_init(&dev, &panel, 128, 64, 0x3C, false) != ESP_OK) {
+        printf("FAIL  ssd1306_init\n");
+        return 1;
+    }
+    srand(12345);
+    ssd1306_clear(&dev);
+    ssd1306_show(&dev);
+    memcpy(ref, dev.buffer, sizeof(ref));
+
+    check_random_blits();
+    check_corrupt_rle();
+    check_icons();
+    bench_blits();
+
+    ssd1306_deinit(&dev);
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
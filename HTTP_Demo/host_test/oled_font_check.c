@@ -0,0 +1,374 @@
+/*
+ * Checks the UTF-8 font renderer and its glyph cache
+ *
+ * Builds a font image in memory in the format written by
+ * tools/gen_oled_font.py (raw and PackBits records), then checks that
+ * oled_font_text() draws every glyph pixel-exact at aligned and unaligned
+ * rows, falls back to the 5x8 font / a box for missing characters, rejects
+ * malformed images, and that repeated characters are served from the LRU
+ * cache. Also reports the cost of a 40-character CJK message against the
+ * ASCII text path and the bus bytes of flushing it.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306.h"
+#include "oled_font.h"
+
+#define CJK_FIRST   0x4E00
+#define CJK_COUNT   3000
+#define FONT_H      16
+
+static struct i2c_master_dev_t panel;
+static ssd1306_t dev;
+static uint8_t image[1 << 18];
+static size_t image_size;
+static int failures = 0;
+
+static const char *MESSAGE_40 =
+    "一丁丂七丄丅丆万丈三上下丌不与丏丐丑丒专且丕世丗丘丙业丛东丝丞丟丠両丢丣两严並丧";
+
+static const char *LONG_TEXT =
+    "This is a long text message that will wrap across multiple lines on the OLED display. "
+    "It demonstrates the auto-wrap feature of the SSD1306 driver with 5x8 font rendering!";
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/* Deterministic glyph pattern: a frame with a code point dependent diagonal and bars */
+static int glyph_bit(uint32_t cp, int w, int x, int y)
+{
+    if (cp == 'A') return (x == 1 || x == w - 2 || y == 7) && y > 2 && y < 14;
+    if (y == 1 || y == FONT_H - 2) return x > 0 && x < w - 1 && (cp & 1);
+    return ((x + y + cp) % 7 == 0) || (x == (int)(cp % w) && y > 3);
+}
+
+static void put16(uint8_t *p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+static void put32(uint8_t *p, uint32_t v) { put16(p, (uint16_t)v); put16(p + 2, (uint16_t)(v >> 16)); }
+
+/* 函数名：pack
+ *
+ * 函数说明：PackBits 压缩（与 gen_oled_font.py 相同的编码规则）。
+ * 参数：
+ *   src, n - 原始数据。
+ *   out    - 输出缓冲。
+ * 返回值：
+ *   压缩后长度。
+ */
+static size_t pack(const uint8_t *src, size_t n, uint8_t *out)
+{
+    size_t i = 0, o = 0, lit = 0, lit_at = 0;
+    while (i < n) {
+        size_t run = 1;
+        while (i + run < n && run < 130 && src[i + run] == src[i]) run++;
+        if (run >= 3) {
+            if (lit) { out[lit_at] = (uint8_t)(lit - 1); lit = 0; }
+            out[o++] = (uint8_t)(run + 125);
+            out[o++] = src[i];
+            i += run;
+        } else {
+            if (lit == 0) lit_at = o++;
+            out[o++] = src[i++];
+            if (++lit == 128) { out[lit_at] = 127; lit = 0; }
+        }
+    }
+    if (lit) out[lit_at] = (uint8_t)(lit - 1);
+    return o;
+}
+
+/* 函数名：build_font
+ *
+ * 函数说明：在内存中生成字体映像：'A'（8 宽）与 CJK_COUNT 个 16 宽汉字，
+ *           奇数码点用 PackBits，偶数码点原样存储。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void build_font(void)
+{
+    uint32_t count = CJK_COUNT + 1;
+    size_t index_off = 16;
+    size_t off = index_off + (size_t)count * 8;
+
+    memcpy(image, OLED_FONT_MAGIC, 4);
+    put16(image + 4, OLED_FONT_VERSION);
+    image[6] = FONT_H;
+    image[7] = 0;
+    put32(image + 8, count);
+    put32(image + 12, (uint32_t)index_off);
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t cp = i == 0 ? 'A' : CJK_FIRST + i - 1;
+        int w = cp < 0x80 ? 8 : 16;
+        uint8_t raw[OLED_FONT_GLYPH_BYTES] = {0};
+        for (int y = 0; y < FONT_H; y++) {
+            for (int x = 0; x < w; x++) {
+                if (glyph_bit(cp, w, x, y)) raw[(y / 8) * w + x] |= (uint8_t)(1 << (y % 8));
+            }
+        }
+        size_t len = (size_t)w * 2;
+        uint8_t *rec = image + off;
+        rec[0] = (uint8_t)w;
+        if (cp & 1) {
+            rec[1] = OLED_FONT_ENC_PACKBITS;
+            len = pack(raw, len, rec + 4);
+        } else {
+            rec[1] = OLED_FONT_ENC_RAW;
+            memcpy(rec + 4, raw, len);
+        }
+        put16(rec + 2, (uint16_t)len);
+        put32(image + index_off + i * 8, cp);
+        put32(image + index_off + i * 8 + 4, (uint32_t)off);
+        off += 4 + len;
+    }
+    image_size = off;
+}
+
+static size_t utf8(uint32_t cp, char *out)
+{
+    if (cp < 0x80) { out[0] = (char)cp; out[1] = 0; return 1; }
+    out[0] = (char)(0xE0 | (cp >> 12));
+    out[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+    out[2] = (char)(0x80 | (cp & 0x3F));
+    out[3] = 0;
+    return 3;
+}
+
+static int pixel_at(int x, int y)
+{
+    return (dev.buffer[(y / 8) * dev.width + x] >> (y % 8)) & 1;
+}
+
+/* 函数名：check_glyphs
+ *
+ * 函数说明：逐个绘制字体中的字形（8 对齐与非对齐两种 y），与参考图案逐像素比对。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_glyphs(void)
+{
+    int bad = 0;
+    for (uint32_t i = 0; i <= CJK_COUNT; i++) {
+        uint32_t cp = i == 0 ? 'A' : CJK_FIRST + i - 1;
+        int w = cp < 0x80 ? 8 : 16;
+        char s[4];
+        utf8(cp, s);
+        for (int y0 = 0; y0 <= 21; y0 += 21) {
+            ssd1306_clear(&dev);
+            oled_font_text(&dev, s, 7, (uint16_t)y0, 1, 0);
+            for (int y = 0; y < dev.height; y++) {
+                for (int x = 0; x < dev.width; x++) {
+                    int inside = x >= 7 && x < 7 + w && y >= y0 && y < y0 + FONT_H;
+                    int want = inside && glyph_bit(cp, w, x - 7, y - y0);
+                    if (pixel_at(x, y) != want) bad++;
+                }
+            }
+        }
+    }
+    if (bad) {
+        printf("FAIL  glyphs                %d pixel(s) differ\n", bad);
+        failures++;
+    } else {
+        printf("ok    glyphs                %d glyphs at aligned and unaligned rows\n", CJK_COUNT + 1);
+    }
+}
+
+/* 函数名：check_fallbacks
+ *
+ * 函数说明：字体中没有的 ASCII 用内置 5x8 字体贴底绘制，其余缺字画方框，
+ *           非法 UTF-8 不越界。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_fallbacks(void)
+{
+    uint8_t ref[128 * 8];
+
+    ssd1306_clear(&dev);
+    ssd1306_text(&dev, "b", 8, 8, 1, 1);
+    memcpy(ref, dev.buffer, sizeof(ref));
+    ssd1306_clear(&dev);
+    oled_font_text(&dev, "Ab", 0, 0, 1, 0);  /* 'A' is 8 px wide in the font, 'b' is not in it */
+    for (size_t i = 0; i < sizeof(ref); i++) {
+        if ((i / 128) == 0 || (i % 128) < 8) continue;  /* ignore the 'A' cell */
+        if (dev.buffer[i] != ref[i]) {
+            printf("FAIL  ascii fallback        5x8 glyph not drawn on the bottom of the line\n");
+            failures++;
+            return;
+        }
+    }
+
+    ssd1306_clear(&dev);
+    oled_font_text(&dev, "\xe2\x82\xac", 0, 0, 1, 0);  /* U+20AC, not in the font */
+    if (!pixel_at(1, 2) || !pixel_at(1, 13) || pixel_at(4, 6)) {
+        printf("FAIL  missing glyph         no box drawn\n");
+        failures++;
+        return;
+    }
+
+    ssd1306_clear(&dev);
+    oled_font_text(&dev, "\xe4\xb8", 0, 0, 1, 0);      /* truncated sequence */
+    oled_font_text(&dev, "\xff\x80" "A", 0, 16, 1, 0);
+    printf("ok    fallbacks             5x8 ASCII, box for missing glyphs, invalid UTF-8\n");
+}
+
+/* 函数名：check_invalid_images
+ *
+ * 函数说明：损坏的映像（魔数、行高、索引越界）必须被拒绝，文本回退到 5x8 字体。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_invalid_images(void)
+{
+    static uint8_t bad[64];
+    memcpy(bad, image, sizeof(bad));
+    bad[0] = 'X';
+    esp_err_t e1 = oled_font_attach(bad, sizeof(bad));
+    memcpy(bad, image, sizeof(bad));
+    bad[6] = 32;
+    esp_err_t e2 = oled_font_attach(bad, sizeof(bad));
+    memcpy(bad, image, sizeof(bad));
+    esp_err_t e3 = oled_font_attach(bad, sizeof(bad));  /* index runs past the end */
+
+    if (e1 != ESP_ERR_INVALID_VERSION || e2 != ESP_ERR_INVALID_SIZE || e3 != ESP_ERR_INVALID_SIZE ||
+        oled_font_ready()) {
+        printf("FAIL  invalid images        accepted (%s, %s, %s)\n",
+               esp_err_to_name(e1), esp_err_to_name(e2), esp_err_to_name(e3));
+        failures++;
+        return;
+    }
+    printf("ok    invalid images        rejected\n");
+}
+
+/* 函数名：check_cache
+ *
+ * 函数说明：同一消息第二次绘制应全部命中缓存；不同字符超过缓存容量时发生淘汰。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_cache(void)
+{
+    oled_font_stats_t st;
+
+    oled_font_attach(image, image_size);  /* empty cache */
+    ssd1306_clear(&dev);
+    oled_font_text(&dev, MESSAGE_40, 0, 0, 1, 0);
+    oled_font_reset_stats();
+    ssd1306_clear(&dev);
+    oled_font_text(&dev, MESSAGE_40, 0, 0, 1, 0);
+    oled_font_get_stats(&st);
+    if (st.misses != 0 || st.hits == 0) {
+        printf("FAIL  cache                 repeated message: %u hits, %u misses\n", st.hits, st.misses);
+        failures++;
+        return;
+    }
+    uint32_t warm_hits = st.hits;
+
+    oled_font_reset_stats();
+    char s[4];
+    for (uint32_t i = 0; i < 300; i++) {
+        utf8(CJK_FIRST + 1000 + i, s);
+        oled_font_text(&dev, s, 0, 0, 1, 0);
+    }
+    oled_font_get_stats(&st);
+    if (st.evictions == 0 || st.misses != 300) {
+        printf("FAIL  cache                 300 distinct glyphs: %u misses, %u evictions\n",
+               st.misses, st.evictions);
+        failures++;
+        return;
+    }
+    printf("ok    cache                 repeat: %u hits / 0 misses; 300 distinct: %u evictions\n",
+           warm_hits, st.evictions);
+}
+
+/* 函数名：bench_message
+ *
+ * 函数说明：测量 40 字中文消息冷/热缓存的绘制耗时与整屏刷新字节数，
+ *           并与当前 ASCII 长文本路径对比。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void bench_message(void)
+{
+    const int iters = 5000;
+    uint64_t cold = 0;
+    for (int i = 0; i < 200; i++) {
+        oled_font_attach(image, image_size);
+        ssd1306_clear(&dev);
+        uint64_t t0 = now_ns();
+        oled_font_text(&dev, MESSAGE_40, 0, 0, 1, 0);
+        cold += now_ns() - t0;
+    }
+
+    uint64_t t0 = now_ns();
+    for (int i = 0; i < iters; i++) {
+        ssd1306_clear(&dev);
+        oled_font_text(&dev, MESSAGE_40, 0, 0, 1, 0);
+    }
+    uint64_t t1 = now_ns();
+    for (int i = 0; i < iters; i++) {
+        ssd1306_clear(&dev);
+        ssd1306_text(&dev, LONG_TEXT, 0, 0, 1, 0);
+    }
+    uint64_t t2 = now_ns();
+
+    printf("time  cjk 40 chars cold cache   %10.1f ns\n", (double)cold / 200);
+    printf("time  cjk 40 chars warm cache   %10.1f ns\n", (double)(t1 - t0) / iters);
+    printf("time  ascii 180 chars wrapped   %10.1f ns\n", (double)(t2 - t1) / iters);
+
+    ssd1306_clear(&dev);
+    ssd1306_show(&dev);
+    oled_font_text(&dev, MESSAGE_40, 0, 0, 1, 0);
+    mock_ssd1306_reset_counters(&panel);
+    ssd1306_show(&dev);
+    printf("flush cjk 40 chars             %4u tx %6u bytes\n", panel.transactions, panel.bytes);
+    if (panel.bytes > 1024 + 64) {
+        printf("FAIL  cjk flush exceeds the full frame budget\n");
+        failures++;
+    }
+}
+
+int main(void)
+{
+    mock_ssd1306_reset(&panel);
+    if (ssd1306_init(&dev, &panel, 128, 64, 0x3C, false) != ESP_OK) {
+        printf("FAIL  ssd1306_init\n");
+        return 1;
+    }
+    build_font();
+
+    check_invalid_images();
+    if (oled_font_attach(image, image_size) != ESP_OK) {
+        printf("FAIL  font image rejected\n");
+        return 1;
+    }
+    check_glyphs();
+    check_fallbacks();
+    check_cache();
+    bench_message();
+
+    oled_font_detach();
+    ssd1306_deinit(&dev);
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,421 @@
+/*
+ * Checks remote frame reception
+ *
+ * Feeds full and delta frames to oled_frame_recv() through a reader that
+ * hands out the body in random-sized pieces (like TCP segments) and checks
+ * the framebuffer and, after ssd1306_show(), the mock GDDRAM. Malformed
+ * bodies must be rejected. An animation of a box moving over a static
+ * background is pushed as full frames and as deltas to report bus bytes per
+ * frame and the frame rate the 700 kHz bus can sustain.
+ *
+ * The mirror direction is checked too: oled_frame_diff() output applied to a
+ * client copy must reproduce the framebuffer, and oled_frame_pbm_rows() must
+ * match a per-pixel reference.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306.h"
+#include "oled_frame.h"
+
+#define FRAME_BYTES     1024
+#define I2C_HZ          700000
+#define MIN_FPS         15
+
+static struct i2c_master_dev_t panel;
+static ssd1306_t dev;
+static struct i2c_master_dev_t canvas_panel;
+static ssd1306_t canvas;    /* "server side" renderer for the animation, never flushed */
+static int failures = 0;
+
+/* Request body served in random pieces of 1..max_chunk bytes */
+typedef struct {
+    const uint8_t *data;
+    size_t len;
+    size_t pos;
+    size_t max_chunk;
+    size_t fail_at;         /* report a socket error once pos reaches this; SIZE_MAX = never */
+} body_reader_t;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/* 函数名：body_read
+ *
+ * 函数说明：读取回调：每次返回随机长度的一段请求体。
+ * 参数：
+ *   ctx - body_reader_t。
+ *   dst - 目标地址。
+ *   len - 最多读取的字节数。
+ * 返回值：
+ *   读取的字节数；请求体结束返回 0，模拟出错返回 -1。
+ */
+static int body_read(void *ctx, uint8_t *dst, size_t len)
+{
+    body_reader_t *r = (body_reader_t *)ctx;
+    if (r->pos >= r->fail_at) return -1;
+    if (r->pos >= r->len) return 0;
+    size_t n = 1 + (size_t)rand() % r->max_chunk;
+    if (n > len) n = len;
+    if (n > r->len - r->pos) n = r->len - r->pos;
+    memcpy(dst, r->data + r->pos, n);
+    r->pos += n;
+    return (int)n;
+}
+
+/* 函数名：push
+ *
+ * 函数说明：以随机分段方式推送一个请求体。
+ * 参数：
+ *   format - 帧格式。
+ *   body   - 请求体。
+ *   len    - 长度。
+ * 返回值：
+ *   oled_frame_recv() 的返回值。
+ */
+static esp_err_t push(oled_frame_format_t format, const uint8_t *body, size_t len)
+{
+    body_reader_t r = { body, len, 0, 1 + (size_t)rand() % 700, (size_t)-1 };
+    return oled_frame_recv(&dev, format, len, body_read, &r);
+}
+
+/* 函数名：make_delta
+ *
+ * 函数说明：按页比较两帧，把每段连续变化（最长 255 字节）编码为增量记录。
+ * 参数：
+ *   prev, next - 上一帧与新帧。
+ *   out        - 输出缓冲（至少 FRAME_BYTES * 2）。
+ * 返回值：
+ *   增量长度。
+ */
+static size_t make_delta(const uint8_t *prev, const uint8_t *next, uint8_t *out)
+{
+    size_t o = 0;
+    for (int page = 0; page < 8; page++) {
+        int col = 0;
+        while (col < 128) {
+            if (prev[page * 128 + col] == next[page * 128 + col]) { col++; continue; }
+            int end = col;
+            while (end < 128 && end - col < 255 && prev[page * 128 + end] != next[page * 128 + end]) end++;
+            out[o++] = (uint8_t)page;
+            out[o++] = (uint8_t)col;
+            out[o++] = (uint8_t)(end - col);
+            memcpy(out + o, next + page * 128 + col, (size_t)(end - col));
+            o += (size_t)(end - col);
+            col = end;
+        }
+    }
+    return o;
+}
+
+/* 函数名：frame_matches
+ *
+ * 函数说明：帧缓冲与期望帧一致，且刷新后模拟 GDDRAM 也一致。
+ * 参数：
+ *   expect - 期望帧。
+ * 返回值：
+ *   true 一致。
+ */
+static bool frame_matches(const uint8_t *expect)
+{
+    if (memcmp(dev.buffer, expect, FRAME_BYTES) != 0) return false;
+    if (ssd1306_show(&dev) != ESP_OK) return false;
+    for (int page = 0; page < 8; page++) {
+        if (memcmp(panel.gddram[page], expect + page * 128, 128) != 0) return false;
+    }
+    return true;
+}
+
+/* 函数名：draw_scene
+ *
+ * 函数说明：绘制动画的一帧：静态边框与文字，加一个移动的实心方块。
+ * 参数：
+ *   out - 输出帧。
+ *   t   - 帧序号。
+ * 返回值：
+ *   无。
+ */
+static void draw_scene(uint8_t *out, int t)
+{
+    ssd1306_clear(&canvas);
+    ssd1306_rect(&canvas, 0, 0, 128, 64, 1);
+    ssd1306_text(&canvas, "Remote render", 4, 3, 1, 1);
+    int x = 4 + (t * 3) % 112, y = 14 + (t * 2) % 40;
+    ssd1306_fill_rect(&canvas, (uint16_t)x, (uint16_t)y, 10, 10, 1);
+    memcpy(out, canvas.buffer, FRAME_BYTES);
+}
+
+/* 函数名：check_full_and_delta
+ *
+ * 函数说明：随机完整帧与随机增量帧经任意分段接收后须与期望帧逐字节一致。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_full_and_delta(void)
+{
+    uint8_t frame[FRAME_BYTES], next[FRAME_BYTES], delta[FRAME_BYTES * 2];
+    int bad_full = 0, bad_delta = 0;
+
+    for (int i = 0; i < 200; i++) {
+        for (int k = 0; k < FRAME_BYTES; k++) frame[k] = (uint8_t)rand();
+        if (push(OLED_FRAME_FULL, frame, FRAME_BYTES) != ESP_OK || !frame_matches(frame)) bad_full++;
+
+        memcpy(next, frame, FRAME_BYTES);
+        for (int k = rand() % 40; k > 0; k--) {
+            int at = rand() % FRAME_BYTES, run = 1 + rand() % 300;
+            for (int j = at; j < at + run && j < FRAME_BYTES; j++) next[j] = (uint8_t)rand();
+        }
+        size_t len = make_delta(frame, next, delta);
+        if (push(OLED_FRAME_DELTA, delta, len) != ESP_OK || !frame_matches(next)) bad_delta++;
+    }
+    if (bad_full || bad_delta) {
+        printf("FAIL  recv         %d full / %d delta frames of 200 differ\n", bad_full, bad_delta);
+        failures++;
+    } else {
+        printf("ok    recv         200 full + 200 delta frames byte-exact in GDDRAM\n");
+    }
+
+    /* An empty delta changes nothing and sends nothing */
+    mock_ssd1306_reset_counters(&panel);
+    if (push(OLED_FRAME_DELTA, delta, 0) != ESP_OK || ssd1306_show(&dev) != ESP_OK || panel.bytes != 0) {
+        printf("FAIL  recv         empty delta was not a no-op\n");
+        failures++;
+    } else {
+        printf("ok    recv         empty delta sends 0 bytes\n");
+    }
+}
+
+/* 函数名：check_malformed
+ *
+ * 函数说明：长度错误、越界记录、截断请求体与读取失败都须被拒绝。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_malformed(void)
+{
+    static uint8_t frame[FRAME_BYTES];
+    static const uint8_t bad_page[] = { 8, 0, 1, 0xFF };
+    static const uint8_t bad_col[] = { 0, 120, 9, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    static const uint8_t zero_len[] = { 0, 0, 0 };
+    static const uint8_t short_header[] = { 0, 0 };
+    static const uint8_t short_data[] = { 1, 10, 4, 0xAA, 0xBB };
+    struct {
+        const char *name;
+        oled_frame_format_t format;
+        const uint8_t *data;
+        size_t len;
+        esp_err_t expect;
+    } cases[] = {
+        { "full too short", OLED_FRAME_FULL, frame, FRAME_BYTES - 1, ESP_ERR_INVALID_SIZE },
+        { "full too long", OLED_FRAME_FULL, frame, FRAME_BYTES + 1, ESP_ERR_INVALID_SIZE },
+        { "delta bad page", OLED_FRAME_DELTA, bad_page, sizeof(bad_page), ESP_ERR_INVALID_SIZE },
+        { "delta past width", OLED_FRAME_DELTA, bad_col, sizeof(bad_col), ESP_ERR_INVALID_SIZE },
+        { "delta zero length", OLED_FRAME_DELTA, zero_len, sizeof(zero_len), ESP_ERR_INVALID_SIZE },
+        { "delta short header", OLED_FRAME_DELTA, short_header, sizeof(short_header), ESP_ERR_INVALID_SIZE },
+        { "delta short data", OLED_FRAME_DELTA, short_data, sizeof(short_data), ESP_ERR_INVALID_SIZE },
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        esp_err_t err = push(cases[i].format, cases[i].data, cases[i].len);
+        if (err != cases[i].expect) {
+            printf("FAIL  malformed    %-18s got 0x%x\n", cases[i].name, err);
+            failures++;
+        } else {
+            printf("ok    malformed    %-18s rejected\n", cases[i].name);
+        }
+    }
+
+    /* Connection dropped half way through the body */
+    body_reader_t r = { frame, FRAME_BYTES, 0, 64, 500 };
+    esp_err_t err = oled_frame_recv(&dev, OLED_FRAME_FULL, FRAME_BYTES, body_read, &r);
+    if (err != ESP_FAIL) {
+        printf("FAIL  malformed    dropped connection got 0x%x\n", err);
+        failures++;
+    } else {
+        printf("ok    malformed    dropped connection reported\n");
+    }
+}
+
+/* 函数名：bench_animation
+ *
+ * 函数说明：同一段动画分别以完整帧与增量帧推送，统计每帧总线字节、请求体字节与
+ *           CPU 耗时，并按 700 kHz 总线估算可持续帧率。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void bench_animation(void)
+{
+    const int frames = 120;
+    static uint8_t scene[FRAME_BYTES], prev[FRAME_BYTES], delta[FRAME_BYTES * 2];
+    uint64_t bus[2] = {0}, body[2] = {0}, cpu[2] = {0};
+
+    for (int mode = 0; mode < 2; mode++) {
+        draw_scene(prev, 0);
+        push(OLED_FRAME_FULL, prev, FRAME_BYTES);
+        ssd1306_show(&dev);
+        mock_ssd1306_reset_counters(&panel);
+        for (int t = 1; t <= frames; t++) {
+            draw_scene(scene, t);
+            uint64_t t0 = now_ns();
+            if (mode == 0) {
+                push(OLED_FRAME_FULL, scene, FRAME_BYTES);
+                body[mode] += FRAME_BYTES;
+            } else {
+                size_t len = make_delta(prev, scene, delta);
+                push(OLED_FRAME_DELTA, delta, len);
+                body[mode] += len;
+            }
+            ssd1306_show(&dev);
+            cpu[mode] += now_ns() - t0;
+            memcpy(prev, scene, FRAME_BYTES);
+        }
+        bus[mode] = panel.bytes;
+        if (memcmp(dev.buffer, scene, FRAME_BYTES) != 0) {
+            printf("FAIL  animation    %s frames diverged\n", mode ? "delta" : "full");
+            failures++;
+        }
+    }
+
+    for (int mode = 0; mode < 2; mode++) {
+        double bytes = (double)bus[mode] / frames;
+        double fps = I2C_HZ / (bytes * 9.0);
+        printf("frame %-5s        body %6.0f B  bus %6.0f B  cpu %7.1f ns  -> %5.0f fps at 700 kHz\n",
+               mode ? "delta" : "full", (double)body[mode] / frames, bytes,
+               (double)cpu[mode] / frames, fps);
+        if (fps < MIN_FPS) {
+            printf("FAIL  animation    below %d fps\n", MIN_FPS);
+            failures++;
+        }
+    }
+
+    /* Worst case: every byte of every frame changes */
+    static uint8_t a[FRAME_BYTES], b[FRAME_BYTES];
+    memset(a, 0x55, sizeof(a));
+    memset(b, 0xAA, sizeof(b));
+    push(OLED_FRAME_FULL, a, FRAME_BYTES);
+    ssd1306_show(&dev);
+    mock_ssd1306_reset_counters(&panel);
+    push(OLED_FRAME_FULL, b, FRAME_BYTES);
+    ssd1306_show(&dev);
+    double fps = I2C_HZ / (panel.bytes * 9.0);
+    printf("frame worst        bus %6u B -> %5.0f fps at 700 kHz\n", panel.bytes, fps);
+    if (fps < MIN_FPS) {
+        printf("FAIL  worst case below %d fps\n", MIN_FPS);
+        failures++;
+    }
+}
+
+/* 函数名：check_mirror
+ *
+ * 函数说明：动画各帧经 oled_frame_diff() 编码后以 oled_frame_recv() 应用到客户端
+ *           设备，须与帧缓冲一致；同时统计镜像流每帧字节数，并检查输出缓冲不足时
+ *           返回 0 且副本不变。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_mirror(void)
+{
+    static uint8_t copy[FRAME_BYTES], client_buf[FRAME_BYTES], scene[FRAME_BYTES];
+    static uint8_t diff[OLED_FRAME_DIFF_MAX(128, 8)];
+    ssd1306_t client = canvas;
+    const int frames = 120;
+    size_t total = 0, first = 0;
+    int bad = 0;
+
+    client.buffer = client_buf;
+    memset(copy, 0, sizeof(copy));
+    memset(client_buf, 0, sizeof(client_buf));
+
+    for (int t = 0; t <= frames; t++) {
+        draw_scene(scene, t);
+        push(OLED_FRAME_FULL, scene, FRAME_BYTES);
+        size_t len = oled_frame_diff(&dev, copy, diff, sizeof(diff));
+        if (t == 0) first = len;
+        else total += len;
+        body_reader_t r = { diff, len, 0, 1 + (size_t)rand() % 64, (size_t)-1 };
+        if (oled_frame_recv(&client, OLED_FRAME_DELTA, len, body_read, &r) != ESP_OK ||
+            memcmp(client_buf, dev.buffer, FRAME_BYTES) != 0 ||
+            memcmp(copy, dev.buffer, FRAME_BYTES) != 0) {
+            bad++;
+        }
+    }
+    if (oled_frame_diff(&dev, copy, diff, sizeof(diff)) != 0) bad++;
+
+    /* Too small an output buffer must leave the copy untouched */
+    copy[0] ^= 0xFF;
+    if (oled_frame_diff(&dev, copy, diff, sizeof(diff) - 1) != 0 || copy[0] == dev.buffer[0]) bad++;
+
+    printf("%s  mirror diff      %d frames, first %u B, then %.0f B/frame\n",
+           bad ? "FAIL" : "ok  ", frames, (unsigned)first, (double)total / frames);
+    if (bad) failures++;
+}
+
+/* 函数名：check_pbm
+ *
+ * 函数说明：随机帧逐页转换为 PBM 行，与逐像素读取的参考结果比较。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_pbm(void)
+{
+    uint8_t frame[FRAME_BYTES], rows[8 * 16];
+    int bad = 0;
+
+    for (int i = 0; i < FRAME_BYTES; i++) frame[i] = (uint8_t)rand();
+    push(OLED_FRAME_FULL, frame, FRAME_BYTES);
+
+    for (uint8_t page = 0; page < 8; page++) {
+        oled_frame_pbm_rows(&dev, page, rows);
+        for (int row = 0; row < 8; row++) {
+            for (int x = 0; x < 128; x++) {
+                int expect = (frame[page * 128 + x] >> row) & 1;
+                int got = (rows[row * 16 + x / 8] >> (7 - x % 8)) & 1;
+                if (expect != got) bad++;
+            }
+        }
+    }
+    printf("%s  pbm rows         %d pixel(s) wrong\n", bad ? "FAIL" : "ok  ", bad);
+    if (bad) failures++;
+}
+
+int main(void)
+{
+    mock_ssd1306_reset(&panel);
+    mock_ssd1306_reset(&canvas_panel);
+    if (ssd1306_init(&dev, &panel, 128, 64, 0x3C, false) != ESP_OK ||
+        ssd1306_init(&canvas, &canvas_panel, 128, 64, 0x3C, false) != ESP_OK) {
+        printf("FAIL  ssd1306_init\n");
+        return 1;
+    }
+    srand(4242);
+
+    check_full_and_delta();
+    check_malformed();
+    check_mirror();
+    check_pbm();
+    bench_animation();
+
+    ssd1306_deinit(&canvas);
+    ssd1306_deinit(&dev);
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,193 @@
+/*
+ * Checks the I2C clock calibration
+ *
+ * The mock bus times every transaction at the added device's SCL rate and
+ * can NACK now and then above a threshold (a marginal cable) or cap the
+ * effective rate (a panel stretching the clock). The sweep must pick the
+ * fastest stable candidate with one step of margin below a failing rate,
+ * must not pick a faster clock that brings no throughput, must report
+ * failure when nothing is stable, and must remove every device it added.
+ * The panel must initialise and flush normally at the chosen rate. The
+ * runtime error-rate monitor and the step-down helper are checked too.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "ssd1306.h"
+#include "oled_i2c_cal.h"
+#include "esp_timer.h"
+
+#define PANEL_ADDR      0x3C
+#define PANEL_WIDTH     128
+#define PANEL_PAGES     8
+
+static struct i2c_master_dev_t panel;
+static struct i2c_master_bus_t bus;
+static int failures = 0;
+
+/* 函数名：print_report
+ *
+ * 函数说明：输出各扫描频率的错误数与每帧耗时。
+ * 参数：
+ *   r - 扫描结果。
+ * 返回值：
+ *   无。
+ */
+static void print_report(const oled_i2c_cal_report_t *r)
+{
+    for (size_t i = 0; i < r->tested; i++) {
+        const oled_i2c_cal_point_t *pt = &r->points[i];
+        printf("        %7lu Hz  %3lu errors  %6lu us/frame\n", (unsigned long)pt->freq_hz,
+               (unsigned long)pt->errors, (unsigned long)pt->frame_us);
+    }
+}
+
+/* 函数名：check_sweep
+ *
+ * 函数说明：按给定故障设置扫描一次，比较选定频率、返回值与已测试的频率数，并检查
+ *           设备全部移除、控制器未收到不支持的命令。
+ * 参数：
+ *   name       - 场景名称。
+ *   nack_above - 高于此频率偶发 NACK（0 不出错）。
+ *   stretch    - 面板可持续的最高频率（0 不限）。
+ *   expect_hz  - 期望选定的频率（0 表示应失败）。
+ *   expect_tested - 期望测试的频率数。
+ * 返回值：
+ *   无。
+ */
+static void check_sweep(const char *name, uint32_t nack_above, uint32_t stretch, uint32_t expect_hz,
+                        size_t expect_tested)
+{
+    oled_i2c_cal_report_t report;
+
+    if (SSD1306_PANEL_SH1106) {
+        mock_sh1106_reset(&panel);
+    } else {
+        mock_ssd1306_reset(&panel);
+    }
+    panel.nack_above_hz = nack_above;
+    panel.stretch_hz = stretch;
+    esp_err_t err = oled_i2c_cal_sweep(&bus, PANEL_ADDR, PANEL_WIDTH, PANEL_PAGES, &report);
+
+    bool ok = report.chosen_hz == expect_hz && report.tested == expect_tested &&
+              err == (expect_hz ? ESP_OK : ESP_ERR_NOT_FOUND) && bus.devices == 0 && panel.bad_cmds == 0;
+    printf("%s  %-22s chose %7lu Hz after %u rates (expected %lu Hz, %u rates)\n", ok ? "ok  " : "FAIL", name,
+           (unsigned long)report.chosen_hz, (unsigned)report.tested, (unsigned long)expect_hz,
+           (unsigned)expect_tested);
+    print_report(&report);
+    if (!ok) failures++;
+}
+
+/* 函数名：check_panel_after
+ *
+ * 函数说明：以选定频率添加设备并初始化面板，绘制并刷新后模拟 GDDRAM 须与帧缓冲一致，
+ *           并输出整帧刷新在该频率与固定 700 kHz 下的耗时。
+ * 参数：
+ *   hz - 选定频率。
+ * 返回值：
+ *   无。
+ */
+static void check_panel_after(uint32_t hz)
+{
+    i2c_device_config_t cfg = {
+        .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+        .device_address = PANEL_ADDR,
+        .scl_speed_hz = hz,
+    };
+    i2c_master_dev_handle_t handle;
+    ssd1306_t dev;
+    bool ok = i2c_master_bus_add_device(&bus, &cfg, &handle) == ESP_OK &&
+              ssd1306_init(&dev, handle, PANEL_WIDTH, PANEL_PAGES * 8, PANEL_ADDR, false) == ESP_OK;
+    if (!ok) {
+        printf("FAIL  panel after sweep      init failed\n");
+        failures++;
+        return;
+    }
+
+    ssd1306_fill(&dev, 1);
+    int64_t t0 = esp_timer_get_time();
+    ok = ssd1306_show(&dev) == ESP_OK && panel.nacks == 0;
+    int64_t frame_us = esp_timer_get_time() - t0;
+    for (int page = 0; page < PANEL_PAGES && ok; page++) {
+        ok = memcmp(panel.gddram[page] + SSD1306_PANEL_COL_OFFSET, dev.buffer + page * PANEL_WIDTH, PANEL_WIDTH) == 0;
+    }
+    printf("%s  panel after sweep      full frame %lld us at %lu Hz (%lld us at 700 kHz)\n", ok ? "ok  " : "FAIL",
+           (long long)frame_us, (unsigned long)hz, (long long)(frame_us * hz / 700000));
+    if (!ok) failures++;
+    ssd1306_deinit(&dev);
+    i2c_master_bus_rm_device(handle);
+}
+
+/* 函数名：check_health
+ *
+ * 函数说明：错误率监视：全部成功或每个窗口内错误少于阈值时不降档，窗口内错误达到阈值时
+ *           降档一次；降档序列逐档递减并停在最低候选频率。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_health(void)
+{
+    oled_i2c_health_t h = {0};
+    int trips = 0;
+
+    for (int i = 0; i < 1000; i++) trips += oled_i2c_health_record(&h, true);
+    bool clean = trips == 0;
+
+    /* Errors spread out: fewer than the limit per window */
+    for (int i = 0; i < OLED_I2C_HEALTH_WINDOW * 10; i++) {
+        trips += oled_i2c_health_record(&h, i % OLED_I2C_HEALTH_WINDOW >= OLED_I2C_HEALTH_MAX_ERRORS - 1);
+    }
+    bool sparse = trips == 0;
+
+    /* A burst: trips once the limit is reached, then starts a new window */
+    int burst_at = -1;
+    for (int i = 0; i < OLED_I2C_HEALTH_MAX_ERRORS * 2; i++) {
+        if (oled_i2c_health_record(&h, false) && burst_at < 0) burst_at = i;
+    }
+    bool burst = burst_at >= 0 && burst_at < OLED_I2C_HEALTH_MAX_ERRORS;
+
+    uint32_t hz = 1000000;
+    int steps = 0;
+    while (oled_i2c_cal_slower(hz) != hz) {
+        uint32_t next = oled_i2c_cal_slower(hz);
+        if (next >= hz || !oled_i2c_cal_is_candidate(next)) break;
+        hz = next;
+        steps++;
+    }
+    bool ladder = hz == oled_i2c_cal_candidates[0] && steps == (int)oled_i2c_cal_candidate_count - 1 &&
+                  oled_i2c_cal_slower(123456) == oled_i2c_cal_candidates[0] && !oled_i2c_cal_is_candidate(123456);
+
+    bool ok = clean && sparse && burst && ladder;
+    printf("%s  health monitor         clean %s, sparse errors %s, burst trips after %d, %d step-downs\n",
+           ok ? "ok  " : "FAIL", clean ? "ok" : "tripped", sparse ? "ok" : "tripped", burst_at + 1, steps);
+    if (!ok) failures++;
+}
+
+int main(void)
+{
+    bus.panel = &panel;
+    bus.addr = PANEL_ADDR;
+
+    /* Every rate clean: the fastest candidate, no failure to keep a margin from */
+    check_sweep("clean bus", 0, 0, 1000000, 6);
+    /* Panel stretches to 400 kHz: faster settings bring nothing */
+    check_sweep("stretching at 400k", 0, 400000, 400000, 6);
+    /* Only 100 kHz works: no step down below the slowest candidate */
+    check_sweep("marginal above 300k", 300000, 0, 100000, 2);
+    /* Nothing works */
+    check_sweep("broken bus", 50000, 0, 0, 1);
+    /* 850 kHz NACKs: stop there, step down from 700 kHz; then run the panel at the result */
+    check_sweep("marginal above 750k", 750000, 0, 550000, 5);
+    panel.nack_above_hz = 0;
+    panel.nacks = 0;
+    check_panel_after(550000);
+    check_health();
+
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,206 @@
+/*
+ * Checks the display idle policy
+ *
+ * Simulated time drives oled_idle_update() against a mock panel: the panel
+ * must dim and switch off at the configured inactivity thresholds (and
+ * not before), skip the dim stage when it would come after power-off, and
+ * stay untouched when the policy is disabled. A wake must restore contrast
+ * and display-on with one or two commands and leave GDDRAM and the rest
+ * of the controller state alone, i.e. no re-init. The time accounted per
+ * state must add up to the elapsed time.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "ssd1306.h"
+#include "oled_idle.h"
+
+#define S(x)            ((int64_t)(x) * 1000000)
+#define FULL_CONTRAST   0xFF
+#define DIM_CONTRAST    16
+
+static struct i2c_master_dev_t panel;
+static ssd1306_t dev;
+static int failures = 0;
+
+/* 函数名：setup_panel
+ *
+ * 函数说明：初始化模拟面板并刷新一帧测试图案。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   true 成功。
+ */
+static bool setup_panel(void)
+{
+    ssd1306_deinit(&dev);
+    mock_ssd1306_reset(&panel);
+    if (ssd1306_init(&dev, &panel, 128, 64, 0x3C, false) != ESP_OK) return false;
+    ssd1306_fill_rect(&dev, 10, 10, 50, 30, 1);
+    ssd1306_text(&dev, "idle", 70, 40, 1, 0);
+    return ssd1306_show(&dev) == ESP_OK;
+}
+
+/* 函数名：panel_is
+ *
+ * 函数说明：模拟控制器的显示开关与对比度是否符合期望。
+ * 参数：
+ *   on       - 期望显示开启。
+ *   contrast - 期望对比度。
+ * 返回值：
+ *   true 符合。
+ */
+static bool panel_is(bool on, uint8_t contrast)
+{
+    return panel.display_on == on && panel.contrast == contrast;
+}
+
+/* 函数名：times_add_up
+ *
+ * 函数说明：各状态累计时长之和等于从开始到 now 的时长，且与期望值一致。
+ * 参数：
+ *   idle   - 空闲状态。
+ *   start  - 开始时间。
+ *   now    - 当前时间。
+ *   active/dim/off - 期望的各状态时长（秒）。
+ * 返回值：
+ *   true 一致。
+ */
+static bool times_add_up(const oled_idle_t *idle, int64_t start, int64_t now, int active, int dim, int off)
+{
+    uint64_t a = oled_idle_time_in(idle, OLED_IDLE_ACTIVE, now);
+    uint64_t d = oled_idle_time_in(idle, OLED_IDLE_DIM, now);
+    uint64_t o = oled_idle_time_in(idle, OLED_IDLE_OFF, now);
+    return a + d + o == (uint64_t)(now - start) && a == (uint64_t)S(active) && d == (uint64_t)S(dim) &&
+           o == (uint64_t)S(off);
+}
+
+/* 函数名：check_dim_then_off
+ *
+ * 函数说明：默认策略（60 s 调暗、300 s 关屏）：阈值前不动，阈值处各发一条命令；
+ *           关屏后长时间空闲不再产生总线流量；唤醒只发送两条命令且画面与控制器状态不变。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_dim_then_off(void)
+{
+    oled_idle_t idle;
+    const oled_idle_config_t cfg = { 60000, 300000, FULL_CONTRAST, DIM_CONTRAST };
+    bool ok = setup_panel();
+    uint8_t before[MOCK_SSD1306_PAGES][MOCK_SH1106_COLS];
+    memcpy(before, panel.gddram, sizeof(before));
+
+    oled_idle_init(&idle, &cfg, S(0));
+    ok = ok && oled_idle_next_us(&idle) == S(60);
+    mock_ssd1306_reset_counters(&panel);
+    oled_idle_update(&idle, &dev, S(59));
+    ok = ok && idle.state == OLED_IDLE_ACTIVE && panel.transactions == 0 && panel_is(true, FULL_CONTRAST);
+
+    oled_idle_update(&idle, &dev, S(60));
+    ok = ok && idle.state == OLED_IDLE_DIM && panel_is(true, DIM_CONTRAST) && oled_idle_next_us(&idle) == S(300);
+    oled_idle_update(&idle, &dev, S(300));
+    ok = ok && idle.state == OLED_IDLE_OFF && panel_is(false, DIM_CONTRAST) && oled_idle_next_us(&idle) == -1;
+    uint32_t idle_tx = panel.transactions;
+
+    /* An hour of nothing: no more bus traffic */
+    for (int t = 301; t < 3900; t += 7) {
+        oled_idle_update(&idle, &dev, S(t));
+    }
+    ok = ok && panel.transactions == idle_tx;
+
+    mock_ssd1306_reset_counters(&panel);
+    uint8_t start_line = panel.start_line;
+    ok = ok && oled_idle_activity(&idle, &dev, S(3900)) == ESP_OK;
+    uint32_t wake_tx = panel.transactions;
+    ok = ok && idle.state == OLED_IDLE_ACTIVE && panel_is(true, FULL_CONTRAST) && idle.wakes == 1 &&
+         wake_tx <= 2 && panel.data_bytes == 0 && panel.start_line == start_line && panel.bad_cmds == 0 &&
+         memcmp(before, panel.gddram, sizeof(before)) == 0;
+    ok = ok && times_add_up(&idle, S(0), S(3960), 60 + 60, 240, 3600);
+
+    /* Activity while active just restarts the countdown */
+    oled_idle_activity(&idle, &dev, S(3990));
+    ok = ok && oled_idle_next_us(&idle) == S(4050) && idle.wakes == 1;
+
+    printf("%s  dim then off           %u bus transactions while idle for an hour, %u to wake\n",
+           ok ? "ok  " : "FAIL", (unsigned)idle_tx, (unsigned)wake_tx);
+    if (!ok) failures++;
+}
+
+/* 函数名：check_off_only
+ *
+ * 函数说明：关屏时间不晚于调暗时间时直接关屏（不调暗），唤醒只需打开显示；
+ *           只调暗（关屏为 0）时永不关屏，唤醒恢复对比度。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_off_only(void)
+{
+    oled_idle_t idle;
+    const oled_idle_config_t off_first = { 120000, 120000, FULL_CONTRAST, DIM_CONTRAST };
+    bool ok = setup_panel();
+
+    oled_idle_init(&idle, &off_first, S(0));
+    ok = ok && oled_idle_next_us(&idle) == S(120);
+    oled_idle_update(&idle, &dev, S(125));
+    ok = ok && idle.state == OLED_IDLE_OFF && panel_is(false, FULL_CONTRAST);
+    mock_ssd1306_reset_counters(&panel);
+    oled_idle_activity(&idle, &dev, S(200));
+    bool straight_off = ok && panel_is(true, FULL_CONTRAST) && panel.transactions == 1 &&
+                        times_add_up(&idle, S(0), S(200), 125, 0, 75);
+
+    const oled_idle_config_t dim_only = { 30000, 0, FULL_CONTRAST, DIM_CONTRAST };
+    ok = setup_panel();
+    oled_idle_init(&idle, &dim_only, S(0));
+    oled_idle_update(&idle, &dev, S(30));
+    ok = ok && idle.state == OLED_IDLE_DIM && oled_idle_next_us(&idle) == -1;
+    oled_idle_update(&idle, &dev, S(100000));
+    ok = ok && idle.state == OLED_IDLE_DIM && panel_is(true, DIM_CONTRAST);
+    oled_idle_activity(&idle, &dev, S(100000));
+    bool never_off = ok && panel_is(true, FULL_CONTRAST) && times_add_up(&idle, S(0), S(100000), 30, 99970, 0);
+
+    ok = straight_off && never_off;
+    printf("%s  single stage           straight to off %s, dim only %s\n", ok ? "ok  " : "FAIL",
+           straight_off ? "ok" : "wrong", never_off ? "ok" : "wrong");
+    if (!ok) failures++;
+}
+
+/* 函数名：check_disabled
+ *
+ * 函数说明：两个阈值都为 0 时策略不切换、不发送任何命令。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_disabled(void)
+{
+    oled_idle_t idle;
+    const oled_idle_config_t cfg = { 0, 0, FULL_CONTRAST, DIM_CONTRAST };
+    bool ok = setup_panel();
+
+    oled_idle_init(&idle, &cfg, S(0));
+    mock_ssd1306_reset_counters(&panel);
+    oled_idle_update(&idle, &dev, S(1000000));
+    oled_idle_activity(&idle, &dev, S(1000001));
+    ok = ok && oled_idle_next_us(&idle) == -1 && idle.state == OLED_IDLE_ACTIVE && panel.transactions == 0 &&
+         idle.wakes == 0;
+    printf("%s  disabled policy        no transitions, no commands\n", ok ? "ok  " : "FAIL");
+    if (!ok) failures++;
+}
+
+int main(void)
+{
+    check_dim_then_off();
+    check_off_only();
+    check_disabled();
+
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,166 @@
+/*
+ * Checks the text layout / pagination engine
+ *
+ * Lays out jokes and messages for the 128 px panel and checks that every
+ * line fits, that words are only split when a single word is wider than the
+ * panel, that no printable character is lost, and that laying out the same
+ * text again is served from the layout cache. Also reports the cost of a
+ * fresh layout against a cache hit.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306.h"
+#include "oled_layout.h"
+
+static int failures = 0;
+
+static const char *JOKE =
+    "Why do programmers prefer dark mode? Because light attracts bugs. "
+    "And why did the developer go broke? Because he used up all his cache!";
+
+static const char *LONG_WORDS =
+    "Supercalifragilisticexpialidocious-antidisestablishmentarianism "
+    "pneumonoultramicroscopicsilicovolcanoconiosis ok";
+
+static const char *LINES = "Line one\nLine two\n\n  indented line";
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/* 函数名：check_text
+ *
+ * 函数说明：校验一段文本的排版：每行宽度不超过行宽；行尾断在单词边界（除非单词
+ *           本身超过行宽）；拼接各行并去掉空白后与原文一致。
+ * 参数：
+ *   name  - 名称。
+ *   text  - 文本。
+ *   width - 行宽。
+ * 返回值：
+ *   无。
+ */
+static void check_text(const char *name, const char *text, uint16_t width)
+{
+    const oled_layout_t *lay = oled_layout_text(text, width);
+    char joined[1024], original[1024];
+    size_t nj = 0, no = 0;
+
+    for (uint16_t i = 0; i < lay->nlines; i++) {
+        const oled_layout_line_t *l = &lay->lines[i];
+        const char *s = text + l->offset;
+        uint16_t ink = l->length ? (uint16_t)(l->length * FONT_TOTAL_WIDTH - FONT_CHAR_SPACING) : 0;
+        if (ink > width) {
+            printf("FAIL  %-12s line %u is %u px wide\n", name, i, ink);
+            failures++;
+            return;
+        }
+        /* A split inside a word is only allowed when the word alone overflows the line */
+        char after = text[l->offset + l->length];
+        if (l->length && s[l->length - 1] != ' ' && s[l->length - 1] != '-' &&
+            after != ' ' && after != '\n' && after != '\0') {
+            size_t word = 0;
+            while (word < l->length && s[l->length - 1 - word] != ' ') word++;
+            if (word < l->length) {
+                printf("FAIL  %-12s line %u breaks a word that fits the next line\n", name, i);
+                failures++;
+                return;
+            }
+        }
+        for (uint16_t k = 0; k < l->length; k++) {
+            if (s[k] != ' ') joined[nj++] = s[k];
+        }
+    }
+    for (const char *p = text; *p; p++) {
+        if (*p != ' ' && *p != '\n') original[no++] = *p;
+    }
+    if (nj != no || memcmp(joined, original, no) != 0) {
+        printf("FAIL  %-12s characters lost or reordered (%zu of %zu)\n", name, nj, no);
+        failures++;
+        return;
+    }
+    printf("ok    %-12s %2u lines, %u pages of 6\n", name, lay->nlines, oled_layout_pages(lay, 6));
+}
+
+/* 函数名：check_lines
+ *
+ * 函数说明：换行符强制换行、保留空行与行首缩进。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_lines(void)
+{
+    const oled_layout_t *lay = oled_layout_text(LINES, 128);
+    if (lay->nlines != 4 || lay->lines[2].length != 0 || LINES[lay->lines[3].offset] != ' ') {
+        printf("FAIL  newlines     got %u lines\n", lay->nlines);
+        failures++;
+        return;
+    }
+    printf("ok    newlines      4 lines, blank line and indent kept\n");
+}
+
+/* 函数名：check_cache
+ *
+ * 函数说明：同一文本第二次排版应命中缓存并返回同一结果；测量排版与命中耗时。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_cache(void)
+{
+    const int iters = 20000;
+    oled_layout_stats_t before, after;
+
+    oled_layout_flush_cache();
+    oled_layout_get_stats(&before);
+    const oled_layout_t *a = oled_layout_text(JOKE, 128);
+    uint16_t nlines = a->nlines;
+    const oled_layout_t *b = oled_layout_text(JOKE, 128);
+    oled_layout_get_stats(&after);
+    if (a != b || b->nlines != nlines || after.misses - before.misses != 1 || after.hits - before.hits != 1) {
+        printf("FAIL  cache        repeated layout was not served from the cache\n");
+        failures++;
+        return;
+    }
+
+    /* Different widths never share an entry */
+    const oled_layout_t *narrow = oled_layout_text(JOKE, 64);
+    if (narrow->nlines <= nlines) {
+        printf("FAIL  cache        64 px layout reused the 128 px one\n");
+        failures++;
+        return;
+    }
+
+    uint64_t t0 = now_ns();
+    for (int i = 0; i < iters; i++) {
+        oled_layout_flush_cache();
+        oled_layout_text(JOKE, 128);
+    }
+    uint64_t t1 = now_ns();
+    for (int i = 0; i < iters; i++) oled_layout_text(JOKE, 128);
+    uint64_t t2 = now_ns();
+    printf("ok    cache         layout %8.1f ns, cache hit %8.1f ns\n",
+           (double)(t1 - t0) / iters, (double)(t2 - t1) / iters);
+}
+
+int main(void)
+{
+    check_text("joke", JOKE, 128);
+    check_text("long words", LONG_WORDS, 128);
+    check_text("narrow", JOKE, 40);
+    check_lines();
+    check_cache();
+
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
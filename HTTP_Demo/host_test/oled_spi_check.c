@@ -0,0 +1,344 @@
+/*
+ * Checks the SPI transport of the SSD1306 driver
+ *
+ * Built once for the generic SSD1306 build and once for SH1106 128x64. The
+ * panel is initialised over the mock SPI master (reset pulse, D/C per
+ * transaction) and random drawing must reach the emulated GDDRAM exactly as
+ * over I2C. In deferred mode the mock holds queued transactions "on the wire":
+ * ssd1306_show_async() must return with the flush still pending and call its
+ * callback exactly once when the last transaction completes, and
+ * ssd1306_take_frame() must wait for the front frame's flush before copying
+ * into it. An I2C panel must call the callback before show_async() returns.
+ * Finally a full-frame flush is timed with a bus model (clock plus a fixed
+ * per-transaction cost) and must allow at least 60 FPS.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ssd1306.h"
+#include "driver/gpio.h"
+
+#define PANEL_WIDTH     128
+#define PANEL_HEIGHT    64
+#define PANEL_PAGES     (PANEL_HEIGHT / 8)
+#define PIN_CS          5
+#define PIN_DC          16
+#define PIN_RST         17
+#define SPI_HZ          (SSD1306_PANEL_SH1106 ? 4000000 : 10000000)
+#define SPI_TXN_US      15.0    /* queue + interrupt cost per transaction */
+#define I2C_HZ          700000
+#define MIN_FPS         60
+#define RANDOM_OPS      300
+
+static struct i2c_master_dev_t panel;
+static spi_device_handle_t spi;
+static ssd1306_t dev;
+static int failures = 0;
+
+static int cb_calls;
+static ssd1306_t *cb_dev;
+static void *cb_arg;
+
+/* 函数名：flush_done
+ *
+ * 函数说明：刷新完成回调：记录调用次数与参数。
+ * 参数：
+ *   d   - 完成刷新的设备。
+ *   arg - 回调参数。
+ * 返回值：
+ *   无。
+ */
+static void flush_done(ssd1306_t *d, void *arg)
+{
+    cb_calls++;
+    cb_dev = d;
+    cb_arg = arg;
+}
+
+/* 函数名：reset_panel
+ *
+ * 函数说明：按所选控制器复位模拟面板。
+ * 参数：
+ *   p - 模拟设备。
+ * 返回值：
+ *   无。
+ */
+static void reset_panel(struct i2c_master_dev_t *p)
+{
+    if (SSD1306_PANEL_SH1106) {
+        mock_sh1106_reset(p);
+    } else {
+        mock_ssd1306_reset(p);
+    }
+}
+
+/* 函数名：gddram_matches
+ *
+ * 函数说明：模拟 GDDRAM 的可见部分与帧缓冲一致。
+ * 参数：
+ *   p - 模拟设备。
+ *   d - 显示设备。
+ * 返回值：
+ *   true 一致。
+ */
+static bool gddram_matches(const struct i2c_master_dev_t *p, const ssd1306_t *d)
+{
+    for (int page = 0; page < PANEL_PAGES; page++) {
+        if (memcmp(p->gddram[page] + SSD1306_PANEL_COL_OFFSET, d->buffer + page * PANEL_WIDTH,
+                   PANEL_WIDTH) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* 函数名：report
+ *
+ * 函数说明：输出一项检查结果并累计失败数。
+ * 参数：
+ *   ok   - 是否通过。
+ *   name - 检查名称。
+ *   info - 附加说明。
+ * 返回值：
+ *   无。
+ */
+static void report(bool ok, const char *name, const char *info)
+{
+    printf("%s  %-16s %s\n", ok ? "ok  " : "FAIL", name, info);
+    if (!ok) failures++;
+}
+
+/* 函数名：check_init
+ *
+ * 函数说明：经 SPI 初始化：复位引脚被拉低再释放，初始化序列与清屏到达控制器，
+ *           GDDRAM 全部清零，且没有不支持的命令或 SPI 调用错误。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   true 初始化成功（失败时后续检查无法进行）。
+ */
+static bool check_init(void)
+{
+    ssd1306_spi_config_t cfg = {
+        .host = SPI2_HOST,
+        .cs_gpio = PIN_CS,
+        .dc_gpio = PIN_DC,
+        .rst_gpio = PIN_RST,
+        .clock_hz = SPI_HZ,
+    };
+
+    reset_panel(&panel);
+    spi = mock_spi_attach(SPI2_HOST, &panel, PIN_DC);
+    gpio_set_level(PIN_RST, 1);
+    uint32_t edges = mock_gpio_edges(PIN_RST);
+    esp_err_t err = ssd1306_init_spi(&dev, &cfg, PANEL_WIDTH, PANEL_HEIGHT, false);
+    if (err != ESP_OK) {
+        printf("FAIL  init             ssd1306_init_spi: 0x%x\n", err);
+        failures++;
+        return false;
+    }
+
+    bool ok = mock_gpio_edges(PIN_RST) - edges == 2 && gpio_get_level(PIN_RST) == 1 &&
+              spi->cfg.clock_speed_hz == SPI_HZ && spi->cfg.spics_io_num == PIN_CS &&
+              panel.display_on && panel.bad_cmds == 0 && spi->errors == 0 && gddram_matches(&panel, &dev);
+    char info[96];
+    snprintf(info, sizeof(info), "%s, %u transactions, %u bad commands",
+             SSD1306_PANEL_SH1106 ? "SH1106" : "SSD1306", (unsigned)spi->transactions, (unsigned)panel.bad_cmds);
+    report(ok, "init", info);
+    return true;
+}
+
+/* 函数名：check_random
+ *
+ * 函数说明：随机绘制像素、矩形与文本并同步刷新，每次刷新后 GDDRAM 须与帧缓冲一致。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_random(void)
+{
+    int bad = 0;
+    mock_spi_reset_counters(spi);
+    for (int i = 0; i < RANDOM_OPS && !bad; i++) {
+        uint16_t x = (uint16_t)(rand() % PANEL_WIDTH), y = (uint16_t)(rand() % PANEL_HEIGHT);
+        switch (rand() % 3) {
+            case 0:
+                ssd1306_pixel(&dev, x, y, (uint8_t)(rand() & 1));
+                break;
+            case 1:
+                ssd1306_fill_rect(&dev, x, y, (uint16_t)(1 + rand() % 40), (uint16_t)(1 + rand() % 20),
+                                  (uint8_t)(rand() & 1));
+                break;
+            default:
+                ssd1306_text(&dev, "SPI", x, y, (uint8_t)(rand() & 1), 1);
+                break;
+        }
+        if (ssd1306_show(&dev) != ESP_OK || !gddram_matches(&panel, &dev)) bad++;
+    }
+    bad += (int)spi->errors + (int)panel.bad_cmds + (int)spi->queued + (int)spi->ndone;
+
+    char info[96];
+    snprintf(info, sizeof(info), "%d flushes, %u transactions, max %u queued",
+             RANDOM_OPS, (unsigned)spi->transactions, (unsigned)spi->max_queued);
+    report(!bad, "random draw", info);
+}
+
+/* 函数名：check_async
+ *
+ * 函数说明：延迟模式下整帧刷新：show_async 返回时刷新仍在进行（回调未调用、GDDRAM 未更新），
+ *           事务全部完成后回调恰好调用一次且参数正确，GDDRAM 与帧缓冲一致；
+ *           无变化的刷新不产生事务并立即调用回调。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_async(void)
+{
+    int arg;
+
+    for (int i = 0; i < PANEL_PAGES * PANEL_WIDTH; i++) dev.buffer[i] = (uint8_t)rand();
+    for (int page = 0; page < PANEL_PAGES; page++) ssd1306_page_span(&dev, (uint8_t)page, 0, PANEL_WIDTH);
+
+    spi->deferred = true;
+    cb_calls = 0;
+    esp_err_t err = ssd1306_show_async(&dev, flush_done, &arg);
+    bool pending = err == ESP_OK && cb_calls == 0 && spi->queued > 0 && !gddram_matches(&panel, &dev);
+    size_t queued = spi->queued;
+    mock_spi_run(spi, MOCK_SPI_MAX_QUEUE);
+    bool done = cb_calls == 1 && cb_dev == &dev && cb_arg == &arg && gddram_matches(&panel, &dev);
+    done = done && ssd1306_wait(&dev) == ESP_OK && spi->ndone == 0 && cb_calls == 1;
+
+    char info[96];
+    snprintf(info, sizeof(info), "%u transactions left queued by show_async", (unsigned)queued);
+    report(pending && done, "async flush", info);
+
+    mock_spi_reset_counters(spi);
+    cb_calls = 0;
+    err = ssd1306_show_async(&dev, flush_done, &arg);
+    report(err == ESP_OK && cb_calls == 1 && spi->queued == 0 && spi->transactions == 0,
+           "async no change", "callback called at once, no transactions");
+    spi->deferred = false;
+}
+
+/* 函数名：check_i2c_sync
+ *
+ * 函数说明：I2C 面板的 show_async 为同步发送，返回前已调用回调。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_i2c_sync(void)
+{
+    static struct i2c_master_dev_t i2c_panel;
+    ssd1306_t i2c_dev;
+
+    reset_panel(&i2c_panel);
+    if (ssd1306_init(&i2c_dev, &i2c_panel, PANEL_WIDTH, PANEL_HEIGHT, 0x3C, false) != ESP_OK) {
+        report(false, "i2c callback", "ssd1306_init failed");
+        return;
+    }
+    ssd1306_fill_rect(&i2c_dev, 10, 10, 50, 20, 1);
+    cb_calls = 0;
+    esp_err_t err = ssd1306_show_async(&i2c_dev, flush_done, NULL);
+    report(err == ESP_OK && cb_calls == 1 && cb_dev == &i2c_dev && gddram_matches(&i2c_panel, &i2c_dev),
+           "i2c callback", "called before show_async returns");
+    ssd1306_deinit(&i2c_dev);
+}
+
+/* 函数名：bench_full_frame
+ *
+ * 函数说明：整帧变化时统计 SPI 事务与位数，按时钟与每事务固定开销估算刷新时间，
+ *           可持续帧率须不低于 MIN_FPS；同时输出同一帧经 700 kHz I2C 的耗时作对比。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void bench_full_frame(void)
+{
+    static struct i2c_master_dev_t i2c_panel;
+    ssd1306_t i2c_dev;
+
+    reset_panel(&i2c_panel);
+    ssd1306_init(&i2c_dev, &i2c_panel, PANEL_WIDTH, PANEL_HEIGHT, 0x3C, false);
+    for (int i = 0; i < PANEL_PAGES * PANEL_WIDTH; i++) dev.buffer[i] = (uint8_t)~dev.buffer[i];
+    memcpy(i2c_dev.buffer, dev.buffer, PANEL_PAGES * PANEL_WIDTH);
+    for (int page = 0; page < PANEL_PAGES; page++) {
+        ssd1306_page_span(&dev, (uint8_t)page, 0, PANEL_WIDTH);
+        ssd1306_page_span(&i2c_dev, (uint8_t)page, 0, PANEL_WIDTH);
+    }
+
+    mock_spi_reset_counters(spi);
+    mock_ssd1306_reset_counters(&i2c_panel);
+    bool ok = ssd1306_show(&dev) == ESP_OK && ssd1306_show(&i2c_dev) == ESP_OK &&
+              gddram_matches(&panel, &dev) && gddram_matches(&i2c_panel, &i2c_dev);
+
+    double spi_us = (double)spi->bits * 1e6 / SPI_HZ + spi->transactions * SPI_TXN_US;
+    double i2c_us = i2c_panel.bytes * 9.0 * 1e6 / I2C_HZ;
+    ok = ok && 1e6 / spi_us >= MIN_FPS;
+    printf("%s  full frame       SPI %.0f MHz: %u txns %u B %6.0f us (%4.0f FPS)   I2C 700 kHz: %u B %6.0f us (%3.0f FPS)\n",
+           ok ? "ok  " : "FAIL", SPI_HZ / 1e6, (unsigned)spi->transactions, (unsigned)(spi->bits / 8), spi_us,
+           1e6 / spi_us, (unsigned)i2c_panel.bytes, i2c_us, 1e6 / i2c_us);
+    if (!ok) failures++;
+    ssd1306_deinit(&i2c_dev);
+}
+
+/* 函数名：check_take_frame
+ *
+ * 函数说明：双缓冲：前台帧异步刷新进行中时，take_frame 须先等待其完成再拷贝新帧，
+ *           随后前台帧的刷新使 GDDRAM 与后台帧一致。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_take_frame(void)
+{
+    ssd1306_t front;
+    if (ssd1306_clone(&front, &dev) != ESP_OK) {
+        report(false, "take frame", "ssd1306_clone failed");
+        return;
+    }
+
+    spi->deferred = true;
+    cb_calls = 0;
+    ssd1306_fill_rect(&dev, 0, 0, 64, 32, 1);
+    ssd1306_take_frame(&front, &dev);
+    ssd1306_show_async(&front, flush_done, NULL);
+    bool pending = cb_calls == 0 && spi->queued > 0;
+
+    ssd1306_fill_rect(&dev, 32, 16, 64, 32, 0);
+    ssd1306_take_frame(&front, &dev);
+    bool waited = cb_calls == 1 && spi->queued == 0 && spi->ndone == 0;
+
+    ssd1306_show_async(&front, flush_done, NULL);
+    ssd1306_wait(&front);
+    bool ok = pending && waited && cb_calls == 2 && spi->errors == 0 &&
+              memcmp(front.buffer, dev.buffer, PANEL_PAGES * PANEL_WIDTH) == 0 && gddram_matches(&panel, &front);
+    report(ok, "take frame", "waits for the front frame's flush");
+    spi->deferred = false;
+    ssd1306_deinit(&front);
+}
+
+int main(void)
+{
+    srand(1818);
+    if (!check_init()) return 1;
+
+    check_random();
+    check_async();
+    check_i2c_sync();
+    bench_full_frame();
+    check_take_frame();
+
+    ssd1306_deinit(&dev);
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
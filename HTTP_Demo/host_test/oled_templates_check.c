@@ -0,0 +1,79 @@
+/*
+ * Checks the pre-rasterized screen templates against runtime rendering
+ *
+ * Each template image must equal what ssd1306_text() draws from the template's
+ * own string list; a mismatch means oled_templates.c is stale and
+ * tools/gen_oled_templates.py has to be re-run. Also reports the cost of
+ * loading a template versus rasterizing it.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306.h"
+#include "oled_templates.h"
+
+static struct i2c_master_dev_t panel;
+static ssd1306_t dev;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void rasterize(const oled_template_t *tpl)
+{
+    ssd1306_clear(&dev);
+    for (uint8_t i = 0; i < tpl->ntexts; i++) {
+        ssd1306_text(&dev, tpl->texts[i].text, tpl->texts[i].x, tpl->texts[i].y, 1, tpl->texts[i].wrap_mode);
+    }
+}
+
+/* 函数名：check_template
+ *
+ * 函数说明：比对模板图像与即时光栅化结果，并测量两种方式的耗时。
+ * 参数：
+ *   name - 模板名称。
+ *   tpl  - 模板。
+ * 返回值：
+ *   0 表示一致，1 表示不一致。
+ */
+static int check_template(const char *name, const oled_template_t *tpl)
+{
+    const int iters = 20000;
+    size_t size = (size_t)dev.pages * dev.width;
+
+    rasterize(tpl);
+    if (memcmp(dev.buffer, tpl->image, size) != 0) {
+        printf("FAIL  %-16s image differs from ssd1306_text() output, re-run gen_oled_templates.py\n", name);
+        return 1;
+    }
+
+    uint64_t t0 = now_ns();
+    for (int i = 0; i < iters; i++) rasterize(tpl);
+    uint64_t t1 = now_ns();
+    for (int i = 0; i < iters; i++) ssd1306_load_frame(&dev, tpl->image);
+    uint64_t t2 = now_ns();
+
+    printf("ok    %-16s rasterize %8.1f ns, load_frame %8.1f ns\n", name,
+           (double)(t1 - t0) / iters, (double)(t2 - t1) / iters);
+    return 0;
+}
+
+int main(void)
+{
+    mock_ssd1306_reset(&panel);
+    if (ssd1306_init(&dev, &panel, OLED_TEMPLATE_WIDTH, OLED_TEMPLATE_HEIGHT, 0x3C, false) != ESP_OK) {
+        printf("FAIL  ssd1306_init\n");
+        return 1;
+    }
+
+    int failures = 0;
+    failures += check_template("connecting", &oled_tpl_connecting);
+    failures += check_template("connected", &oled_tpl_connected);
+    failures += check_template("connected_ip", &oled_tpl_connected_ip);
+
+    ssd1306_deinit(&dev);
+    return failures ? 1 : 0;
+}
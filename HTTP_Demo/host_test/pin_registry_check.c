@@ -0,0 +1,159 @@
+/*
+ * Checks the GPIO pin registry
+ *
+ * Against the mock GPIO driver: a pin is configured with gpio_config() the
+ * first time it is used and never again, a mask of new pins costs a single
+ * gpio_config() call, and pins that are missing, input-only or reserved
+ * (SPI flash, UART0 console, OLED panel bus) are rejected without touching
+ * the driver. Built once for the I2C panel and once for the SPI panel. Bulk writes must land on the mock pin levels
+ * through the output set/clear registers with at most one register write per
+ * bank and direction, pins 32 and up going to the second bank.
+ */
+#include <stdio.h>
+#include "driver/gpio.h"
+#include "pin_registry.h"
+#include "oled_pins.h"
+
+static int failures = 0;
+
+/* 函数名：levels_are
+ *
+ * 函数说明：模拟引脚 0~39 的电平是否与期望掩码一致。
+ * 参数：
+ *   expect - 期望的电平掩码。
+ * 返回值：
+ *   true 一致。
+ */
+static bool levels_are(uint64_t expect)
+{
+    for (int pin = 0; pin < MOCK_GPIO_COUNT; pin++) {
+        if (gpio_get_level(pin) != (int)((expect >> pin) & 1)) return false;
+    }
+    return true;
+}
+
+/* 函数名：check_configure_once
+ *
+ * 函数说明：同一引脚重复使用只配置一次；掩码中的新引脚一并配置，已配置的不再配置。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_configure_once(void)
+{
+    uint32_t start = mock_gpio_config_calls();
+    bool ok = !pin_reg_is_output(4);
+
+    for (int i = 0; i < 100; i++) {
+        ok = ok && pin_reg_output(4) == ESP_OK;
+    }
+    uint32_t single = mock_gpio_config_calls() - start;
+    ok = ok && single == 1 && pin_reg_is_output(4) && !pin_reg_is_output(5);
+
+    uint64_t mask = PIN_REG_BIT(4) | PIN_REG_BIT(5) | PIN_REG_BIT(12) | PIN_REG_BIT(13);
+    start = mock_gpio_config_calls();
+    ok = ok && pin_reg_output_mask(mask) == ESP_OK && pin_reg_output_mask(mask) == ESP_OK &&
+         pin_reg_output(13) == ESP_OK;
+    uint32_t multi = mock_gpio_config_calls() - start;
+    ok = ok && multi == 1 && pin_reg_outputs() == mask && pin_reg_output_mask(0) == ESP_OK &&
+         mock_gpio_config_calls() - start == 1;
+
+    printf("%s  configure once         100 uses of one pin: %u gpio_config, 3 new pins: %u\n",
+           ok ? "ok  " : "FAIL", (unsigned)single, (unsigned)multi);
+    if (!ok) failures++;
+}
+
+/* 函数名：check_invalid_pins
+ *
+ * 函数说明：不存在、只能输入、超出范围或保留（闪存、串口控制台、OLED 面板总线）的引脚被拒绝，
+ *           不调用 gpio_config，也不登记掩码中的其他引脚。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_invalid_pins(void)
+{
+    static const int bad[] = { -1, 24, 28, 31, 34, 39, 40, 63, 64,
+                               1, 3, 6, 7, 8, 9, 10, 11 };   /* console and flash */
+    uint32_t start = mock_gpio_config_calls();
+    uint64_t before = pin_reg_outputs();
+    bool ok = OLED_PANEL_PIN_MASK != 0;
+    int panel = 0;
+
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        ok = ok && pin_reg_output(bad[i]) == ESP_ERR_INVALID_ARG && !pin_reg_is_output(bad[i]);
+    }
+    for (int pin = 0; pin < 64; pin++) {
+        if (!(OLED_PANEL_PIN_MASK & PIN_REG_BIT(pin))) continue;
+        ok = ok && pin_reg_output(pin) == ESP_ERR_INVALID_ARG && !pin_reg_is_output(pin);
+        ok = ok && pin_reg_output_mask(PIN_REG_BIT(21) | PIN_REG_BIT(pin)) == ESP_ERR_INVALID_ARG;
+        panel++;
+    }
+    ok = ok && pin_reg_output_mask(PIN_REG_BIT(18) | PIN_REG_BIT(35)) == ESP_ERR_INVALID_ARG &&
+         !pin_reg_is_output(18);
+    ok = ok && pin_reg_output_mask(PIN_REG_BIT(22) | PIN_REG_BIT(6)) == ESP_ERR_INVALID_ARG &&
+         !pin_reg_is_output(22);
+    ok = ok && mock_gpio_config_calls() == start && pin_reg_outputs() == before;
+
+    printf("%s  invalid pins           missing, input-only, out-of-range and reserved pins rejected "
+           "(%d panel pins)\n", ok ? "ok  " : "FAIL", panel);
+    if (!ok) failures++;
+}
+
+/* 函数名：check_bulk_write
+ *
+ * 函数说明：掩码写入后模拟引脚电平与期望一致，每组每个方向最多一次寄存器写入，
+ *           空掩码方向不写；GPIO32 以上经第二组寄存器写入。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void check_bulk_write(void)
+{
+    const uint64_t low_bank = 0xFF000ULL;   /* GPIO12~19 */
+    const uint64_t high_bank = PIN_REG_BIT(32) | PIN_REG_BIT(33);
+    bool ok = pin_reg_output_mask(low_bank | high_bank) == ESP_OK;
+    uint64_t expect = 0;
+
+    uint32_t start = mock_reg_writes();
+    pin_reg_write(0xF000ULL, 0xF0000ULL);
+    expect = 0xF000ULL;
+    uint32_t low_writes = mock_reg_writes() - start;
+    ok = ok && low_writes == 2 && levels_are(expect);
+
+    start = mock_reg_writes();
+    pin_reg_write(0xF0000ULL | PIN_REG_BIT(33), 0);
+    expect |= 0xF0000ULL | PIN_REG_BIT(33);
+    ok = ok && mock_reg_writes() - start == 2 && levels_are(expect);
+
+    start = mock_reg_writes();
+    pin_reg_write(PIN_REG_BIT(32), 0xF000ULL | PIN_REG_BIT(33));
+    expect = (expect | PIN_REG_BIT(32)) & ~(0xF000ULL | PIN_REG_BIT(33));
+    uint32_t both_writes = mock_reg_writes() - start;
+    ok = ok && both_writes == 3 && levels_are(expect);
+
+    start = mock_reg_writes();
+    pin_reg_write(0, 0);
+    ok = ok && mock_reg_writes() == start;
+
+    printf("%s  bulk write             8 pins in %u register writes, both banks in %u\n",
+           ok ? "ok  " : "FAIL", (unsigned)low_writes, (unsigned)both_writes);
+    if (!ok) failures++;
+}
+
+int main(void)
+{
+    check_configure_once();
+    check_invalid_pins();
+    check_bulk_write();
+
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
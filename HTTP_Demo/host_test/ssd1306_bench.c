@@ -0,0 +1,251 @@
+/*
+ * SSD1306 driver host benchmark
+ *
+ * Builds the real ssd1306.c against the mock I2C backend, times the drawing
+ * primitives, counts bus transactions/bytes per ssd1306_show() for typical
+ * screens and checks that the emulated GDDRAM matches the framebuffer after
+ * every flush. Exits non-zero on a GDDRAM mismatch or when a scenario exceeds
+ * its bus byte budget.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306.h"
+#include "oled_widget.h"
+
+#define BENCH_WIDTH   128
+#define BENCH_HEIGHT  64
+
+static struct i2c_master_dev_t panel;
+static ssd1306_t dev;
+static int failures = 0;
+
+static const char *LONG_TEXT =
+    "Chuck Norris can compile syntax errors. When he throws an exception, "
+    "nothing can catch it. His code never has bugs, only surprise features "
+    "that work exactly as he intended, every single time.";
+
+/* 函数名：now_ns
+ *
+ * 函数说明：读取单调时钟（纳秒）。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   当前时间（ns）。
+ */
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/* 函数名：check_gddram
+ *
+ * 函数说明：比对模拟 GDDRAM 与驱动帧缓冲，不一致时记录失败。
+ * 参数：
+ *   what - 场景名称。
+ * 返回值：
+ *   无。
+ */
+static void check_gddram(const char *what)
+{
+    for (uint8_t page = 0; page < dev.pages; ++page) {
+        if (memcmp(panel.gddram[page], dev.buffer + (size_t)page * dev.width, dev.width) != 0) {
+            printf("FAIL  %-28s GDDRAM mismatch on page %u\n", what, page);
+            failures++;
+            return;
+        }
+    }
+}
+
+/* 函数名：bench_primitive
+ *
+ * 函数说明：重复执行绘制函数并输出平均耗时（不刷新）。
+ * 参数：
+ *   name - 名称。
+ *   fn   - 绘制函数。
+ *   iters - 迭代次数。
+ * 返回值：
+ *   无。
+ */
+static void bench_primitive(const char *name, void (*fn)(void), int iters)
+{
+    uint64_t t0 = now_ns();
+    for (int i = 0; i < iters; i++) fn();
+    uint64_t t1 = now_ns();
+    printf("time  %-28s %10.1f ns/op\n", name, (double)(t1 - t0) / iters);
+    ssd1306_show(&dev);
+    check_gddram(name);
+}
+
+static void draw_fill(void)        { ssd1306_fill(&dev, 1); }
+static void draw_clear(void)       { ssd1306_clear(&dev); }
+static void draw_fill_rect(void)   { ssd1306_fill_rect(&dev, 3, 5, 100, 50, 1); }
+static void draw_rect(void)        { ssd1306_rect(&dev, 3, 5, 100, 50, 1); }
+static void draw_h_line(void)      { ssd1306_h_line(&dev, 0, 37, 128, 1); }
+static void draw_v_line(void)      { ssd1306_v_line(&dev, 64, 0, 64, 1); }
+static void draw_text_line(void)   { ssd1306_text(&dev, "WiFi Connected!", 0, 0, 1, 1); }
+static void draw_text_unaligned(void) { ssd1306_text(&dev, "Server: Port 443", 0, 12, 1, 1); }
+static void draw_text_long(void)   { ssd1306_text(&dev, LONG_TEXT, 0, 10, 1, 0); }
+
+/* 函数名：bench_flush
+ *
+ * 函数说明：绘制一帧并刷新，统计本次 ssd1306_show() 的总线事务与字节数，
+ *           校验 GDDRAM，并检查字节预算。
+ * 参数：
+ *   name   - 场景名称。
+ *   draw   - 绘制函数（在 show 前调用）。
+ *   budget - 允许的最大总线字节数。
+ * 返回值：
+ *   无。
+ */
+static void bench_flush(const char *name, void (*draw)(void), uint32_t budget)
+{
+    draw();
+    mock_ssd1306_reset_counters(&panel);
+    uint64_t t0 = now_ns();
+    esp_err_t ret = ssd1306_show(&dev);
+    uint64_t t1 = now_ns();
+
+    printf("flush %-28s %4u tx %6u bytes %10.1f us cpu\n", name,
+           panel.transactions, panel.bytes, (double)(t1 - t0) / 1000.0);
+    if (ret != ESP_OK) {
+        printf("FAIL  %-28s ssd1306_show returned %s\n", name, esp_err_to_name(ret));
+        failures++;
+    }
+    if (panel.bytes > budget) {
+        printf("FAIL  %-28s %u bytes exceeds budget %u\n", name, panel.bytes, budget);
+        failures++;
+    }
+    check_gddram(name);
+}
+
+static const char *status_ip = "192.168.1.5";
+
+static void screen_full(void)
+{
+    for (size_t i = 0; i < (size_t)dev.pages * dev.width; i++) dev.buffer[i] = (uint8_t)(i * 37u);
+    ssd1306_fill_rect(&dev, 0, 0, dev.width, dev.height, 1);
+    ssd1306_fill_rect(&dev, 1, 1, dev.width - 2, dev.height - 2, 0);
+    ssd1306_text(&dev, LONG_TEXT, 2, 2, 1, 0);
+}
+
+static void screen_status(void)
+{
+    ssd1306_clear(&dev);
+    ssd1306_text(&dev, "WiFi Connected!", 0, 0, 1, 1);
+    ssd1306_text(&dev, "Server: Port 443", 0, 12, 1, 1);
+    ssd1306_text(&dev, "IP Address:", 0, 24, 1, 1);
+    ssd1306_text(&dev, status_ip, 0, 36, 1, 1);
+}
+
+static void screen_status_new_ip(void)
+{
+    status_ip = "192.168.1.6";
+    screen_status();
+}
+
+static void screen_progress(void)
+{
+    ssd1306_rect(&dev, 0, 54, 128, 10, 1);
+    ssd1306_fill_rect(&dev, 2, 56, 40, 6, 1);
+}
+
+static void screen_nothing(void) { }
+
+/* Retained widgets: only widgets whose content changed are redrawn */
+static oled_ui_t ui;
+static oled_widget_t w_bar, w_label, w_progress;
+static uint16_t w_value = 0;
+
+static void screen_widgets(void)
+{
+    ssd1306_clear(&dev);
+    oled_ui_init(&ui, &dev);
+    oled_status_bar_init(&w_bar, 0, dev.width);
+    oled_label_init(&w_label, 0, 20, dev.width);
+    oled_progress_init(&w_progress, 0, 40, dev.width, 10, 100);
+    oled_ui_add(&ui, &w_bar);
+    oled_ui_add(&ui, &w_label);
+    oled_ui_add(&ui, &w_progress);
+    oled_status_bar_set(&w_bar, "HTTP", "12:00");
+    oled_label_set(&w_label, "Uploading...");
+    oled_progress_set(&w_progress, w_value);
+    oled_ui_render(&ui);
+}
+
+static void screen_widgets_unchanged(void)
+{
+    oled_status_bar_set(&w_bar, "HTTP", "12:00");
+    oled_label_set(&w_label, "Uploading...");
+    oled_progress_set(&w_progress, w_value);
+    if (oled_ui_render(&ui) != 0) {
+        printf("FAIL  widgets redrawn without a content change\n");
+        failures++;
+    }
+}
+
+static void screen_widgets_progress(void)
+{
+    w_value += 5;
+    oled_progress_set(&w_progress, w_value);
+    oled_ui_render(&ui);
+}
+
+static void screen_widgets_clock(void)
+{
+    oled_status_bar_set(&w_bar, "HTTP", "12:01");
+    oled_ui_render(&ui);
+}
+
+int main(void)
+{
+    mock_ssd1306_reset(&panel);
+    esp_err_t ret = ssd1306_init(&dev, &panel, BENCH_WIDTH, BENCH_HEIGHT, 0x3C, false);
+    if (ret != ESP_OK) {
+        printf("FAIL  ssd1306_init returned %s\n", esp_err_to_name(ret));
+        return 1;
+    }
+    check_gddram("init");
+
+    printf("== primitives ==\n");
+    bench_primitive("fill", draw_fill, 20000);
+    bench_primitive("clear", draw_clear, 20000);
+    bench_primitive("fill_rect 100x50", draw_fill_rect, 20000);
+    bench_primitive("rect 100x50", draw_rect, 20000);
+    bench_primitive("h_line 128", draw_h_line, 20000);
+    bench_primitive("v_line 64", draw_v_line, 20000);
+    bench_primitive("text 15 chars aligned", draw_text_line, 20000);
+    bench_primitive("text 16 chars unaligned", draw_text_unaligned, 20000);
+    bench_primitive("text 180 chars wrapped", draw_text_long, 5000);
+
+    /* Budgets: a full frame is 1024 data bytes plus addressing overhead */
+    printf("== flush ==\n");
+    ssd1306_reset_bus_stats(&dev);
+    bench_flush("full frame", screen_full, 1024 + 64);
+    bench_flush("status screen", screen_status, 1024 + 64);
+    bench_flush("status screen repeated", screen_status, 0);
+    bench_flush("status screen new ip", screen_status_new_ip, 64);
+    bench_flush("progress bar", screen_progress, 400);
+    bench_flush("no change", screen_nothing, 0);
+    bench_flush("widgets", screen_widgets, 1024 + 64);
+    bench_flush("widgets unchanged", screen_widgets_unchanged, 0);
+    bench_flush("widget progress +5%", screen_widgets_progress, 64);
+    bench_flush("widget status clock", screen_widgets_clock, 64);
+
+    ssd1306_bus_stats_t stats;
+    ssd1306_get_bus_stats(&dev, &stats);
+    printf("== driver stats ==\n");
+    printf("flushes %u, bursts %u, runs %u, transactions %u, bytes %u\n",
+           stats.flushes, stats.bursts, stats.runs, stats.transactions, stats.bytes);
+
+    ssd1306_deinit(&dev);
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
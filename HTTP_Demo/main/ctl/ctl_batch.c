@@ -0,0 +1,258 @@
+#include "ctl_batch.h"
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "cJSON.h"
+#include "ctl_frame.h"
+#include "device_ctl.h"
+
+static const char *TAG = "ctl_batch";
+
+#define CTL_BATCH_RESULT_MAX    64      /* longest per-op result object, comma included */
+#define CTL_BATCH_HEAD_MAX      96      /* status, counters and brackets */
+
+/* Response being assembled; sized up front from the op count */
+typedef struct {
+    char *buf;
+    size_t len;
+    size_t cap;
+} ctl_batch_out_t;
+
+/* 函数名：ctl_batch_append
+ *
+ * 函数说明：向响应追加格式化文本；空间不足时截断（缓冲按操作数预留，正常不会发生）。
+ * 参数：
+ *   o   - 响应缓冲。
+ *   fmt - 格式串。
+ * 返回值：
+ *   无。
+ */
+static void ctl_batch_append(ctl_batch_out_t *o, const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(o->buf + o->len, o->cap - o->len, fmt, ap);
+    va_end(ap);
+    if (n > 0) {
+        o->len += (size_t)n < o->cap - o->len ? (size_t)n : o->cap - o->len - 1;
+    }
+}
+
+/* 函数名：ctl_batch_op_name
+ *
+ * 函数说明：取操作名。
+ * 参数：
+ *   item - 操作对象。
+ * 返回值：
+ *   操作名；缺失或不是字符串时返回 NULL。
+ */
+static const char *ctl_batch_op_name(const cJSON *item)
+{
+    const cJSON *op = cJSON_GetObjectItemCaseSensitive(item, "op");
+    return cJSON_IsString(op) ? op->valuestring : NULL;
+}
+
+/* 函数名：ctl_batch_text
+ *
+ * 函数说明：取 text 操作的文本。
+ * 参数：
+ *   item - 操作对象。
+ * 返回值：
+ *   文本；缺失、不是字符串或超过 CTL_TEXT_MAX 字节时返回 NULL。
+ */
+static const char *ctl_batch_text(const cJSON *item)
+{
+    const cJSON *text = cJSON_GetObjectItemCaseSensitive(item, "text");
+    if (!cJSON_IsString(text) || strlen(text->valuestring) > CTL_TEXT_MAX) return NULL;
+    return text->valuestring;
+}
+
+/* 函数名：ctl_batch_is_oled
+ *
+ * 函数说明：是否为可执行的 OLED 操作（clear，或文本有效的 text）。
+ * 参数：
+ *   item - 操作对象。
+ * 返回值：
+ *   true 是。
+ */
+static bool ctl_batch_is_oled(const cJSON *item)
+{
+    const char *op = ctl_batch_op_name(item);
+    if (!op) return false;
+    return strcmp(op, "clear") == 0 || (strcmp(op, "text") == 0 && ctl_batch_text(item) != NULL);
+}
+
+/* 函数名：ctl_batch_level
+ *
+ * 函数说明：解析 gpio 操作的电平："high"/"low"、1/0 或 true/false。
+ * 参数：
+ *   item  - 操作对象。
+ *   level - 输出电平。
+ * 返回值：
+ *   true 解析成功。
+ */
+static bool ctl_batch_level(const cJSON *item, int *level)
+{
+    const cJSON *v = cJSON_GetObjectItemCaseSensitive(item, "level");
+    if (cJSON_IsString(v)) {
+        if (strcmp(v->valuestring, "high") == 0) {
+            *level = 1;
+        } else if (strcmp(v->valuestring, "low") == 0) {
+            *level = 0;
+        } else {
+            return false;
+        }
+    } else if (cJSON_IsBool(v)) {
+        *level = cJSON_IsTrue(v) ? 1 : 0;
+    } else if (cJSON_IsNumber(v) && (v->valueint == 0 || v->valueint == 1)) {
+        *level = v->valueint;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/* 函数名：ctl_batch_exec
+ *
+ * 函数说明：执行一个操作并追加其结果对象。
+ * 参数：
+ *   item      - 操作对象。
+ *   show_oled - 本操作是批次中最后一个 OLED 操作，需要真正提交画面。
+ *   o         - 响应缓冲。
+ * 返回值：
+ *   true 执行成功。
+ */
+static bool ctl_batch_exec(const cJSON *item, bool show_oled, ctl_batch_out_t *o)
+{
+    const char *op = ctl_batch_op_name(item);
+    const char *error = NULL;
+
+    if (!op) {
+        error = "missing op";
+    } else if (strcmp(op, "led") == 0) {
+        const cJSON *action = cJSON_GetObjectItemCaseSensitive(item, "action");
+        ctl_led_action_t led = CTL_LED_OFF;
+        if (!cJSON_IsString(action)) {
+            error = "missing action";
+        } else if (strcmp(action->valuestring, "on") == 0) {
+            led = CTL_LED_ON;
+        } else if (strcmp(action->valuestring, "off") == 0) {
+            led = CTL_LED_OFF;
+        } else if (strcmp(action->valuestring, "toggle") == 0) {
+            led = CTL_LED_TOGGLE;
+        } else {
+            error = "bad action";
+        }
+        if (!error) {
+            ctl_batch_append(o, "{\"op\":\"led\",\"ok\":true,\"led\":\"%s\"}", device_ctl_led(led) ? "on" : "off");
+            return true;
+        }
+    } else if (strcmp(op, "gpio") == 0) {
+        const cJSON *pin = cJSON_GetObjectItemCaseSensitive(item, "pin");
+        int level = 0;
+        if (!cJSON_IsNumber(pin)) {
+            error = "missing pin";
+        } else if (!ctl_batch_level(item, &level)) {
+            error = "bad level";
+        } else if (device_ctl_gpio(pin->valueint, level) != ESP_OK) {
+            error = "bad pin";
+        } else {
+            ctl_batch_append(o, "{\"op\":\"gpio\",\"ok\":true,\"pin\":%d,\"level\":\"%s\"}", pin->valueint,
+                             level ? "high" : "low");
+            return true;
+        }
+    } else if (strcmp(op, "text") == 0 || strcmp(op, "clear") == 0) {
+        bool text = op[0] == 't';
+        if (text && !ctl_batch_text(item)) {
+            error = "bad or too long text";
+        } else {
+            if (show_oled) {
+                if (text) {
+                    device_ctl_text(ctl_batch_text(item));
+                } else {
+                    device_ctl_clear();
+                }
+            }
+            ctl_batch_append(o, "{\"op\":\"%s\",\"ok\":true,\"shown\":%s}", text ? "text" : "clear",
+                             show_oled ? "true" : "false");
+            return true;
+        }
+    } else {
+        error = "unknown op";
+    }
+
+    ctl_batch_append(o, "{\"ok\":false,\"error\":\"%s\"}", error);
+    return false;
+}
+
+/* 函数名：ctl_batch_run
+ *
+ * 函数说明：解析并按顺序执行一批操作，生成 JSON 响应（格式见头文件）。OLED 操作只提交
+ *           最后一个有效的，一批最多触发一次重绘。
+ * 参数：
+ *   body  - 请求体（不要求以 NUL 结尾）。
+ *   len   - 请求体长度。
+ *   out   - 成功时输出响应（malloc 分配，调用方 free）。
+ *   error - 失败时输出原因。
+ * 返回值：
+ *   ESP_OK 已执行（个别操作可能失败，见结果）；ESP_ERR_INVALID_ARG 不是 JSON 数组；
+ *   ESP_ERR_INVALID_SIZE 请求体或操作数超限；ESP_ERR_NO_MEM 分配失败。
+ */
+esp_err_t ctl_batch_run(const char *body, size_t len, char **out, const char **error)
+{
+    *out = NULL;
+    *error = NULL;
+    if (len > CTL_BATCH_MAX_BODY) {
+        *error = "Body too large";
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    cJSON *ops = cJSON_ParseWithLength(body, len);
+    if (!cJSON_IsArray(ops)) {
+        cJSON_Delete(ops);
+        *error = "Body must be a JSON array of operations";
+        return ESP_ERR_INVALID_ARG;
+    }
+    int count = cJSON_GetArraySize(ops);
+    if (count > CTL_BATCH_MAX_OPS) {
+        cJSON_Delete(ops);
+        *error = "Too many operations";
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    ctl_batch_out_t o = { .cap = CTL_BATCH_HEAD_MAX + (size_t)count * CTL_BATCH_RESULT_MAX };
+    o.buf = malloc(o.cap);
+    if (!o.buf) {
+        cJSON_Delete(ops);
+        *error = "Out of memory";
+        return ESP_ERR_NO_MEM;
+    }
+
+    /* Only the last OLED op reaches the screen: one redraw per batch */
+    int last_oled = -1;
+    int i = 0;
+    const cJSON *item;
+    cJSON_ArrayForEach(item, ops) {
+        if (ctl_batch_is_oled(item)) last_oled = i;
+        i++;
+    }
+
+    int failed = 0;
+    o.len = 0;
+    ctl_batch_append(&o, "{\"status\":\"ok\",\"results\":[");
+    i = 0;
+    cJSON_ArrayForEach(item, ops) {
+        if (i) ctl_batch_append(&o, ",");
+        if (!ctl_batch_exec(item, i == last_oled, &o)) failed++;
+        i++;
+    }
+    ctl_batch_append(&o, "],\"ops\":%d,\"failed\":%d,\"oled_redraws\":%d}", count, failed, last_oled >= 0 ? 1 : 0);
+    cJSON_Delete(ops);
+
+    ESP_LOGI(TAG, "%d ops, %d failed, %d OLED redraw", count, failed, last_oled >= 0 ? 1 : 0);
+    *out = o.buf;
+    return ESP_OK;
+}
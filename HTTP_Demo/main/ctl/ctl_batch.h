@@ -0,0 +1,33 @@
+/*
+ * 批量命令（POST /api/batch）
+ *
+ * 请求体为 JSON 数组，每个元素一个操作，按顺序在同一请求内执行：
+ *   {"op":"led","action":"on|off|toggle"}
+ *   {"op":"gpio","pin":4,"level":"high|low"}（level 也接受 1/0、true/false）
+ *   {"op":"text","text":"..."}
+ *   {"op":"clear"}
+ * 单个操作失败不影响其余操作。OLED 操作合并：只有最后一个有效的 text/clear 真正提交
+ * 画面（一次重绘），之前的在结果中标记为 "shown":false。
+ * 响应为 {"status":"ok","results":[...],"ops":N,"failed":F,"oled_redraws":R}，
+ * results 与请求中的操作一一对应，失败的操作为 {"ok":false,"error":"原因"}。
+ */
+#ifndef CTL_BATCH_H
+#define CTL_BATCH_H
+
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CTL_BATCH_MAX_BODY  2048
+#define CTL_BATCH_MAX_OPS   32
+
+esp_err_t ctl_batch_run(const char *body, size_t len, char **out, const char **error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CTL_BATCH_H */
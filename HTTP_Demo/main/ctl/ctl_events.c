@@ -0,0 +1,228 @@
+#include "ctl_events.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CTL_EVENTS_MASK     (CTL_EVENTS_SLOTS - 1)
+#define CTL_EVENT_BUSY      1u
+
+/* 函数名：ctl_events_sum
+ *
+ * 函数说明：事件校验和（FNV-1a，覆盖序号、长度与文本），用于发现被迟到的写入方弄脏的槽位。
+ * 参数：
+ *   seq  - 事件序号。
+ *   text - 事件文本。
+ *   len  - 文本长度。
+ * 返回值：
+ *   校验和。
+ */
+static uint32_t ctl_events_sum(uint32_t seq, const char *text, size_t len)
+{
+    uint32_t h = 2166136261u ^ seq;
+    h = (h ^ (uint32_t)len) * 16777619u;
+    for (size_t i = 0; i < len; i++) {
+        h = (h ^ (uint8_t)text[i]) * 16777619u;
+    }
+    return h;
+}
+
+/* 函数名：ctl_events_init
+ *
+ * 函数说明：清空事件环并设置纪元。须在任何写入或读取之前调用。
+ * 参数：
+ *   ring  - 事件环。
+ *   epoch - 本次开机的纪元（随机数）。
+ * 返回值：
+ *   无。
+ */
+void ctl_events_init(ctl_events_t *ring, uint32_t epoch)
+{
+    ring->epoch = epoch;
+    atomic_init(&ring->next, 0);
+    for (size_t i = 0; i < CTL_EVENTS_SLOTS; i++) {
+        atomic_init(&ring->slots[i].state, 0);
+        ring->slots[i].len = 0;
+    }
+}
+
+/* 函数名：ctl_events_push
+ *
+ * 函数说明：追加一条事件，覆盖最旧的一条；超过 CTL_EVENT_MAX 的部分截断。
+ *           领取序号后把槽位标为写入中，写完后发布；槽位期间被更新的事件接管时放弃，
+ *           读取方把该事件按丢失处理。
+ * 参数：
+ *   ring  - 事件环。
+ *   event - 事件文本。
+ *   len   - 文本长度。
+ * 返回值：
+ *   事件序号（从 1 开始）。
+ */
+uint32_t ctl_events_push(ctl_events_t *ring, const char *event, size_t len)
+{
+    uint32_t seq = (uint32_t)atomic_fetch_add_explicit(&ring->next, 1, memory_order_relaxed) + 1;
+    ctl_event_slot_t *slot = &ring->slots[seq & CTL_EVENTS_MASK];
+    const uint_fast32_t busy = (seq << 1) | CTL_EVENT_BUSY;
+    uint_fast32_t cur = atomic_load_explicit(&slot->state, memory_order_relaxed);
+
+    do {
+        if ((uint32_t)(cur >> 1) > seq) return seq;     /* a newer event already owns the slot */
+    } while (!atomic_compare_exchange_weak_explicit(&slot->state, &cur, busy, memory_order_relaxed,
+                                                    memory_order_relaxed));
+    atomic_thread_fence(memory_order_release);
+
+    if (len > CTL_EVENT_MAX) len = CTL_EVENT_MAX;
+    memcpy(slot->text, event, len);
+    slot->len = (uint16_t)len;
+    slot->sum = ctl_events_sum(seq, event, len);
+
+    cur = busy;
+    atomic_compare_exchange_strong_explicit(&slot->state, &cur, (uint_fast32_t)seq << 1, memory_order_release,
+                                            memory_order_relaxed);
+    return seq;
+}
+
+/* 函数名：ctl_events_last
+ *
+ * 函数说明：最近领取的事件序号（可能尚在写入）；还没有事件时为 0。
+ * 参数：
+ *   ring - 事件环。
+ * 返回值：
+ *   事件序号。
+ */
+uint32_t ctl_events_last(ctl_events_t *ring)
+{
+    return (uint32_t)atomic_load_explicit(&ring->next, memory_order_acquire);
+}
+
+/* 函数名：ctl_events_get
+ *
+ * 函数说明：按序号读取一条事件。复制前后核对槽位状态并校验内容，读取期间被覆盖或
+ *           内容不一致的按丢失处理。
+ * 参数：
+ *   ring - 事件环。
+ *   seq  - 事件序号。
+ *   out  - 输出：事件。
+ * 返回值：
+ *   ESP_OK 表示读到；ESP_ERR_NOT_FOUND 该事件尚未发布（稍后再读）；
+ *   ESP_ERR_INVALID_STATE 该事件已丢失（读取方落后超过 CTL_EVENTS_SLOTS 条，或写入被更新的事件取代）。
+ */
+esp_err_t ctl_events_get(ctl_events_t *ring, uint32_t seq, ctl_event_t *out)
+{
+    uint32_t last = ctl_events_last(ring);
+    if (seq == 0 || seq > last) return ESP_ERR_NOT_FOUND;
+    if (last - seq >= CTL_EVENTS_SLOTS) return ESP_ERR_INVALID_STATE;
+
+    ctl_event_slot_t *slot = &ring->slots[seq & CTL_EVENTS_MASK];
+    uint_fast32_t before = atomic_load_explicit(&slot->state, memory_order_acquire);
+    if ((uint32_t)(before >> 1) > seq) return ESP_ERR_INVALID_STATE;
+    if (before != (uint_fast32_t)seq << 1) return ESP_ERR_NOT_FOUND;   /* older event, or still being written */
+
+    size_t len = slot->len < CTL_EVENT_MAX ? slot->len : CTL_EVENT_MAX;
+    uint32_t sum = slot->sum;
+    memcpy(out->text, slot->text, len);
+    atomic_thread_fence(memory_order_acquire);
+    if (atomic_load_explicit(&slot->state, memory_order_relaxed) != before ||
+        ctl_events_sum(seq, out->text, len) != sum) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    out->seq = seq;
+    out->len = len;
+    return ESP_OK;
+}
+
+/* 函数名：ctl_events_format_id
+ *
+ * 函数说明：生成事件号“纪元-序号”（纪元为 8 位十六进制）。
+ * 参数：
+ *   ring - 事件环。
+ *   seq  - 事件序号。
+ *   buf  - 输出缓冲（至少 CTL_EVENT_ID_MAX 字节）。
+ *   cap  - 缓冲大小。
+ * 返回值：
+ *   事件号长度。
+ */
+size_t ctl_events_format_id(const ctl_events_t *ring, uint32_t seq, char *buf, size_t cap)
+{
+    int n = snprintf(buf, cap, "%08" PRIx32 "-%" PRIu32, ring->epoch, seq);
+    return n > 0 && (size_t)n < cap ? (size_t)n : 0;
+}
+
+/* 函数名：ctl_events_parse_id
+ *
+ * 函数说明：解析客户端带回的事件号（Last-Event-ID）。纪元不符（设备已重启）、
+ *           序号超前或格式错误时无效。
+ * 参数：
+ *   ring - 事件环。
+ *   id   - 事件号。
+ *   seq  - 输出：序号。
+ * 返回值：
+ *   true 有效，可从 seq + 1 续传。
+ */
+bool ctl_events_parse_id(ctl_events_t *ring, const char *id, uint32_t *seq)
+{
+    char *end;
+    if (strlen(id) < 10 || id[8] != '-') return false;
+    for (int i = 0; i < 8; i++) {
+        if (!((id[i] >= '0' && id[i] <= '9') || (id[i] >= 'a' && id[i] <= 'f'))) return false;
+    }
+    if (strtoul(id, NULL, 16) != ring->epoch) return false;
+    if (id[9] < '0' || id[9] > '9') return false;
+
+    unsigned long long v = strtoull(id + 9, &end, 10);
+    if (*end != '\0' || v > UINT32_MAX || (int32_t)((uint32_t)v - ctl_events_last(ring)) > 0) return false;
+    *seq = (uint32_t)v;
+    return true;
+}
+
+/* 函数名：ctl_events_to_sse
+ *
+ * 函数说明：把事件转为一条 SSE 消息：事件文本“* 名称 数据”中名称作为 event 字段，
+ *           其余作为 data 字段；数据中的换行拆为多行 data，消息以空行结束。
+ * 参数：
+ *   ring - 事件环（提供纪元）。
+ *   ev   - 事件。
+ *   buf  - 输出缓冲（CTL_EVENT_SSE_MAX 字节足够任何事件）。
+ *   cap  - 缓冲大小。
+ * 返回值：
+ *   消息长度；缓冲不足时为 0。
+ */
+size_t ctl_events_to_sse(const ctl_events_t *ring, const ctl_event_t *ev, char *buf, size_t cap)
+{
+    const char *p = ev->text;
+    const char *end = ev->text + ev->len;
+    char id[CTL_EVENT_ID_MAX];
+
+    if (end - p >= 2 && p[0] == '*' && p[1] == ' ') p += 2;
+    const char *name = p;
+    while (p < end && *p != ' ') p++;
+    int name_len = (int)(p - name);
+    if (p < end) p++;
+    if (name_len == 0) {
+        name = "message";
+        name_len = 7;
+    }
+
+    ctl_events_format_id(ring, ev->seq, id, sizeof(id));
+    int n = snprintf(buf, cap, "id: %s\nevent: %.*s\ndata: ", id, name_len, name);
+    if (n < 0 || (size_t)n >= cap) return 0;
+    size_t len = (size_t)n;
+
+    for (; p < end; p++) {
+        if (*p == '\r' || *p == '\n') {
+            if (*p == '\r' && p + 1 < end && p[1] == '\n') p++;
+            if (cap - len <= 7) return 0;
+            memcpy(buf + len, "\ndata: ", 7);
+            len += 7;
+        } else {
+            if (cap - len <= 1) return 0;
+            buf[len++] = *p;
+        }
+    }
+    if (cap - len <= 2) return 0;
+    buf[len++] = '\n';
+    buf[len++] = '\n';
+    buf[len] = '\0';
+    return len;
+}
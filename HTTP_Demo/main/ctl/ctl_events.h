@@ -0,0 +1,64 @@
+/*
+ * 设备状态事件环
+ *
+ * 保存最近 CTL_EVENTS_SLOTS 条状态变化通知（device_ctl 的“* led on”等），供
+ * GET /api/events 的 SSE 流按序号读取与断线续传。写入与读取都不加锁、不等待：写入方以
+ * 原子自增领取序号与槽位，以比较交换把槽位标为“写入中”，写完内容与校验和后发布序号；
+ * 槽位已被更新的事件占用时放弃写入（该事件按丢失处理）。读取方按序号核对槽位，复制
+ * 前后状态不变且校验和一致才算读到，被覆盖或被迟到的写入方弄脏的事件报告为丢失，
+ * 不会读出半条。序号在 2^31 以内（每秒一条也够用几十年）。
+ *
+ * 事件号为“纪元-序号”，纪元每次开机随机选取，旧纪元的 Last-Event-ID 不会被误认为有效。
+ */
+#ifndef CTL_EVENTS_H
+#define CTL_EVENTS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "esp_err.h"
+#include "ctl_frame.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CTL_EVENTS_SLOTS    16                      /* power of two */
+#define CTL_EVENT_MAX       (CTL_TEXT_MAX + 8)      /* "* text " and up to 255 bytes of text */
+#define CTL_EVENT_ID_MAX    20                      /* "xxxxxxxx-4294967295" */
+/* One SSE message: id and event lines, then every data byte may start a new "data: " line */
+#define CTL_EVENT_SSE_MAX   (CTL_EVENT_ID_MAX + 32 + 7 * CTL_EVENT_MAX)
+
+typedef struct {
+    atomic_uint_fast32_t state;     /* seq << 1, low bit set while being written */
+    uint32_t sum;                   /* checksum of seq, len and text */
+    uint16_t len;
+    char text[CTL_EVENT_MAX];
+} ctl_event_slot_t;
+
+typedef struct {
+    uint32_t epoch;
+    atomic_uint_fast32_t next;      /* last claimed sequence number */
+    ctl_event_slot_t slots[CTL_EVENTS_SLOTS];
+} ctl_events_t;
+
+typedef struct {
+    uint32_t seq;
+    size_t len;
+    char text[CTL_EVENT_MAX];
+} ctl_event_t;
+
+void ctl_events_init(ctl_events_t *ring, uint32_t epoch);
+uint32_t ctl_events_push(ctl_events_t *ring, const char *event, size_t len);
+uint32_t ctl_events_last(ctl_events_t *ring);
+esp_err_t ctl_events_get(ctl_events_t *ring, uint32_t seq, ctl_event_t *out);
+size_t ctl_events_format_id(const ctl_events_t *ring, uint32_t seq, char *buf, size_t cap);
+bool ctl_events_parse_id(ctl_events_t *ring, const char *id, uint32_t *seq);
+size_t ctl_events_to_sse(const ctl_events_t *ring, const ctl_event_t *ev, char *buf, size_t cap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CTL_EVENTS_H */
@@ -0,0 +1,157 @@
+#include "ctl_frame.h"
+#include <string.h>
+
+/* 函数名：ctl_frame_token
+ *
+ * 函数说明：取出下一个以空格分隔的词并原地以 NUL 结束，*p 移到其后。
+ * 参数：
+ *   p - 当前位置（输入输出）。
+ * 返回值：
+ *   词的起始地址；已到帧尾时为空串。
+ */
+static char *ctl_frame_token(char **p)
+{
+    char *start = *p;
+    char *end = start;
+    while (*end != '\0' && *end != ' ') end++;
+    if (*end == ' ') {
+        *end = '\0';
+        *p = end + 1;
+    } else {
+        *p = end;
+    }
+    return start;
+}
+
+/* 函数名：ctl_frame_u32
+ *
+ * 函数说明：解析十进制无符号数（不接受符号、空串与溢出）。
+ * 参数：
+ *   s   - 字符串。
+ *   out - 输出值。
+ * 返回值：
+ *   true 解析成功。
+ */
+static bool ctl_frame_u32(const char *s, uint32_t *out)
+{
+    uint64_t v = 0;
+    if (*s == '\0') return false;
+    for (; *s; s++) {
+        if (*s < '0' || *s > '9') return false;
+        v = v * 10 + (uint64_t)(*s - '0');
+        if (v > UINT32_MAX) return false;
+    }
+    *out = (uint32_t)v;
+    return true;
+}
+
+/* 函数名：ctl_frame_parse
+ *
+ * 函数说明：解析一条命令帧（格式见头文件）。帧缓冲至少要有 len + 1 字节：
+ *           解析时原地切分并以 NUL 结束，text 指向帧内。
+ * 参数：
+ *   frame - 帧内容（会被修改）。
+ *   len   - 帧长度。
+ *   cmd   - 输出命令；请求号无法解析时 id 为 0。
+ *   error - 失败时输出简短原因（用于应答）。
+ * 返回值：
+ *   ESP_OK 解析成功；ESP_ERR_INVALID_SIZE 帧或文本过长；ESP_ERR_INVALID_ARG 格式错误。
+ */
+esp_err_t ctl_frame_parse(char *frame, size_t len, ctl_cmd_t *cmd, const char **error)
+{
+    memset(cmd, 0, sizeof(*cmd));
+    *error = NULL;
+    if (len > CTL_FRAME_MAX) {
+        *error = "frame too long";
+        return ESP_ERR_INVALID_SIZE;
+    }
+    frame[len] = '\0';
+
+    char *p = frame;
+    if (!ctl_frame_u32(ctl_frame_token(&p), &cmd->id)) {
+        cmd->id = 0;
+        *error = "bad request id";
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const char *verb = ctl_frame_token(&p);
+    if (strcmp(verb, "text") == 0) {
+        if (strlen(p) > CTL_TEXT_MAX) {
+            *error = "text too long";
+            return ESP_ERR_INVALID_SIZE;
+        }
+        cmd->kind = CTL_CMD_TEXT;
+        cmd->text = p;
+        return ESP_OK;
+    }
+
+    if (strcmp(verb, "led") == 0) {
+        const char *action = ctl_frame_token(&p);
+        cmd->kind = CTL_CMD_LED;
+        if (strcmp(action, "on") == 0) {
+            cmd->led = CTL_LED_ON;
+        } else if (strcmp(action, "off") == 0) {
+            cmd->led = CTL_LED_OFF;
+        } else if (strcmp(action, "toggle") == 0) {
+            cmd->led = CTL_LED_TOGGLE;
+        } else {
+            *error = "bad led action";
+            return ESP_ERR_INVALID_ARG;
+        }
+    } else if (strcmp(verb, "gpio") == 0) {
+        uint32_t pin;
+        const char *level;
+        cmd->kind = CTL_CMD_GPIO;
+        if (!ctl_frame_u32(ctl_frame_token(&p), &pin) || pin > CTL_GPIO_MAX) {
+            *error = "bad pin";
+            return ESP_ERR_INVALID_ARG;
+        }
+        cmd->pin = (uint8_t)pin;
+        level = ctl_frame_token(&p);
+        if (strcmp(level, "high") == 0 || strcmp(level, "1") == 0) {
+            cmd->level = 1;
+        } else if (strcmp(level, "low") == 0 || strcmp(level, "0") == 0) {
+            cmd->level = 0;
+        } else {
+            *error = "bad level";
+            return ESP_ERR_INVALID_ARG;
+        }
+    } else if (strcmp(verb, "clear") == 0) {
+        cmd->kind = CTL_CMD_CLEAR;
+    } else if (strcmp(verb, "ping") == 0) {
+        cmd->kind = CTL_CMD_PING;
+    } else if (strcmp(verb, "stats") == 0) {
+        cmd->kind = CTL_CMD_STATS;
+    } else {
+        *error = "unknown command";
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (*p != '\0') {
+        *error = "unexpected argument";
+        return ESP_ERR_INVALID_ARG;
+    }
+    return ESP_OK;
+}
+
+/* 函数名：ctl_text_clip
+ *
+ * 函数说明：计算文本截到最多 max 字节后的长度；截断点落在多字节 UTF-8 字符中间时
+ *           退到该字符之前，避免通知中出现半个字符。
+ * 参数：
+ *   text - 文本（UTF-8，NUL 结尾）。
+ *   max  - 最大字节数。
+ * 返回值：
+ *   截断后的字节数。
+ */
+size_t ctl_text_clip(const char *text, size_t max)
+{
+    size_t n = strnlen(text, max + 1);
+    if (n <= max) return n;
+
+    n = max;
+    while (n > 0 && ((uint8_t)text[n] & 0xC0) == 0x80) {
+        n--;
+    }
+    return n;
+}
@@ -0,0 +1,68 @@
+/*
+ * 控制通道命令帧
+ *
+ * WebSocket 控制通道上每个文本帧是一条命令，格式为“请求号 命令 [参数]”，以空格分隔：
+ *   7 led on|off|toggle
+ *   8 gpio 4 high|low（也接受 1|0）
+ *   9 text 任意文本（到帧尾，可含空格）
+ *   10 clear
+ *   11 ping
+ *   12 stats
+ * 设备以同一请求号应答：“7 ok on”或“7 err 原因”；stats 应答为
+ * “12 ok 命令数 错误数 平均耗时us 最大耗时us”。状态变化以“* ”开头的通知帧推送给
+ * 所有客户端（“* led on”、“* gpio 4 high”、“* text ...”、“* clear”）。
+ * 请求号由客户端选择（十进制 uint32），用于在流水线发送时匹配应答。
+ *
+ * 本模块只解析，不执行命令；不分配内存，原地切分帧。
+ */
+#ifndef CTL_FRAME_H
+#define CTL_FRAME_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CTL_FRAME_MAX       320     /* request id, command and up to 255 bytes of UTF-8 text */
+#define CTL_TEXT_MAX        255
+#define CTL_GPIO_MAX        63
+
+typedef enum {
+    CTL_CMD_LED,
+    CTL_CMD_GPIO,
+    CTL_CMD_TEXT,
+    CTL_CMD_CLEAR,
+    CTL_CMD_PING,
+    CTL_CMD_STATS,
+} ctl_cmd_kind_t;
+
+typedef enum {
+    CTL_LED_OFF,
+    CTL_LED_ON,
+    CTL_LED_TOGGLE,
+} ctl_led_action_t;
+
+/* Parsed command; text points into the frame */
+typedef struct {
+    uint32_t id;
+    ctl_cmd_kind_t kind;
+    ctl_led_action_t led;
+    uint8_t pin;
+    uint8_t level;
+    const char *text;
+} ctl_cmd_t;
+
+esp_err_t ctl_frame_parse(char *frame, size_t len, ctl_cmd_t *cmd, const char **error);
+
+/* Length of text cut to at most max bytes without splitting a UTF-8 character */
+size_t ctl_text_clip(const char *text, size_t max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CTL_FRAME_H */
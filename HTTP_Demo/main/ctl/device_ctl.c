@@ -0,0 +1,251 @@
+#include "device_ctl.h"
+#include <stdio.h>
+#include <string.h>
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "driver/gpio.h"
+#include "pin_registry.h"
+#include "oled_integration.h"
+
+static const char *TAG = "device_ctl";
+
+/* GPIO definitions - adjust these to match your hardware */
+#define LED_PIN GPIO_NUM_2  /* GPIO2 - 使用内置LED或连接外部LED */
+
+static portMUX_TYPE ctl_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint64_t gpio_known = 0;     /* pins set through this layer (LED included) */
+static uint64_t gpio_levels = 0;    /* last level set on each known pin */
+
+static device_ctl_listener_t ctl_listeners[DEVICE_CTL_MAX_LISTENERS];
+static size_t ctl_listener_count = 0;
+
+/* 函数名：device_ctl_notify
+ *
+ * 函数说明：把一条状态变化通知依次交给所有监听者。
+ * 参数：
+ *   event - 通知文本。
+ *   len   - 通知长度。
+ * 返回值：
+ *   无。
+ */
+static void device_ctl_notify(const char *event, size_t len)
+{
+    for (size_t i = 0; i < ctl_listener_count; i++) {
+        ctl_listeners[i](event, len);
+    }
+}
+
+/* 函数名：device_ctl_apply
+ *
+ * 函数说明：在控制锁内更新电平记录并以一次置位、一次清零写入输出寄存器，
+ *           使 set 中的引脚同时置高、clear 中的引脚同时拉低。引脚须已配置为输出。
+ * 参数：
+ *   set    - 置高的引脚掩码。
+ *   clear  - 拉低的引脚掩码（与 set 不重叠）。
+ *   levels - 输出：写入后全部已知引脚的电平，可为 NULL。
+ * 返回值：
+ *   电平改变或首次设置的引脚掩码。
+ */
+static uint64_t device_ctl_apply(uint64_t set, uint64_t clear, uint64_t *levels)
+{
+    portENTER_CRITICAL(&ctl_lock);
+    uint64_t changed = ((set | clear) & ~gpio_known) | (set & ~gpio_levels) | (clear & gpio_levels);
+    gpio_known |= set | clear;
+    gpio_levels = (gpio_levels | set) & ~clear;
+    pin_reg_write(set, clear);
+    if (levels) *levels = gpio_levels;
+    portEXIT_CRITICAL(&ctl_lock);
+    return changed;
+}
+
+/* 函数名：device_ctl_notify_pins
+ *
+ * 函数说明：为每个改变的引脚发出通知：LED 引脚为“* led on|off”，其余为“* gpio N high|low”。
+ * 参数：
+ *   changed - 改变的引脚掩码。
+ *   levels  - 写入后的电平。
+ * 返回值：
+ *   无。
+ */
+static void device_ctl_notify_pins(uint64_t changed, uint64_t levels)
+{
+    while (changed) {
+        int pin = __builtin_ctzll(changed);
+        bool high = (levels >> pin) & 1;
+        changed &= changed - 1;
+        if (pin == LED_PIN) {
+            device_ctl_notify(high ? "* led on" : "* led off", high ? 8 : 9);
+        } else {
+            char event[24];
+            int len = snprintf(event, sizeof(event), "* gpio %d %s", pin, high ? "high" : "low");
+            device_ctl_notify(event, (size_t)len);
+        }
+    }
+}
+
+/* 函数名：device_ctl_init
+ *
+ * 函数说明：配置 LED 引脚为输出并熄灭。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   ESP_OK 表示成功，否则为 pin_reg_output 的错误码。
+ */
+esp_err_t device_ctl_init(void)
+{
+    esp_err_t ret = pin_reg_output(LED_PIN);
+    if (ret != ESP_OK) return ret;
+    device_ctl_apply(0, PIN_REG_BIT(LED_PIN), NULL);  /* LED off initially */
+    ESP_LOGI(TAG, "GPIO%d initialized for LED control", LED_PIN);
+    return ESP_OK;
+}
+
+/* 函数名：device_ctl_listen
+ *
+ * 函数说明：注册状态变化监听者。须在服务器启动前调用（列表不加锁）。
+ * 参数：
+ *   listener - 监听回调。
+ * 返回值：
+ *   ESP_OK 表示成功；ESP_ERR_NO_MEM 监听者已满。
+ */
+esp_err_t device_ctl_listen(device_ctl_listener_t listener)
+{
+    if (ctl_listener_count >= DEVICE_CTL_MAX_LISTENERS) return ESP_ERR_NO_MEM;
+    ctl_listeners[ctl_listener_count++] = listener;
+    return ESP_OK;
+}
+
+/* 函数名：device_ctl_led
+ *
+ * 函数说明：打开、关闭或翻转 LED；状态改变时发出“* led on|off”通知。
+ * 参数：
+ *   action - 操作。
+ * 返回值：
+ *   操作后的 LED 状态（true 为亮）。
+ */
+bool device_ctl_led(ctl_led_action_t action)
+{
+    const uint64_t bit = PIN_REG_BIT(LED_PIN);
+    bool on;
+    bool changed;
+
+    portENTER_CRITICAL(&ctl_lock);
+    bool was_on = (gpio_levels & bit) != 0;
+    on = action == CTL_LED_TOGGLE ? !was_on : action == CTL_LED_ON;
+    changed = on != was_on;
+    gpio_levels = on ? (gpio_levels | bit) : (gpio_levels & ~bit);
+    pin_reg_write(on ? bit : 0, on ? 0 : bit);
+    portEXIT_CRITICAL(&ctl_lock);
+
+    ESP_LOGD(TAG, "LED %s", on ? "ON" : "OFF");
+    if (changed) {
+        device_ctl_notify(on ? "* led on" : "* led off", on ? 8 : 9);
+    }
+    return on;
+}
+
+/* 函数名：device_ctl_led_state
+ *
+ * 函数说明：当前 LED 状态。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   true 为亮。
+ */
+bool device_ctl_led_state(void)
+{
+    uint64_t levels;
+    device_ctl_gpio_state(NULL, &levels);
+    return (levels >> LED_PIN) & 1;
+}
+
+/* 函数名：device_ctl_gpio_state
+ *
+ * 函数说明：读取经本层设置过的引脚（含 LED）及其当前电平。
+ * 参数：
+ *   known  - 输出：设置过的引脚掩码，可为 NULL。
+ *   levels - 输出：电平掩码（未设置过的引脚为 0），可为 NULL。
+ * 返回值：
+ *   无。
+ */
+void device_ctl_gpio_state(uint64_t *known, uint64_t *levels)
+{
+    portENTER_CRITICAL(&ctl_lock);
+    if (known) *known = gpio_known;
+    if (levels) *levels = gpio_levels;
+    portEXIT_CRITICAL(&ctl_lock);
+}
+
+/* 函数名：device_ctl_gpio
+ *
+ * 函数说明：设置单个引脚电平（首次使用时配置为输出）；电平改变或首次设置时发出通知。
+ * 参数：
+ *   pin   - 引脚号。
+ *   level - 电平（非 0 为高）。
+ * 返回值：
+ *   同 device_ctl_gpio_bulk。
+ */
+esp_err_t device_ctl_gpio(int pin, int level)
+{
+    if (pin < 0 || pin > CTL_GPIO_MAX) return ESP_ERR_INVALID_ARG;
+    uint64_t bit = PIN_REG_BIT(pin);
+    return device_ctl_gpio_bulk(level ? bit : 0, level ? 0 : bit, NULL);
+}
+
+/* 函数名：device_ctl_gpio_bulk
+ *
+ * 函数说明：一次设置多个引脚：set 中的引脚同时置高，clear 中的引脚紧接着同时拉低。
+ *           尚未配置的引脚先一并配置为输出；每个电平改变（或首次设置）的引脚发出一条通知，
+ *           LED 引脚的通知为“* led on|off”。
+ * 参数：
+ *   set    - 置高的引脚掩码。
+ *   clear  - 拉低的引脚掩码。
+ *   levels - 输出：写入后全部已知引脚的电平，可为 NULL。
+ * 返回值：
+ *   ESP_OK 表示成功；ESP_ERR_INVALID_ARG 掩码为空、两掩码重叠或含不能作输出的引脚；
+ *   其余为 gpio_config 的错误码。
+ */
+esp_err_t device_ctl_gpio_bulk(uint64_t set, uint64_t clear, uint64_t *levels)
+{
+    if (!(set | clear) || (set & clear)) return ESP_ERR_INVALID_ARG;
+    esp_err_t ret = pin_reg_output_mask(set | clear);
+    if (ret != ESP_OK) return ret;
+
+    uint64_t now;
+    uint64_t changed = device_ctl_apply(set, clear, &now);
+    ESP_LOGD(TAG, "GPIO set 0x%llx clear 0x%llx", (unsigned long long)set, (unsigned long long)clear);
+    device_ctl_notify_pins(changed, now);
+    if (levels) *levels = now;
+    return ESP_OK;
+}
+
+/* 函数名：device_ctl_text
+ *
+ * 函数说明：在 OLED 上显示自定义文本并发出“* text ...”通知（超过 CTL_TEXT_MAX 的部分不通知，
+ *           截断不会拆开多字节字符）。
+ * 参数：
+ *   text - 文本（UTF-8）。
+ * 返回值：
+ *   无。
+ */
+void device_ctl_text(const char *text)
+{
+    char event[CTL_FRAME_MAX];
+    oled_show_custom_text(text);
+    int len = snprintf(event, sizeof(event), "* text %.*s", (int)ctl_text_clip(text, CTL_TEXT_MAX), text);
+    device_ctl_notify(event, (size_t)len);
+}
+
+/* 函数名：device_ctl_clear
+ *
+ * 函数说明：清空 OLED 并发出“* clear”通知。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+void device_ctl_clear(void)
+{
+    oled_show_status("", "", "");
+    device_ctl_notify("* clear", 7);
+}
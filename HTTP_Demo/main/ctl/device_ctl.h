@@ -0,0 +1,42 @@
+/*
+ * 设备控制层：LED、GPIO 与 OLED 文本命令的统一执行入口
+ *
+ * HTTP 接口与 WebSocket 控制通道都经由这里改变设备状态，状态只在这里维护。
+ * 每次状态变化生成一条通知（格式同控制通道的通知帧，如“* led on”），同步分发给
+ * 已注册的监听者；监听者在调用方的任务中执行，应只做排队之类的轻量工作。
+ * GPIO 只在电平改变（或首次设置）时通知，重复设置同一电平不产生通知。
+ * 引脚经 pin_registry 在首次使用时配置为输出，电平经置位/清零寄存器写入。
+ */
+#ifndef DEVICE_CTL_H
+#define DEVICE_CTL_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "ctl_frame.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DEVICE_CTL_MAX_LISTENERS    4
+
+/* Receives each state-change notification; event is not NUL-terminated past len */
+typedef void (*device_ctl_listener_t)(const char *event, size_t len);
+
+esp_err_t device_ctl_init(void);
+esp_err_t device_ctl_listen(device_ctl_listener_t listener);
+bool device_ctl_led(ctl_led_action_t action);
+bool device_ctl_led_state(void);
+void device_ctl_gpio_state(uint64_t *known, uint64_t *levels);
+esp_err_t device_ctl_gpio(int pin, int level);
+esp_err_t device_ctl_gpio_bulk(uint64_t set, uint64_t clear, uint64_t *levels);
+void device_ctl_text(const char *text);
+void device_ctl_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEVICE_CTL_H */
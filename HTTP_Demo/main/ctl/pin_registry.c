@@ -0,0 +1,116 @@
+#include "pin_registry.h"
+#include "freertos/FreeRTOS.h"
+#include "driver/gpio.h"
+#include "soc/soc.h"
+#include "soc/gpio_reg.h"
+#include "soc/soc_caps.h"
+#include "oled_pins.h"
+
+/* Pins GPIO control must never drive: the ESP32 SPI flash (GPIO6~11), the UART0
+ * console (GPIO1 TX, GPIO3 RX) and the OLED panel bus */
+#define PIN_REG_FLASH_MASK      (0x3FULL << 6)
+#define PIN_REG_CONSOLE_MASK    (PIN_REG_BIT(1) | PIN_REG_BIT(3))
+#define PIN_REG_RESERVED_MASK   (PIN_REG_FLASH_MASK | PIN_REG_CONSOLE_MASK | OLED_PANEL_PIN_MASK)
+
+static portMUX_TYPE pin_reg_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/* Pins configured as outputs. Bits are only ever added, so a torn 64-bit
+ * read outside the lock can only miss a pin (and configure it again), never
+ * report one that is not configured. */
+static volatile uint64_t pin_reg_out = 0;
+
+/* 函数名：pin_reg_output_mask
+ *
+ * 函数说明：确保掩码中的引脚都已配置为输出。尚未配置的引脚以一次 gpio_config() 一并配置，
+ *           已配置的不再触碰。
+ * 参数：
+ *   mask - 引脚掩码。
+ * 返回值：
+ *   ESP_OK 表示成功；ESP_ERR_INVALID_ARG 掩码含不能作输出的引脚或保留引脚（闪存、串口控制台、
+ *   OLED 面板）；其余为 gpio_config 的错误码。
+ */
+esp_err_t pin_reg_output_mask(uint64_t mask)
+{
+    if (mask & (~(uint64_t)SOC_GPIO_VALID_OUTPUT_GPIO_MASK | PIN_REG_RESERVED_MASK)) return ESP_ERR_INVALID_ARG;
+
+    uint64_t todo = mask & ~pin_reg_out;
+    if (!todo) return ESP_OK;
+
+    gpio_config_t io_conf = {
+        .pin_bit_mask = todo,
+        .mode = GPIO_MODE_OUTPUT,
+        .pull_down_en = 0,
+        .pull_up_en = 0,
+        .intr_type = GPIO_INTR_DISABLE
+    };
+    esp_err_t ret = gpio_config(&io_conf);
+    if (ret != ESP_OK) return ret;
+
+    portENTER_CRITICAL(&pin_reg_lock);
+    pin_reg_out |= todo;
+    portEXIT_CRITICAL(&pin_reg_lock);
+    return ESP_OK;
+}
+
+/* 函数名：pin_reg_output
+ *
+ * 函数说明：确保单个引脚已配置为输出。
+ * 参数：
+ *   pin - 引脚号。
+ * 返回值：
+ *   同 pin_reg_output_mask。
+ */
+esp_err_t pin_reg_output(int pin)
+{
+    if (pin < 0 || pin >= 64) return ESP_ERR_INVALID_ARG;
+    return pin_reg_output_mask(PIN_REG_BIT(pin));
+}
+
+/* 函数名：pin_reg_is_output
+ *
+ * 函数说明：引脚是否已由登记表配置为输出。
+ * 参数：
+ *   pin - 引脚号。
+ * 返回值：
+ *   true 已配置。
+ */
+bool pin_reg_is_output(int pin)
+{
+    return pin >= 0 && pin < 64 && (pin_reg_outputs() & PIN_REG_BIT(pin));
+}
+
+/* 函数名：pin_reg_outputs
+ *
+ * 函数说明：已配置为输出的引脚掩码。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   引脚掩码。
+ */
+uint64_t pin_reg_outputs(void)
+{
+    portENTER_CRITICAL(&pin_reg_lock);
+    uint64_t out = pin_reg_out;
+    portEXIT_CRITICAL(&pin_reg_lock);
+    return out;
+}
+
+/* 函数名：pin_reg_write
+ *
+ * 函数说明：按掩码经置位/清零寄存器写输出电平，每组每个方向最多一次寄存器写入，
+ *           掩码为 0 的写入跳过。引脚须已配置（pin_reg_output_mask）。
+ * 参数：
+ *   set   - 置高的引脚掩码。
+ *   clear - 拉低的引脚掩码（与 set 不应重叠，重叠时最终为低）。
+ * 返回值：
+ *   无。
+ */
+void pin_reg_write(uint64_t set, uint64_t clear)
+{
+    if ((uint32_t)set) REG_WRITE(GPIO_OUT_W1TS_REG, (uint32_t)set);
+    if ((uint32_t)clear) REG_WRITE(GPIO_OUT_W1TC_REG, (uint32_t)clear);
+#if SOC_GPIO_PIN_COUNT > 32
+    if (set >> 32) REG_WRITE(GPIO_OUT1_W1TS_REG, (uint32_t)(set >> 32));
+    if (clear >> 32) REG_WRITE(GPIO_OUT1_W1TC_REG, (uint32_t)(clear >> 32));
+#endif
+}
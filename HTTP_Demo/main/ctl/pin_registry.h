@@ -0,0 +1,37 @@
+/*
+ * GPIO 引脚登记表
+ *
+ * 每个引脚只在第一次使用时以 gpio_config() 配置为推挽输出，之后登记在已配置掩码中，
+ * 再次使用直接跳过配置。输出经 GPIO 的 W1TS/W1TC（置位/清零）寄存器按掩码写入：
+ * 同一组（GPIO0~31 / GPIO32~）内要置高的引脚在同一次写入中同时变化，要拉低的引脚
+ * 在紧随其后的一次写入中同时变化。
+ *
+ * 闪存（GPIO6~11）、串口控制台（GPIO1/3）与 OLED 面板总线占用的引脚是保留引脚，
+ * 与不能输出的引脚一样被拒绝。
+ *
+ * 写寄存器不加锁：调用方须串行化（device_ctl 在其临界区内调用）。
+ */
+#ifndef PIN_REGISTRY_H
+#define PIN_REGISTRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PIN_REG_BIT(pin)    (1ULL << (pin))
+
+esp_err_t pin_reg_output(int pin);
+esp_err_t pin_reg_output_mask(uint64_t mask);
+bool pin_reg_is_output(int pin);
+uint64_t pin_reg_outputs(void);
+void pin_reg_write(uint64_t set, uint64_t clear);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PIN_REGISTRY_H */
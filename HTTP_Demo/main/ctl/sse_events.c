@@ -0,0 +1,255 @@
+#include "sse_events.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_random.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+#include "cJSON.h"
+#include "ctl_events.h"
+#include "device_ctl.h"
+
+static const char *TAG = "sse_events";
+
+#define SSE_ALL_CLIENTS     ((EventBits_t)((1u << SSE_EVENTS_MAX_CLIENTS) - 1))
+
+/* One connected stream; owned by its task */
+typedef struct {
+    httpd_req_t *req;
+    int slot;                   /* event group bit */
+    bool resume;                /* seq came from a valid Last-Event-ID */
+    uint32_t seq;               /* last event sent */
+    ctl_event_t event;
+    char msg[CTL_EVENT_SSE_MAX];
+} sse_client_t;
+
+static ctl_events_t sse_ring;
+static EventGroupHandle_t sse_wake = NULL;
+static portMUX_TYPE sse_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t sse_slots_used = 0;
+static bool sse_text_shown = false;     /* OLED shows text set through device_ctl */
+static char sse_text[CTL_TEXT_MAX + 1];
+
+/* 函数名：sse_events_listener
+ *
+ * 函数说明：device_ctl 状态变化监听者：写入事件环，记下当前 OLED 文本（供快照），
+ *           唤醒所有事件流任务。
+ * 参数：
+ *   event - 通知文本。
+ *   len   - 通知长度。
+ * 返回值：
+ *   无。
+ */
+static void sse_events_listener(const char *event, size_t len)
+{
+    if (len >= 7 && memcmp(event, "* text ", 7) == 0) {
+        size_t n = len - 7 < CTL_TEXT_MAX ? len - 7 : CTL_TEXT_MAX;
+        portENTER_CRITICAL(&sse_lock);
+        memcpy(sse_text, event + 7, n);
+        sse_text[n] = '\0';
+        sse_text_shown = true;
+        portEXIT_CRITICAL(&sse_lock);
+    } else if (len == 7 && memcmp(event, "* clear", 7) == 0) {
+        portENTER_CRITICAL(&sse_lock);
+        sse_text_shown = false;
+        portEXIT_CRITICAL(&sse_lock);
+    }
+
+    ctl_events_push(&sse_ring, event, len);
+    xEventGroupSetBits(sse_wake, SSE_ALL_CLIENTS);
+}
+
+/* 函数名：sse_events_init
+ *
+ * 函数说明：以随机纪元初始化事件环并注册 device_ctl 监听者。须在服务器启动前调用。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   ESP_OK 表示成功；ESP_ERR_NO_MEM 无法创建事件组或监听者已满。
+ */
+esp_err_t sse_events_init(void)
+{
+    ctl_events_init(&sse_ring, esp_random());
+    sse_wake = xEventGroupCreate();
+    if (!sse_wake) return ESP_ERR_NO_MEM;
+    return device_ctl_listen(sse_events_listener);
+}
+
+/* 函数名：sse_events_send_state
+ *
+ * 函数说明：发送当前状态快照（state 事件），事件号取最近的事件序号，之后从其下一条继续。
+ * 参数：
+ *   c - 客户端。
+ * 返回值：
+ *   ESP_OK 表示成功，否则为发送或内存错误。
+ */
+static esp_err_t sse_events_send_state(sse_client_t *c)
+{
+    char id[CTL_EVENT_ID_MAX];
+    char mask[20];
+    uint64_t known;
+    uint64_t levels;
+
+    c->seq = ctl_events_last(&sse_ring);
+    device_ctl_gpio_state(&known, &levels);
+
+    cJSON *root = cJSON_CreateObject();
+    if (!root) return ESP_ERR_NO_MEM;
+    cJSON_AddBoolToObject(root, "led", device_ctl_led_state());
+    snprintf(mask, sizeof(mask), "0x%llx", (unsigned long long)known);
+    cJSON_AddStringToObject(root, "known", mask);
+    snprintf(mask, sizeof(mask), "0x%llx", (unsigned long long)levels);
+    cJSON_AddStringToObject(root, "levels", mask);
+    portENTER_CRITICAL(&sse_lock);
+    bool shown = sse_text_shown;
+    memcpy(c->event.text, sse_text, sizeof(sse_text));
+    portEXIT_CRITICAL(&sse_lock);
+    if (shown) {
+        cJSON_AddStringToObject(root, "text", c->event.text);
+    } else {
+        cJSON_AddNullToObject(root, "text");
+    }
+    char *json = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    if (!json) return ESP_ERR_NO_MEM;
+
+    ctl_events_format_id(&sse_ring, c->seq, id, sizeof(id));
+    int n = snprintf(c->msg, sizeof(c->msg), "id: %s\nevent: state\ndata: %s\n\n", id, json);
+    free(json);
+    if (n < 0 || (size_t)n >= sizeof(c->msg)) return ESP_ERR_INVALID_SIZE;
+    return httpd_resp_send_chunk(c->req, c->msg, n);
+}
+
+/* 函数名：sse_events_release
+ *
+ * 函数说明：释放客户端的唤醒位与内存。
+ * 参数：
+ *   c - 客户端。
+ * 返回值：
+ *   无。
+ */
+static void sse_events_release(sse_client_t *c)
+{
+    portENTER_CRITICAL(&sse_lock);
+    sse_slots_used &= ~(1u << c->slot);
+    portEXIT_CRITICAL(&sse_lock);
+    free(c);
+}
+
+/* 函数名：sse_events_task
+ *
+ * 函数说明：事件流任务：先发快照（续传时跳过），之后按序发送事件环中的新事件；
+ *           落后过多丢失事件时重发快照，空闲时定期保活。客户端断开时退出。
+ * 参数：
+ *   arg - 客户端（sse_events_handler 分配）。
+ * 返回值：
+ *   无。
+ */
+static void sse_events_task(void *arg)
+{
+    sse_client_t *c = (sse_client_t *)arg;
+    const EventBits_t bit = (EventBits_t)1 << c->slot;
+    char retry[24];
+    int n = snprintf(retry, sizeof(retry), "retry: %d\n\n", SSE_EVENTS_RETRY_MS);
+
+    httpd_resp_set_hdr(c->req, "Access-Control-Allow-Origin", "*");
+    httpd_resp_set_hdr(c->req, "Cache-Control", "no-store");
+    httpd_resp_set_type(c->req, "text/event-stream");
+    ESP_LOGI(TAG, "Event stream client connected%s", c->resume ? " (resumed)" : "");
+
+    esp_err_t ret = httpd_resp_send_chunk(c->req, retry, n);
+    if (ret == ESP_OK && !c->resume) ret = sse_events_send_state(c);
+    while (ret == ESP_OK) {
+        esp_err_t got = ctl_events_get(&sse_ring, c->seq + 1, &c->event);
+        if (got == ESP_OK) {
+            size_t len = ctl_events_to_sse(&sse_ring, &c->event, c->msg, sizeof(c->msg));
+            c->seq = c->event.seq;
+            if (len) ret = httpd_resp_send_chunk(c->req, c->msg, (ssize_t)len);
+        } else if (got == ESP_ERR_INVALID_STATE) {
+            ESP_LOGW(TAG, "Event stream fell behind, resending state");
+            ret = sse_events_send_state(c);
+        } else if (!(xEventGroupWaitBits(sse_wake, bit, pdTRUE, pdFALSE, pdMS_TO_TICKS(SSE_EVENTS_KEEPALIVE_MS)) & bit)) {
+            ret = httpd_resp_send_chunk(c->req, ": keepalive\n\n", 13);
+        }
+    }
+    ESP_LOGI(TAG, "Event stream client disconnected");
+
+    httpd_req_async_handler_complete(c->req);
+    sse_events_release(c);
+    vTaskDelete(NULL);
+}
+
+/* 函数名：sse_events_claim_slot
+ *
+ * 函数说明：为新客户端分配一个唤醒位。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   位号；客户端已满时为 -1。
+ */
+static int sse_events_claim_slot(void)
+{
+    int slot = -1;
+    portENTER_CRITICAL(&sse_lock);
+    for (int i = 0; i < SSE_EVENTS_MAX_CLIENTS; i++) {
+        if (!(sse_slots_used & (1u << i))) {
+            sse_slots_used |= 1u << i;
+            slot = i;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&sse_lock);
+    return slot;
+}
+
+/* 函数名：sse_events_handler
+ *
+ * 函数说明：处理 /api/events GET。读取 Last-Event-ID（或 last_event_id 查询参数）决定
+ *           续传位置，把请求转为异步请求交给独立任务长期推送。
+ * 参数：
+ *   req - HTTP 请求上下文。
+ * 返回值：
+ *   ESP_OK 表示已转交；客户端已满时返回 503，无法创建任务时返回 500。
+ */
+esp_err_t sse_events_handler(httpd_req_t *req)
+{
+    char id[CTL_EVENT_ID_MAX + 4] = {0};
+    char query[48];
+
+    sse_client_t *c = calloc(1, sizeof(*c));
+    if (!c) {
+        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Out of memory");
+        return ESP_FAIL;
+    }
+    if (httpd_req_get_hdr_value_str(req, "Last-Event-ID", id, sizeof(id)) == ESP_OK ||
+        (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+         httpd_query_key_value(query, "last_event_id", id, sizeof(id)) == ESP_OK)) {
+        c->resume = ctl_events_parse_id(&sse_ring, id, &c->seq);
+    }
+
+    c->slot = sse_events_claim_slot();
+    if (c->slot < 0) {
+        free(c);
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+        httpd_resp_send(req, "Too many event streams", HTTPD_RESP_USE_STRLEN);
+        return ESP_OK;
+    }
+    /* Drop a wake-up left over from the slot's previous owner */
+    xEventGroupClearBits(sse_wake, (EventBits_t)1 << c->slot);
+
+    if (httpd_req_async_handler_begin(req, &c->req) != ESP_OK) {
+        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Cannot start stream");
+        sse_events_release(c);
+        return ESP_FAIL;
+    }
+    if (xTaskCreate(sse_events_task, "sse_events", 3072, c, 4, NULL) != pdPASS) {
+        httpd_resp_send_err(c->req, HTTPD_500_INTERNAL_SERVER_ERROR, "Cannot start stream");
+        httpd_req_async_handler_complete(c->req);
+        sse_events_release(c);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
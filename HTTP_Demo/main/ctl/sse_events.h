@@ -0,0 +1,33 @@
+/*
+ * 设备状态事件流（GET /api/events，Server-Sent Events）
+ *
+ * LED、GPIO 电平与 OLED 文本的每次变化（无论来自 HTTP、WebSocket 还是批量命令）写入
+ * 事件环（ctl_events.h），再推送给所有事件流客户端，面板无需轮询即可跟踪设备状态：
+ *   id: 1a2b3c4d-17
+ *   event: gpio
+ *   data: 4 high
+ * 新连接先收到一条 state 事件（当前状态的 JSON 快照），之后是逐条变化。带 Last-Event-ID
+ * 头（浏览器 EventSource 断线重连时自动携带）或 last_event_id 查询参数重连时，从该事件之后
+ * 续传；事件已被覆盖或设备已重启时改发快照。空闲时每 SSE_EVENTS_KEEPALIVE_MS 发送注释行保活。
+ */
+#ifndef SSE_EVENTS_H
+#define SSE_EVENTS_H
+
+#include <esp_http_server.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSE_EVENTS_MAX_CLIENTS      4
+#define SSE_EVENTS_KEEPALIVE_MS     15000
+#define SSE_EVENTS_RETRY_MS         3000    /* reconnect delay suggested to EventSource */
+
+esp_err_t sse_events_init(void);
+esp_err_t sse_events_handler(httpd_req_t *req);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSE_EVENTS_H */
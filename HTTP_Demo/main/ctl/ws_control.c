@@ -0,0 +1,317 @@
+#include "ws_control.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "ctl_frame.h"
+#include "device_ctl.h"
+
+static const char *TAG = "ws_control";
+
+#if CONFIG_HTTPD_WS_SUPPORT
+
+#define WS_REPLY_MAX    96
+
+/* Notification queued to one server's task */
+typedef struct {
+    httpd_handle_t server;
+    size_t len;
+    char data[];
+} ws_control_msg_t;
+
+static httpd_handle_t ws_servers[WS_CONTROL_MAX_SERVERS];   /* guarded by ws_servers_mutex */
+static SemaphoreHandle_t ws_servers_mutex = NULL;            /* held across httpd_queue_work() */
+static portMUX_TYPE ws_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t ws_commands = 0;
+static uint32_t ws_errors = 0;
+static uint64_t ws_total_us = 0;
+static uint32_t ws_max_us = 0;
+
+/* 函数名：ws_control_record
+ *
+ * 函数说明：记录一条命令的处理耗时（两个服务器任务都会调用）。
+ * 参数：
+ *   us - 耗时（微秒）。
+ *   ok - 是否以 ok 应答。
+ * 返回值：
+ *   无。
+ */
+static void ws_control_record(uint32_t us, bool ok)
+{
+    portENTER_CRITICAL(&ws_lock);
+    ws_commands++;
+    if (!ok) ws_errors++;
+    ws_total_us += us;
+    if (us > ws_max_us) ws_max_us = us;
+    portEXIT_CRITICAL(&ws_lock);
+}
+
+/* 函数名：ws_control_get_stats
+ *
+ * 函数说明：读取命令处理统计。
+ * 参数：
+ *   out - 输出统计。
+ * 返回值：
+ *   无。
+ */
+void ws_control_get_stats(ws_control_stats_t *out)
+{
+    portENTER_CRITICAL(&ws_lock);
+    out->commands = ws_commands;
+    out->errors = ws_errors;
+    out->avg_us = ws_commands ? (uint32_t)(ws_total_us / ws_commands) : 0;
+    out->max_us = ws_max_us;
+    portEXIT_CRITICAL(&ws_lock);
+}
+
+/* 函数名：ws_control_execute
+ *
+ * 函数说明：经设备控制层执行一条已解析的命令，生成应答帧。
+ * 参数：
+ *   cmd   - 命令。
+ *   reply - 应答缓冲。
+ *   cap   - 缓冲大小。
+ *   ok    - 输出命令是否执行成功；失败时应答为“id err 原因”。
+ * 返回值：
+ *   应答长度。
+ */
+static int ws_control_execute(const ctl_cmd_t *cmd, char *reply, size_t cap, bool *ok)
+{
+    unsigned long id = (unsigned long)cmd->id;
+    ws_control_stats_t stats;
+
+    *ok = true;
+    switch (cmd->kind) {
+        case CTL_CMD_LED:
+            return snprintf(reply, cap, "%lu ok %s", id, device_ctl_led(cmd->led) ? "on" : "off");
+        case CTL_CMD_GPIO:
+            if (device_ctl_gpio(cmd->pin, cmd->level) != ESP_OK) {
+                *ok = false;
+                return snprintf(reply, cap, "%lu err bad pin", id);
+            }
+            return snprintf(reply, cap, "%lu ok %u %s", id, (unsigned)cmd->pin, cmd->level ? "high" : "low");
+        case CTL_CMD_TEXT:
+            device_ctl_text(cmd->text);
+            return snprintf(reply, cap, "%lu ok", id);
+        case CTL_CMD_CLEAR:
+            device_ctl_clear();
+            return snprintf(reply, cap, "%lu ok", id);
+        case CTL_CMD_PING:
+            return snprintf(reply, cap, "%lu ok pong", id);
+        case CTL_CMD_STATS:
+        default:
+            ws_control_get_stats(&stats);
+            return snprintf(reply, cap, "%lu ok %lu %lu %lu %lu", id, (unsigned long)stats.commands,
+                            (unsigned long)stats.errors, (unsigned long)stats.avg_us, (unsigned long)stats.max_us);
+    }
+}
+
+/* 函数名：ws_control_handler
+ *
+ * 函数说明：/api/ws 处理函数。握手请求只记录连接；此后每个文本帧是一条命令，解析、
+ *           执行后在同一连接上应答。超过 CTL_FRAME_MAX 的帧关闭连接，其他类型的帧忽略。
+ * 参数：
+ *   req - HTTP 请求上下文。
+ * 返回值：
+ *   ESP_OK 继续保持连接；其余值使服务器关闭该连接。
+ */
+static esp_err_t ws_control_handler(httpd_req_t *req)
+{
+    if (req->method == HTTP_GET) {
+        ESP_LOGI(TAG, "client %d connected", httpd_req_to_sockfd(req));
+        return ESP_OK;
+    }
+
+    char buf[CTL_FRAME_MAX + 1];
+    httpd_ws_frame_t frame = {0};
+    esp_err_t ret = httpd_ws_recv_frame(req, &frame, 0);
+    if (ret != ESP_OK) return ret;
+    if (frame.len > CTL_FRAME_MAX) {
+        ESP_LOGW(TAG, "client %d: %u byte frame, closing", httpd_req_to_sockfd(req), (unsigned)frame.len);
+        return ESP_FAIL;
+    }
+    frame.payload = (uint8_t *)buf;
+    ret = httpd_ws_recv_frame(req, &frame, frame.len);
+    if (ret != ESP_OK || frame.type != HTTPD_WS_TYPE_TEXT) return ret;
+
+    int64_t t0 = esp_timer_get_time();
+    char reply[WS_REPLY_MAX];
+    int len;
+    bool ok = false;
+    ctl_cmd_t cmd;
+    const char *error;
+    if (ctl_frame_parse(buf, frame.len, &cmd, &error) == ESP_OK) {
+        len = ws_control_execute(&cmd, reply, sizeof(reply), &ok);
+    } else {
+        len = snprintf(reply, sizeof(reply), "%lu err %s", (unsigned long)cmd.id, error);
+    }
+    if (len >= (int)sizeof(reply)) len = sizeof(reply) - 1;
+
+    httpd_ws_frame_t out = {
+        .final = true,
+        .type = HTTPD_WS_TYPE_TEXT,
+        .payload = (uint8_t *)reply,
+        .len = (size_t)len,
+    };
+    ret = httpd_ws_send_frame(req, &out);
+    ws_control_record((uint32_t)(esp_timer_get_time() - t0), ok);
+    return ret;
+}
+
+/* 函数名：ws_control_broadcast_work
+ *
+ * 函数说明：在服务器任务中把一条通知发给该服务器上的所有 WebSocket 客户端，然后释放消息。
+ * 参数：
+ *   arg - ws_control_msg_t。
+ * 返回值：
+ *   无。
+ */
+static void ws_control_broadcast_work(void *arg)
+{
+    ws_control_msg_t *msg = (ws_control_msg_t *)arg;
+    int fds[CONFIG_LWIP_MAX_SOCKETS];
+    size_t count = sizeof(fds) / sizeof(fds[0]);
+
+    if (httpd_get_client_list(msg->server, &count, fds) == ESP_OK) {
+        httpd_ws_frame_t frame = {
+            .final = true,
+            .type = HTTPD_WS_TYPE_TEXT,
+            .payload = (uint8_t *)msg->data,
+            .len = msg->len,
+        };
+        for (size_t i = 0; i < count; i++) {
+            if (httpd_ws_get_fd_info(msg->server, fds[i]) == HTTPD_WS_CLIENT_WEBSOCKET) {
+                httpd_ws_send_frame_async(msg->server, fds[i], &frame);
+            }
+        }
+    }
+    free(msg);
+}
+
+/* 函数名：ws_control_broadcast
+ *
+ * 函数说明：设备状态变化监听者：为每个已注册的服务器复制一份通知并排入其任务队列，
+ *           不在调用方任务中做网络发送。排队期间持有 ws_servers_mutex，
+ *           ws_control_unregister() 返回后不会再向该服务器排队。
+ * 参数：
+ *   event - 通知文本。
+ *   len   - 通知长度。
+ * 返回值：
+ *   无。
+ */
+static void ws_control_broadcast(const char *event, size_t len)
+{
+    xSemaphoreTake(ws_servers_mutex, portMAX_DELAY);
+    for (size_t i = 0; i < WS_CONTROL_MAX_SERVERS; i++) {
+        httpd_handle_t server = ws_servers[i];
+        if (!server) continue;
+        ws_control_msg_t *msg = (ws_control_msg_t *)malloc(sizeof(*msg) + len);
+        if (!msg) continue;
+        msg->server = server;
+        msg->len = len;
+        memcpy(msg->data, event, len);
+        if (httpd_queue_work(server, ws_control_broadcast_work, msg) != ESP_OK) {
+            free(msg);
+        }
+    }
+    xSemaphoreGive(ws_servers_mutex);
+}
+
+/* 函数名：ws_control_init
+ *
+ * 函数说明：创建服务器登记表的互斥锁，并把广播注册为设备状态变化监听者。
+ *           须在服务器启动前调用一次。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   ESP_OK 表示成功；ESP_ERR_NO_MEM 无法创建互斥锁；否则为 device_ctl_listen 的错误码。
+ */
+esp_err_t ws_control_init(void)
+{
+    ws_servers_mutex = xSemaphoreCreateMutex();
+    if (ws_servers_mutex == NULL) return ESP_ERR_NO_MEM;
+    return device_ctl_listen(ws_control_broadcast);
+}
+
+/* 函数名：ws_control_register
+ *
+ * 函数说明：在服务器上注册 /api/ws 端点，并记录该服务器用于广播。
+ * 参数：
+ *   server - 服务器句柄。
+ * 返回值：
+ *   ESP_OK 表示成功；ESP_ERR_INVALID_STATE 未调用 ws_control_init；ESP_ERR_NO_MEM 服务器已满；
+ *   其余为注册失败的错误码。
+ */
+esp_err_t ws_control_register(httpd_handle_t server)
+{
+    static const httpd_uri_t ws_uri = {
+        .uri = WS_CONTROL_URI,
+        .method = HTTP_GET,
+        .handler = ws_control_handler,
+        .is_websocket = true,
+    };
+    if (ws_servers_mutex == NULL) return ESP_ERR_INVALID_STATE;
+
+    esp_err_t ret = ESP_ERR_NO_MEM;
+    xSemaphoreTake(ws_servers_mutex, portMAX_DELAY);
+    for (size_t i = 0; i < WS_CONTROL_MAX_SERVERS; i++) {
+        if (!ws_servers[i]) {
+            ret = httpd_register_uri_handler(server, &ws_uri);
+            if (ret == ESP_OK) ws_servers[i] = server;
+            break;
+        }
+    }
+    xSemaphoreGive(ws_servers_mutex);
+    return ret;
+}
+
+/* 函数名：ws_control_unregister
+ *
+ * 函数说明：服务器停止前调用，不再向其广播。等待进行中的广播排队完成后返回，
+ *           之后才可停止服务器。
+ * 参数：
+ *   server - 服务器句柄。
+ * 返回值：
+ *   无。
+ */
+void ws_control_unregister(httpd_handle_t server)
+{
+    if (ws_servers_mutex == NULL) return;
+
+    xSemaphoreTake(ws_servers_mutex, portMAX_DELAY);
+    for (size_t i = 0; i < WS_CONTROL_MAX_SERVERS; i++) {
+        if (ws_servers[i] == server) ws_servers[i] = NULL;
+    }
+    xSemaphoreGive(ws_servers_mutex);
+}
+
+#else /* !CONFIG_HTTPD_WS_SUPPORT */
+
+/* WebSocket support is off: the endpoint is not registered, stats stay zero */
+
+esp_err_t ws_control_init(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t ws_control_register(httpd_handle_t server)
+{
+    (void)server;
+    ESP_LOGW(TAG, "CONFIG_HTTPD_WS_SUPPORT is off, %s not available", WS_CONTROL_URI);
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+void ws_control_unregister(httpd_handle_t server)
+{
+    (void)server;
+}
+
+void ws_control_get_stats(ws_control_stats_t *out)
+{
+    memset(out, 0, sizeof(*out));
+}
+
+#endif /* CONFIG_HTTPD_WS_SUPPORT */
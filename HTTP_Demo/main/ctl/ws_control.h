@@ -0,0 +1,42 @@
+/*
+ * WebSocket 控制通道（/api/ws）
+ *
+ * 在已有的 HTTP 与 HTTPS 服务器上各注册一个 WebSocket 端点。客户端保持一条连接，
+ * 以文本帧发送命令（格式见 ctl_frame.h），设备同步执行并以同一请求号应答；
+ * 省去每个命令的 TCP/TLS 握手与 HTTP 头解析。设备状态变化（无论来自哪个通道）
+ * 以通知帧异步推送给两个服务器上的所有 WebSocket 客户端。
+ *
+ * 需要 CONFIG_HTTPD_WS_SUPPORT；未开启时注册返回 ESP_ERR_NOT_SUPPORTED。
+ */
+#ifndef WS_CONTROL_H
+#define WS_CONTROL_H
+
+#include <stdint.h>
+#include <esp_http_server.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WS_CONTROL_URI          "/api/ws"
+#define WS_CONTROL_MAX_SERVERS  2       /* HTTP and HTTPS */
+
+/* Command handling time, measured from frame received to reply sent */
+typedef struct {
+    uint32_t commands;
+    uint32_t errors;        /* frames answered with "err" */
+    uint32_t avg_us;
+    uint32_t max_us;
+} ws_control_stats_t;
+
+esp_err_t ws_control_init(void);
+esp_err_t ws_control_register(httpd_handle_t server);
+/* Must return before the server is stopped: no notification is queued to it afterwards */
+void ws_control_unregister(httpd_handle_t server);
+void ws_control_get_stats(ws_control_stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WS_CONTROL_H */
@@ -0,0 +1,120 @@
+#include "http_route.h"
+#include "esp_log.h"
+
+static const char *TAG = "http_route";
+
+#define HTTP_ROUTE_METHODS  (HTTP_ROUTE_GET | HTTP_ROUTE_POST)
+
+const http_route_hdrs_t http_route_json = { "application/json", true };
+const http_route_hdrs_t http_route_html = { "text/html", true };
+const http_route_hdrs_t http_route_cors = { NULL, true };
+const http_route_hdrs_t http_route_raw = { NULL, false };
+
+/* Access-Control-Allow-Methods / Allow values, indexed by method mask */
+static const char *const http_route_allow[HTTP_ROUTE_METHODS + 1] = {
+    "OPTIONS",
+    "GET, OPTIONS",
+    "POST, OPTIONS",
+    "GET, POST, OPTIONS",
+};
+
+/* 函数名：http_route_set_cors
+ *
+ * 函数说明：写入 CORS 响应头（值均为静态字符串，不复制）。
+ * 参数：
+ *   req   - HTTP 请求上下文。
+ *   route - 路由。
+ * 返回值：
+ *   无。
+ */
+static void http_route_set_cors(httpd_req_t *req, const http_route_t *route)
+{
+    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+    httpd_resp_set_hdr(req, "Access-Control-Allow-Methods", http_route_allow[route->methods & HTTP_ROUTE_METHODS]);
+    httpd_resp_set_hdr(req, "Access-Control-Allow-Headers", "Content-Type");
+}
+
+/* 函数名：http_route_dispatch
+ *
+ * 函数说明：所有路由共用的处理函数：OPTIONS 预检返回 204，方法不允许时返回 405，
+ *           否则按路由的响应头集合写入 CORS 头与内容类型后调用路由的处理函数。
+ *           HTTP_ROUTE_ANY 路由跳过预检与方法检查。
+ * 参数：
+ *   req - HTTP 请求上下文，user_ctx 指向路由。
+ * 返回值：
+ *   处理函数的返回值；预检与 405 返回 ESP_OK。
+ */
+static esp_err_t http_route_dispatch(httpd_req_t *req)
+{
+    const http_route_t *route = (const http_route_t *)req->user_ctx;
+    unsigned bit = req->method == HTTP_GET ? HTTP_ROUTE_GET : req->method == HTTP_POST ? HTTP_ROUTE_POST : 0;
+
+    bool any = route->methods & HTTP_ROUTE_ANY;
+
+    if (req->method == HTTP_OPTIONS && !any) {
+        http_route_set_cors(req, route);
+        httpd_resp_set_status(req, "204 No Content");
+        return httpd_resp_send(req, NULL, 0);
+    }
+    if (!(route->methods & bit) && !any) {
+        http_route_set_cors(req, route);
+        httpd_resp_set_hdr(req, "Allow", http_route_allow[route->methods & HTTP_ROUTE_METHODS]);
+        httpd_resp_set_status(req, "405 Method Not Allowed");
+        httpd_resp_set_type(req, "application/json");
+        httpd_resp_send(req, "{\"status\":\"error\",\"message\":\"Method not allowed\"}", HTTPD_RESP_USE_STRLEN);
+        return ESP_OK;
+    }
+
+    if (route->hdrs->cors) {
+        http_route_set_cors(req, route);
+    }
+    if (route->hdrs->content_type) {
+        httpd_resp_set_type(req, route->hdrs->content_type);
+    }
+    return route->handler(req);
+}
+
+/* 函数名：http_route_config
+ *
+ * 函数说明：按路由数设置服务器的处理器容量，并启用通配符 URI 匹配。
+ * 参数：
+ *   config   - 服务器配置。
+ *   handlers - 需要注册的处理器总数（路由表加上另行注册的端点）。
+ * 返回值：
+ *   无。
+ */
+void http_route_config(httpd_config_t *config, size_t handlers)
+{
+    config->max_uri_handlers = handlers;
+    config->uri_match_fn = httpd_uri_match_wildcard;
+}
+
+/* 函数名：http_route_register
+ *
+ * 函数说明：把路由表按顺序注册到服务器，每条路由一个 HTTP_ANY 处理器。匹配按注册顺序
+ *           进行，通配的路由应放在表尾。
+ * 参数：
+ *   server - 服务器句柄。
+ *   routes - 路由表（须在服务器生命周期内有效）。
+ *   count  - 路由数。
+ * 返回值：
+ *   ESP_OK 表示全部注册成功，否则为第一个失败的错误码（其余路由照常注册）。
+ */
+esp_err_t http_route_register(httpd_handle_t server, const http_route_t *routes, size_t count)
+{
+    esp_err_t first_err = ESP_OK;
+    for (size_t i = 0; i < count; i++) {
+        const httpd_uri_t uri = {
+            .uri = routes[i].uri,
+            .method = HTTP_ANY,
+            .handler = http_route_dispatch,
+            .user_ctx = (void *)&routes[i],
+        };
+        esp_err_t ret = httpd_register_uri_handler(server, &uri);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "cannot register %s: %s", routes[i].uri, esp_err_to_name(ret));
+            if (first_err == ESP_OK) first_err = ret;
+        }
+    }
+    return first_err;
+}
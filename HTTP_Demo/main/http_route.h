@@ -0,0 +1,51 @@
+/*
+ * HTTP 路由表
+ *
+ * 每个端点在常量路由表中占一行：URI（可用 httpd_uri_match_wildcard 的 '*' / '?' 结尾）、
+ * 允许的方法掩码、响应头集合与处理函数。每条路由只以 HTTP_ANY 注册一次，由公共分发函数
+ * 统一完成：写入预先生成的 CORS 头与内容类型，应答 OPTIONS 预检（204），方法不在掩码中时
+ * 返回 405，其余交给处理函数。掩码含 HTTP_ROUTE_ANY 的路由（如 404 兜底）不做预检与 405，
+ * 任何方法都交给处理函数。HTTP 与 HTTPS 服务器共用同一张表与同一注册入口。
+ */
+#ifndef HTTP_ROUTE_H
+#define HTTP_ROUTE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <esp_http_server.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HTTP_ROUTE_GET      (1u << 0)
+#define HTTP_ROUTE_POST     (1u << 1)
+#define HTTP_ROUTE_ANY      (1u << 7)   /* every method, OPTIONS included, goes to the handler */
+
+/* Response headers the dispatcher writes before calling the handler */
+typedef struct {
+    const char *content_type;   /* NULL: set by the handler */
+    bool cors;                  /* false: the handler writes every header itself */
+} http_route_hdrs_t;
+
+extern const http_route_hdrs_t http_route_json;    /* CORS + application/json */
+extern const http_route_hdrs_t http_route_html;    /* CORS + text/html */
+extern const http_route_hdrs_t http_route_cors;    /* CORS, content type chosen by the handler */
+extern const http_route_hdrs_t http_route_raw;     /* nothing, e.g. requests handed to another task */
+
+typedef struct {
+    const char *uri;
+    uint8_t methods;                    /* HTTP_ROUTE_* mask; OPTIONS is always answered */
+    const http_route_hdrs_t *hdrs;
+    esp_err_t (*handler)(httpd_req_t *req);
+} http_route_t;
+
+void http_route_config(httpd_config_t *config, size_t handlers);
+esp_err_t http_route_register(httpd_handle_t server, const http_route_t *routes, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HTTP_ROUTE_H */
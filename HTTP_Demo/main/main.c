@@ -24,10 +24,18 @@
 #include "esp_http_client.h"
 #include "esp_crt_bundle.h"
 #include "cJSON.h"
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
-#include "driver/gpio.h"
+#include <errno.h>
 
 #include "oled_integration.h"
+#include "oled_anims.h"
+#include "device_ctl.h"
+#include "ws_control.h"
+#include "http_route.h"
+#include "ctl_batch.h"
+#include "sse_events.h"
 
 /* A simple example that demonstrates how to create GET and POST
  * handlers and start an HTTPS server.
@@ -36,8 +44,9 @@
 static const char *TAG = "example";
 const char *FETCH_URL = "https://api.chucknorris.io/jokes/random";
 
-/* GPIO definitions - adjust these to match your hardware */
-#define LED_PIN GPIO_NUM_2  /* GPIO2 - 使用内置LED或连接外部LED */
+/* OLED mirror endpoints */
+#define OLED_PBM_MAX_WIDTH        256    /* frame columns are addressed with a u8 */
+#define OLED_STREAM_KEEPALIVE_MS  10000  /* empty update sent when the screen is idle */
 
 typedef struct {
     char *buf;
@@ -45,8 +54,6 @@ typedef struct {
     size_t cap;
 } http_buf_t;
 
-static bool led_state = false;  /* 追踪LED状态 */
-
 /* 函数名：http_event_handler
  *
  * 函数说明：HTTP 客户端事件回调，收集响应体到用户缓冲区。
@@ -172,7 +179,7 @@ static void event_handler(void* arg, esp_event_base_t event_base,
 /* An HTTP GET handler */
 /* 函数名：root_get_handler
  *
- * 函数说明：处理根路径 GET 请求，返回示例 HTML 并添加 CORS 头。
+ * 函数说明：处理根路径 GET 请求，返回示例 HTML（CORS 头与内容类型由路由分发写入）。
  * 参数：
  *   req - HTTP 请求上下文。
  * 返回值：
@@ -180,36 +187,11 @@ static void event_handler(void* arg, esp_event_base_t event_base,
  */
 static esp_err_t root_get_handler(httpd_req_t *req)
 {
-    /* Add CORS headers */
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Methods", "GET, POST, PUT, DELETE, OPTIONS");
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Headers", "Content-Type");
-    
-    httpd_resp_set_type(req, "text/html");
     httpd_resp_send(req, "<h1>Hello Secure World!</h1>", HTTPD_RESP_USE_STRLEN);
 
     return ESP_OK;
 }
 
-/* OPTIONS handler for CORS preflight */
-/* 函数名：options_handler
- *
- * 函数说明：通用 OPTIONS 预检响应，写入 CORS 头并返回 204。
- * 参数：
- *   req - HTTP 请求上下文。
- * 返回值：
- *   ESP_OK 表示处理成功。
- */
-static esp_err_t options_handler(httpd_req_t *req)
-{
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Methods", "GET, POST, PUT, DELETE, OPTIONS");
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Headers", "Content-Type");
-    httpd_resp_set_status(req, "204 No Content");
-    httpd_resp_send(req, NULL, 0);
-    return ESP_OK;
-}
-
 /* LED control handler */
 /* 函数名：led_handler
  *
@@ -221,33 +203,22 @@ static esp_err_t options_handler(httpd_req_t *req)
  */
 static esp_err_t led_handler(httpd_req_t *req)
 {
-    /* Add CORS headers */
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Methods", "GET, POST, PUT, DELETE, OPTIONS");
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Headers", "Content-Type");
-    
     char query[128];
     char action[16] = {0};
     
     if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
         if (httpd_query_key_value(query, "action", action, sizeof(action)) == ESP_OK) {
             if (strcmp(action, "on") == 0) {
-                led_state = true;
-                gpio_set_level(LED_PIN, 1);
+                device_ctl_led(CTL_LED_ON);
                 ESP_LOGI(TAG, "LED ON");
-                httpd_resp_set_type(req, "application/json");
                 httpd_resp_send(req, "{\"status\":\"ok\",\"action\":\"LED ON\"}", HTTPD_RESP_USE_STRLEN);
             } else if (strcmp(action, "off") == 0) {
-                led_state = false;
-                gpio_set_level(LED_PIN, 0);
+                device_ctl_led(CTL_LED_OFF);
                 ESP_LOGI(TAG, "LED OFF");
-                httpd_resp_set_type(req, "application/json");
                 httpd_resp_send(req, "{\"status\":\"ok\",\"action\":\"LED OFF\"}", HTTPD_RESP_USE_STRLEN);
             } else if (strcmp(action, "toggle") == 0) {
-                led_state = !led_state;
-                gpio_set_level(LED_PIN, led_state ? 1 : 0);
+                bool led_state = device_ctl_led(CTL_LED_TOGGLE);
                 ESP_LOGI(TAG, "LED TOGGLE -> %s", led_state ? "ON" : "OFF");
-                httpd_resp_set_type(req, "application/json");
                 char response[100];
                 snprintf(response, sizeof(response), "{\"status\":\"ok\",\"action\":\"LED %s\"}", led_state ? "ON" : "OFF");
                 httpd_resp_send(req, response, HTTPD_RESP_USE_STRLEN);
@@ -271,15 +242,10 @@ static esp_err_t led_handler(httpd_req_t *req)
  * 参数：
  *   req - HTTP 请求上下文。
  * 返回值：
- *   ESP_OK 表示处理成功，缺参时返回 400。
+ *   ESP_OK 表示处理成功，缺参或引脚不能作输出时返回 400。
  */
 static esp_err_t gpio_handler(httpd_req_t *req)
 {
-    /* Add CORS headers */
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Methods", "GET, POST, PUT, DELETE, OPTIONS");
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Headers", "Content-Type");
-    
     char query[128];
     char pin_str[8] = {0};
     char level[8] = {0};
@@ -291,20 +257,14 @@ static esp_err_t gpio_handler(httpd_req_t *req)
             int pin = atoi(pin_str);
             int level_val = strcmp(level, "high") == 0 ? 1 : 0;
             
-            /* Setup GPIO */
-            gpio_config_t io_conf = {
-                .pin_bit_mask = (1ULL << pin),
-                .mode = GPIO_MODE_OUTPUT,
-                .pull_down_en = 0,
-                .pull_up_en = 0,
-                .intr_type = GPIO_INTR_DISABLE
-            };
-            gpio_config(&io_conf);
-            gpio_set_level(pin, level_val);
+            if (device_ctl_gpio(pin, level_val) != ESP_OK) {
+                httpd_resp_set_status(req, "400 Bad Request");
+                httpd_resp_send(req, "{\"status\":\"error\",\"message\":\"Invalid pin\"}", HTTPD_RESP_USE_STRLEN);
+                return ESP_OK;
+            }
             
             ESP_LOGI(TAG, "GPIO%d set to %s", pin, level_val ? "HIGH" : "LOW");
             
-            httpd_resp_set_type(req, "application/json");
             char response[100];
             snprintf(response, sizeof(response), "{\"status\":\"ok\",\"gpio\":%d,\"level\":\"%s\"}", pin, level_val ? "HIGH" : "LOW");
             httpd_resp_send(req, response, HTTPD_RESP_USE_STRLEN);
@@ -317,6 +277,69 @@ static esp_err_t gpio_handler(httpd_req_t *req)
     return ESP_OK;
 }
 
+/* 函数名：parse_pin_mask
+ *
+ * 函数说明：解析引脚掩码查询参数（十进制或 0x 开头的十六进制），参数缺失时为 0。
+ * 参数：
+ *   query - 查询字符串。
+ *   key   - 参数名。
+ *   mask  - 输出：掩码。
+ * 返回值：
+ *   true 成功；false 参数不是数字或超出 64 位。
+ */
+static bool parse_pin_mask(const char *query, const char *key, uint64_t *mask)
+{
+    char value[24];
+    *mask = 0;
+    if (httpd_query_key_value(query, key, value, sizeof(value)) != ESP_OK) return true;
+
+    char *end;
+    errno = 0;
+    unsigned long long v = strtoull(value, &end, 0);
+    if (end == value || *end != '\0' || errno == ERANGE || value[0] == '-') return false;
+    *mask = (uint64_t)v;
+    return true;
+}
+
+/* 函数名：gpio_bulk_handler
+ *
+ * 函数说明：处理 /api/gpio/bulk GET，按 set/clear 掩码一次设置多个引脚：set 中的引脚同时置高，
+ *           clear 中的引脚紧接着同时拉低。
+ * 参数：
+ *   req - HTTP 请求上下文。
+ * 返回值：
+ *   ESP_OK 表示处理成功；掩码缺失、格式错误、重叠或含不能作输出的引脚时返回 400。
+ */
+static esp_err_t gpio_bulk_handler(httpd_req_t *req)
+{
+    char query[128];
+    uint64_t set = 0;
+    uint64_t clear = 0;
+    uint64_t levels = 0;
+
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) != ESP_OK ||
+        !parse_pin_mask(query, "set", &set) || !parse_pin_mask(query, "clear", &clear)) {
+        httpd_resp_set_status(req, "400 Bad Request");
+        httpd_resp_send(req, "{\"status\":\"error\",\"message\":\"Expected set and/or clear pin masks\"}",
+                        HTTPD_RESP_USE_STRLEN);
+        return ESP_OK;
+    }
+    if (device_ctl_gpio_bulk(set, clear, &levels) != ESP_OK) {
+        httpd_resp_set_status(req, "400 Bad Request");
+        httpd_resp_send(req, "{\"status\":\"error\",\"message\":\"Empty or overlapping masks, or invalid pin\"}",
+                        HTTPD_RESP_USE_STRLEN);
+        return ESP_OK;
+    }
+
+    ESP_LOGI(TAG, "GPIO bulk set 0x%llx clear 0x%llx", (unsigned long long)set, (unsigned long long)clear);
+
+    char response[128];
+    snprintf(response, sizeof(response), "{\"status\":\"ok\",\"set\":\"0x%llx\",\"clear\":\"0x%llx\",\"levels\":\"0x%llx\"}",
+             (unsigned long long)set, (unsigned long long)clear, (unsigned long long)levels);
+    httpd_resp_send(req, response, HTTPD_RESP_USE_STRLEN);
+    return ESP_OK;
+}
+
 /* Joke trigger handler */
 /* 函数名：joke_handler
  *
@@ -328,13 +351,7 @@ static esp_err_t gpio_handler(httpd_req_t *req)
  */
 static esp_err_t joke_handler(httpd_req_t *req)
 {
-    /* Add CORS headers */
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Methods", "GET, POST, PUT, DELETE, OPTIONS");
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Headers", "Content-Type");
-    
     ESP_LOGI(TAG, "Joke request received - fetching joke...");
-    httpd_resp_set_type(req, "application/json");
     httpd_resp_send(req, "{\"status\":\"ok\",\"message\":\"Fetching joke...\"}", HTTPD_RESP_USE_STRLEN);
     
     /* Trigger joke fetch in background */
@@ -354,13 +371,8 @@ static esp_err_t joke_handler(httpd_req_t *req)
  */
 static esp_err_t oled_text_handler(httpd_req_t *req)
 {
-    /* Add CORS headers */
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Methods", "GET, POST, PUT, DELETE, OPTIONS");
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Headers", "Content-Type");
-    
     char query[512];
-    char text[256] = {0};
+    char text[sizeof(query)] = {0};  /* percent-encoded UTF-8 takes 9 bytes per CJK character */
     
     /* Get query string */
     if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
@@ -386,10 +398,9 @@ static esp_err_t oled_text_handler(httpd_req_t *req)
             decoded[decoded_len] = '\0';
             
             /* Display on OLED */
-            oled_show_custom_text(decoded);
+            device_ctl_text(decoded);
             
             /* Send success response */
-            httpd_resp_set_type(req, "application/json");
             httpd_resp_send(req, "{\"status\":\"ok\",\"message\":\"Text displayed on OLED\"}", HTTPD_RESP_USE_STRLEN);
         } else {
             /* Check for action parameter (clear) */
@@ -397,24 +408,396 @@ static esp_err_t oled_text_handler(httpd_req_t *req)
             if (httpd_query_key_value(query, "action", action, sizeof(action)) == ESP_OK) {
                 if (strcmp(action, "clear") == 0) {
                     ESP_LOGI(TAG, "Clearing OLED display");
-                    oled_show_status("", "", "");
-                    httpd_resp_set_type(req, "application/json");
+                    device_ctl_clear();
                     httpd_resp_send(req, "{\"status\":\"ok\",\"message\":\"OLED cleared\"}", HTTPD_RESP_USE_STRLEN);
                     return ESP_OK;
                 }
             }
             
             httpd_resp_set_status(req, "400 Bad Request");
-            httpd_resp_send(req, "Missing 'text' or 'action' parameter", HTTPD_RESP_USE_STRLEN);
+            httpd_resp_send(req, "{\"status\":\"error\",\"message\":\"Missing text or action parameter\"}", HTTPD_RESP_USE_STRLEN);
         }
     } else {
         httpd_resp_set_status(req, "400 Bad Request");
-        httpd_resp_send(req, "No query string provided", HTTPD_RESP_USE_STRLEN);
+        httpd_resp_send(req, "{\"status\":\"error\",\"message\":\"No query string provided\"}", HTTPD_RESP_USE_STRLEN);
     }
     
     return ESP_OK;
 }
 
+/* 函数名：oled_frame_read
+ *
+ * 函数说明：帧接收的读取回调，从 HTTP 请求体读取数据；接收超时时重试几次。
+ * 参数：
+ *   ctx - HTTP 请求上下文。
+ *   dst - 目标地址（后台帧缓冲）。
+ *   len - 最多读取的字节数。
+ * 返回值：
+ *   读取的字节数，<= 0 表示出错或连接关闭。
+ */
+static int oled_frame_read(void *ctx, uint8_t *dst, size_t len)
+{
+    httpd_req_t *req = (httpd_req_t *)ctx;
+    int n = HTTPD_SOCK_ERR_TIMEOUT;
+    for (int retry = 0; retry < 3 && n == HTTPD_SOCK_ERR_TIMEOUT; retry++) {
+        n = httpd_req_recv(req, (char *)dst, len);
+    }
+    return n;
+}
+
+/* Remote frame push handler */
+/* 函数名：oled_frame_handler
+ *
+ * 函数说明：处理 /api/oled/frame POST，请求体为服务器端渲染的 1bpp 页格式帧，
+ *           直接读入 OLED 后台帧后由渲染任务刷新。查询参数 format=delta 表示请求体
+ *           为相对上一帧的增量记录，否则为 1024 字节完整帧。响应中返回帧计数。
+ * 参数：
+ *   req - HTTP 请求上下文。
+ * 返回值：
+ *   ESP_OK 表示处理成功；格式错误返回 400，增量帧缺少基准帧返回 409，
+ *   无法分配接收缓冲返回 500，显示未初始化返回 503。
+ */
+static esp_err_t oled_frame_handler(httpd_req_t *req)
+{
+    char query[32];
+    char format[8] = {0};
+    oled_frame_format_t fmt = OLED_FRAME_FULL;
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "format", format, sizeof(format)) == ESP_OK &&
+        strcmp(format, "delta") == 0) {
+        fmt = OLED_FRAME_DELTA;
+    }
+
+    esp_err_t ret = oled_push_frame(fmt, req->content_len, oled_frame_read, req);
+    if (ret == ESP_FAIL) {
+        ESP_LOGW(TAG, "OLED frame body not received");
+        httpd_resp_send_err(req, HTTPD_408_REQ_TIMEOUT, "Frame body not received");
+        return ESP_FAIL;
+    }
+
+    httpd_resp_set_type(req, "application/json");
+    if (ret == ESP_ERR_INVALID_SIZE) {
+        httpd_resp_set_status(req, "400 Bad Request");
+        httpd_resp_send(req, "{\"status\":\"error\",\"message\":\"Invalid frame size or delta record\"}", HTTPD_RESP_USE_STRLEN);
+        return ESP_OK;
+    }
+    if (ret == ESP_ERR_NOT_FOUND) {
+        httpd_resp_set_status(req, "409 Conflict");
+        httpd_resp_send(req, "{\"status\":\"error\",\"message\":\"No base frame, send a full frame\"}", HTTPD_RESP_USE_STRLEN);
+        return ESP_OK;
+    }
+    if (ret == ESP_ERR_NO_MEM) {
+        httpd_resp_set_status(req, "500 Internal Server Error");
+        httpd_resp_send(req, "{\"status\":\"error\",\"message\":\"Out of memory\"}", HTTPD_RESP_USE_STRLEN);
+        return ESP_OK;
+    }
+    if (ret != ESP_OK) {
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        httpd_resp_send(req, "{\"status\":\"error\",\"message\":\"OLED not initialized\"}", HTTPD_RESP_USE_STRLEN);
+        return ESP_OK;
+    }
+
+    oled_frame_stats_t stats;
+    oled_get_frame_stats(&stats);
+    char response[128];
+    snprintf(response, sizeof(response),
+             "{\"status\":\"ok\",\"accepted\":%lu,\"skipped\":%lu,\"flushed\":%lu,\"rejected\":%lu}",
+             (unsigned long)stats.accepted, (unsigned long)stats.skipped,
+             (unsigned long)stats.flushed, (unsigned long)stats.rejected);
+    httpd_resp_send(req, response, HTTPD_RESP_USE_STRLEN);
+    return ESP_OK;
+}
+
+/* Batch command handler */
+/* 函数名：batch_handler
+ *
+ * 函数说明：处理 /api/batch POST。请求体为 JSON 操作数组（格式见 ctl_batch.h），在一个请求内
+ *           按顺序执行，OLED 操作合并为一次重绘，响应中返回每个操作的结果。
+ * 参数：
+ *   req - HTTP 请求上下文。
+ * 返回值：
+ *   ESP_OK 表示处理成功；请求体不是 JSON 数组返回 400，超限返回 413。
+ */
+static esp_err_t batch_handler(httpd_req_t *req)
+{
+    if (req->content_len > CTL_BATCH_MAX_BODY) {
+        httpd_resp_set_status(req, "413 Payload Too Large");
+        httpd_resp_send(req, "{\"status\":\"error\",\"message\":\"Body too large\"}", HTTPD_RESP_USE_STRLEN);
+        return ESP_OK;
+    }
+
+    char *body = malloc(req->content_len + 1);  /* off the httpd task stack */
+    if (!body) {
+        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Out of memory");
+        return ESP_FAIL;
+    }
+    size_t got = 0;
+    while (got < req->content_len) {
+        int n = oled_frame_read(req, (uint8_t *)body + got, req->content_len - got);
+        if (n <= 0) {
+            free(body);
+            httpd_resp_send_err(req, HTTPD_408_REQ_TIMEOUT, "Batch body not received");
+            return ESP_FAIL;
+        }
+        got += (size_t)n;
+    }
+
+    char *response;
+    const char *error;
+    esp_err_t ret = ctl_batch_run(body, got, &response, &error);
+    free(body);
+    if (ret != ESP_OK) {
+        char msg[96];
+        snprintf(msg, sizeof(msg), "{\"status\":\"error\",\"message\":\"%s\"}", error);
+        httpd_resp_set_status(req, ret == ESP_ERR_INVALID_SIZE ? "413 Payload Too Large" :
+                                   ret == ESP_ERR_NO_MEM ? "503 Service Unavailable" : "400 Bad Request");
+        httpd_resp_send(req, msg, HTTPD_RESP_USE_STRLEN);
+        return ESP_OK;
+    }
+    httpd_resp_send(req, response, HTTPD_RESP_USE_STRLEN);
+    free(response);
+    return ESP_OK;
+}
+
+/* Animation handler */
+/* 函数名：oled_anim_handler
+ *
+ * 函数说明：处理 /api/oled/anim。POST ?name=<动画名> 播放 Flash 中的动画；GET 与 POST
+ *           均返回当前（或最近一次）动画的帧节奏统计。
+ * 参数：
+ *   req - HTTP 请求上下文。
+ * 返回值：
+ *   ESP_OK 表示处理成功；动画不存在返回 404，显示不可用返回 503。
+ */
+static esp_err_t oled_anim_handler(httpd_req_t *req)
+{
+    if (req->method == HTTP_POST) {
+        char query[48];
+        char name[24] = {0};
+        if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+            httpd_query_key_value(query, "name", name, sizeof(name));
+        }
+        const oled_anim_t *anim = oled_anim_find(name);
+        if (anim == NULL) {
+            httpd_resp_set_status(req, "404 Not Found");
+            httpd_resp_send(req, "{\"status\":\"error\",\"message\":\"Unknown animation\"}", HTTPD_RESP_USE_STRLEN);
+            return ESP_OK;
+        }
+        if (oled_play_anim(anim) != ESP_OK) {
+            httpd_resp_set_status(req, "503 Service Unavailable");
+            httpd_resp_send(req, "{\"status\":\"error\",\"message\":\"OLED animations unavailable\"}", HTTPD_RESP_USE_STRLEN);
+            return ESP_OK;
+        }
+    }
+
+    oled_anim_stats_t stats;
+    oled_get_anim_stats(&stats);
+    char response[256];
+    snprintf(response, sizeof(response),
+             "{\"status\":\"ok\",\"name\":\"%s\",\"playing\":%s,\"target_fps\":%u,\"shown\":%lu,"
+             "\"dropped\":%lu,\"elapsed_ms\":%lu,\"max_late_us\":%lu,\"avg_flush_us\":%lu,\"max_flush_us\":%lu}",
+             stats.name ? stats.name : "", stats.playing ? "true" : "false", stats.target_fps,
+             (unsigned long)stats.shown, (unsigned long)stats.dropped, (unsigned long)stats.elapsed_ms,
+             (unsigned long)stats.max_late_us, (unsigned long)stats.avg_flush_us,
+             (unsigned long)stats.max_flush_us);
+    httpd_resp_send(req, response, HTTPD_RESP_USE_STRLEN);
+    return ESP_OK;
+}
+
+/* Idle power handler */
+/* 函数名：oled_idle_handler
+ *
+ * 函数说明：处理 /api/oled/idle GET，返回显示空闲策略的当前状态（active/dim/off）、
+ *           距最近一次活动的时长与开机以来各状态的累计时长。
+ * 参数：
+ *   req - HTTP 请求上下文。
+ * 返回值：
+ *   ESP_OK 表示处理成功。
+ */
+static esp_err_t oled_idle_handler(httpd_req_t *req)
+{
+    static const char *const states[] = { "active", "dim", "off" };
+
+    oled_idle_stats_t stats;
+    oled_get_idle_stats(&stats);
+    char response[192];
+    snprintf(response, sizeof(response),
+             "{\"status\":\"ok\",\"enabled\":%s,\"state\":\"%s\",\"idle_ms\":%lu,\"active_ms\":%lu,"
+             "\"dim_ms\":%lu,\"off_ms\":%lu,\"wakes\":%lu}",
+             stats.enabled ? "true" : "false", states[stats.state], (unsigned long)stats.idle_ms,
+             (unsigned long)stats.active_ms, (unsigned long)stats.dim_ms, (unsigned long)stats.off_ms,
+             (unsigned long)stats.wakes);
+    httpd_resp_send(req, response, HTTPD_RESP_USE_STRLEN);
+    return ESP_OK;
+}
+
+/* 函数名：oled_queue_handler
+ *
+ * 函数说明：处理 /api/oled/queue GET，返回显示请求队列统计：当前深度、已接收、已显示、
+ *           被新请求合并与丢弃的请求数。
+ * 参数：
+ *   req - HTTP 请求上下文。
+ * 返回值：
+ *   ESP_OK 表示处理成功。
+ */
+static esp_err_t oled_queue_handler(httpd_req_t *req)
+{
+    oled_queue_stats_t stats;
+    oled_get_queue_stats(&stats);
+    char response[160];
+    snprintf(response, sizeof(response),
+             "{\"status\":\"ok\",\"depth\":%u,\"posted\":%lu,\"rendered\":%lu,\"coalesced\":%lu,\"dropped\":%lu}",
+             (unsigned)stats.depth, (unsigned long)stats.posted, (unsigned long)stats.rendered,
+             (unsigned long)stats.coalesced, (unsigned long)stats.dropped);
+    httpd_resp_send(req, response, HTTPD_RESP_USE_STRLEN);
+    return ESP_OK;
+}
+
+/* 函数名：oled_snapshot_send
+ *
+ * 函数说明：发送快照副本。raw 格式直接以副本为响应体；PBM 格式逐页转换为
+ *           8 行像素后分块发送。此时不持有显示锁。
+ * 参数：
+ *   req  - HTTP 请求上下文。
+ *   snap - oled_read_frame() 得到的快照。
+ *   pbm  - true 发送 PBM，false 发送原始帧。
+ * 返回值：
+ *   发送结果。
+ */
+static esp_err_t oled_snapshot_send(httpd_req_t *req, const ssd1306_t *snap, bool pbm)
+{
+    if (!pbm) {
+        httpd_resp_set_type(req, "application/octet-stream");
+        return httpd_resp_send(req, (const char *)snap->buffer, (ssize_t)snap->width * snap->pages);
+    }
+
+    char header[24];
+    uint8_t rows[8 * (OLED_PBM_MAX_WIDTH / 8)];
+    size_t rows_len = (size_t)8 * ((snap->width + 7) / 8);
+    int n = snprintf(header, sizeof(header), "P4\n%u %u\n", snap->width, snap->height);
+
+    httpd_resp_set_type(req, "image/x-portable-bitmap");
+    esp_err_t ret = httpd_resp_send_chunk(req, header, n);
+    for (uint8_t page = 0; page < snap->pages && ret == ESP_OK; page++) {
+        oled_frame_pbm_rows(snap, page, rows);
+        ret = httpd_resp_send_chunk(req, (const char *)rows, (ssize_t)rows_len);
+    }
+    if (ret == ESP_OK) {
+        ret = httpd_resp_send_chunk(req, NULL, 0);
+    }
+    return ret;
+}
+
+/* Framebuffer snapshot handler */
+/* 函数名：oled_snapshot_handler
+ *
+ * 函数说明：处理 /api/oled/frame GET，返回 OLED 当前画面。默认 PBM（P4）图像，
+ *           format=raw 返回与 POST 相同的 1bpp 页格式原始帧。
+ * 参数：
+ *   req - HTTP 请求上下文。
+ * 返回值：
+ *   ESP_OK 表示处理成功；显示未初始化时返回 503，无法分配快照缓冲时返回 500。
+ */
+static esp_err_t oled_snapshot_handler(httpd_req_t *req)
+{
+    httpd_resp_set_hdr(req, "Cache-Control", "no-store");
+
+    char query[32];
+    char format[8] = {0};
+    bool pbm = true;
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "format", format, sizeof(format)) == ESP_OK &&
+        strcmp(format, "raw") == 0) {
+        pbm = false;
+    }
+
+    ssd1306_t snap;
+    esp_err_t ret = oled_read_frame(&snap);
+    if (ret == ESP_ERR_NO_MEM) {
+        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Out of memory");
+        return ESP_OK;
+    }
+    if (ret != ESP_OK) {
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        httpd_resp_send(req, "OLED not initialized", HTTPD_RESP_USE_STRLEN);
+        return ESP_OK;
+    }
+    oled_snapshot_send(req, &snap, pbm);
+    free(snap.buffer);
+    return ESP_OK;
+}
+
+/* 函数名：oled_stream_task
+ *
+ * 函数说明：实时镜像流任务。以分块传输持续发送画面更新，每条更新为 2 字节小端
+ *           长度加增量记录（格式同 POST /api/oled/frame?format=delta），客户端从
+ *           全黑帧开始依次应用；空闲时定期发送长度为 0 的保活更新。客户端断开时退出。
+ * 参数：
+ *   arg - 异步请求上下文（httpd_req_async_handler_begin 的副本）。
+ * 返回值：
+ *   无。
+ */
+static void oled_stream_task(void *arg)
+{
+    httpd_req_t *req = (httpd_req_t *)arg;
+    oled_mirror_t *mirror = NULL;
+    size_t cap = OLED_FRAME_DIFF_MAX(g_oled.display.width, g_oled.display.pages);
+    uint8_t *update = malloc(2 + cap);
+
+    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-store");
+    if (!update || oled_mirror_open(&mirror) != ESP_OK) {
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        httpd_resp_send(req, "OLED stream unavailable", HTTPD_RESP_USE_STRLEN);
+    } else {
+        char size[16];
+        snprintf(size, sizeof(size), "%ux%u", g_oled.display.width, g_oled.display.height);
+        httpd_resp_set_hdr(req, "X-OLED-Size", size);
+        httpd_resp_set_type(req, "application/octet-stream");
+        ESP_LOGI(TAG, "OLED stream client connected");
+
+        for (;;) {
+            size_t len = oled_mirror_next(mirror, update + 2, cap, OLED_STREAM_KEEPALIVE_MS);
+            update[0] = (uint8_t)len;
+            update[1] = (uint8_t)(len >> 8);
+            if (httpd_resp_send_chunk(req, (const char *)update, (ssize_t)(2 + len)) != ESP_OK) {
+                break;
+            }
+        }
+        ESP_LOGI(TAG, "OLED stream client disconnected");
+    }
+
+    oled_mirror_close(mirror);
+    free(update);
+    httpd_req_async_handler_complete(req);
+    vTaskDelete(NULL);
+}
+
+/* Live framebuffer stream handler */
+/* 函数名：oled_stream_handler
+ *
+ * 函数说明：处理 /api/oled/stream GET。把请求转为异步请求交给独立任务长期推送，
+ *           服务器任务立即返回继续处理其他请求。
+ * 参数：
+ *   req - HTTP 请求上下文。
+ * 返回值：
+ *   ESP_OK 表示已转交；无法创建任务时返回 500。
+ */
+static esp_err_t oled_stream_handler(httpd_req_t *req)
+{
+    httpd_req_t *async_req = NULL;
+    if (httpd_req_async_handler_begin(req, &async_req) != ESP_OK) {
+        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Cannot start stream");
+        return ESP_FAIL;
+    }
+    if (xTaskCreate(oled_stream_task, "oled_stream", 3072, async_req, 4, NULL) != pdPASS) {
+        httpd_resp_send_err(async_req, HTTPD_500_INTERNAL_SERVER_ERROR, "Cannot start stream");
+        httpd_req_async_handler_complete(async_req);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
 #if CONFIG_EXAMPLE_ENABLE_HTTPS_USER_CALLBACK
 #ifdef CONFIG_ESP_TLS_USING_MBEDTLS
 /* 函数名：print_peer_cert_info
@@ -517,65 +900,69 @@ static void https_server_user_callback(esp_https_server_user_cb_arg_t *user_cb)
 }
 #endif
 
-static const httpd_uri_t root = {
-    .uri       = "/",
-    .method    = HTTP_GET,
-    .handler   = root_get_handler
-};
-
-static const httpd_uri_t root_options = {
-    .uri       = "/",
-    .method    = HTTP_OPTIONS,
-    .handler   = options_handler
-};
-
-static const httpd_uri_t oled_text = {
-    .uri       = "/api/oled",
-    .method    = HTTP_GET,
-    .handler   = oled_text_handler
-};
-
-static const httpd_uri_t oled_text_options = {
-    .uri       = "/api/oled",
-    .method    = HTTP_OPTIONS,
-    .handler   = options_handler
-};
-
-static const httpd_uri_t led_uri = {
-    .uri       = "/api/led",
-    .method    = HTTP_GET,
-    .handler   = led_handler
-};
-
-static const httpd_uri_t led_options = {
-    .uri       = "/api/led",
-    .method    = HTTP_OPTIONS,
-    .handler   = options_handler
-};
+/* 函数名：oled_frame_route
+ *
+ * 函数说明：/api/oled/frame 按方法分派：POST 推送帧，GET 返回当前画面。
+ * 参数：
+ *   req - HTTP 请求上下文。
+ * 返回值：
+ *   对应处理函数的返回值。
+ */
+static esp_err_t oled_frame_route(httpd_req_t *req)
+{
+    return req->method == HTTP_POST ? oled_frame_handler(req) : oled_snapshot_handler(req);
+}
 
-static const httpd_uri_t gpio_uri = {
-    .uri       = "/api/gpio",
-    .method    = HTTP_GET,
-    .handler   = gpio_handler
-};
+/* 函数名：not_found_handler
+ *
+ * 函数说明：未匹配任何路由的请求（任何方法，含 OPTIONS）返回带 CORS 头的 JSON 404。
+ * 参数：
+ *   req - HTTP 请求上下文。
+ * 返回值：
+ *   ESP_OK 表示处理成功。
+ */
+static esp_err_t not_found_handler(httpd_req_t *req)
+{
+    httpd_resp_set_status(req, "404 Not Found");
+    httpd_resp_send(req, "{\"status\":\"error\",\"message\":\"Not found\"}", HTTPD_RESP_USE_STRLEN);
+    return ESP_OK;
+}
 
-static const httpd_uri_t gpio_options = {
-    .uri       = "/api/gpio",
-    .method    = HTTP_OPTIONS,
-    .handler   = options_handler
+/* Routes served by both servers, matched in order; /api/ws is registered by ws_control */
+static const http_route_t routes[] = {
+    { "/",                  HTTP_ROUTE_GET,                     &http_route_html,   root_get_handler },
+    { "/api/oled",          HTTP_ROUTE_GET,                     &http_route_json,   oled_text_handler },
+    { "/api/oled/frame",    HTTP_ROUTE_GET | HTTP_ROUTE_POST,   &http_route_cors,   oled_frame_route },
+    { "/api/oled/stream",   HTTP_ROUTE_GET,                     &http_route_raw,    oled_stream_handler },
+    { "/api/oled/anim",     HTTP_ROUTE_GET | HTTP_ROUTE_POST,   &http_route_json,   oled_anim_handler },
+    { "/api/oled/idle",     HTTP_ROUTE_GET,                     &http_route_json,   oled_idle_handler },
+    { "/api/oled/queue",    HTTP_ROUTE_GET,                     &http_route_json,   oled_queue_handler },
+    { "/api/led",           HTTP_ROUTE_GET,                     &http_route_json,   led_handler },
+    { "/api/gpio",          HTTP_ROUTE_GET,                     &http_route_json,   gpio_handler },
+    { "/api/gpio/bulk",     HTTP_ROUTE_GET,                     &http_route_json,   gpio_bulk_handler },
+    { "/api/events",        HTTP_ROUTE_GET,                     &http_route_raw,    sse_events_handler },
+    { "/api/joke",          HTTP_ROUTE_GET,                     &http_route_json,   joke_handler },
+    { "/api/batch",         HTTP_ROUTE_POST,                    &http_route_json,   batch_handler },
+    { "/*",                 HTTP_ROUTE_ANY,                     &http_route_json,   not_found_handler },
 };
 
-static const httpd_uri_t joke_uri = {
-    .uri       = "/api/joke",
-    .method    = HTTP_GET,
-    .handler   = joke_handler
-};
+#define ROUTE_COUNT         (sizeof(routes) / sizeof(routes[0]))
+#define ROUTE_HANDLERS      (ROUTE_COUNT + 1)   /* + /api/ws */
 
-static const httpd_uri_t joke_options = {
-    .uri       = "/api/joke",
-    .method    = HTTP_OPTIONS,
-    .handler   = options_handler
-};
+/* 函数名：register_routes
+ *
+ * 函数说明：在服务器上注册 WebSocket 控制通道与路由表（HTTP 与 HTTPS 共用）。
+ *           /api/ws 须在表尾的通配路由之前注册。
+ * 参数：
+ *   server - 服务器句柄。
+ * 返回值：
+ *   无。
+ */
+static void register_routes(httpd_handle_t server)
+{
+    ws_control_register(server);
+    http_route_register(server, routes, ROUTE_COUNT);
+}
 
 /* Start HTTP server (port 80) */
 /* 函数名：start_http_server
@@ -592,21 +979,12 @@ static httpd_handle_t start_http_server(void)
     httpd_config_t config = HTTPD_DEFAULT_CONFIG();
     config.server_port = 80;
     config.ctrl_port = 32768;
-    config.max_uri_handlers = 16;  /* allow enough handlers (root/oled/led/gpio/joke + OPTIONS) */
+    http_route_config(&config, ROUTE_HANDLERS);  /* one handler per route, OPTIONS included */
 
     ESP_LOGI(TAG, "Starting HTTP server on port 80");
     if (httpd_start(&server, &config) == ESP_OK) {
         ESP_LOGI(TAG, "Registering URI handlers for HTTP");
-        httpd_register_uri_handler(server, &root);
-        httpd_register_uri_handler(server, &root_options);
-        httpd_register_uri_handler(server, &oled_text);
-        httpd_register_uri_handler(server, &oled_text_options);
-        httpd_register_uri_handler(server, &led_uri);
-        httpd_register_uri_handler(server, &led_options);
-        httpd_register_uri_handler(server, &gpio_uri);
-        httpd_register_uri_handler(server, &gpio_options);
-        httpd_register_uri_handler(server, &joke_uri);
-        httpd_register_uri_handler(server, &joke_options);
+        register_routes(server);
         return server;
     }
 
@@ -630,7 +1008,7 @@ static httpd_handle_t start_https_server(void)
     ESP_LOGI(TAG, "Starting HTTPS server on port 443");
 
     httpd_ssl_config_t conf = HTTPD_SSL_CONFIG_DEFAULT();
-    conf.httpd.max_uri_handlers = 16;  /* mirror HTTP handler capacity */
+    http_route_config(&conf.httpd, ROUTE_HANDLERS);  /* mirror HTTP handler capacity */
 
     extern const unsigned char servercert_start[] asm("_binary_servercert_pem_start");
     extern const unsigned char servercert_end[]   asm("_binary_servercert_pem_end");
@@ -653,16 +1031,7 @@ static httpd_handle_t start_https_server(void)
 
     // Set URI handlers
     ESP_LOGI(TAG, "Registering URI handlers for HTTPS");
-    httpd_register_uri_handler(server, &root);
-    httpd_register_uri_handler(server, &root_options);
-    httpd_register_uri_handler(server, &oled_text);
-    httpd_register_uri_handler(server, &oled_text_options);
-    httpd_register_uri_handler(server, &led_uri);
-    httpd_register_uri_handler(server, &led_options);
-    httpd_register_uri_handler(server, &gpio_uri);
-    httpd_register_uri_handler(server, &gpio_options);
-    httpd_register_uri_handler(server, &joke_uri);
-    httpd_register_uri_handler(server, &joke_options);
+    register_routes(server);
     return server;
 }
 
@@ -705,7 +1074,8 @@ static httpd_handle_t start_webserver(void)
  */
 static esp_err_t stop_webserver(httpd_handle_t server)
 {
-    // Stop the httpd server
+    // Stop broadcasting to the server before it is freed, then stop it
+    ws_control_unregister(server);
     return httpd_ssl_stop(server);
 }
 
@@ -794,20 +1164,16 @@ void app_main(void)
     ESP_ERROR_CHECK(esp_netif_init());
     ESP_ERROR_CHECK(esp_event_loop_create_default());
 
-    /* Initialize GPIO for LED */
-    gpio_config_t io_conf = {
-        .pin_bit_mask = (1ULL << LED_PIN),
-        .mode = GPIO_MODE_OUTPUT,
-        .pull_down_en = 0,
-        .pull_up_en = 0,
-        .intr_type = GPIO_INTR_DISABLE
-    };
-    gpio_config(&io_conf);
-    gpio_set_level(LED_PIN, 0);  /* LED off initially */
-    ESP_LOGI(TAG, "GPIO%d initialized for LED control", LED_PIN);
+    /* Initialize GPIO for LED, the control channel's change notifications and the event stream */
+    ESP_ERROR_CHECK(device_ctl_init());
+    ESP_ERROR_CHECK(ws_control_init());
+    ESP_ERROR_CHECK(sse_events_init());
 
     /* Initialize OLED display */
     if (oled_init() == ESP_OK) {
+#ifdef CONFIG_OLED_BOOT_ANIMATION
+        oled_play_anim(&oled_anim_boot);    /* the connecting screen follows when it ends */
+#endif
         oled_show_connecting();
     }
 
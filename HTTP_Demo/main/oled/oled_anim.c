@@ -0,0 +1,144 @@
+#include "oled_anim.h"
+#include "oled_anims.h"
+#include <string.h>
+
+/* 函数名：oled_anim_xor_sink
+ *
+ * 函数说明：增量解压回调：把一段解出的字节异或到目标列段，重复的 0 字节直接跳过。
+ * 参数：
+ *   ctx  - 目标列段。
+ *   out  - 字节偏移。
+ *   src  - 字面字节；重复段为 NULL。
+ *   fill - 重复字节。
+ *   n    - 字节数。
+ * 返回值：
+ *   无。
+ */
+static void oled_anim_xor_sink(void *ctx, size_t out, const uint8_t *src, uint8_t fill, size_t n)
+{
+    uint8_t *dst = (uint8_t *)ctx + out;
+    if (src) {
+        for (size_t i = 0; i < n; i++) {
+            dst[i] ^= src[i];
+        }
+    } else if (fill) {
+        for (size_t i = 0; i < n; i++) {
+            dst[i] ^= fill;
+        }
+    }
+}
+
+/* 函数名：oled_anim_unpack_xor
+ *
+ * 函数说明：解压一段 PackBits 数据（格式见 ssd1306_rle_decode）并异或到目标列段。
+ * 参数：
+ *   src - 压缩数据。
+ *   end - 压缩数据结尾。
+ *   dst - 目标列段。
+ *   len - 目标字节数。
+ * 返回值：
+ *   下一条记录的起始地址；数据截断或解压长度与 len 不符时返回 NULL。
+ */
+static const uint8_t *oled_anim_unpack_xor(const uint8_t *src, const uint8_t *end, uint8_t *dst, uint16_t len)
+{
+    size_t used;
+    if (ssd1306_rle_decode(src, (size_t)(end - src), len, &used, oled_anim_xor_sink, dst) != ESP_OK) return NULL;
+    return src + used;
+}
+
+/* 函数名：oled_anim_start
+ *
+ * 函数说明：从第 0 帧开始播放动画。动画尺寸必须与显示设备一致。
+ * 参数：
+ *   p    - 播放位置。
+ *   anim - 动画。
+ *   dev  - 显示设备。
+ * 返回值：
+ *   ESP_OK 成功；ESP_ERR_INVALID_ARG 参数为空或动画没有帧；ESP_ERR_INVALID_SIZE 尺寸不符。
+ */
+esp_err_t oled_anim_start(oled_anim_player_t *p, const oled_anim_t *anim, const ssd1306_t *dev)
+{
+    if (!p || !anim || !anim->data || anim->frames == 0 || !dev) return ESP_ERR_INVALID_ARG;
+    if (anim->width != dev->width || anim->height != dev->height) return ESP_ERR_INVALID_SIZE;
+
+    p->anim = anim;
+    p->pos = 0;
+    p->frame = 0;
+    return ESP_OK;
+}
+
+/* 函数名：oled_anim_next
+ *
+ * 函数说明：把下一帧应用到帧缓冲：关键帧先清屏，随后逐条记录异或到对应列段并只标记
+ *           该列段为脏。循环动画在最后一帧之后回到第 0 帧（关键帧）。
+ * 参数：
+ *   p   - 播放位置。
+ *   dev - 显示设备（通常为后台帧）。
+ * 返回值：
+ *   ESP_OK 成功；ESP_ERR_INVALID_STATE 单次动画已播放完毕；ESP_ERR_INVALID_SIZE 数据损坏
+ *   （帧缓冲可能已部分更新，应停止播放）。
+ */
+esp_err_t oled_anim_next(oled_anim_player_t *p, ssd1306_t *dev)
+{
+    const oled_anim_t *anim = p->anim;
+    if (p->frame >= anim->frames) {
+        if (!anim->loop) return ESP_ERR_INVALID_STATE;
+        p->frame = 0;
+        p->pos = 0;
+    }
+
+    const uint8_t *src = anim->data + p->pos;
+    const uint8_t *end = anim->data + anim->len;
+    if (end - src < OLED_ANIM_FRAME_HEADER) return ESP_ERR_INVALID_SIZE;
+    uint8_t flags = src[0];
+    uint8_t records = src[1];
+    src += OLED_ANIM_FRAME_HEADER;
+    if (p->frame == 0 && !(flags & OLED_ANIM_KEYFRAME)) return ESP_ERR_INVALID_SIZE;
+
+    if (flags & OLED_ANIM_KEYFRAME) {
+        ssd1306_clear(dev);
+    }
+    for (uint8_t i = 0; i < records; i++) {
+        if (end - src < OLED_ANIM_RECORD_HEADER) return ESP_ERR_INVALID_SIZE;
+        uint8_t *dst = ssd1306_page_span(dev, src[0], src[1], src[2]);
+        if (dst == NULL) return ESP_ERR_INVALID_SIZE;
+        src = oled_anim_unpack_xor(src + OLED_ANIM_RECORD_HEADER, end, dst, src[2]);
+        if (src == NULL) return ESP_ERR_INVALID_SIZE;
+    }
+
+    p->pos = (uint32_t)(src - anim->data);
+    p->frame++;
+    return ESP_OK;
+}
+
+/* 函数名：oled_anim_done
+ *
+ * 函数说明：单次动画是否已播放完最后一帧（循环动画永不结束）。
+ * 参数：
+ *   p - 播放位置。
+ * 返回值：
+ *   true 已结束。
+ */
+bool oled_anim_done(const oled_anim_player_t *p)
+{
+    return !p->anim->loop && p->frame >= p->anim->frames;
+}
+
+/* 函数名：oled_anim_find
+ *
+ * 函数说明：按名称查找 Flash 中的动画。
+ * 参数：
+ *   name - 动画名称。
+ * 返回值：
+ *   动画指针；未找到返回 NULL。
+ */
+const oled_anim_t *oled_anim_find(const char *name)
+{
+    if (!name) return NULL;
+    for (size_t i = 0; i < oled_anim_count; i++) {
+        if (strcmp(oled_anim_list[i]->name, name) == 0) {
+            return oled_anim_list[i];
+        }
+    }
+    return NULL;
+}
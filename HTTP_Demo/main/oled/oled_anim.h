@@ -0,0 +1,58 @@
+/*
+ * Flash 帧动画解码
+ *
+ * 开机、告警等动画预先渲染（tools/gen_oled_anims.py）并以“关键帧 + 按页 XOR 增量”
+ * 存放在 Flash 中。每帧格式：
+ *   u8 flags（bit0 = 关键帧：先清空整帧），u8 记录数，
+ *   若干条记录 {u8 page, u8 col, u8 len, PackBits 数据（解压后 len 字节）}。
+ * 每条记录解压后异或到帧缓冲对应列段并只标记该列段为脏，未变化的页不会被触及，
+ * 随后 ssd1306_show() 的差分刷新只把真正变化的字节送上总线。
+ *
+ * 第 0 帧总是关键帧，循环动画播放完最后一帧后从第 0 帧重新开始。
+ * 本模块只负责解码，不加锁、不计时；按固定帧率驱动由调用方（渲染任务）完成。
+ */
+#ifndef OLED_ANIM_H
+#define OLED_ANIM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define OLED_ANIM_KEYFRAME      0x01    /* frame flags: clear the frame before applying the records */
+#define OLED_ANIM_FRAME_HEADER  2       /* flags, record count */
+#define OLED_ANIM_RECORD_HEADER 3       /* page, col, len */
+
+/* Animation stored in flash */
+typedef struct {
+    const char *name;
+    const uint8_t *data;
+    uint32_t len;
+    uint16_t frames;
+    uint16_t width;
+    uint16_t height;
+    uint8_t fps;            /* target frame rate */
+    bool loop;              /* restart from frame 0 after the last frame */
+} oled_anim_t;
+
+/* Playback position */
+typedef struct {
+    const oled_anim_t *anim;
+    uint32_t pos;           /* offset of the next frame in anim->data */
+    uint16_t frame;         /* index of the next frame */
+} oled_anim_player_t;
+
+esp_err_t oled_anim_start(oled_anim_player_t *p, const oled_anim_t *anim, const ssd1306_t *dev);
+esp_err_t oled_anim_next(oled_anim_player_t *p, ssd1306_t *dev);
+bool oled_anim_done(const oled_anim_player_t *p);
+const oled_anim_t *oled_anim_find(const char *name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OLED_ANIM_H */
@@ -0,0 +1,253 @@
+/* Generated by tools/gen_oled_anims.py - do not edit by hand */
+#include "oled_anims.h"
+
+/* 36 frames at 25 fps, 10 keyframe(s), 36864 -> 618 bytes */
+static const uint8_t boot_data[618] = {
+    0x01, 0x00, 0x01, 0x01, 0x00, 0x34, 0x18, 0x95, 0x03, 0x01, 0x01, 0x00, 0x30, 0x20, 0x03, 0x04,
+    0x04, 0x00, 0x00, 0x95, 0x1f, 0x03, 0x00, 0x00, 0x04, 0x04, 0x01, 0x01, 0x00, 0x30, 0x20, 0x03,
+    0x24, 0x24, 0x00, 0x00, 0x95, 0xff, 0x03, 0x00, 0x00, 0x24, 0x24, 0x00, 0x01, 0x01, 0x30, 0x20,
+    0x03, 0x01, 0x01, 0x00, 0x00, 0x95, 0x07, 0x03, 0x00, 0x00, 0x01, 0x01, 0x00, 0x02, 0x00, 0x36,
+    0x01, 0x00, 0x04, 0x01, 0x30, 0x20, 0x03, 0x08, 0x08, 0x00, 0x00, 0x95, 0x38, 0x03, 0x00, 0x00,
+    0x08, 0x08, 0x01, 0x03, 0x00, 0x30, 0x20, 0x06, 0x20, 0x20, 0x00, 0x00, 0xf8, 0xf8, 0xd8, 0x92,
+    0xf8, 0x03, 0x00, 0x00, 0x20, 0x20, 0x01, 0x30, 0x20, 0x03, 0x49, 0x49, 0x00, 0x00, 0x95, 0xff,
+    0x03, 0x00, 0x00, 0x49, 0x49, 0x02, 0x34, 0x18, 0x95, 0x01, 0x01, 0x03, 0x00, 0x34, 0x18, 0x95,
+    0xc0, 0x01, 0x30, 0x20, 0x06, 0x49, 0x49, 0x00, 0x00, 0xff, 0xff, 0xfe, 0x92, 0xff, 0x03, 0x00,
+    0x00, 0x49, 0x49, 0x02, 0x30, 0x20, 0x03, 0x02, 0x02, 0x00, 0x00, 0x95, 0x0f, 0x03, 0x00, 0x00,
+    0x02, 0x02, 0x01, 0x02, 0x01, 0x30, 0x20, 0x06, 0x48, 0x48, 0x00, 0x00, 0xfe, 0xfe, 0xf6, 0x92,
+    0xfe, 0x03, 0x00, 0x00, 0x48, 0x48, 0x02, 0x30, 0x20, 0x03, 0x12, 0x12, 0x00, 0x00, 0x95, 0x7f,
+    0x03, 0x00, 0x00, 0x12, 0x12, 0x01, 0x03, 0x01, 0x30, 0x20, 0x06, 0x40, 0x40, 0x00, 0x00, 0xf0,
+    0xf0, 0xb0, 0x92, 0xf0, 0x03, 0x00, 0x00, 0x40, 0x40, 0x02, 0x30, 0x20, 0x03, 0x92, 0x92, 0x00,
+    0x00, 0x95, 0xff, 0x03, 0x00, 0x00, 0x92, 0x92, 0x03, 0x34, 0x18, 0x95, 0x03, 0x01, 0x03, 0x01,
+    0x34, 0x18, 0x95, 0x80, 0x02, 0x30, 0x20, 0x06, 0x92, 0x92, 0x00, 0x00, 0xff, 0xff, 0xfd, 0x92,
+    0xff, 0x03, 0x00, 0x00, 0x92, 0x92, 0x03, 0x30, 0x20, 0x03, 0x04, 0x04, 0x00, 0x00, 0x95, 0x1f,
+    0x03, 0x00, 0x00, 0x04, 0x04, 0x01, 0x04, 0x02, 0x30, 0x20, 0x06, 0x48, 0x48, 0x00, 0x00, 0xfe,
+    0xfe, 0xf6, 0x92, 0xfe, 0x03, 0x00, 0x00, 0x48, 0x48, 0x03, 0x30, 0x20, 0x03, 0x12, 0x12, 0x00,
+    0x00, 0x95, 0x7f, 0x03, 0x00, 0x00, 0x12, 0x12, 0x05, 0x0e, 0x64, 0x00, 0xf0, 0xdf, 0x10, 0x00,
+    0xf0, 0x06, 0x0e, 0x64, 0x00, 0x0f, 0xdf, 0x08, 0x00, 0x0f, 0x00, 0x02, 0x05, 0x10, 0x04, 0x81,
+    0xc0, 0x06, 0x10, 0x04, 0x81, 0x03, 0x00, 0x02, 0x05, 0x14, 0x04, 0x81, 0xc0, 0x06, 0x14, 0x04,
+    0x81, 0x03, 0x00, 0x02, 0x05, 0x18, 0x04, 0x81, 0xc0, 0x06, 0x18, 0x04, 0x81, 0x03, 0x00, 0x02,
+    0x05, 0x1c, 0x04, 0x81, 0xc0, 0x06, 0x1c, 0x04, 0x81, 0x03, 0x00, 0x02, 0x05, 0x20, 0x04, 0x81,
+    0xc0, 0x06, 0x20, 0x04, 0x81, 0x03, 0x00, 0x02, 0x05, 0x24, 0x04, 0x81, 0xc0, 0x06, 0x24, 0x04,
+    0x81, 0x03, 0x00, 0x02, 0x05, 0x28, 0x04, 0x81, 0xc0, 0x06, 0x28, 0x04, 0x81, 0x03, 0x00, 0x02,
+    0x05, 0x2c, 0x04, 0x81, 0xc0, 0x06, 0x2c, 0x04, 0x81, 0x03, 0x00, 0x02, 0x05, 0x30, 0x04, 0x81,
+    0xc0, 0x06, 0x30, 0x04, 0x81, 0x03, 0x00, 0x02, 0x05, 0x34, 0x04, 0x81, 0xc0, 0x06, 0x34, 0x04,
+    0x81, 0x03, 0x00, 0x02, 0x05, 0x38, 0x04, 0x81, 0xc0, 0x06, 0x38, 0x04, 0x81, 0x03, 0x00, 0x02,
+    0x05, 0x3c, 0x04, 0x81, 0xc0, 0x06, 0x3c, 0x04, 0x81, 0x03, 0x00, 0x02, 0x05, 0x40, 0x04, 0x81,
+    0xc0, 0x06, 0x40, 0x04, 0x81, 0x03, 0x00, 0x02, 0x05, 0x44, 0x04, 0x81, 0xc0, 0x06, 0x44, 0x04,
+    0x81, 0x03, 0x00, 0x02, 0x05, 0x48, 0x04, 0x81, 0xc0, 0x06, 0x48, 0x04, 0x81, 0x03, 0x00, 0x02,
+    0x05, 0x4c, 0x04, 0x81, 0xc0, 0x06, 0x4c, 0x04, 0x81, 0x03, 0x00, 0x02, 0x05, 0x50, 0x04, 0x81,
+    0xc0, 0x06, 0x50, 0x04, 0x81, 0x03, 0x00, 0x02, 0x05, 0x54, 0x04, 0x81, 0xc0, 0x06, 0x54, 0x04,
+    0x81, 0x03, 0x00, 0x02, 0x05, 0x58, 0x04, 0x81, 0xc0, 0x06, 0x58, 0x04, 0x81, 0x03, 0x00, 0x02,
+    0x05, 0x5c, 0x04, 0x81, 0xc0, 0x06, 0x5c, 0x04, 0x81, 0x03, 0x00, 0x02, 0x05, 0x60, 0x04, 0x81,
+    0xc0, 0x06, 0x60, 0x04, 0x81, 0x03, 0x00, 0x02, 0x05, 0x64, 0x04, 0x81, 0xc0, 0x06, 0x64, 0x04,
+    0x81, 0x03, 0x00, 0x02, 0x05, 0x68, 0x04, 0x81, 0xc0, 0x06, 0x68, 0x04, 0x81, 0x03, 0x00, 0x02,
+    0x05, 0x6c, 0x04, 0x81, 0xc0, 0x06, 0x6c, 0x04, 0x81, 0x03,
+};
+
+const oled_anim_t oled_anim_boot = {
+    .name = "boot",
+    .data = boot_data,
+    .len = 618,
+    .frames = 36,
+    .width = 128,
+    .height = 64,
+    .fps = 25,
+    .loop = false,
+};
+
+/* 16 frames at 12 fps, 4 keyframe(s), 16384 -> 2814 bytes */
+static const uint8_t alert_data[2814] = {
+    0x01, 0x08, 0x00, 0x00, 0x80, 0x00, 0xff, 0xfb, 0x01, 0x00, 0xff, 0x01, 0x00, 0x80, 0x00, 0xff,
+    0xb1, 0x00, 0x03, 0x80, 0x80, 0x40, 0x40, 0x80, 0x20, 0x86, 0x10, 0x80, 0x20, 0x03, 0x40, 0x40,
+    0x80, 0x80, 0xb0, 0x00, 0x00, 0xff, 0x02, 0x00, 0x80, 0x00, 0xff, 0xaa, 0x00, 0x06, 0x80, 0x60,
+    0x10, 0x08, 0x04, 0x02, 0x01, 0x84, 0x00, 0x80, 0x80, 0x80, 0x70, 0x80, 0x80, 0x84, 0x00, 0x06,
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x60, 0x80, 0xa9, 0x00, 0x00, 0xff, 0x03, 0x00, 0x80, 0x00, 0xff,
+    0xa8, 0x00, 0x02, 0xf0, 0x0e, 0x01, 0x87, 0x00, 0x80, 0xfc, 0x80, 0x03, 0x80, 0xfc, 0x80, 0x03,
+    0x80, 0xfc, 0x87, 0x00, 0x02, 0x01, 0x0e, 0xf0, 0xa7, 0x00, 0x00, 0xff, 0x04, 0x00, 0x80, 0x00,
+    0xff, 0xa8, 0x00, 0x01, 0x1f, 0xe0, 0x82, 0x00, 0x80, 0xc0, 0x80, 0x3f, 0x83, 0x00, 0x80, 0xc7,
+    0x83, 0x00, 0x80, 0x3f, 0x80, 0xc0, 0x82, 0x00, 0x01, 0xe0, 0x1f, 0xa7, 0x00, 0x00, 0xff, 0x05,
+    0x00, 0x80, 0x00, 0xff, 0xaa, 0x00, 0x07, 0x03, 0x0c, 0x10, 0x20, 0x40, 0x8f, 0x0f, 0x0f, 0x86,
+    0x0e, 0x80, 0x0f, 0x86, 0x0e, 0x07, 0x0f, 0x0f, 0x8f, 0x40, 0x20, 0x10, 0x0c, 0x03, 0xa9, 0x00,
+    0x00, 0xff, 0x06, 0x00, 0x80, 0x00, 0xff, 0xb0, 0x00, 0x04, 0x01, 0x02, 0x02, 0x04, 0x04, 0x80,
+    0x08, 0x86, 0x10, 0x80, 0x08, 0x04, 0x04, 0x04, 0x02, 0x02, 0x01, 0xaf, 0x00, 0x00, 0xff, 0x07,
+    0x00, 0x80, 0x00, 0xff, 0xfb, 0x80, 0x00, 0xff, 0x00, 0x06, 0x01, 0x33, 0x1b, 0x08, 0x80, 0x40,
+    0xe0, 0xa0, 0x70, 0x50, 0x30, 0x28, 0x28, 0x81, 0x18, 0x00, 0x14, 0x81, 0x18, 0x08, 0x28, 0x28,
+    0x30, 0x50, 0x70, 0xa0, 0xe0, 0x40, 0x80, 0x02, 0x2c, 0x29, 0x08, 0x80, 0xe0, 0xb0, 0x68, 0x14,
+    0x0a, 0x05, 0x02, 0x01, 0x94, 0x00, 0x08, 0x01, 0x02, 0x05, 0x0a, 0x14, 0x68, 0xb0, 0xe0, 0x80,
+    0x03, 0x2b, 0x2b, 0x03, 0xfc, 0xf3, 0x0e, 0x01, 0xa0, 0x00, 0x03, 0x01, 0x0e, 0xf3, 0xfc, 0x04,
+    0x2a, 0x2d, 0x03, 0x01, 0x7e, 0x9f, 0xe0, 0xa2, 0x00, 0x03, 0xe0, 0x9f, 0x7e, 0x01, 0x05, 0x2c,
+    0x29, 0x07, 0x03, 0x0e, 0x1b, 0x2c, 0x50, 0xa0, 0x40, 0x80, 0x96, 0x00, 0x07, 0x80, 0x40, 0xa0,
+    0x50, 0x2c, 0x1b, 0x0e, 0x03, 0x06, 0x32, 0x1d, 0x09, 0x01, 0x02, 0x05, 0x0e, 0x0a, 0x1c, 0x14,
+    0x18, 0x28, 0x28, 0x81, 0x30, 0x00, 0x50, 0x81, 0x30, 0x09, 0x28, 0x28, 0x18, 0x14, 0x1c, 0x0a,
+    0x0e, 0x05, 0x02, 0x01, 0x00, 0x06, 0x01, 0x30, 0x21, 0x0b, 0x80, 0xc0, 0x60, 0xa0, 0x50, 0x70,
+    0x28, 0x38, 0x14, 0x14, 0x0c, 0x0c, 0x81, 0x0a, 0x00, 0x06, 0x81, 0x0a, 0x0b, 0x0c, 0x0c, 0x14,
+    0x14, 0x38, 0x28, 0x70, 0x50, 0xa0, 0x60, 0xc0, 0x80, 0x02, 0x2b, 0x2b, 0x07, 0xc0, 0xb0, 0xec,
+    0x36, 0x0b, 0x04, 0x02, 0x01, 0x98, 0x00, 0x07, 0x01, 0x02, 0x04, 0x0b, 0x36, 0xec, 0xb0, 0xc0,
+    0x03, 0x29, 0x2f, 0x03, 0xf0, 0x0f, 0xfc, 0x03, 0xa4, 0x00, 0x03, 0x03, 0xfc, 0x0f, 0xf0, 0x04,
+    0x29, 0x2f, 0x03, 0x1f, 0xe1, 0x7e, 0x80, 0xa4, 0x00, 0x03, 0x80, 0x7e, 0xe1, 0x1f, 0x05, 0x2a,
+    0x2d, 0x07, 0x01, 0x06, 0x1b, 0x6e, 0xd8, 0xa0, 0x40, 0x80, 0x9a, 0x00, 0x07, 0x80, 0x40, 0xa0,
+    0xd8, 0x6e, 0x1b, 0x06, 0x01, 0x06, 0x2f, 0x23, 0x0c, 0x01, 0x02, 0x06, 0x0d, 0x0a, 0x14, 0x1c,
+    0x28, 0x38, 0x50, 0x50, 0x60, 0x60, 0x81, 0xa0, 0x00, 0xc0, 0x81, 0xa0, 0x0c, 0x60, 0x60, 0x50,
+    0x50, 0x38, 0x28, 0x1c, 0x14, 0x0a, 0x0d, 0x06, 0x02, 0x01, 0x00, 0x07, 0x01, 0x2e, 0x25, 0x0a,
+    0x80, 0x40, 0xe0, 0xe0, 0x70, 0x28, 0x1c, 0x14, 0x0c, 0x0a, 0x06, 0x80, 0x05, 0x86, 0x03, 0x80,
+    0x05, 0x0a, 0x06, 0x0a, 0x0c, 0x14, 0x1c, 0x28, 0x70, 0xe0, 0xe0, 0x40, 0x80, 0x02, 0x29, 0x2f,
+    0x06, 0x80, 0x70, 0xd8, 0x34, 0x0f, 0x07, 0x03, 0x9e, 0x00, 0x06, 0x03, 0x07, 0x0f, 0x34, 0xd8,
+    0x70, 0x80, 0x03, 0x28, 0x31, 0x02, 0xfe, 0xf1, 0x0f, 0xa8, 0x00, 0x02, 0x0f, 0xf1, 0xfe, 0x04,
+    0x28, 0x31, 0x02, 0xff, 0x1f, 0xe0, 0xa8, 0x00, 0x02, 0xe0, 0x1f, 0xff, 0x05, 0x29, 0x2f, 0x06,
+    0x03, 0x1d, 0x36, 0x58, 0xe0, 0xc0, 0x80, 0x9e, 0x00, 0x06, 0x80, 0xc0, 0xe0, 0x58, 0x36, 0x1d,
+    0x03, 0x06, 0x2d, 0x27, 0x0b, 0x01, 0x03, 0x05, 0x0e, 0x0e, 0x1c, 0x28, 0x70, 0x50, 0x60, 0xa0,
+    0xc0, 0x80, 0x40, 0x86, 0x80, 0x80, 0x40, 0x0b, 0xc0, 0xa0, 0x60, 0x50, 0x70, 0x28, 0x1c, 0x0e,
+    0x0e, 0x05, 0x03, 0x01, 0x07, 0x39, 0x0f, 0x8c, 0x01, 0x01, 0x08, 0x00, 0x38, 0x11, 0x80, 0x80,
+    0x00, 0xc0, 0x86, 0x40, 0x00, 0xc0, 0x80, 0x80, 0x01, 0x2c, 0x29, 0x0b, 0x80, 0xc0, 0x20, 0x30,
+    0x10, 0x0c, 0x04, 0x02, 0x02, 0x03, 0x01, 0x01, 0x8e, 0x00, 0x0b, 0x01, 0x01, 0x03, 0x02, 0x02,
+    0x04, 0x0c, 0x10, 0x30, 0x20, 0xc0, 0x80, 0x02, 0x28, 0x31, 0x04, 0xe0, 0x38, 0x06, 0x02, 0x01,
+    0x8c, 0x00, 0x80, 0x80, 0x80, 0x70, 0x80, 0x80, 0x8c, 0x00, 0x04, 0x01, 0x02, 0x06, 0x38, 0xe0,
+    0x03, 0x26, 0x35, 0x01, 0xf8, 0x0f, 0x8e, 0x00, 0x80, 0xfc, 0x80, 0x03, 0x80, 0xfc, 0x80, 0x03,
+    0x80, 0xfc, 0x8e, 0x00, 0x01, 0x0f, 0xf8, 0x04, 0x26, 0x35, 0x01, 0x3f, 0xe0, 0x88, 0x00, 0x80,
+    0xc0, 0x80, 0x3f, 0x83, 0x00, 0x80, 0xc7, 0x83, 0x00, 0x80, 0x3f, 0x80, 0xc0, 0x88, 0x00, 0x01,
+    0xe0, 0x3f, 0x05, 0x27, 0x33, 0x04, 0x01, 0x0e, 0x38, 0xc0, 0x80, 0x84, 0x00, 0x80, 0x0f, 0x86,
+    0x0e, 0x80, 0x0f, 0x86, 0x0e, 0x80, 0x0f, 0x84, 0x00, 0x04, 0x80, 0xc0, 0x38, 0x0e, 0x01, 0x06,
+    0x2c, 0x29, 0x06, 0x03, 0x06, 0x08, 0x18, 0x10, 0x60, 0x40, 0x80, 0x80, 0x92, 0x00, 0x80, 0x80,
+    0x06, 0x40, 0x60, 0x10, 0x18, 0x08, 0x06, 0x03, 0x07, 0x35, 0x17, 0x80, 0x01, 0x80, 0x02, 0x00,
+    0x06, 0x86, 0x04, 0x00, 0x06, 0x80, 0x02, 0x80, 0x01, 0x00, 0x08, 0x00, 0x34, 0x19, 0x80, 0x80,
+    0x04, 0x40, 0xc0, 0xa0, 0xa0, 0xe0, 0x81, 0x60, 0x00, 0x50, 0x81, 0x60, 0x04, 0xe0, 0xa0, 0xa0,
+    0xc0, 0x40, 0x80, 0x80, 0x01, 0x2a, 0x2d, 0x0d, 0x80, 0x40, 0xe0, 0xd0, 0x38, 0x34, 0x14, 0x0e,
+    0x05, 0x03, 0x02, 0x03, 0x01, 0x01, 0x8e, 0x00, 0x0d, 0x01, 0x01, 0x03, 0x02, 0x03, 0x05, 0x0e,
+    0x14, 0x34, 0x38, 0xd0, 0xe0, 0x40, 0x80, 0x02, 0x26, 0x35, 0x06, 0x80, 0x70, 0xec, 0x3a, 0x07,
+    0x02, 0x01, 0xa4, 0x00, 0x06, 0x01, 0x02, 0x07, 0x3a, 0xec, 0x70, 0x80, 0x03, 0x25, 0x37, 0x02,
+    0xfe, 0xf9, 0x0f, 0xae, 0x00, 0x02, 0x0f, 0xf9, 0xfe, 0x04, 0x24, 0x39, 0x03, 0x01, 0xfe, 0x3f,
+    0xe0, 0xae, 0x00, 0x03, 0xe0, 0x3f, 0xfe, 0x01, 0x05, 0x26, 0x35, 0x05, 0x03, 0x1d, 0x6e, 0xb8,
+    0xc0, 0x80, 0xa6, 0x00, 0x05, 0x80, 0xc0, 0xb8, 0x6e, 0x1d, 0x03, 0x06, 0x2a, 0x2d, 0x08, 0x03,
+    0x04, 0x0f, 0x16, 0x38, 0x58, 0x50, 0xe0, 0x40, 0x80, 0x80, 0x92, 0x00, 0x80, 0x80, 0x08, 0x40,
+    0xe0, 0x50, 0x58, 0x38, 0x16, 0x0f, 0x04, 0x03, 0x07, 0x32, 0x1d, 0x09, 0x01, 0x01, 0x02, 0x03,
+    0x03, 0x05, 0x06, 0x0a, 0x0a, 0x0e, 0x81, 0x0c, 0x00, 0x14, 0x81, 0x0c, 0x09, 0x0e, 0x0a, 0x0a,
+    0x06, 0x05, 0x03, 0x03, 0x02, 0x01, 0x01, 0x00, 0x08, 0x00, 0x31, 0x1f, 0x09, 0x80, 0x40, 0x40,
+    0xc0, 0xa0, 0xa0, 0x50, 0x50, 0x30, 0x30, 0x82, 0x28, 0x00, 0x18, 0x82, 0x28, 0x09, 0x30, 0x30,
+    0x50, 0x50, 0xa0, 0xa0, 0xc0, 0x40, 0xc0, 0x80, 0x01, 0x29, 0x2f, 0x0a, 0xc0, 0xa0, 0x50, 0x68,
+    0x14, 0x1a, 0x06, 0x05, 0x02, 0x01, 0x01, 0x96, 0x00, 0x0a, 0x01, 0x01, 0x02, 0x05, 0x06, 0x1a,
+    0x14, 0x68, 0x50, 0xa0, 0xc0, 0x02, 0x24, 0x39, 0x06, 0x80, 0x60, 0x9c, 0x72, 0x0d, 0x02, 0x01,
+    0xa8, 0x00, 0x06, 0x01, 0x02, 0x0d, 0x72, 0x9c, 0x60, 0x80, 0x03, 0x23, 0x3b, 0x03, 0xf8, 0x07,
+    0xfe, 0x01, 0xb0, 0x00, 0x03, 0x01, 0xfe, 0x07, 0xf8, 0x04, 0x23, 0x3b, 0x02, 0x3f, 0xc1, 0xfe,
+    0xb2, 0x00, 0x02, 0xfe, 0xc1, 0x3f, 0x05, 0x24, 0x39, 0x05, 0x03, 0x0c, 0x73, 0xdc, 0x60, 0x80,
+    0xaa, 0x00, 0x05, 0x80, 0x60, 0xdc, 0x73, 0x0c, 0x03, 0x06, 0x28, 0x31, 0x09, 0x01, 0x06, 0x0b,
+    0x14, 0x2c, 0x50, 0xb0, 0xc0, 0x40, 0x80, 0x9a, 0x00, 0x09, 0x80, 0x40, 0xc0, 0xb0, 0x50, 0x2c,
+    0x14, 0x0b, 0x06, 0x01, 0x07, 0x30, 0x21, 0x0a, 0x01, 0x02, 0x07, 0x05, 0x06, 0x0a, 0x0a, 0x14,
+    0x14, 0x18, 0x18, 0x82, 0x28, 0x00, 0x30, 0x82, 0x28, 0x0a, 0x18, 0x18, 0x14, 0x14, 0x0a, 0x0a,
+    0x06, 0x05, 0x07, 0x02, 0x01, 0x00, 0x08, 0x00, 0x2e, 0x25, 0x0c, 0x80, 0x80, 0x40, 0xc0, 0x60,
+    0x60, 0x50, 0x30, 0x28, 0x18, 0x18, 0x14, 0x14, 0x88, 0x0c, 0x0c, 0x14, 0x14, 0x18, 0x18, 0x28,
+    0x30, 0x50, 0x60, 0xe0, 0xc0, 0x40, 0x80, 0x80, 0x01, 0x27, 0x33, 0x09, 0xc0, 0x20, 0xd0, 0x28,
+    0x14, 0x0a, 0x05, 0x02, 0x02, 0x01, 0x9c, 0x00, 0x09, 0x01, 0x02, 0x02, 0x05, 0x0a, 0x14, 0x28,
+    0xd0, 0x20, 0xc0, 0x02, 0x23, 0x3b, 0x05, 0xc0, 0xb0, 0x6c, 0x1f, 0x02, 0x01, 0xac, 0x00, 0x05,
+    0x01, 0x02, 0x1f, 0x6c, 0xb0, 0xc0, 0x03, 0x22, 0x3d, 0x02, 0xfe, 0xf9, 0x07, 0xb4, 0x00, 0x02,
+    0x07, 0xf9, 0xfe, 0x04, 0x22, 0x3d, 0x02, 0xff, 0x3f, 0xc0, 0xb4, 0x00, 0x02, 0xc0, 0x3f, 0xff,
+    0x05, 0x23, 0x3b, 0x04, 0x07, 0x1b, 0x6c, 0xf0, 0xc0, 0xae, 0x00, 0x04, 0xc0, 0xf0, 0x6c, 0x1b,
+    0x07, 0x06, 0x26, 0x35, 0x09, 0x01, 0x06, 0x09, 0x16, 0x28, 0x50, 0xa0, 0x40, 0x80, 0x80, 0x9e,
+    0x00, 0x09, 0x80, 0x80, 0x40, 0xa0, 0x50, 0x28, 0x16, 0x09, 0x06, 0x01, 0x07, 0x2d, 0x27, 0x0d,
+    0x01, 0x02, 0x02, 0x05, 0x06, 0x0e, 0x0c, 0x14, 0x18, 0x28, 0x30, 0x30, 0x50, 0x50, 0x88, 0x60,
+    0x0d, 0x50, 0x50, 0x30, 0x30, 0x28, 0x18, 0x14, 0x0c, 0x0e, 0x06, 0x05, 0x02, 0x02, 0x01, 0x01,
+    0x08, 0x00, 0x00, 0x80, 0x00, 0xff, 0xfb, 0x01, 0x00, 0xff, 0x01, 0x00, 0x80, 0x00, 0xff, 0xb1,
+    0x00, 0x03, 0x80, 0x80, 0x40, 0x40, 0x80, 0x20, 0x86, 0x10, 0x80, 0x20, 0x03, 0x40, 0x40, 0x80,
+    0x80, 0xb0, 0x00, 0x00, 0xff, 0x02, 0x00, 0x80, 0x00, 0xff, 0xaa, 0x00, 0x06, 0x80, 0x60, 0x10,
+    0x08, 0x04, 0x02, 0x01, 0x84, 0x00, 0x80, 0x80, 0x80, 0x70, 0x80, 0x80, 0x84, 0x00, 0x06, 0x01,
+    0x02, 0x04, 0x08, 0x10, 0x60, 0x80, 0xa9, 0x00, 0x00, 0xff, 0x03, 0x00, 0x80, 0x00, 0xff, 0xa8,
+    0x00, 0x02, 0xf0, 0x0e, 0x01, 0x87, 0x00, 0x80, 0xfc, 0x80, 0x03, 0x80, 0xfc, 0x80, 0x03, 0x80,
+    0xfc, 0x87, 0x00, 0x02, 0x01, 0x0e, 0xf0, 0xa7, 0x00, 0x00, 0xff, 0x04, 0x00, 0x80, 0x00, 0xff,
+    0xa8, 0x00, 0x01, 0x1f, 0xe0, 0x82, 0x00, 0x80, 0xc0, 0x80, 0x3f, 0x83, 0x00, 0x80, 0xc7, 0x83,
+    0x00, 0x80, 0x3f, 0x80, 0xc0, 0x82, 0x00, 0x01, 0xe0, 0x1f, 0xa7, 0x00, 0x00, 0xff, 0x05, 0x00,
+    0x80, 0x00, 0xff, 0xaa, 0x00, 0x07, 0x03, 0x0c, 0x10, 0x20, 0x40, 0x8f, 0x0f, 0x0f, 0x86, 0x0e,
+    0x80, 0x0f, 0x86, 0x0e, 0x07, 0x0f, 0x0f, 0x8f, 0x40, 0x20, 0x10, 0x0c, 0x03, 0xa9, 0x00, 0x00,
+    0xff, 0x06, 0x00, 0x80, 0x00, 0xff, 0xb0, 0x00, 0x04, 0x01, 0x02, 0x02, 0x04, 0x04, 0x80, 0x08,
+    0x86, 0x10, 0x80, 0x08, 0x04, 0x04, 0x04, 0x02, 0x02, 0x01, 0xaf, 0x00, 0x00, 0xff, 0x07, 0x00,
+    0x80, 0x00, 0xff, 0xfb, 0x80, 0x00, 0xff, 0x00, 0x06, 0x01, 0x33, 0x1b, 0x08, 0x80, 0x40, 0xe0,
+    0xa0, 0x70, 0x50, 0x30, 0x28, 0x28, 0x81, 0x18, 0x00, 0x14, 0x81, 0x18, 0x08, 0x28, 0x28, 0x30,
+    0x50, 0x70, 0xa0, 0xe0, 0x40, 0x80, 0x02, 0x2c, 0x29, 0x08, 0x80, 0xe0, 0xb0, 0x68, 0x14, 0x0a,
+    0x05, 0x02, 0x01, 0x94, 0x00, 0x08, 0x01, 0x02, 0x05, 0x0a, 0x14, 0x68, 0xb0, 0xe0, 0x80, 0x03,
+    0x2b, 0x2b, 0x03, 0xfc, 0xf3, 0x0e, 0x01, 0xa0, 0x00, 0x03, 0x01, 0x0e, 0xf3, 0xfc, 0x04, 0x2a,
+    0x2d, 0x03, 0x01, 0x7e, 0x9f, 0xe0, 0xa2, 0x00, 0x03, 0xe0, 0x9f, 0x7e, 0x01, 0x05, 0x2c, 0x29,
+    0x07, 0x03, 0x0e, 0x1b, 0x2c, 0x50, 0xa0, 0x40, 0x80, 0x96, 0x00, 0x07, 0x80, 0x40, 0xa0, 0x50,
+    0x2c, 0x1b, 0x0e, 0x03, 0x06, 0x32, 0x1d, 0x09, 0x01, 0x02, 0x05, 0x0e, 0x0a, 0x1c, 0x14, 0x18,
+    0x28, 0x28, 0x81, 0x30, 0x00, 0x50, 0x81, 0x30, 0x09, 0x28, 0x28, 0x18, 0x14, 0x1c, 0x0a, 0x0e,
+    0x05, 0x02, 0x01, 0x00, 0x06, 0x01, 0x30, 0x21, 0x0b, 0x80, 0xc0, 0x60, 0xa0, 0x50, 0x70, 0x28,
+    0x38, 0x14, 0x14, 0x0c, 0x0c, 0x81, 0x0a, 0x00, 0x06, 0x81, 0x0a, 0x0b, 0x0c, 0x0c, 0x14, 0x14,
+    0x38, 0x28, 0x70, 0x50, 0xa0, 0x60, 0xc0, 0x80, 0x02, 0x2b, 0x2b, 0x07, 0xc0, 0xb0, 0xec, 0x36,
+    0x0b, 0x04, 0x02, 0x01, 0x98, 0x00, 0x07, 0x01, 0x02, 0x04, 0x0b, 0x36, 0xec, 0xb0, 0xc0, 0x03,
+    0x29, 0x2f, 0x03, 0xf0, 0x0f, 0xfc, 0x03, 0xa4, 0x00, 0x03, 0x03, 0xfc, 0x0f, 0xf0, 0x04, 0x29,
+    0x2f, 0x03, 0x1f, 0xe1, 0x7e, 0x80, 0xa4, 0x00, 0x03, 0x80, 0x7e, 0xe1, 0x1f, 0x05, 0x2a, 0x2d,
+    0x07, 0x01, 0x06, 0x1b, 0x6e, 0xd8, 0xa0, 0x40, 0x80, 0x9a, 0x00, 0x07, 0x80, 0x40, 0xa0, 0xd8,
+    0x6e, 0x1b, 0x06, 0x01, 0x06, 0x2f, 0x23, 0x0c, 0x01, 0x02, 0x06, 0x0d, 0x0a, 0x14, 0x1c, 0x28,
+    0x38, 0x50, 0x50, 0x60, 0x60, 0x81, 0xa0, 0x00, 0xc0, 0x81, 0xa0, 0x0c, 0x60, 0x60, 0x50, 0x50,
+    0x38, 0x28, 0x1c, 0x14, 0x0a, 0x0d, 0x06, 0x02, 0x01, 0x00, 0x07, 0x01, 0x2e, 0x25, 0x0a, 0x80,
+    0x40, 0xe0, 0xe0, 0x70, 0x28, 0x1c, 0x14, 0x0c, 0x0a, 0x06, 0x80, 0x05, 0x86, 0x03, 0x80, 0x05,
+    0x0a, 0x06, 0x0a, 0x0c, 0x14, 0x1c, 0x28, 0x70, 0xe0, 0xe0, 0x40, 0x80, 0x02, 0x29, 0x2f, 0x06,
+    0x80, 0x70, 0xd8, 0x34, 0x0f, 0x07, 0x03, 0x9e, 0x00, 0x06, 0x03, 0x07, 0x0f, 0x34, 0xd8, 0x70,
+    0x80, 0x03, 0x28, 0x31, 0x02, 0xfe, 0xf1, 0x0f, 0xa8, 0x00, 0x02, 0x0f, 0xf1, 0xfe, 0x04, 0x28,
+    0x31, 0x02, 0xff, 0x1f, 0xe0, 0xa8, 0x00, 0x02, 0xe0, 0x1f, 0xff, 0x05, 0x29, 0x2f, 0x06, 0x03,
+    0x1d, 0x36, 0x58, 0xe0, 0xc0, 0x80, 0x9e, 0x00, 0x06, 0x80, 0xc0, 0xe0, 0x58, 0x36, 0x1d, 0x03,
+    0x06, 0x2d, 0x27, 0x0b, 0x01, 0x03, 0x05, 0x0e, 0x0e, 0x1c, 0x28, 0x70, 0x50, 0x60, 0xa0, 0xc0,
+    0x80, 0x40, 0x86, 0x80, 0x80, 0x40, 0x0b, 0xc0, 0xa0, 0x60, 0x50, 0x70, 0x28, 0x1c, 0x0e, 0x0e,
+    0x05, 0x03, 0x01, 0x07, 0x39, 0x0f, 0x8c, 0x01, 0x01, 0x08, 0x00, 0x38, 0x11, 0x80, 0x80, 0x00,
+    0xc0, 0x86, 0x40, 0x00, 0xc0, 0x80, 0x80, 0x01, 0x2c, 0x29, 0x0b, 0x80, 0xc0, 0x20, 0x30, 0x10,
+    0x0c, 0x04, 0x02, 0x02, 0x03, 0x01, 0x01, 0x8e, 0x00, 0x0b, 0x01, 0x01, 0x03, 0x02, 0x02, 0x04,
+    0x0c, 0x10, 0x30, 0x20, 0xc0, 0x80, 0x02, 0x28, 0x31, 0x04, 0xe0, 0x38, 0x06, 0x02, 0x01, 0x8c,
+    0x00, 0x80, 0x80, 0x80, 0x70, 0x80, 0x80, 0x8c, 0x00, 0x04, 0x01, 0x02, 0x06, 0x38, 0xe0, 0x03,
+    0x26, 0x35, 0x01, 0xf8, 0x0f, 0x8e, 0x00, 0x80, 0xfc, 0x80, 0x03, 0x80, 0xfc, 0x80, 0x03, 0x80,
+    0xfc, 0x8e, 0x00, 0x01, 0x0f, 0xf8, 0x04, 0x26, 0x35, 0x01, 0x3f, 0xe0, 0x88, 0x00, 0x80, 0xc0,
+    0x80, 0x3f, 0x83, 0x00, 0x80, 0xc7, 0x83, 0x00, 0x80, 0x3f, 0x80, 0xc0, 0x88, 0x00, 0x01, 0xe0,
+    0x3f, 0x05, 0x27, 0x33, 0x04, 0x01, 0x0e, 0x38, 0xc0, 0x80, 0x84, 0x00, 0x80, 0x0f, 0x86, 0x0e,
+    0x80, 0x0f, 0x86, 0x0e, 0x80, 0x0f, 0x84, 0x00, 0x04, 0x80, 0xc0, 0x38, 0x0e, 0x01, 0x06, 0x2c,
+    0x29, 0x06, 0x03, 0x06, 0x08, 0x18, 0x10, 0x60, 0x40, 0x80, 0x80, 0x92, 0x00, 0x80, 0x80, 0x06,
+    0x40, 0x60, 0x10, 0x18, 0x08, 0x06, 0x03, 0x07, 0x35, 0x17, 0x80, 0x01, 0x80, 0x02, 0x00, 0x06,
+    0x86, 0x04, 0x00, 0x06, 0x80, 0x02, 0x80, 0x01, 0x00, 0x08, 0x00, 0x34, 0x19, 0x80, 0x80, 0x04,
+    0x40, 0xc0, 0xa0, 0xa0, 0xe0, 0x81, 0x60, 0x00, 0x50, 0x81, 0x60, 0x04, 0xe0, 0xa0, 0xa0, 0xc0,
+    0x40, 0x80, 0x80, 0x01, 0x2a, 0x2d, 0x0d, 0x80, 0x40, 0xe0, 0xd0, 0x38, 0x34, 0x14, 0x0e, 0x05,
+    0x03, 0x02, 0x03, 0x01, 0x01, 0x8e, 0x00, 0x0d, 0x01, 0x01, 0x03, 0x02, 0x03, 0x05, 0x0e, 0x14,
+    0x34, 0x38, 0xd0, 0xe0, 0x40, 0x80, 0x02, 0x26, 0x35, 0x06, 0x80, 0x70, 0xec, 0x3a, 0x07, 0x02,
+    0x01, 0xa4, 0x00, 0x06, 0x01, 0x02, 0x07, 0x3a, 0xec, 0x70, 0x80, 0x03, 0x25, 0x37, 0x02, 0xfe,
+    0xf9, 0x0f, 0xae, 0x00, 0x02, 0x0f, 0xf9, 0xfe, 0x04, 0x24, 0x39, 0x03, 0x01, 0xfe, 0x3f, 0xe0,
+    0xae, 0x00, 0x03, 0xe0, 0x3f, 0xfe, 0x01, 0x05, 0x26, 0x35, 0x05, 0x03, 0x1d, 0x6e, 0xb8, 0xc0,
+    0x80, 0xa6, 0x00, 0x05, 0x80, 0xc0, 0xb8, 0x6e, 0x1d, 0x03, 0x06, 0x2a, 0x2d, 0x08, 0x03, 0x04,
+    0x0f, 0x16, 0x38, 0x58, 0x50, 0xe0, 0x40, 0x80, 0x80, 0x92, 0x00, 0x80, 0x80, 0x08, 0x40, 0xe0,
+    0x50, 0x58, 0x38, 0x16, 0x0f, 0x04, 0x03, 0x07, 0x32, 0x1d, 0x09, 0x01, 0x01, 0x02, 0x03, 0x03,
+    0x05, 0x06, 0x0a, 0x0a, 0x0e, 0x81, 0x0c, 0x00, 0x14, 0x81, 0x0c, 0x09, 0x0e, 0x0a, 0x0a, 0x06,
+    0x05, 0x03, 0x03, 0x02, 0x01, 0x01, 0x00, 0x08, 0x00, 0x31, 0x1f, 0x09, 0x80, 0x40, 0x40, 0xc0,
+    0xa0, 0xa0, 0x50, 0x50, 0x30, 0x30, 0x82, 0x28, 0x00, 0x18, 0x82, 0x28, 0x09, 0x30, 0x30, 0x50,
+    0x50, 0xa0, 0xa0, 0xc0, 0x40, 0xc0, 0x80, 0x01, 0x29, 0x2f, 0x0a, 0xc0, 0xa0, 0x50, 0x68, 0x14,
+    0x1a, 0x06, 0x05, 0x02, 0x01, 0x01, 0x96, 0x00, 0x0a, 0x01, 0x01, 0x02, 0x05, 0x06, 0x1a, 0x14,
+    0x68, 0x50, 0xa0, 0xc0, 0x02, 0x24, 0x39, 0x06, 0x80, 0x60, 0x9c, 0x72, 0x0d, 0x02, 0x01, 0xa8,
+    0x00, 0x06, 0x01, 0x02, 0x0d, 0x72, 0x9c, 0x60, 0x80, 0x03, 0x23, 0x3b, 0x03, 0xf8, 0x07, 0xfe,
+    0x01, 0xb0, 0x00, 0x03, 0x01, 0xfe, 0x07, 0xf8, 0x04, 0x23, 0x3b, 0x02, 0x3f, 0xc1, 0xfe, 0xb2,
+    0x00, 0x02, 0xfe, 0xc1, 0x3f, 0x05, 0x24, 0x39, 0x05, 0x03, 0x0c, 0x73, 0xdc, 0x60, 0x80, 0xaa,
+    0x00, 0x05, 0x80, 0x60, 0xdc, 0x73, 0x0c, 0x03, 0x06, 0x28, 0x31, 0x09, 0x01, 0x06, 0x0b, 0x14,
+    0x2c, 0x50, 0xb0, 0xc0, 0x40, 0x80, 0x9a, 0x00, 0x09, 0x80, 0x40, 0xc0, 0xb0, 0x50, 0x2c, 0x14,
+    0x0b, 0x06, 0x01, 0x07, 0x30, 0x21, 0x0a, 0x01, 0x02, 0x07, 0x05, 0x06, 0x0a, 0x0a, 0x14, 0x14,
+    0x18, 0x18, 0x82, 0x28, 0x00, 0x30, 0x82, 0x28, 0x0a, 0x18, 0x18, 0x14, 0x14, 0x0a, 0x0a, 0x06,
+    0x05, 0x07, 0x02, 0x01, 0x00, 0x08, 0x00, 0x2e, 0x25, 0x0c, 0x80, 0x80, 0x40, 0xc0, 0x60, 0x60,
+    0x50, 0x30, 0x28, 0x18, 0x18, 0x14, 0x14, 0x88, 0x0c, 0x0c, 0x14, 0x14, 0x18, 0x18, 0x28, 0x30,
+    0x50, 0x60, 0xe0, 0xc0, 0x40, 0x80, 0x80, 0x01, 0x27, 0x33, 0x09, 0xc0, 0x20, 0xd0, 0x28, 0x14,
+    0x0a, 0x05, 0x02, 0x02, 0x01, 0x9c, 0x00, 0x09, 0x01, 0x02, 0x02, 0x05, 0x0a, 0x14, 0x28, 0xd0,
+    0x20, 0xc0, 0x02, 0x23, 0x3b, 0x05, 0xc0, 0xb0, 0x6c, 0x1f, 0x02, 0x01, 0xac, 0x00, 0x05, 0x01,
+    0x02, 0x1f, 0x6c, 0xb0, 0xc0, 0x03, 0x22, 0x3d, 0x02, 0xfe, 0xf9, 0x07, 0xb4, 0x00, 0x02, 0x07,
+    0xf9, 0xfe, 0x04, 0x22, 0x3d, 0x02, 0xff, 0x3f, 0xc0, 0xb4, 0x00, 0x02, 0xc0, 0x3f, 0xff, 0x05,
+    0x23, 0x3b, 0x04, 0x07, 0x1b, 0x6c, 0xf0, 0xc0, 0xae, 0x00, 0x04, 0xc0, 0xf0, 0x6c, 0x1b, 0x07,
+    0x06, 0x26, 0x35, 0x09, 0x01, 0x06, 0x09, 0x16, 0x28, 0x50, 0xa0, 0x40, 0x80, 0x80, 0x9e, 0x00,
+    0x09, 0x80, 0x80, 0x40, 0xa0, 0x50, 0x28, 0x16, 0x09, 0x06, 0x01, 0x07, 0x2d, 0x27, 0x0d, 0x01,
+    0x02, 0x02, 0x05, 0x06, 0x0e, 0x0c, 0x14, 0x18, 0x28, 0x30, 0x30, 0x50, 0x50, 0x88, 0x60, 0x0d,
+    0x50, 0x50, 0x30, 0x30, 0x28, 0x18, 0x14, 0x0c, 0x0e, 0x06, 0x05, 0x02, 0x02, 0x01,
+};
+
+const oled_anim_t oled_anim_alert = {
+    .name = "alert",
+    .data = alert_data,
+    .len = 2814,
+    .frames = 16,
+    .width = 128,
+    .height = 64,
+    .fps = 12,
+    .loop = true,
+};
+
+const oled_anim_t *const oled_anim_list[] = {
+    &oled_anim_boot,
+    &oled_anim_alert,
+};
+const size_t oled_anim_count = 2;
@@ -0,0 +1,14 @@
+/* Generated by tools/gen_oled_anims.py - do not edit by hand */
+#ifndef OLED_ANIMS_H
+#define OLED_ANIMS_H
+
+#include "oled_anim.h"
+
+extern const oled_anim_t oled_anim_boot;
+extern const oled_anim_t oled_anim_alert;
+
+/* All animations, for lookup by name */
+extern const oled_anim_t *const oled_anim_list[];
+extern const size_t oled_anim_count;
+
+#endif /* OLED_ANIMS_H */
@@ -0,0 +1,545 @@
+#include "oled_font.h"
+#include <string.h>
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+static const char *TAG = "oled_font";
+
+#ifdef CONFIG_OLED_GLYPH_CACHE_SIZE
+#define OLED_GLYPH_CACHE_SIZE   CONFIG_OLED_GLYPH_CACHE_SIZE
+#else
+#define OLED_GLYPH_CACHE_SIZE   64
+#endif
+#define OLED_GLYPH_HASH_SIZE    64      /* power of two */
+#define OLED_GLYPH_NONE         0xFF    /* empty link / bucket */
+
+/* Image layout (little endian):
+ *   header  magic[4] "OFN1", u16 version, u8 height, u8 reserved, u32 count, u32 index_offset
+ *   index   count x {u32 codepoint, u32 record_offset}, sorted by codepoint
+ *   record  u8 width, u8 encoding, u16 length, data[length]
+ * Decoded glyph data is page-major: width bytes per page, ceil(height / 8) pages. */
+#define OLED_FONT_HEADER_SIZE   16
+#define OLED_FONT_INDEX_ENTRY   8
+#define OLED_FONT_RECORD_HEADER 4
+
+typedef struct {
+    uint32_t codepoint;
+    uint8_t width;          /* 0: code point not in the font (cached negative lookup) */
+    uint8_t prev;           /* LRU list, towards most recently used */
+    uint8_t next;           /* LRU list, towards least recently used */
+    uint8_t hash_next;      /* bucket chain */
+    uint8_t bitmap[OLED_FONT_GLYPH_BYTES];
+} oled_glyph_t;
+
+typedef struct {
+    const uint8_t *image;
+    size_t size;
+    uint32_t count;
+    const uint8_t *index;
+    uint8_t height;
+    uint8_t pages;
+    uint8_t used;           /* cache slots handed out so far */
+    uint8_t mru;
+    uint8_t lru;
+    uint8_t buckets[OLED_GLYPH_HASH_SIZE];
+    oled_glyph_t glyphs[OLED_GLYPH_CACHE_SIZE];
+    oled_font_stats_t stats;
+} oled_font_t;
+
+_Static_assert(OLED_GLYPH_CACHE_SIZE < OLED_GLYPH_NONE, "glyph cache indices are uint8_t");
+
+static oled_font_t oled_font = {0};
+
+/* 函数名：oled_font_rd16 / oled_font_rd32
+ *
+ * 函数说明：读取小端 16/32 位整数（映像中的字段不保证对齐）。
+ * 参数：
+ *   p - 数据地址。
+ * 返回值：
+ *   读取的数值。
+ */
+static uint16_t oled_font_rd16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t oled_font_rd32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/* 函数名：oled_font_cache_reset
+ *
+ * 函数说明：清空字形缓存与统计。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void oled_font_cache_reset(void)
+{
+    oled_font.used = 0;
+    oled_font.mru = OLED_GLYPH_NONE;
+    oled_font.lru = OLED_GLYPH_NONE;
+    memset(oled_font.buckets, OLED_GLYPH_NONE, sizeof(oled_font.buckets));
+    memset(&oled_font.stats, 0, sizeof(oled_font.stats));
+}
+
+/* 函数名：oled_font_attach
+ *
+ * 函数说明：挂载字体映像（通常为内存映射的 Flash 分区），校验头部与索引范围。
+ *           映像须在 detach 之前保持可访问。
+ * 参数：
+ *   image - 映像起始地址。
+ *   size  - 映像大小（字节）。
+ * 返回值：
+ *   ESP_OK 成功；ESP_ERR_INVALID_ARG 参数为空；ESP_ERR_INVALID_VERSION 魔数或版本不符；
+ *   ESP_ERR_INVALID_SIZE 索引超出映像或字形尺寸不受支持。
+ */
+esp_err_t oled_font_attach(const void *image, size_t size)
+{
+    const uint8_t *p = image;
+    oled_font_detach();
+
+    if (!p || size < OLED_FONT_HEADER_SIZE) return ESP_ERR_INVALID_ARG;
+    if (memcmp(p, OLED_FONT_MAGIC, 4) != 0 || oled_font_rd16(p + 4) != OLED_FONT_VERSION) {
+        ESP_LOGW(TAG, "Font image has no valid header");
+        return ESP_ERR_INVALID_VERSION;
+    }
+
+    uint8_t height = p[6];
+    uint32_t count = oled_font_rd32(p + 8);
+    uint32_t index_off = oled_font_rd32(p + 12);
+    if (height == 0 || height > OLED_FONT_MAX_HEIGHT || index_off < OLED_FONT_HEADER_SIZE ||
+        index_off > size || count > (size - index_off) / OLED_FONT_INDEX_ENTRY) {
+        ESP_LOGW(TAG, "Font image is truncated or unsupported (height %u, %u glyphs)",
+                 (unsigned)height, (unsigned)count);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    oled_font.image = p;
+    oled_font.size = size;
+    oled_font.count = count;
+    oled_font.index = p + index_off;
+    oled_font.height = height;
+    oled_font.pages = (uint8_t)((height + 7) / 8);
+    oled_font_cache_reset();
+
+    ESP_LOGI(TAG, "Font attached: %u glyphs, %u px high", (unsigned)count, (unsigned)height);
+    return ESP_OK;
+}
+
+/* 函数名：oled_font_detach
+ *
+ * 函数说明：卸载字体映像并清空缓存，之后文本回退为内置 5x8 ASCII 字体。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+void oled_font_detach(void)
+{
+    oled_font.image = NULL;
+    oled_font.size = 0;
+    oled_font.count = 0;
+    oled_font.index = NULL;
+    oled_font.height = 0;
+    oled_font_cache_reset();
+}
+
+/* 函数名：oled_font_ready
+ *
+ * 函数说明：查询是否已挂载字体映像。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   true 已挂载。
+ */
+bool oled_font_ready(void)
+{
+    return oled_font.image != NULL;
+}
+
+/* 函数名：oled_font_height
+ *
+ * 函数说明：获取字体行高；未挂载时返回内置字体高度。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   行高（像素）。
+ */
+uint8_t oled_font_height(void)
+{
+    return oled_font.image ? oled_font.height : FONT_CHAR_HEIGHT;
+}
+
+/* 函数名：oled_font_needed
+ *
+ * 函数说明：判断字符串是否含有内置 ASCII 字体无法显示的字符（非 ASCII 字节）。
+ * 参数：
+ *   str - 字符串，可为 NULL。
+ * 返回值：
+ *   true 表示需要走 UTF-8 字体路径。
+ */
+bool oled_font_needed(const char *str)
+{
+    if (!str) return false;
+    for (const unsigned char *p = (const unsigned char *)str; *p; p++) {
+        if (*p >= 0x80) return true;
+    }
+    return false;
+}
+
+/* 函数名：oled_font_next_codepoint
+ *
+ * 函数说明：解码一个 UTF-8 码点。非法序列按单字节跳过并返回 U+FFFD。
+ * 参数：
+ *   str - 输入/输出：当前读取位置（不得指向结束符），解码后前移。
+ * 返回值：
+ *   码点。
+ */
+uint32_t oled_font_next_codepoint(const char **str)
+{
+    const unsigned char *p = (const unsigned char *)*str;
+    uint32_t cp;
+    uint8_t extra;
+
+    if (p[0] < 0x80) {
+        *str = (const char *)(p + 1);
+        return p[0];
+    } else if ((p[0] & 0xE0) == 0xC0) {
+        cp = p[0] & 0x1F; extra = 1;
+    } else if ((p[0] & 0xF0) == 0xE0) {
+        cp = p[0] & 0x0F; extra = 2;
+    } else if ((p[0] & 0xF8) == 0xF0) {
+        cp = p[0] & 0x07; extra = 3;
+    } else {
+        *str = (const char *)(p + 1);
+        return 0xFFFD;
+    }
+
+    for (uint8_t i = 1; i <= extra; i++) {
+        if ((p[i] & 0xC0) != 0x80) {  /* also stops at the terminator */
+            *str = (const char *)(p + 1);
+            return 0xFFFD;
+        }
+        cp = (cp << 6) | (p[i] & 0x3F);
+    }
+    *str = (const char *)(p + 1 + extra);
+    return cp;
+}
+
+/* 函数名：oled_font_unpack_sink
+ *
+ * 函数说明：字形解压回调：把一段解出的字节拷贝到字形缓冲。
+ * 参数：
+ *   ctx  - 字形缓冲。
+ *   out  - 字节偏移。
+ *   src  - 字面字节；重复段为 NULL。
+ *   fill - 重复字节。
+ *   n    - 字节数。
+ * 返回值：
+ *   无。
+ */
+static void oled_font_unpack_sink(void *ctx, size_t out, const uint8_t *src, uint8_t fill, size_t n)
+{
+    uint8_t *dst = (uint8_t *)ctx + out;
+    if (src) {
+        memcpy(dst, src, n);
+    } else {
+        memset(dst, fill, n);
+    }
+}
+
+/* 函数名：oled_font_unpack
+ *
+ * 函数说明：按 PackBits 解压字形数据（格式见 ssd1306_rle_decode）。
+ * 参数：
+ *   src, src_len - 压缩数据。
+ *   dst, dst_len - 输出缓冲与期望长度。
+ * 返回值：
+ *   true 数据恰好解出 dst_len 字节。
+ */
+static bool oled_font_unpack(const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_len)
+{
+    return ssd1306_rle_decode(src, src_len, dst_len, NULL, oled_font_unpack_sink, dst) == ESP_OK;
+}
+
+/* 函数名：oled_font_decode
+ *
+ * 函数说明：在映像索引中二分查找码点并解码字形到缓存槽位。
+ * 参数：
+ *   cp    - 码点。
+ *   glyph - 目标缓存槽位；找不到或数据损坏时 width 置 0。
+ * 返回值：
+ *   无。
+ */
+static void oled_font_decode(uint32_t cp, oled_glyph_t *glyph)
+{
+    glyph->codepoint = cp;
+    glyph->width = 0;
+
+    uint32_t lo = 0, hi = oled_font.count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        uint32_t key = oled_font_rd32(oled_font.index + (size_t)mid * OLED_FONT_INDEX_ENTRY);
+        if (key < cp) {
+            lo = mid + 1;
+        } else if (key > cp) {
+            hi = mid;
+        } else {
+            lo = mid;
+            break;
+        }
+    }
+    if (lo >= oled_font.count ||
+        oled_font_rd32(oled_font.index + (size_t)lo * OLED_FONT_INDEX_ENTRY) != cp) {
+        oled_font.stats.missing++;
+        return;
+    }
+
+    uint32_t off = oled_font_rd32(oled_font.index + (size_t)lo * OLED_FONT_INDEX_ENTRY + 4);
+    if (off > oled_font.size || oled_font.size - off < OLED_FONT_RECORD_HEADER) return;
+
+    const uint8_t *rec = oled_font.image + off;
+    uint8_t width = rec[0];
+    uint8_t enc = rec[1];
+    uint16_t len = oled_font_rd16(rec + 2);
+    size_t need = (size_t)width * oled_font.pages;
+    if (width == 0 || width > OLED_FONT_MAX_WIDTH ||
+        oled_font.size - off - OLED_FONT_RECORD_HEADER < len) {
+        return;
+    }
+
+    const uint8_t *data = rec + OLED_FONT_RECORD_HEADER;
+    if (enc == OLED_FONT_ENC_RAW) {
+        if (len != need) return;
+        memcpy(glyph->bitmap, data, need);
+    } else if (enc != OLED_FONT_ENC_PACKBITS || !oled_font_unpack(data, len, glyph->bitmap, need)) {
+        return;
+    }
+    glyph->width = width;
+}
+
+/* 函数名：oled_font_lru_unlink / oled_font_lru_push
+ *
+ * 函数说明：从 LRU 链表中摘除槽位 / 把槽位放到链表头（最近使用）。
+ * 参数：
+ *   i - 槽位下标。
+ * 返回值：
+ *   无。
+ */
+static void oled_font_lru_unlink(uint8_t i)
+{
+    oled_glyph_t *g = &oled_font.glyphs[i];
+    if (g->prev != OLED_GLYPH_NONE) oled_font.glyphs[g->prev].next = g->next;
+    else oled_font.mru = g->next;
+    if (g->next != OLED_GLYPH_NONE) oled_font.glyphs[g->next].prev = g->prev;
+    else oled_font.lru = g->prev;
+}
+
+static void oled_font_lru_push(uint8_t i)
+{
+    oled_glyph_t *g = &oled_font.glyphs[i];
+    g->prev = OLED_GLYPH_NONE;
+    g->next = oled_font.mru;
+    if (oled_font.mru != OLED_GLYPH_NONE) oled_font.glyphs[oled_font.mru].prev = i;
+    oled_font.mru = i;
+    if (oled_font.lru == OLED_GLYPH_NONE) oled_font.lru = i;
+}
+
+/* 函数名：oled_font_hash_remove
+ *
+ * 函数说明：把被淘汰的槽位从其哈希桶链中摘除。
+ * 参数：
+ *   i - 槽位下标。
+ * 返回值：
+ *   无。
+ */
+static void oled_font_hash_remove(uint8_t i)
+{
+    uint8_t *link = &oled_font.buckets[oled_font.glyphs[i].codepoint & (OLED_GLYPH_HASH_SIZE - 1)];
+    while (*link != OLED_GLYPH_NONE) {
+        if (*link == i) {
+            *link = oled_font.glyphs[i].hash_next;
+            return;
+        }
+        link = &oled_font.glyphs[*link].hash_next;
+    }
+}
+
+/* 函数名：oled_font_glyph
+ *
+ * 函数说明：获取码点对应的解码字形。命中缓存时移到 LRU 头部；未命中时解码到
+ *           空闲槽位或淘汰最久未使用的槽位。字体中没有的码点也会缓存（width 为 0）。
+ * 参数：
+ *   cp - 码点。
+ * 返回值：
+ *   缓存中的字形，指针在下一次查找前有效。
+ */
+static const oled_glyph_t *oled_font_glyph(uint32_t cp)
+{
+    uint8_t bucket = (uint8_t)(cp & (OLED_GLYPH_HASH_SIZE - 1));
+    for (uint8_t i = oled_font.buckets[bucket]; i != OLED_GLYPH_NONE; i = oled_font.glyphs[i].hash_next) {
+        if (oled_font.glyphs[i].codepoint == cp) {
+            oled_font.stats.hits++;
+            if (oled_font.mru != i) {
+                oled_font_lru_unlink(i);
+                oled_font_lru_push(i);
+            }
+            return &oled_font.glyphs[i];
+        }
+    }
+
+    uint8_t slot;
+    if (oled_font.used < OLED_GLYPH_CACHE_SIZE) {
+        slot = oled_font.used++;
+    } else {
+        slot = oled_font.lru;
+        oled_font_lru_unlink(slot);
+        oled_font_hash_remove(slot);
+        oled_font.stats.evictions++;
+    }
+
+    oled_font.stats.misses++;
+    oled_glyph_t *g = &oled_font.glyphs[slot];
+    oled_font_decode(cp, g);
+    g->hash_next = oled_font.buckets[bucket];
+    oled_font.buckets[bucket] = slot;
+    oled_font_lru_push(slot);
+    return g;
+}
+
+/* 函数名：oled_font_metrics
+ *
+ * 函数说明：计算字符的前进宽度与墨迹宽度：字体字形按其宽度，字体中没有的 ASCII
+ *           按内置 5x8 字体，其余缺字按方框。
+ * 参数：
+ *   cp    - 码点。
+ *   g     - 缓存中的字形。
+ *   ink   - 输出：墨迹宽度（行尾是否放得下以此判断）。
+ * 返回值：
+ *   前进宽度。
+ */
+static uint16_t oled_font_metrics(uint32_t cp, const oled_glyph_t *g, uint16_t *ink)
+{
+    if (g->width) {
+        *ink = g->width;
+        return g->width;
+    }
+    if (cp < 0x80) {
+        *ink = FONT_CHAR_WIDTH;
+        return FONT_TOTAL_WIDTH;
+    }
+    uint16_t advance = (uint16_t)(oled_font.height / 2 + 2);  /* tofu box */
+    *ink = (uint16_t)(advance - 1);
+    return advance;
+}
+
+/* 函数名：oled_font_measure
+ *
+ * 函数说明：测量字符按 oled_font_text 绘制时占用的宽度，供排版使用。
+ *           未挂载字体时按内置 5x8 字体规则测量。
+ * 参数：
+ *   cp  - 码点。
+ *   ink - 输出：墨迹宽度，可为 NULL。
+ * 返回值：
+ *   前进宽度，不绘制的字符返回 0。
+ */
+uint16_t oled_font_measure(uint32_t cp, uint16_t *ink)
+{
+    uint16_t dummy;
+    if (!ink) ink = &dummy;
+    *ink = 0;
+
+    if (!oled_font.image) {
+        if (cp < 0x20 || cp > 0x7F) return 0;
+        *ink = FONT_CHAR_WIDTH;
+        return FONT_TOTAL_WIDTH;
+    }
+    if (cp < 0x20 || cp == 0x7F) return 0;
+    return oled_font_metrics(cp, oled_font_glyph(cp), ink);
+}
+
+/* 函数名：oled_font_text
+ *
+ * 函数说明：绘制 UTF-8 字符串。字符优先使用字体映像中的字形，映像中没有的 ASCII
+ *           字符用内置 5x8 字体贴底绘制，其余缺字画空心方框。行高为字体高度，
+ *           换行/截断规则与 ssd1306_text 相同。未挂载字体时等同于 ssd1306_text。
+ * 参数：
+ *   dev - 设备句柄。
+ *   str - UTF-8 字符串。
+ *   x, y - 起始坐标。
+ *   color - 非 0 置 1，0 置 0。
+ *   wrap_mode - 0 自动换行，1 截断当前行。
+ * 返回值：
+ *   无。
+ */
+void oled_font_text(ssd1306_t *dev, const char *str, uint16_t x, uint16_t y, uint8_t color, uint8_t wrap_mode)
+{
+    if (!str) return;
+    if (!oled_font.image) {
+        ssd1306_text(dev, str, x, y, color, wrap_mode);
+        return;
+    }
+
+    const uint16_t line_h = oled_font.height;
+    const char *p = str;
+    uint16_t cur_x = x;
+    uint16_t cur_y = y;
+    char ascii[2] = {0};
+
+    while (*p) {
+        uint32_t cp = oled_font_next_codepoint(&p);
+        if (cp < 0x20 || cp == 0x7F) continue;
+
+        const oled_glyph_t *g = oled_font_glyph(cp);
+        uint16_t ink;
+        uint16_t advance = oled_font_metrics(cp, g, &ink);
+
+        /* Check if character will exceed screen width */
+        if (cur_x + ink > dev->width) {
+            if (wrap_mode != 0) break;
+            cur_x = x;
+            cur_y += line_h;
+        }
+        if (cur_y + line_h > dev->height) break;
+
+        if (g->width) {
+            ssd1306_bitmap(dev, g->bitmap, cur_x, cur_y, g->width, line_h, color);
+        } else if (cp < 0x80) {
+            ascii[0] = (char)cp;
+            ssd1306_text(dev, ascii, cur_x, (uint16_t)(cur_y + line_h - FONT_CHAR_HEIGHT), color, 1);
+        } else {
+            ssd1306_rect(dev, (uint16_t)(cur_x + 1), (uint16_t)(cur_y + 2), (uint16_t)(advance - 2),
+                         (uint16_t)(line_h - 3), color);
+        }
+        cur_x += advance;
+    }
+}
+
+/* 函数名：oled_font_get_stats
+ *
+ * 函数说明：读取字形缓存统计（命中、未命中、淘汰、缺字）。
+ * 参数：
+ *   out - 输出统计结构。
+ * 返回值：
+ *   无。
+ */
+void oled_font_get_stats(oled_font_stats_t *out)
+{
+    if (out) *out = oled_font.stats;
+}
+
+/* 函数名：oled_font_reset_stats
+ *
+ * 函数说明：清零字形缓存统计。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+void oled_font_reset_stats(void)
+{
+    memset(&oled_font.stats, 0, sizeof(oled_font.stats));
+}
@@ -0,0 +1,57 @@
+/*
+ * UTF-8 点阵字体文本渲染
+ *
+ * 字体映像由 tools/gen_oled_font.py 生成，存放在 "font" 数据分区并以内存映射方式
+ * 原地读取：字形按码点排序索引，页格式 1bpp，PackBits 压缩。解码后的字形保存在
+ * RAM 中的 LRU 缓存里，重复出现的字符只需一次查表和一次 ssd1306_bitmap()。
+ * 本模块不加锁，由调用方串行访问（集成层在 oled_mutex 内调用）。
+ */
+#ifndef OLED_FONT_H
+#define OLED_FONT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define OLED_FONT_MAGIC         "OFN1"
+#define OLED_FONT_VERSION       1
+#define OLED_FONT_MAX_WIDTH     16
+#define OLED_FONT_MAX_HEIGHT    16
+#define OLED_FONT_GLYPH_BYTES   (OLED_FONT_MAX_WIDTH * ((OLED_FONT_MAX_HEIGHT + 7) / 8))
+
+/* Glyph record encodings */
+#define OLED_FONT_ENC_RAW       0
+#define OLED_FONT_ENC_PACKBITS  1
+
+typedef struct {
+    uint32_t hits;          /* glyph served from the cache */
+    uint32_t misses;        /* glyph looked up and decoded from the font image */
+    uint32_t evictions;     /* least recently used glyph dropped to make room */
+    uint32_t missing;       /* code point not present in the font */
+} oled_font_stats_t;
+
+esp_err_t oled_font_attach(const void *image, size_t size);
+void oled_font_detach(void);
+bool oled_font_ready(void);
+uint8_t oled_font_height(void);
+bool oled_font_needed(const char *str);
+uint32_t oled_font_next_codepoint(const char **str);
+uint16_t oled_font_measure(uint32_t cp, uint16_t *ink);
+
+void oled_font_text(ssd1306_t *dev, const char *str, uint16_t x, uint16_t y, uint8_t color, uint8_t wrap_mode);
+/* wrap_mode: 0 = auto wrap to next line, 1 = truncate (no wrap) */
+
+void oled_font_get_stats(oled_font_stats_t *out);
+void oled_font_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OLED_FONT_H */
@@ -0,0 +1,174 @@
+#include "oled_frame.h"
+#include <string.h>
+
+/* 函数名：oled_frame_read_exact
+ *
+ * 函数说明：循环调用读取回调直到读满 len 字节（网络数据可能分多段到达）。
+ * 参数：
+ *   read - 读取回调。
+ *   ctx  - 回调上下文。
+ *   dst  - 目标地址。
+ *   len  - 字节数。
+ * 返回值：
+ *   ESP_OK 读满；ESP_FAIL 请求体提前结束或读取出错。
+ */
+static esp_err_t oled_frame_read_exact(oled_frame_read_fn read, void *ctx, uint8_t *dst, size_t len)
+{
+    while (len > 0) {
+        int n = read(ctx, dst, len);
+        if (n <= 0) return ESP_FAIL;
+        dst += n;
+        len -= (size_t)n;
+    }
+    return ESP_OK;
+}
+
+/* 函数名：oled_frame_recv_full
+ *
+ * 函数说明：逐页把完整帧直接读入帧缓冲。
+ * 参数：
+ *   dev  - 设备句柄。
+ *   read - 读取回调。
+ *   ctx  - 回调上下文。
+ * 返回值：
+ *   ESP_OK 成功；ESP_FAIL 读取失败。
+ */
+static esp_err_t oled_frame_recv_full(ssd1306_t *dev, oled_frame_read_fn read, void *ctx)
+{
+    for (uint8_t page = 0; page < dev->pages; page++) {
+        uint8_t *dst = ssd1306_page_span(dev, page, 0, dev->width);
+        esp_err_t ret = oled_frame_read_exact(read, ctx, dst, dev->width);
+        if (ret != ESP_OK) return ret;
+    }
+    return ESP_OK;
+}
+
+/* 函数名：oled_frame_recv_delta
+ *
+ * 函数说明：逐条读取增量记录，校验页/列范围后把数据直接读入帧缓冲对应列段。
+ * 参数：
+ *   dev      - 设备句柄。
+ *   body_len - 请求体长度。
+ *   read     - 读取回调。
+ *   ctx      - 回调上下文。
+ * 返回值：
+ *   ESP_OK 成功；ESP_ERR_INVALID_SIZE 记录越界或与请求体长度不符（此前的记录已写入）；
+ *   ESP_FAIL 读取失败。
+ */
+static esp_err_t oled_frame_recv_delta(ssd1306_t *dev, size_t body_len, oled_frame_read_fn read, void *ctx)
+{
+    while (body_len > 0) {
+        uint8_t hdr[OLED_FRAME_DELTA_HEADER];
+        if (body_len < sizeof(hdr)) return ESP_ERR_INVALID_SIZE;
+        esp_err_t ret = oled_frame_read_exact(read, ctx, hdr, sizeof(hdr));
+        if (ret != ESP_OK) return ret;
+        body_len -= sizeof(hdr);
+
+        if (hdr[2] > body_len) return ESP_ERR_INVALID_SIZE;
+        uint8_t *dst = ssd1306_page_span(dev, hdr[0], hdr[1], hdr[2]);
+        if (dst == NULL) return ESP_ERR_INVALID_SIZE;
+        ret = oled_frame_read_exact(read, ctx, dst, hdr[2]);
+        if (ret != ESP_OK) return ret;
+        body_len -= hdr[2];
+    }
+    return ESP_OK;
+}
+
+/* 函数名：oled_frame_recv
+ *
+ * 函数说明：把推送的帧直接读入帧缓冲并标记脏区，调用方随后刷新即可。
+ *           完整帧长度必须等于 width * pages；增量帧为空时视为“无变化”。
+ * 参数：
+ *   dev      - 设备句柄（通常为后台帧）。
+ *   format   - 完整帧或增量帧。
+ *   body_len - 请求体长度。
+ *   read     - 读取回调。
+ *   ctx      - 回调上下文。
+ * 返回值：
+ *   ESP_OK 成功；ESP_ERR_INVALID_ARG 参数为空；ESP_ERR_INVALID_SIZE 长度或记录不合法；
+ *   ESP_FAIL 读取失败。失败时帧缓冲可能已被部分覆盖。
+ */
+esp_err_t oled_frame_recv(ssd1306_t *dev, oled_frame_format_t format, size_t body_len,
+                          oled_frame_read_fn read, void *ctx)
+{
+    if (!dev || !dev->buffer || !read) return ESP_ERR_INVALID_ARG;
+
+    if (format == OLED_FRAME_FULL) {
+        if (body_len != (size_t)dev->width * dev->pages) return ESP_ERR_INVALID_SIZE;
+        return oled_frame_recv_full(dev, read, ctx);
+    }
+    return oled_frame_recv_delta(dev, body_len, read, ctx);
+}
+
+/* 函数名：oled_frame_diff
+ *
+ * 函数说明：逐页比较帧缓冲与副本，把变化的列段编码为增量记录（间隔不超过一个记录头
+ *           的相邻变化段合并为一条），并把副本更新为当前帧。
+ * 参数：
+ *   dev  - 设备句柄。
+ *   copy - 接收方已有的帧副本（width * pages 字节），输出后与帧缓冲一致。
+ *   out  - 输出缓冲。
+ *   cap  - 输出缓冲大小，至少 OLED_FRAME_DIFF_MAX(width, pages)。
+ * 返回值：
+ *   增量长度，0 表示无变化；cap 不足时返回 0 且副本不变。
+ */
+size_t oled_frame_diff(const ssd1306_t *dev, uint8_t *copy, uint8_t *out, size_t cap)
+{
+    if (cap < OLED_FRAME_DIFF_MAX(dev->width, dev->pages)) return 0;
+
+    size_t o = 0;
+    for (uint8_t page = 0; page < dev->pages; page++) {
+        const uint8_t *cur = dev->buffer + (size_t)page * dev->width;
+        uint8_t *old = copy + (size_t)page * dev->width;
+        uint16_t col = 0;
+
+        while (col < dev->width) {
+            if (cur[col] == old[col]) {
+                col++;
+                continue;
+            }
+            /* Extend the run over short unchanged gaps */
+            uint16_t end = (uint16_t)(col + 1);
+            uint16_t last = col;
+            while (end < dev->width && end - last <= OLED_FRAME_DIFF_GAP) {
+                if (cur[end] != old[end]) last = end;
+                end++;
+            }
+            uint16_t len = (uint16_t)(last - col + 1);
+            out[o++] = page;
+            out[o++] = (uint8_t)col;
+            out[o++] = (uint8_t)len;
+            memcpy(out + o, cur + col, len);
+            memcpy(old + col, cur + col, len);
+            o += len;
+            col = (uint16_t)(last + 1);
+        }
+    }
+    return o;
+}
+
+/* 函数名：oled_frame_pbm_rows
+ *
+ * 函数说明：把一页（8 行像素）从页格式转换为 PBM（P4）行格式：每行 ceil(width/8)
+ *           字节，最高位为最左像素，1 为黑色（即点亮的像素）。
+ * 参数：
+ *   dev  - 设备句柄。
+ *   page - 页号。
+ *   out  - 输出缓冲（8 * ceil(width/8) 字节）。
+ * 返回值：
+ *   无。
+ */
+void oled_frame_pbm_rows(const ssd1306_t *dev, uint8_t page, uint8_t *out)
+{
+    const uint8_t *src = dev->buffer + (size_t)page * dev->width;
+    uint16_t stride = (uint16_t)((dev->width + 7) / 8);
+
+    memset(out, 0, (size_t)stride * 8);
+    for (uint16_t x = 0; x < dev->width; x++) {
+        uint8_t column = src[x];
+        uint8_t mask = (uint8_t)(0x80 >> (x & 7));
+        for (uint8_t row = 0; column; row++, column >>= 1) {
+            if (column & 1) out[row * stride + x / 8] |= mask;
+        }
+    }
+}
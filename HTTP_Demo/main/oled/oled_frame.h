@@ -0,0 +1,50 @@
+/*
+ * 远程渲染帧接收
+ *
+ * 服务器端渲染好的 1bpp 帧（与 SSD1306 帧缓冲相同的页格式）经 HTTP 请求体推送到
+ * 设备。请求体按页/列段直接读入 ssd1306_t 的帧缓冲并标记脏区，不经过中间缓冲；
+ * 随后 ssd1306_show() 的差分刷新只把变化的字节送上总线。
+ *
+ * 两种格式：
+ *   完整帧：width * pages 字节，按页依次排列。
+ *   增量帧：若干条记录 {u8 page, u8 col, u8 len, len 字节}，覆盖上一帧的对应列段。
+ *
+ * 反方向（实时镜像）使用同一增量格式：oled_frame_diff() 比较帧缓冲与客户端已有的
+ * 副本，只编码变化的列段；oled_frame_pbm_rows() 把一页转换为 PBM（P4）的 8 行。
+ *
+ * 本模块不依赖 HTTP 服务器，由调用方提供读取回调；不加锁，由调用方串行访问。
+ */
+#ifndef OLED_FRAME_H
+#define OLED_FRAME_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define OLED_FRAME_DELTA_HEADER  3      /* page, col, len */
+#define OLED_FRAME_DIFF_GAP      OLED_FRAME_DELTA_HEADER  /* unchanged bytes cheaper to resend than a new record */
+/* Largest diff: every page resent as one record */
+#define OLED_FRAME_DIFF_MAX(width, pages)  ((size_t)(pages) * (OLED_FRAME_DELTA_HEADER + (width)))
+
+typedef enum {
+    OLED_FRAME_FULL,
+    OLED_FRAME_DELTA,
+} oled_frame_format_t;
+
+/* Reads up to len bytes of the request body into dst: bytes read, or <= 0 on error / end of body */
+typedef int (*oled_frame_read_fn)(void *ctx, uint8_t *dst, size_t len);
+
+esp_err_t oled_frame_recv(ssd1306_t *dev, oled_frame_format_t format, size_t body_len,
+                          oled_frame_read_fn read, void *ctx);
+size_t oled_frame_diff(const ssd1306_t *dev, uint8_t *copy, uint8_t *out, size_t cap);
+void oled_frame_pbm_rows(const ssd1306_t *dev, uint8_t page, uint8_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OLED_FRAME_H */
@@ -0,0 +1,235 @@
+#include "oled_i2c_cal.h"
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char *TAG = "oled_i2c_cal";
+
+#define CAL_XFER_TIMEOUT_MS     50
+#define CAL_PROBE_TIMEOUT_MS    20
+#define CAL_NONE                SIZE_MAX
+
+const uint32_t oled_i2c_cal_candidates[] = { 100000, 400000, 550000, 700000, 850000, 1000000 };
+const size_t oled_i2c_cal_candidate_count = sizeof(oled_i2c_cal_candidates) / sizeof(oled_i2c_cal_candidates[0]);
+
+/* 函数名：oled_i2c_cal_pattern
+ *
+ * 函数说明：生成一页压力测试数据：按帧轮换交错棋盘（0x55/0xAA）、整字节翻转（0x00/0xFF）
+ *           与伪随机图案，使 SDA 在相邻位、相邻字节间都频繁翻转。
+ * 参数：
+ *   row   - 输出（width 字节）。
+ *   width - 每页列数。
+ *   frame - 帧序号。
+ *   page  - 页号。
+ *   seed  - 伪随机状态（xorshift32，非 0）。
+ * 返回值：
+ *   无。
+ */
+static void oled_i2c_cal_pattern(uint8_t *row, uint16_t width, uint32_t frame, uint8_t page, uint32_t *seed)
+{
+    for (uint16_t col = 0; col < width; col++) {
+        switch (frame % 3) {
+            case 0:
+                row[col] = ((col + page + frame / 3) & 1) ? 0x55 : 0xAA;
+                break;
+            case 1:
+                row[col] = ((col + frame / 3) & 1) ? 0xFF : 0x00;
+                break;
+            default:
+                *seed ^= *seed << 13;
+                *seed ^= *seed >> 17;
+                *seed ^= *seed << 5;
+                row[col] = (uint8_t)*seed;
+                break;
+        }
+    }
+}
+
+/* 函数名：oled_i2c_cal_run
+ *
+ * 函数说明：以给定 SCL 频率添加设备，发送若干帧压力测试数据（每页一个页/列地址命令事务
+ *           与一个数据事务，SSD1306 与 SH1106 都支持这组命令），统计失败的事务与每帧
+ *           平均耗时，最后探测一次地址并移除设备。
+ * 参数：
+ *   bus    - I2C 总线。
+ *   addr   - 面板地址。
+ *   freq   - SCL 频率。
+ *   width  - 每页列数。
+ *   pages  - 页数。
+ *   frames - 发送帧数。
+ *   buf    - 数据事务缓冲（1 + width 字节）。
+ *   point  - 输出统计。
+ * 返回值：
+ *   ESP_OK 测试已完成（错误计入 point）；添加设备失败返回对应错误码。
+ */
+static esp_err_t oled_i2c_cal_run(i2c_master_bus_handle_t bus, uint16_t addr, uint32_t freq,
+                                  uint16_t width, uint8_t pages, uint32_t frames, uint8_t *buf,
+                                  oled_i2c_cal_point_t *point)
+{
+    i2c_device_config_t config = {
+        .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+        .device_address = addr,
+        .scl_speed_hz = freq,
+    };
+    i2c_master_dev_handle_t dev;
+    esp_err_t ret = i2c_master_bus_add_device(bus, &config, &dev);
+    if (ret != ESP_OK) return ret;
+
+    uint32_t seed = 0x2545F491u ^ freq;
+    memset(point, 0, sizeof(*point));
+    point->freq_hz = freq;
+
+    int64_t t0 = esp_timer_get_time();
+    for (uint32_t f = 0; f < frames; f++) {
+        for (uint8_t page = 0; page < pages; page++) {
+            const uint8_t cmds[] = { 0x00, (uint8_t)(0xB0 | page), 0x00, 0x10 };
+            if (i2c_master_transmit(dev, cmds, sizeof(cmds), CAL_XFER_TIMEOUT_MS) != ESP_OK) {
+                point->errors++;
+            }
+            buf[0] = 0x40;
+            oled_i2c_cal_pattern(buf + 1, width, f, page, &seed);
+            if (i2c_master_transmit(dev, buf, 1 + (size_t)width, CAL_XFER_TIMEOUT_MS) != ESP_OK) {
+                point->errors++;
+            }
+        }
+        point->frames++;
+    }
+    point->frame_us = frames ? (uint32_t)((esp_timer_get_time() - t0) / frames) : 0;
+
+    /* Still answering its address: the bus is not stuck after the stress run */
+    if (i2c_master_probe(bus, addr, CAL_PROBE_TIMEOUT_MS) != ESP_OK) {
+        point->errors++;
+    }
+    i2c_master_bus_rm_device(dev);
+    return ESP_OK;
+}
+
+/* 函数名：oled_i2c_cal_sweep
+ *
+ * 函数说明：从低到高扫描候选 SCL 频率，按头文件所述规则选出最快的稳定频率
+ *           （速度收益不足的频率不算更快；紧邻的更高频率出错时再降一档），再以更多帧
+ *           确认，确认出错则继续降档。结束时面板 GDDRAM 内容为测试图案，须重新初始化。
+ * 参数：
+ *   bus    - I2C 总线。
+ *   addr   - 面板地址。
+ *   width  - 面板宽度（像素）。
+ *   pages  - 面板页数。
+ *   report - 输出各频率的统计与选定频率。
+ * 返回值：
+ *   ESP_OK 已选定频率；ESP_ERR_NOT_FOUND 最低频率也不稳定；ESP_ERR_INVALID_ARG 参数错误；
+ *   ESP_ERR_NO_MEM 分配失败；添加设备失败时返回对应错误码。
+ */
+esp_err_t oled_i2c_cal_sweep(i2c_master_bus_handle_t bus, uint16_t addr, uint16_t width, uint8_t pages,
+                             oled_i2c_cal_report_t *report)
+{
+    if (!bus || !report || width == 0 || pages == 0) return ESP_ERR_INVALID_ARG;
+    memset(report, 0, sizeof(*report));
+
+    uint8_t *buf = (uint8_t *)malloc(1 + (size_t)width);
+    if (!buf) return ESP_ERR_NO_MEM;
+
+    esp_err_t ret = ESP_OK;
+    size_t best = CAL_NONE;
+    size_t failed = CAL_NONE;
+    for (size_t i = 0; i < oled_i2c_cal_candidate_count && i < OLED_I2C_CAL_MAX_CANDIDATES; i++) {
+        oled_i2c_cal_point_t *pt = &report->points[i];
+        ret = oled_i2c_cal_run(bus, addr, oled_i2c_cal_candidates[i], width, pages, OLED_I2C_CAL_FRAMES, buf, pt);
+        if (ret != ESP_OK) break;
+        report->tested++;
+        ESP_LOGI(TAG, "%7lu Hz: %lu errors in %lu frames, %lu us per frame", (unsigned long)pt->freq_hz,
+                 (unsigned long)pt->errors, (unsigned long)pt->frames, (unsigned long)pt->frame_us);
+        if (pt->errors) {
+            failed = i;
+            break;
+        }
+        if (best == CAL_NONE ||
+            (uint64_t)pt->frame_us * 100 <= (uint64_t)report->points[best].frame_us * (100 - OLED_I2C_CAL_MIN_GAIN_PCT)) {
+            best = i;
+        }
+    }
+    if (ret != ESP_OK) {
+        free(buf);
+        return ret;
+    }
+
+    /* Margin: do not settle right below a rate that already failed */
+    if (best != CAL_NONE && best > 0 && failed == best + 1) {
+        best--;
+    }
+    while (best != CAL_NONE) {
+        oled_i2c_cal_point_t confirm;
+        ret = oled_i2c_cal_run(bus, addr, oled_i2c_cal_candidates[best], width, pages,
+                               OLED_I2C_CAL_CONFIRM_FRAMES, buf, &confirm);
+        if (ret != ESP_OK) break;
+        if (confirm.errors == 0) {
+            report->chosen_hz = confirm.freq_hz;
+            break;
+        }
+        ESP_LOGW(TAG, "%lu Hz failed confirmation (%lu errors)", (unsigned long)confirm.freq_hz,
+                 (unsigned long)confirm.errors);
+        best = best > 0 ? best - 1 : CAL_NONE;
+    }
+    free(buf);
+    if (ret != ESP_OK) return ret;
+    return report->chosen_hz ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+/* 函数名：oled_i2c_cal_is_candidate
+ *
+ * 函数说明：频率是否为候选频率之一（用于校验 NVS 中保存的值）。
+ * 参数：
+ *   freq_hz - 频率。
+ * 返回值：
+ *   true 是候选频率。
+ */
+bool oled_i2c_cal_is_candidate(uint32_t freq_hz)
+{
+    for (size_t i = 0; i < oled_i2c_cal_candidate_count; i++) {
+        if (oled_i2c_cal_candidates[i] == freq_hz) return true;
+    }
+    return false;
+}
+
+/* 函数名：oled_i2c_cal_slower
+ *
+ * 函数说明：运行期降档：返回低于给定频率的最高候选频率。
+ * 参数：
+ *   freq_hz - 当前频率。
+ * 返回值：
+ *   下一档频率；已在最低候选频率或更低时返回 freq_hz 本身。
+ */
+uint32_t oled_i2c_cal_slower(uint32_t freq_hz)
+{
+    uint32_t slower = freq_hz;
+    for (size_t i = 0; i < oled_i2c_cal_candidate_count; i++) {
+        if (oled_i2c_cal_candidates[i] < freq_hz) slower = oled_i2c_cal_candidates[i];
+    }
+    return slower;
+}
+
+/* 函数名：oled_i2c_health_record
+ *
+ * 函数说明：记录一次刷新结果。每 OLED_I2C_HEALTH_WINDOW 次刷新为一个窗口，窗口内失败
+ *           达到 OLED_I2C_HEALTH_MAX_ERRORS 次时返回 true（并开始新窗口），调用方应降档。
+ * 参数：
+ *   h  - 统计状态。
+ *   ok - 本次刷新是否成功。
+ * 返回值：
+ *   true 错误率过高，应降低 SCL 频率。
+ */
+bool oled_i2c_health_record(oled_i2c_health_t *h, bool ok)
+{
+    h->flushes++;
+    if (!ok) h->errors++;
+    if (h->errors >= OLED_I2C_HEALTH_MAX_ERRORS) {
+        h->flushes = 0;
+        h->errors = 0;
+        return true;
+    }
+    if (h->flushes >= OLED_I2C_HEALTH_WINDOW) {
+        h->flushes = 0;
+        h->errors = 0;
+    }
+    return false;
+}
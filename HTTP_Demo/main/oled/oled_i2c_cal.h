@@ -0,0 +1,74 @@
+/*
+ * I2C 时钟自动校准
+ *
+ * 开机时按从低到高的候选 SCL 频率依次给面板添加设备并做写入压力测试：每帧按页发送
+ * 页/列地址命令与整页数据（0x55/0xAA、0x00/0xFF 与伪随机图案交替，覆盖 SDA 的各种翻转），
+ * 统计发送错误（NACK/超时）与每帧耗时，测试后再探测一次地址确认面板仍然应答。
+ * SSD1306/SH1106 在 I2C 下不可回读，“校验”即每个字节都被应答且总线未挂死。
+ *
+ * 选择规则：
+ *   - 出现第一个错误的频率即停止扫描，更高频率不再尝试；
+ *   - 每帧耗时比上一个稳定频率缩短不足 OLED_I2C_CAL_MIN_GAIN_PCT% 的频率不算更快
+ *     （面板拉伸时钟或上拉太弱时提高 SCL 并不提高吞吐）；
+ *   - 若紧邻的更高频率出错，再降一档留出余量（温度、线缆变化）；
+ *   - 选定频率再以更多帧确认一次，仍出错则继续降档。
+ *
+ * 运行期由 oled_i2c_health_record() 统计刷新错误率，窗口内错误过多时由调用方降到
+ * oled_i2c_cal_slower() 给出的下一档。结果的保存（NVS）与设备的重新添加由调用方完成。
+ */
+#ifndef OLED_I2C_CAL_H
+#define OLED_I2C_CAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "driver/i2c_master.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define OLED_I2C_CAL_MAX_CANDIDATES  8
+#define OLED_I2C_CAL_FRAMES          8      /* stress frames per candidate */
+#define OLED_I2C_CAL_CONFIRM_FRAMES  24     /* stress frames at the chosen rate */
+#define OLED_I2C_CAL_MIN_GAIN_PCT    5      /* a faster clock must cut frame time by this much */
+
+#define OLED_I2C_HEALTH_WINDOW       64     /* flushes per error-rate window */
+#define OLED_I2C_HEALTH_MAX_ERRORS   3      /* errors within one window that call for a slower clock */
+
+/* Candidate SCL frequencies, ascending */
+extern const uint32_t oled_i2c_cal_candidates[];
+extern const size_t oled_i2c_cal_candidate_count;
+
+/* One swept frequency */
+typedef struct {
+    uint32_t freq_hz;
+    uint32_t frames;        /* stress frames sent */
+    uint32_t errors;        /* failed transmits, plus a failed probe afterwards */
+    uint32_t frame_us;      /* average time of one stress frame */
+} oled_i2c_cal_point_t;
+
+/* Sweep result */
+typedef struct {
+    uint32_t chosen_hz;     /* 0 when even the slowest candidate failed */
+    size_t tested;
+    oled_i2c_cal_point_t points[OLED_I2C_CAL_MAX_CANDIDATES];
+} oled_i2c_cal_report_t;
+
+/* Flush error-rate monitor */
+typedef struct {
+    uint16_t flushes;
+    uint16_t errors;
+} oled_i2c_health_t;
+
+esp_err_t oled_i2c_cal_sweep(i2c_master_bus_handle_t bus, uint16_t addr, uint16_t width, uint8_t pages,
+                             oled_i2c_cal_report_t *report);
+bool oled_i2c_cal_is_candidate(uint32_t freq_hz);
+uint32_t oled_i2c_cal_slower(uint32_t freq_hz);
+bool oled_i2c_health_record(oled_i2c_health_t *h, bool ok);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OLED_I2C_CAL_H */
@@ -0,0 +1,55 @@
+/* Generated by tools/gen_oled_icons.py - do not edit by hand */
+#include "oled_icons.h"
+
+/* 11x8, raw */
+static const uint8_t wifi_data[11] = {
+    0x04, 0x12, 0x0a, 0x29, 0x95, 0xd5, 0x95, 0x29, 0x0a, 0x12, 0x04,
+};
+
+const ssd1306_image_t oled_icon_wifi = {
+    .data = wifi_data,
+    .len = 11,
+    .w = 11,
+    .h = 8,
+    .rle = false,
+};
+
+/* 7x7, raw */
+static const uint8_t lock_data[7] = {
+    0x78, 0x7e, 0x79, 0x49, 0x79, 0x7e, 0x78,
+};
+
+const ssd1306_image_t oled_icon_lock = {
+    .data = lock_data,
+    .len = 7,
+    .w = 7,
+    .h = 7,
+    .rle = false,
+};
+
+/* 9x8, raw */
+static const uint8_t warning_data[9] = {
+    0xc0, 0xb0, 0x8c, 0x82, 0xdd, 0x82, 0x8c, 0xb0, 0xc0,
+};
+
+const ssd1306_image_t oled_icon_warning = {
+    .data = warning_data,
+    .len = 9,
+    .w = 9,
+    .h = 8,
+    .rle = false,
+};
+
+/* 32x16, PackBits 64 -> 26 bytes */
+static const uint8_t chip_data[26] = {
+    0x06, 0x48, 0x48, 0x00, 0x00, 0xfe, 0xfe, 0xf6, 0x92, 0xfe, 0x07, 0x00, 0x00, 0x48, 0x48, 0x12,
+    0x12, 0x00, 0x00, 0x95, 0x7f, 0x03, 0x00, 0x00, 0x12, 0x12,
+};
+
+const ssd1306_image_t oled_icon_chip = {
+    .data = chip_data,
+    .len = 26,
+    .w = 32,
+    .h = 16,
+    .rle = true,
+};
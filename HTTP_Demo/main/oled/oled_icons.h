@@ -0,0 +1,12 @@
+/* Generated by tools/gen_oled_icons.py - do not edit by hand */
+#ifndef OLED_ICONS_H
+#define OLED_ICONS_H
+
+#include "ssd1306.h"
+
+extern const ssd1306_image_t oled_icon_wifi;
+extern const ssd1306_image_t oled_icon_lock;
+extern const ssd1306_image_t oled_icon_warning;
+extern const ssd1306_image_t oled_icon_chip;
+
+#endif /* OLED_ICONS_H */
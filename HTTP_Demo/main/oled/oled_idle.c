@@ -0,0 +1,142 @@
+#include "oled_idle.h"
+#include <string.h>
+
+/* 函数名：oled_idle_enter
+ *
+ * 函数说明：切换状态，把上一状态本段的时长计入累计时长。
+ * 参数：
+ *   idle   - 空闲状态。
+ *   state  - 新状态。
+ *   now_us - 当前时间。
+ * 返回值：
+ *   无。
+ */
+static void oled_idle_enter(oled_idle_t *idle, oled_idle_state_t state, int64_t now_us)
+{
+    idle->state_us[idle->state] += (uint64_t)(now_us - idle->state_since_us);
+    idle->state = state;
+    idle->state_since_us = now_us;
+}
+
+/* 函数名：oled_idle_init
+ *
+ * 函数说明：初始化空闲策略，从 ACTIVE 开始计时（面板须已按 cfg->contrast 打开）。
+ * 参数：
+ *   idle   - 空闲状态。
+ *   cfg    - 策略配置。
+ *   now_us - 当前时间。
+ * 返回值：
+ *   无。
+ */
+void oled_idle_init(oled_idle_t *idle, const oled_idle_config_t *cfg, int64_t now_us)
+{
+    memset(idle, 0, sizeof(*idle));
+    idle->cfg = *cfg;
+    idle->state = OLED_IDLE_ACTIVE;
+    idle->last_activity_us = now_us;
+    idle->state_since_us = now_us;
+}
+
+/* 函数名：oled_idle_activity
+ *
+ * 函数说明：记录一次活动。面板已调暗或关闭时立即恢复对比度并打开显示；命令失败时
+ *           保持原状态，下一次活动重试。
+ * 参数：
+ *   idle   - 空闲状态。
+ *   dev    - 面板（前台帧）设备句柄。
+ *   now_us - 当前时间。
+ * 返回值：
+ *   ESP_OK 表示成功，否则为总线错误码。
+ */
+esp_err_t oled_idle_activity(oled_idle_t *idle, ssd1306_t *dev, int64_t now_us)
+{
+    idle->last_activity_us = now_us;
+    if (idle->state == OLED_IDLE_ACTIVE) return ESP_OK;
+
+    esp_err_t ret = ESP_OK;
+    if (idle->dimmed) {
+        ret = ssd1306_set_contrast(dev, idle->cfg.contrast);
+        if (ret == ESP_OK) idle->dimmed = false;
+    }
+    if (ret == ESP_OK && idle->state == OLED_IDLE_OFF) {
+        ret = ssd1306_power_on(dev);
+    }
+    if (ret != ESP_OK) {
+        idle->errors++;
+        return ret;
+    }
+    oled_idle_enter(idle, OLED_IDLE_ACTIVE, now_us);
+    idle->wakes++;
+    return ESP_OK;
+}
+
+/* 函数名：oled_idle_update
+ *
+ * 函数说明：按距最近一次活动的时长推进到应处的状态（只会变暗或关闭，不会自行唤醒）。
+ *           命令失败时状态照样推进并计入错误，避免反复重试占用总线；面板多亮一会并无害处。
+ * 参数：
+ *   idle   - 空闲状态。
+ *   dev    - 面板（前台帧）设备句柄。
+ *   now_us - 当前时间。
+ * 返回值：
+ *   ESP_OK 表示成功或无需切换，否则为总线错误码。
+ */
+esp_err_t oled_idle_update(oled_idle_t *idle, ssd1306_t *dev, int64_t now_us)
+{
+    int64_t idle_ms = (now_us - idle->last_activity_us) / 1000;
+    oled_idle_state_t target = OLED_IDLE_ACTIVE;
+    if (idle->cfg.off_after_ms && idle_ms >= idle->cfg.off_after_ms) {
+        target = OLED_IDLE_OFF;
+    } else if (idle->cfg.dim_after_ms && idle_ms >= idle->cfg.dim_after_ms) {
+        target = OLED_IDLE_DIM;
+    }
+    if (target <= idle->state) return ESP_OK;
+
+    esp_err_t ret;
+    if (target == OLED_IDLE_DIM) {
+        ret = ssd1306_set_contrast(dev, idle->cfg.dim_contrast);
+        if (ret == ESP_OK) idle->dimmed = true;
+    } else {
+        ret = ssd1306_power_off(dev);
+    }
+    if (ret != ESP_OK) idle->errors++;
+    oled_idle_enter(idle, target, now_us);
+    return ret;
+}
+
+/* 函数名：oled_idle_next_us
+ *
+ * 函数说明：下一次状态切换的时间（供渲染任务计算等待时长）。
+ * 参数：
+ *   idle - 空闲状态。
+ * 返回值：
+ *   切换时间；已关闭或策略不再切换时返回 -1。
+ */
+int64_t oled_idle_next_us(const oled_idle_t *idle)
+{
+    if (idle->state == OLED_IDLE_ACTIVE && idle->cfg.dim_after_ms &&
+        (idle->cfg.off_after_ms == 0 || idle->cfg.dim_after_ms < idle->cfg.off_after_ms)) {
+        return idle->last_activity_us + (int64_t)idle->cfg.dim_after_ms * 1000;
+    }
+    if (idle->state != OLED_IDLE_OFF && idle->cfg.off_after_ms) {
+        return idle->last_activity_us + (int64_t)idle->cfg.off_after_ms * 1000;
+    }
+    return -1;
+}
+
+/* 函数名：oled_idle_time_in
+ *
+ * 函数说明：某状态的累计时长，含当前状态正在进行的一段。
+ * 参数：
+ *   idle   - 空闲状态。
+ *   state  - 状态。
+ *   now_us - 当前时间。
+ * 返回值：
+ *   累计时长（微秒）。
+ */
+uint64_t oled_idle_time_in(const oled_idle_t *idle, oled_idle_state_t state, int64_t now_us)
+{
+    uint64_t t = idle->state_us[state];
+    if (state == idle->state) t += (uint64_t)(now_us - idle->state_since_us);
+    return t;
+}
@@ -0,0 +1,61 @@
+/*
+ * 显示空闲策略：自动调暗与关屏
+ *
+ * 状态按最近一次活动（新的屏幕请求、推送帧、动画播放）后的时长推进：
+ *   ACTIVE --dim_after_ms--> DIM（ssd1306_set_contrast 降到 dim_contrast）
+ *          --off_after_ms--> OFF（ssd1306_power_off，GDDRAM 内容保留）
+ * 时长为 0 的阶段被跳过；off_after_ms 不大于 dim_after_ms 时直接关屏。
+ * 有活动时立即唤醒：恢复对比度并打开显示，只发送一两条命令，无需重新初始化。
+ * 每个状态的累计时长与唤醒次数一并统计。
+ *
+ * 本模块不加锁、不计时：时间由调用方传入，面板命令在调用方（渲染任务）中发送，
+ * 与刷新共用同一总线顺序。
+ */
+#ifndef OLED_IDLE_H
+#define OLED_IDLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    OLED_IDLE_ACTIVE = 0,
+    OLED_IDLE_DIM,
+    OLED_IDLE_OFF,
+    OLED_IDLE_STATES,
+} oled_idle_state_t;
+
+/* Policy: inactivity thresholds and contrast levels */
+typedef struct {
+    uint32_t dim_after_ms;  /* inactivity before dimming, 0: never dim */
+    uint32_t off_after_ms;  /* inactivity before switching the panel off, 0: never */
+    uint8_t contrast;       /* contrast while active */
+    uint8_t dim_contrast;
+} oled_idle_config_t;
+
+typedef struct {
+    oled_idle_config_t cfg;
+    oled_idle_state_t state;
+    bool dimmed;                        /* panel contrast is dim_contrast */
+    int64_t last_activity_us;
+    int64_t state_since_us;
+    uint64_t state_us[OLED_IDLE_STATES]; /* time in each state, current stretch excluded */
+    uint32_t wakes;                     /* DIM/OFF -> ACTIVE */
+    uint32_t errors;                    /* panel commands that failed */
+} oled_idle_t;
+
+void oled_idle_init(oled_idle_t *idle, const oled_idle_config_t *cfg, int64_t now_us);
+esp_err_t oled_idle_activity(oled_idle_t *idle, ssd1306_t *dev, int64_t now_us);
+esp_err_t oled_idle_update(oled_idle_t *idle, ssd1306_t *dev, int64_t now_us);
+int64_t oled_idle_next_us(const oled_idle_t *idle);
+uint64_t oled_idle_time_in(const oled_idle_t *idle, oled_idle_state_t state, int64_t now_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OLED_IDLE_H */
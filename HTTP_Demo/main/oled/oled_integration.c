@@ -1,49 +1,1657 @@
 #include "oled_integration.h"
+#include "oled_templates.h"
+#include "oled_icons.h"
+#include "oled_widget.h"
+#include "oled_font.h"
+#include "oled_layout.h"
+#include "oled_frame.h"
+#include "oled_anim.h"
+#include "oled_i2c_cal.h"
+#include "oled_idle.h"
+#include "oled_pins.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdkconfig.h"
 #include "driver/i2c_master.h"
+#include "driver/spi_master.h"
+#include "esp_attr.h"
+#include "esp_partition.h"
+#include "nvs.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
+#include "freertos/task.h"
 
 static const char *TAG = "oled_integration";
 
-/* I2C configuration - Hardware I2C1 */
+/* I2C configuration - Hardware I2C1 (pins in oled_pins.h) */
 #define I2C_NUM           1         /* Hardware I2C port 1 */
-#define I2C_SDA_PIN       25        /* GPIO25 - Standard SDA for I2C1 */
-#define I2C_SCL_PIN       26        /* GPIO26 - Standard SCL for I2C1 */
-#define I2C_FREQ_HZ       700000    /* 700 kHz boosted I2C speed (verify hardware) */
+#define I2C_FREQ_HZ       700000    /* 700 kHz boosted I2C speed, used unless calibrated */
+
+/* SCL calibration at boot, result kept in NVS (menuconfig: OLED_I2C_CALIBRATE) */
+#ifdef CONFIG_OLED_I2C_CALIBRATE
+#define OLED_I2C_CALIBRATE  1
+#else
+#define OLED_I2C_CALIBRATE  0
+#endif
+#define OLED_NVS_NAMESPACE  "oled"
+#define OLED_NVS_I2C_HZ     "i2c_hz"
+
+/* SPI configuration (menuconfig: OLED bus) - SPI2 with DMA */
+#ifdef CONFIG_OLED_BUS_SPI
+#define OLED_SPI_HOST     SPI2_HOST
+#define OLED_SPI_MOSI_PIN CONFIG_OLED_SPI_MOSI_GPIO
+#define OLED_SPI_SCLK_PIN CONFIG_OLED_SPI_SCLK_GPIO
+#define OLED_SPI_CS_PIN   CONFIG_OLED_SPI_CS_GPIO
+#define OLED_SPI_DC_PIN   CONFIG_OLED_SPI_DC_GPIO
+#define OLED_SPI_RST_PIN  CONFIG_OLED_SPI_RST_GPIO
+#define OLED_SPI_CLOCK_HZ CONFIG_OLED_SPI_CLOCK_HZ
+#endif
+
+/* Panel (menuconfig: OLED controller / size / I2C address) */
+#ifdef CONFIG_OLED_I2C_ADDR
+#define OLED_I2C_ADDR     CONFIG_OLED_I2C_ADDR
+#else
 #define OLED_I2C_ADDR     0x3C      /* SSD1306 default I2C address */
+#endif
+#ifdef SSD1306_FIXED_WIDTH
+#define OLED_PANEL_WIDTH  SSD1306_FIXED_WIDTH
+#define OLED_PANEL_HEIGHT SSD1306_FIXED_HEIGHT
+#else
+#define OLED_PANEL_WIDTH  128
+#define OLED_PANEL_HEIGHT 64
+#endif
+
+/* Refresh rate control */
+#ifdef CONFIG_OLED_MAX_FPS
+#define OLED_MAX_FPS         CONFIG_OLED_MAX_FPS
+#else
+#define OLED_MAX_FPS         20
+#endif
+#define OLED_FRAME_INTERVAL_MS  (1000 / OLED_MAX_FPS)  /* Minimum interval between frames (ms) */
+
+/* Long joke/message text is paged; optionally ASCII text scrolls with the hardware marquee */
+#ifdef CONFIG_OLED_PAGE_HOLD_MS
+#define OLED_PAGE_HOLD_MS    CONFIG_OLED_PAGE_HOLD_MS
+#else
+#define OLED_PAGE_HOLD_MS    3000
+#endif
+#ifdef CONFIG_OLED_SCROLL_LONG_TEXT
+#define OLED_SCROLL_LONG_TEXT  1
+#else
+#define OLED_SCROLL_LONG_TEXT  0
+#endif
+#ifdef CONFIG_OLED_SCROLL_STEP_MS
+#define OLED_SCROLL_STEP_MS  CONFIG_OLED_SCROLL_STEP_MS
+#else
+#define OLED_SCROLL_STEP_MS  60
+#endif
+#define OLED_SCROLL_HOLD_MS  1500   /* Show the first lines this long before scrolling */
+
+/* Idle power policy (menuconfig: OLED_DIM_AFTER_S / OLED_OFF_AFTER_S / OLED_DIM_CONTRAST) */
+#ifdef CONFIG_OLED_DIM_AFTER_S
+#define OLED_DIM_AFTER_S     CONFIG_OLED_DIM_AFTER_S
+#else
+#define OLED_DIM_AFTER_S     60
+#endif
+#ifdef CONFIG_OLED_OFF_AFTER_S
+#define OLED_OFF_AFTER_S     CONFIG_OLED_OFF_AFTER_S
+#else
+#define OLED_OFF_AFTER_S     300
+#endif
+#ifdef CONFIG_OLED_DIM_CONTRAST
+#define OLED_DIM_CONTRAST    CONFIG_OLED_DIM_CONTRAST
+#else
+#define OLED_DIM_CONTRAST    16
+#endif
+#define OLED_CONTRAST        0xFF   /* set by ssd1306_init() */
+
+/* UTF-8 font image partition (tools/gen_oled_font.py, see partitions.csv) */
+#define OLED_FONT_PARTITION_LABEL    "font"
+#define OLED_FONT_PARTITION_SUBTYPE  0x40
+
+/* Live mirror clients (GET /api/oled/stream) */
+#define OLED_MIRROR_MAX_CLIENTS  2
+
+/* Background render/flush task; the I2C clock fallback also writes NVS and logs from it */
+#if OLED_I2C_CALIBRATE
+#define OLED_RENDER_TASK_STACK  4096
+#else
+#define OLED_RENDER_TASK_STACK  3072
+#endif
+#define OLED_RENDER_TASK_PRIO   4
+
+/* Screen request payload limits */
+#define OLED_SCREEN_LINE_MAX    32
+#define OLED_SCREEN_TEXT_MAX    512
+
+typedef enum {
+    OLED_SCREEN_STATUS,
+    OLED_SCREEN_CONNECTING,
+    OLED_SCREEN_CONNECTED,
+    OLED_SCREEN_CONNECTED_IP,
+    OLED_SCREEN_ERROR,
+    OLED_SCREEN_JOKE,
+    OLED_SCREEN_CUSTOM_TEXT,
+} oled_screen_kind_t;
+
+/* Screen description posted by producers; rendered later by the render task */
+typedef struct {
+    oled_screen_kind_t kind;
+    char line[3][OLED_SCREEN_LINE_MAX];
+    char text[OLED_SCREEN_TEXT_MAX];
+} oled_screen_t;
+
+/* Latest-wins mailbox: a newer request replaces the pending one. A pushed frame
+ * lives in the back buffer itself, so only its pending flag is queued. */
+typedef struct {
+    oled_screen_t screen;
+    bool pending;
+    bool frame_pending;     /* back buffer holds a pushed frame not yet flushed */
+    const oled_anim_t *anim;
+    bool anim_pending;      /* anim waits to be started by the render task */
+    oled_queue_stats_t stats;
+    oled_frame_stats_t frame_stats;
+    oled_anim_stats_t anim_stats;
+    oled_idle_t idle;       /* render task's idle state as of its last change */
+} oled_queue_t;
+
+/* Marquee state: the panel scrolls via its display start line, one GDDRAM page stays
+ * hidden (MUX ratio reduced by 8 rows) and receives the next line before it scrolls in */
+typedef struct {
+    bool active;
+    const char *title;      /* first scrolled line */
+    const char *body;       /* laid-out text (render task's screen copy) */
+    uint16_t body_lines;
+    uint16_t nlines;        /* title + body lines + one blank separator line */
+    uint16_t next_line;     /* next line to stream into the hidden page */
+    uint8_t start_line;     /* current hardware display start line */
+    TickType_t next_step;   /* tick of the next scroll step */
+} oled_marquee_t;
+
+/* Status screen as retained widgets: repeated posts only redraw the lines that changed */
+typedef struct {
+    oled_ui_t ui;
+    oled_widget_t line[3];
+    bool live;              /* back buffer currently holds this screen */
+} oled_status_view_t;
+
+/* Pager state: long text is shown one page of laid-out lines at a time */
+typedef struct {
+    bool active;            /* more than one page: the render task flips pages */
+    const char *title;
+    const char *text;       /* laid-out text (render task's screen copy) */
+    uint16_t y0;            /* first body row */
+    uint16_t page;
+    uint16_t pages;
+    TickType_t next_flip;   /* tick of the next page flip */
+} oled_pager_t;
+
+/* Animation playback: an esp_timer wakes the render task every frame period, which
+ * decodes the frames due by then into the back buffer and flushes once */
+typedef struct {
+    bool active;
+    oled_anim_player_t player;
+    int64_t start_us;       /* slot of the first frame */
+    uint32_t period_us;
+    uint32_t decoded;       /* frames decoded since start */
+    int64_t flush_start_us; /* queue time of the flush still to be accounted, 0 if none */
+    uint32_t flushes;       /* flushes accounted in flush_total_us */
+    uint64_t flush_total_us;
+} oled_playback_t;
+
+/* One live mirror client: the frame as the client last saw it */
+struct oled_mirror {
+    TaskHandle_t task;      /* notified after every flush */
+    uint8_t *copy;          /* width * pages bytes, starts all off */
+    bool primed;            /* first update sent */
+};
+
+oled_context_t g_oled = {0};
+static SemaphoreHandle_t oled_mutex = NULL;        /* guards g_oled.display (back buffer) */
+static SemaphoreHandle_t oled_queue_mutex = NULL;  /* guards oled_queue */
+static TaskHandle_t oled_render_task_handle = NULL;
+static oled_queue_t oled_queue = {0};
+static oled_marquee_t oled_marquee = {0};        /* owned by the render task */
+static oled_pager_t oled_pager = {0};            /* guarded by oled_mutex */
+static oled_status_view_t oled_status_view = {0}; /* guarded by oled_mutex */
+static bool oled_remote_live = false;            /* back buffer holds the last pushed frame; guarded by oled_mutex */
+static SemaphoreHandle_t oled_rx_mutex = NULL;     /* guards oled_rx, the push path's receive buffer */
+static ssd1306_t oled_rx = {0};                  /* last pushed frame, base for deltas; never flushed */
+static bool oled_rx_valid = false;               /* oled_rx holds a complete frame; guarded by oled_rx_mutex */
+static oled_mirror_t *oled_mirrors[OLED_MIRROR_MAX_CLIENTS]; /* guarded by oled_queue_mutex */
+static oled_playback_t oled_playback = {0};      /* owned by the render task */
+static esp_timer_handle_t oled_anim_timer = NULL;
+static oled_idle_t oled_idle = {0};              /* owned by the render task */
+static volatile int64_t oled_flush_done_us = 0;   /* completion time of the last front-buffer flush */
+#ifndef CONFIG_OLED_BUS_SPI
+static i2c_master_bus_handle_t oled_i2c_bus = NULL;
+static uint32_t oled_i2c_hz = I2C_FREQ_HZ;       /* SCL rate of the panel device */
+#if OLED_I2C_CALIBRATE
+static oled_i2c_health_t oled_i2c_health = {0};  /* owned by the render task */
+static bool oled_i2c_health_off = false;         /* no slower clock left to fall back to; render task */
+#endif
+#endif
+
+extern const char *FETCH_URL;
+
+/* 函数名：oled_mirror_notify
+ *
+ * 函数说明：一帧刷新到面板后唤醒所有实时镜像客户端。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void oled_mirror_notify(void)
+{
+    xSemaphoreTake(oled_queue_mutex, portMAX_DELAY);
+    for (int i = 0; i < OLED_MIRROR_MAX_CLIENTS; i++) {
+        if (oled_mirrors[i]) {
+            xTaskNotifyGive(oled_mirrors[i]->task);
+        }
+    }
+    xSemaphoreGive(oled_queue_mutex);
+}
+
+/* 函数名：oled_flush_done
+ *
+ * 函数说明：前台帧刷新完成回调，记录完成时间。SPI 面板在 SPI 中断中调用，I2C 面板在
+ *           渲染任务中同步调用。
+ * 参数：
+ *   dev - 完成刷新的设备。
+ *   arg - 未使用。
+ * 返回值：
+ *   无。
+ */
+static void IRAM_ATTR oled_flush_done(ssd1306_t *dev, void *arg)
+{
+    (void)dev;
+    (void)arg;
+    oled_flush_done_us = esp_timer_get_time();
+}
+
+#ifndef CONFIG_OLED_BUS_SPI
+/* 函数名：oled_i2c_add_panel
+ *
+ * 函数说明：以给定 SCL 频率把面板添加为 I2C 总线上的设备。
+ * 参数：
+ *   hz     - SCL 频率。
+ *   handle - 输出设备句柄。
+ * 返回值：
+ *   ESP_OK 表示成功，错误时返回对应 esp_err_t。
+ */
+static esp_err_t oled_i2c_add_panel(uint32_t hz, i2c_master_dev_handle_t *handle)
+{
+    i2c_device_config_t device_config = {
+        .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+        .device_address = OLED_I2C_ADDR,
+        .scl_speed_hz = hz,
+    };
+    return i2c_master_bus_add_device(oled_i2c_bus, &device_config, handle);
+}
+#endif
+
+#if OLED_I2C_CALIBRATE
+/* 函数名：oled_i2c_load_hz
+ *
+ * 函数说明：读取 NVS 中保存的 SCL 频率。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   保存的频率；没有保存或不是候选频率时返回 0。
+ */
+static uint32_t oled_i2c_load_hz(void)
+{
+    nvs_handle_t nvs;
+    uint32_t hz = 0;
+    if (nvs_open(OLED_NVS_NAMESPACE, NVS_READONLY, &nvs) != ESP_OK) {
+        return 0;
+    }
+    if (nvs_get_u32(nvs, OLED_NVS_I2C_HZ, &hz) != ESP_OK || !oled_i2c_cal_is_candidate(hz)) {
+        hz = 0;
+    }
+    nvs_close(nvs);
+    return hz;
+}
+
+/* 函数名：oled_i2c_store_hz
+ *
+ * 函数说明：把 SCL 频率保存到 NVS，供以后开机直接使用。
+ * 参数：
+ *   hz - SCL 频率。
+ * 返回值：
+ *   无。
+ */
+static void oled_i2c_store_hz(uint32_t hz)
+{
+    nvs_handle_t nvs;
+    esp_err_t ret = nvs_open(OLED_NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (ret == ESP_OK) {
+        ret = nvs_set_u32(nvs, OLED_NVS_I2C_HZ, hz);
+        if (ret == ESP_OK) {
+            ret = nvs_commit(nvs);
+        }
+        nvs_close(nvs);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to save OLED I2C clock: %s", esp_err_to_name(ret));
+    }
+}
+
+/* 函数名：oled_i2c_calibrated_hz
+ *
+ * 函数说明：确定面板的 SCL 频率：优先使用 NVS 中保存的结果，否则扫描校准并保存。
+ *           校准失败（面板不应答或最低频率也出错）时使用默认频率且不保存，下次开机重试。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   SCL 频率。
+ */
+static uint32_t oled_i2c_calibrated_hz(void)
+{
+    uint32_t hz = oled_i2c_load_hz();
+    if (hz) {
+        ESP_LOGI(TAG, "OLED I2C clock %lu Hz (saved calibration)", (unsigned long)hz);
+        return hz;
+    }
+
+    ESP_LOGI(TAG, "Calibrating OLED I2C clock");
+    oled_i2c_cal_report_t report;
+    esp_err_t ret = oled_i2c_cal_sweep(oled_i2c_bus, OLED_I2C_ADDR, OLED_PANEL_WIDTH, OLED_PANEL_HEIGHT / 8, &report);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "OLED I2C calibration failed: %s, using %d Hz", esp_err_to_name(ret), I2C_FREQ_HZ);
+        return I2C_FREQ_HZ;
+    }
+    ESP_LOGI(TAG, "OLED I2C clock calibrated to %lu Hz", (unsigned long)report.chosen_hz);
+    oled_i2c_store_hz(report.chosen_hz);
+    return report.chosen_hz;
+}
+
+/* 函数名：oled_i2c_fallback
+ *
+ * 函数说明：刷新错误率过高时把 SCL 降一档：先以新频率添加面板设备，成功后才移除旧设备并
+ *           替换前后台帧共用的设备句柄，失败时保留旧句柄继续使用；新频率保存到 NVS。
+ *           已是最低频率或无法添加新设备时停止错误率监测。由渲染任务调用（只有它访问面板总线）。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void oled_i2c_fallback(void)
+{
+    uint32_t slower = oled_i2c_cal_slower(oled_i2c_hz);
+    if (slower == oled_i2c_hz) {
+        ESP_LOGW(TAG, "OLED I2C errors at %lu Hz, already the slowest rate", (unsigned long)oled_i2c_hz);
+        oled_i2c_health_off = true;
+        return;
+    }
+
+    i2c_master_dev_handle_t handle;
+    esp_err_t ret = oled_i2c_add_panel(slower, &handle);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to add OLED device at %lu Hz: %s, staying at %lu Hz",
+                 (unsigned long)slower, esp_err_to_name(ret), (unsigned long)oled_i2c_hz);
+        oled_i2c_health_off = true;
+        return;
+    }
+
+    xSemaphoreTake(oled_mutex, portMAX_DELAY);
+    i2c_master_dev_handle_t old = g_oled.front.i2c_dev;
+    g_oled.display.i2c_dev = handle;
+    g_oled.front.i2c_dev = handle;
+    xSemaphoreGive(oled_mutex);
+    i2c_master_bus_rm_device(old);
+
+    ESP_LOGW(TAG, "OLED I2C error rate too high at %lu Hz, falling back to %lu Hz",
+             (unsigned long)oled_i2c_hz, (unsigned long)slower);
+    oled_i2c_hz = slower;
+    oled_i2c_store_hz(slower);
+}
+#endif
+
+/* 函数名：oled_flush_front
+ *
+ * 函数说明：推送前台帧（渲染任务专用）。开启 I2C 时钟校准时统计刷新错误率，
+ *           错误过多时降低 SCL 频率。
+ * 参数：
+ *   cb - 刷新完成回调，可为 NULL。
+ * 返回值：
+ *   ESP_OK 表示成功（SPI 为已排队），其他为总线错误码。
+ */
+static esp_err_t oled_flush_front(ssd1306_flush_cb_t cb)
+{
+    esp_err_t ret = ssd1306_show_async(&g_oled.front, cb, NULL);
+#if OLED_I2C_CALIBRATE
+    if (!oled_i2c_health_off && oled_i2c_health_record(&oled_i2c_health, ret == ESP_OK)) {
+        oled_i2c_fallback();
+    }
+#endif
+    return ret;
+}
+
+/* 函数名：oled_idle_publish
+ *
+ * 函数说明：把渲染任务的空闲状态复制到队列，供 oled_get_idle_stats() 读取。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void oled_idle_publish(void)
+{
+    xSemaphoreTake(oled_queue_mutex, portMAX_DELAY);
+    oled_queue.idle = oled_idle;
+    xSemaphoreGive(oled_queue_mutex);
+}
+
+/* 函数名：oled_idle_wake
+ *
+ * 函数说明：记录一次显示活动（新画面、推送帧、动画帧）；面板已调暗或关闭时立即恢复。
+ *           在新画面刷新之后调用，面板亮起时即为新内容。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void oled_idle_wake(void)
+{
+    oled_idle_state_t was = oled_idle.state;
+    esp_err_t ret = oled_idle_activity(&oled_idle, &g_oled.front, esp_timer_get_time());
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to wake OLED: %s", esp_err_to_name(ret));
+    } else if (was != OLED_IDLE_ACTIVE) {
+        ESP_LOGI(TAG, "OLED awake");
+    }
+    oled_idle_publish();
+}
+
+/* 函数名：oled_idle_poll
+ *
+ * 函数说明：空闲时长到达阈值时调暗或关闭面板。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void oled_idle_poll(void)
+{
+    oled_idle_state_t was = oled_idle.state;
+    esp_err_t ret = oled_idle_update(&oled_idle, &g_oled.front, esp_timer_get_time());
+    if (oled_idle.state == was) return;
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "OLED idle command failed: %s", esp_err_to_name(ret));
+    }
+    ESP_LOGI(TAG, "OLED %s after %lu s idle", oled_idle.state == OLED_IDLE_OFF ? "off" : "dimmed",
+             (unsigned long)((esp_timer_get_time() - oled_idle.last_activity_us) / 1000000));
+    oled_idle_publish();
+}
+
+/* 函数名：oled_draw_template
+ *
+ * 函数说明：绘制固定画面。屏幕尺寸与模板一致时直接拷贝 Flash 中的预渲染图像，
+ *           否则按模板记录的字符串即时光栅化。
+ * 参数：
+ *   d   - 设备句柄。
+ *   tpl - 屏幕模板。
+ * 返回值：
+ *   无。
+ */
+static void oled_draw_template(ssd1306_t *d, const oled_template_t *tpl)
+{
+    if (d->width == OLED_TEMPLATE_WIDTH && d->height == OLED_TEMPLATE_HEIGHT) {
+        ssd1306_load_frame(d, tpl->image);
+        return;
+    }
+    ssd1306_clear(d);
+    for (uint8_t i = 0; i < tpl->ntexts; i++) {
+        ssd1306_text(d, tpl->texts[i].text, tpl->texts[i].x, tpl->texts[i].y, 1, tpl->texts[i].wrap_mode);
+    }
+}
+
+/* 函数名：oled_pager_draw
+ *
+ * 函数说明：绘制当前页：标题、右上角页码（多于一页时）与本页的正文行。
+ *           排版结果取自缓存，翻页不会重新排版。调用方须持有 oled_mutex。
+ * 参数：
+ *   d - 设备句柄。
+ * 返回值：
+ *   无。
+ */
+static void oled_pager_draw(ssd1306_t *d)
+{
+    const oled_layout_t *lay = oled_layout_text(oled_pager.text, d->width);
+    uint16_t per_page = (uint16_t)((d->height - oled_pager.y0) / lay->line_height);
+
+    ssd1306_clear(d);
+    ssd1306_text(d, oled_pager.title, 0, 0, 1, 1);  /* truncate mode */
+    if (oled_pager.pages > 1) {
+        char indicator[12];
+        int n = snprintf(indicator, sizeof(indicator), "%u/%u",
+                         (unsigned)(oled_pager.page + 1), (unsigned)oled_pager.pages);
+        ssd1306_text(d, indicator, (uint16_t)(d->width - n * FONT_TOTAL_WIDTH + FONT_CHAR_SPACING), 0, 1, 1);
+    }
+    oled_layout_draw(d, oled_pager.text, lay, (uint16_t)(oled_pager.page * per_page), per_page,
+                     0, oled_pager.y0);
+}
+
+/* 函数名：oled_pager_begin
+ *
+ * 函数说明：排版正文并绘制第一页。多于一页时由渲染任务定时翻页。
+ *           使用字体排版时起始行向下取整到页边界以保持字形按字节对齐。
+ *           调用方须持有 oled_mutex。
+ * 参数：
+ *   d     - 设备句柄。
+ *   title - 标题。
+ *   text  - 正文（须在下一次屏幕请求前保持有效）。
+ *   y0    - 5x8 字体时正文的起始行。
+ * 返回值：
+ *   无。
+ */
+static void oled_pager_begin(ssd1306_t *d, const char *title, const char *text, uint16_t y0)
+{
+    const oled_layout_t *lay = oled_layout_text(text, d->width);
+    if (lay->utf8) y0 = (uint16_t)((y0 + 7) & ~7u);
+    uint16_t per_page = (uint16_t)((d->height - y0) / lay->line_height);
+
+    oled_pager.title = title;
+    oled_pager.text = text;
+    oled_pager.y0 = y0;
+    oled_pager.page = 0;
+    oled_pager.pages = oled_layout_pages(lay, per_page);
+    oled_pager_draw(d);
+
+    oled_pager.active = oled_pager.pages > 1;
+    oled_pager.next_flip = xTaskGetTickCount() + pdMS_TO_TICKS(OLED_PAGE_HOLD_MS);
+}
+
+/* 函数名：oled_pager_step
+ *
+ * 函数说明：翻到下一页（循环）并刷新；只有正文与页码变化的字节上总线。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void oled_pager_step(void)
+{
+    xSemaphoreTake(oled_mutex, portMAX_DELAY);
+    oled_pager.page = (uint16_t)((oled_pager.page + 1) % oled_pager.pages);
+    oled_pager_draw(&g_oled.display);
+    ssd1306_take_frame(&g_oled.front, &g_oled.display);
+    xSemaphoreGive(oled_mutex);
+
+    esp_err_t ret = oled_flush_front(NULL);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "OLED flush failed: %s", esp_err_to_name(ret));
+    } else {
+        oled_mirror_notify();
+    }
+    oled_pager.next_flip += pdMS_TO_TICKS(OLED_PAGE_HOLD_MS);
+}
+
+/* 函数名：oled_status_view_setup
+ *
+ * 函数说明：创建状态画面的三个文本标签控件（y = 0/16/32）。
+ * 参数：
+ *   d - 后台帧设备句柄。
+ * 返回值：
+ *   无。
+ */
+static void oled_status_view_setup(ssd1306_t *d)
+{
+    oled_ui_init(&oled_status_view.ui, d);
+    for (uint8_t i = 0; i < 3; i++) {
+        oled_label_init(&oled_status_view.line[i], 0, (uint16_t)(i * 16), d->width);
+        oled_ui_add(&oled_status_view.ui, &oled_status_view.line[i]);
+    }
+    oled_status_view.live = false;
+}
+
+/* 函数名：oled_status_view_render
+ *
+ * 函数说明：绘制状态画面。画面已在后台帧中时只重绘内容变化的行，
+ *           从其他画面切换过来时清屏并全部重绘。
+ * 参数：
+ *   d   - 后台帧设备句柄。
+ *   scr - 屏幕描述。
+ * 返回值：
+ *   无。
+ */
+static void oled_status_view_render(ssd1306_t *d, const oled_screen_t *scr)
+{
+    if (!oled_status_view.live) {
+        ssd1306_clear(d);
+        oled_ui_invalidate(&oled_status_view.ui);
+        oled_status_view.live = true;
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        oled_label_set(&oled_status_view.line[i], scr->line[i]);
+    }
+    oled_ui_render(&oled_status_view.ui);
+}
+
+/* 函数名：oled_render_screen
+ *
+ * 函数说明：按屏幕描述在后台帧中重绘整屏；调用方须持有 oled_mutex。
+ * 参数：
+ *   scr - 屏幕描述。
+ * 返回值：
+ *   无。
+ */
+static void oled_render_screen(const oled_screen_t *scr)
+{
+    ssd1306_t *d = &g_oled.display;
+
+    if (scr->kind != OLED_SCREEN_STATUS) {
+        oled_status_view.live = false;
+    }
+    oled_pager.active = false;
+    oled_remote_live = false;
+
+    switch (scr->kind) {
+        case OLED_SCREEN_STATUS:
+            oled_status_view_render(d, scr);
+            break;
+        case OLED_SCREEN_CONNECTING:
+            oled_draw_template(d, &oled_tpl_connecting);
+            ssd1306_image(d, &oled_icon_chip, (uint16_t)((d->width - oled_icon_chip.w) / 2), 36, SSD1306_BLIT_SET);
+            break;
+        case OLED_SCREEN_CONNECTED:
+            oled_draw_template(d, &oled_tpl_connected);
+            ssd1306_image(d, &oled_icon_wifi, (uint16_t)(d->width - oled_icon_wifi.w), 0, SSD1306_BLIT_SET);
+            ssd1306_text(d, FETCH_URL, 0, 32, 1, 0);     /* auto wrap mode */
+            break;
+        case OLED_SCREEN_CONNECTED_IP:
+            oled_draw_template(d, &oled_tpl_connected_ip);
+            ssd1306_image(d, &oled_icon_wifi, (uint16_t)(d->width - oled_icon_wifi.w), 0, SSD1306_BLIT_SET);
+            ssd1306_image(d, &oled_icon_lock, 100, 12, SSD1306_BLIT_SET);  /* after "Server: Port 443" */
+            ssd1306_text(d, scr->line[0], 0, 36, 1, 1);  /* truncate mode */
+            break;
+        case OLED_SCREEN_ERROR: {
+            const oled_layout_t *lay = oled_layout_text(scr->text, d->width);
+            ssd1306_clear(d);
+            ssd1306_image(d, &oled_icon_warning, 0, 0, SSD1306_BLIT_SET);
+            ssd1306_text(d, "ERROR", (uint16_t)(oled_icon_warning.w + 3), 0, 1, 1);  /* truncate mode */
+            oled_layout_draw(d, scr->text, lay, 0, (uint16_t)((d->height - 16) / lay->line_height), 0, 16);
+            break;
+        }
+        case OLED_SCREEN_JOKE:
+            oled_pager_begin(d, "Joke:", scr->text, 10);
+            break;
+        case OLED_SCREEN_CUSTOM_TEXT:
+            oled_pager_begin(d, "Web Message:", scr->text, 12);
+            break;
+    }
+}
+
+/* 函数名：oled_copy_str
+ *
+ * 函数说明：安全拷贝字符串到定长缓冲，NULL 视为空串，超长截断。
+ * 参数：
+ *   dst  - 目标缓冲。
+ *   size - 目标缓冲大小。
+ *   src  - 源字符串，可为 NULL。
+ * 返回值：
+ *   无。
+ */
+static void oled_copy_str(char *dst, size_t size, const char *src)
+{
+    if (!src) src = "";
+    size_t n = strnlen(src, size - 1);
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+}
+
+/* 函数名：oled_marquee_draw_line
+ *
+ * 函数说明：把滚动内容的第 k 行（循环）绘制到后台帧的指定页；调用方须持有 oled_mutex。
+ * 参数：
+ *   page - 目标页。
+ *   k    - 行号，按总行数取模。
+ * 返回值：
+ *   无。
+ */
+static void oled_marquee_draw_line(uint8_t page, uint16_t k)
+{
+    ssd1306_t *d = &g_oled.display;
+    uint16_t idx = k % oled_marquee.nlines;
+
+    ssd1306_fill_rect(d, 0, (uint16_t)(page * 8), d->width, 8, 0);
+    if (idx == 0) {
+        ssd1306_text(d, oled_marquee.title, 0, (uint16_t)(page * 8), 1, 1);  /* truncate mode */
+    } else if (idx <= oled_marquee.body_lines) {
+        const oled_layout_t *lay = oled_layout_text(oled_marquee.body, d->width);
+        oled_layout_draw(d, oled_marquee.body, lay, (uint16_t)(idx - 1), 1, 0, (uint16_t)(page * 8));
+    }
+}
+
+/* 函数名：oled_marquee_begin
+ *
+ * 函数说明：ASCII 正文超出静态版面时进入滚动模式：按排版结果逐行，把前 pages 行
+ *           （最后一页位于屏外）绘制到后台帧。调用方须持有 oled_mutex，返回后由
+ *           渲染任务设置复用率与起始行并刷新。
+ * 参数：
+ *   scr - 屏幕请求。
+ * 返回值：
+ *   true 表示已进入滚动模式，false 表示按静态版面绘制。
+ */
+static bool oled_marquee_begin(oled_screen_t *scr)
+{
+    ssd1306_t *d = &g_oled.display;
+    const char *title;
+    uint16_t y0;
+
+    switch (scr->kind) {
+        case OLED_SCREEN_JOKE:        title = "Joke:";        y0 = 10; break;
+        case OLED_SCREEN_CUSTOM_TEXT: title = "Web Message:"; y0 = 12; break;
+        default: return false;
+    }
+    if (d->pages < 3) return false;
+
+    /* The marquee streams one 8-row page per line: 5x8 layouts only */
+    const oled_layout_t *lay = oled_layout_text(scr->text, d->width);
+    if (lay->utf8 || lay->line_height != 8) return false;
+    uint16_t body_lines = lay->nlines;
+    if (body_lines <= (d->height - y0) / 8) return false;  /* fits the static layout */
+
+    oled_marquee.title = title;
+    oled_marquee.body = scr->text;
+    oled_marquee.body_lines = body_lines;
+    oled_marquee.nlines = (uint16_t)(body_lines + 2);
+    oled_marquee.start_line = 0;
+    oled_marquee.next_line = d->pages;
+
+    oled_status_view.live = false;
+    oled_pager.active = false;
+    oled_remote_live = false;
+    ssd1306_clear(d);
+    for (uint8_t page = 0; page < d->pages; ++page) {
+        oled_marquee_draw_line(page, page);
+    }
+    oled_marquee.active = true;
+    oled_marquee.next_step = xTaskGetTickCount() + pdMS_TO_TICKS(OLED_SCROLL_HOLD_MS);
+    return true;
+}
+
+/* 函数名：oled_marquee_step
+ *
+ * 函数说明：滚动一行像素：只发送一条起始行命令，由面板完成移动。每滚过一整页，
+ *           刚移出顶部的页即成为屏外页，写入下一行内容（仅该页差分上总线）。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void oled_marquee_step(void)
+{
+    ssd1306_t *panel = &g_oled.front;
+
+    oled_marquee.start_line = (uint8_t)((oled_marquee.start_line + 1) % panel->height);
+    ssd1306_set_start_line(panel, oled_marquee.start_line);
+
+    if (oled_marquee.start_line % 8 == 0) {
+        uint8_t hidden = (uint8_t)((oled_marquee.start_line / 8 + panel->pages - 1) % panel->pages);
+
+        xSemaphoreTake(oled_mutex, portMAX_DELAY);
+        oled_marquee_draw_line(hidden, oled_marquee.next_line);
+        ssd1306_take_frame(panel, &g_oled.display);
+        xSemaphoreGive(oled_mutex);
+        if (oled_flush_front(NULL) == ESP_OK) {
+            oled_mirror_notify();
+        }
+
+        oled_marquee.next_line = (uint16_t)((oled_marquee.next_line + 1) % oled_marquee.nlines);
+    }
+    oled_marquee.next_step += pdMS_TO_TICKS(OLED_SCROLL_STEP_MS);
+}
+
+/* 函数名：oled_marquee_stop
+ *
+ * 函数说明：退出滚动模式，恢复起始行 0 与全部可见行。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void oled_marquee_stop(void)
+{
+    oled_marquee.active = false;
+    ssd1306_set_start_line(&g_oled.front, 0);
+    ssd1306_set_visible_rows(&g_oled.front, (uint8_t)g_oled.front.height);
+}
+
+/* 函数名：oled_anim_timer_cb
+ *
+ * 函数说明：动画帧定时器回调（esp_timer 任务中执行），唤醒渲染任务。
+ * 参数：
+ *   arg - 未使用。
+ * 返回值：
+ *   无。
+ */
+static void oled_anim_timer_cb(void *arg)
+{
+    (void)arg;
+    xTaskNotifyGive(oled_render_task_handle);
+}
+
+/* 函数名：oled_playback_account_flush
+ *
+ * 函数说明：等待上一帧的异步刷新完成，把从排队到完成的耗时计入刷新统计。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void oled_playback_account_flush(void)
+{
+    if (oled_playback.flush_start_us == 0) return;
+    ssd1306_wait(&g_oled.front);
+    uint32_t flush_us = (uint32_t)(oled_flush_done_us - oled_playback.flush_start_us);
+    oled_playback.flush_start_us = 0;
+    oled_playback.flushes++;
+    oled_playback.flush_total_us += flush_us;
+
+    xSemaphoreTake(oled_queue_mutex, portMAX_DELAY);
+    oled_anim_stats_t *st = &oled_queue.anim_stats;
+    st->avg_flush_us = (uint32_t)(oled_playback.flush_total_us / oled_playback.flushes);
+    if (flush_us > st->max_flush_us) st->max_flush_us = flush_us;
+    xSemaphoreGive(oled_queue_mutex);
+}
+
+/* 函数名：oled_playback_stop
+ *
+ * 函数说明：停止动画定时器并记录本次播放的帧节奏统计（实际帧率、丢帧、刷新耗时）。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void oled_playback_stop(void)
+{
+    esp_timer_stop(oled_anim_timer);
+    oled_playback.active = false;
+    oled_playback_account_flush();
+
+    xSemaphoreTake(oled_queue_mutex, portMAX_DELAY);
+    oled_anim_stats_t *st = &oled_queue.anim_stats;
+    st->playing = false;
+    st->elapsed_ms = (uint32_t)((esp_timer_get_time() - oled_playback.start_us) / 1000);
+    oled_anim_stats_t done = *st;
+    xSemaphoreGive(oled_queue_mutex);
+
+    ESP_LOGI(TAG, "Animation %s: %lu frames in %lu ms (target %u fps), %lu dropped, "
+             "flush avg %lu us max %lu us, max lateness %lu us",
+             done.name, (unsigned long)done.shown, (unsigned long)done.elapsed_ms, done.target_fps,
+             (unsigned long)done.dropped, (unsigned long)done.avg_flush_us,
+             (unsigned long)done.max_flush_us, (unsigned long)done.max_late_us);
+}
+
+/* 函数名：oled_playback_step
+ *
+ * 函数说明：播放到期的动画帧。按开始时间与帧周期计算应显示到第几帧：渲染任务落后时
+ *           把错过的帧依次解码（增量帧必须按序应用）但只刷新最后一帧并计为丢帧。
+ *           刷新异步进行（SPI 由 DMA 发送，解码下一帧时无需等待）；记录每帧相对其时隙
+ *           的延迟，刷新耗时在下一帧开始时（或停止时）计入。单次动画播完或数据损坏时停止。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void oled_playback_step(void)
+{
+    int64_t now = esp_timer_get_time();
+    uint32_t due = (uint32_t)((now - oled_playback.start_us) / oled_playback.period_us) + 1;
+    if (due <= oled_playback.decoded) {
+        return;     /* woken by a display request, not the timer */
+    }
+
+    uint32_t decoded = 0;
+    esp_err_t ret = ESP_OK;
+    xSemaphoreTake(oled_mutex, portMAX_DELAY);
+    while (oled_playback.decoded < due && !oled_anim_done(&oled_playback.player)) {
+        ret = oled_anim_next(&oled_playback.player, &g_oled.display);
+        if (ret != ESP_OK) break;
+        oled_playback.decoded++;
+        decoded++;
+    }
+    ssd1306_take_frame(&g_oled.front, &g_oled.display);
+    xSemaphoreGive(oled_mutex);
+    oled_playback_account_flush();
+
+    int64_t t0 = esp_timer_get_time();
+    int64_t late = t0 - (oled_playback.start_us + (int64_t)(oled_playback.decoded - 1) * oled_playback.period_us);
+    bool shown = decoded > 0 && oled_flush_front(oled_flush_done) == ESP_OK;
+    if (shown) {
+        oled_playback.flush_start_us = t0;
+        oled_mirror_notify();
+        oled_idle_wake();
+    }
+
+    if (decoded > 0) {
+        xSemaphoreTake(oled_queue_mutex, portMAX_DELAY);
+        oled_anim_stats_t *st = &oled_queue.anim_stats;
+        st->dropped += shown ? decoded - 1 : decoded;
+        if (shown) {
+            st->shown++;
+            if (late > (int64_t)st->max_late_us) st->max_late_us = (uint32_t)late;
+        }
+        st->elapsed_ms = (uint32_t)((t0 - oled_playback.start_us) / 1000);
+        xSemaphoreGive(oled_queue_mutex);
+    }
+
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Animation %s is corrupt: %s", oled_playback.player.anim->name, esp_err_to_name(ret));
+        oled_playback_stop();
+    } else if (oled_anim_done(&oled_playback.player)) {
+        oled_playback_stop();
+    }
+}
+
+/* 函数名：oled_playback_begin
+ *
+ * 函数说明：开始播放动画：结束正在播放的动画与滚动，使状态控件、分页与远程帧失效，
+ *           按动画帧率启动周期定时器，并立即显示第 0 帧。
+ * 参数：
+ *   anim - 动画。
+ * 返回值：
+ *   无。
+ */
+static void oled_playback_begin(const oled_anim_t *anim)
+{
+    if (oled_playback.active) {
+        oled_playback_stop();
+    }
+    if (oled_marquee.active) {
+        oled_marquee_stop();
+    }
+
+    xSemaphoreTake(oled_mutex, portMAX_DELAY);
+    esp_err_t ret = oled_anim_start(&oled_playback.player, anim, &g_oled.display);
+    if (ret == ESP_OK) {
+        oled_status_view.live = false;
+        oled_pager.active = false;
+        oled_remote_live = false;
+    }
+    xSemaphoreGive(oled_mutex);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Cannot play animation %s: %s", anim->name, esp_err_to_name(ret));
+        return;
+    }
+
+    oled_playback.period_us = 1000000u / anim->fps;
+    oled_playback.decoded = 0;
+    oled_playback.flush_start_us = 0;
+    oled_playback.flushes = 0;
+    oled_playback.flush_total_us = 0;
+    oled_playback.start_us = esp_timer_get_time();
+    oled_playback.active = true;
+
+    xSemaphoreTake(oled_queue_mutex, portMAX_DELAY);
+    memset(&oled_queue.anim_stats, 0, sizeof(oled_queue.anim_stats));
+    oled_queue.anim_stats.name = anim->name;
+    oled_queue.anim_stats.target_fps = anim->fps;
+    oled_queue.anim_stats.playing = true;
+    xSemaphoreGive(oled_queue_mutex);
+
+    esp_timer_start_periodic(oled_anim_timer, oled_playback.period_us);
+    oled_playback_step();
+}
+
+/* 函数名：oled_render_task
+ *
+ * 函数说明：后台渲染/刷新任务。收到通知后先按帧率上限等待本帧时隙（期间到达的
+ *           请求被合并），取出最新的屏幕请求，在互斥保护下绘制到后台帧并把脏区
+ *           搬到前台帧（仅内存操作），释放互斥后再推送前台帧。SPI 面板的刷新由 DMA 在后台
+ *           完成，任务随即处理下一个请求；下一次 take_frame 前才等待其完成。
+ *           滚动模式下按步进周期超时唤醒，推进硬件滚动。空闲时长到达阈值时同样超时唤醒，
+ *           调暗或关闭面板；关屏期间暂停滚动与翻页，新画面刷新后立即重新点亮。
+ * 参数：
+ *   pv - 任务参数，未使用。
+ * 返回值：
+ *   无。
+ */
+static void oled_render_task(void *pv)
+{
+    (void)pv;
+    static oled_screen_t screen;    /* task-private copy of the newest request */
+    const TickType_t frame_ticks = pdMS_TO_TICKS(OLED_FRAME_INTERVAL_MS);
+    TickType_t last_frame = xTaskGetTickCount() - frame_ticks;
+
+    for (;;) {
+        /* Scrolling and page flips pause while the panel is off */
+        bool stepping = (oled_marquee.active || oled_pager.active) && oled_idle.state != OLED_IDLE_OFF;
+        TickType_t due = 0;
+        TickType_t wait = portMAX_DELAY;
+        if (stepping) {
+            due = oled_marquee.active ? oled_marquee.next_step : oled_pager.next_flip;
+            TickType_t now = xTaskGetTickCount();
+            wait = (int32_t)(due - now) > 0 ? due - now : 0;
+        }
+        int64_t idle_at = oled_idle_next_us(&oled_idle);
+        if (idle_at >= 0) {
+            int64_t us = idle_at - esp_timer_get_time();
+            TickType_t idle_wait = us > 0 ? pdMS_TO_TICKS(us / 1000) + 1 : 0;
+            if (idle_wait < wait) {
+                wait = idle_wait;
+            }
+        }
+        if (ulTaskNotifyTake(pdTRUE, wait) == 0) {
+            /* timed out: the idle policy, the marquee or the pager has work to do */
+            oled_idle_poll();
+            if (stepping && (int32_t)(due - xTaskGetTickCount()) <= 0) {
+                if (oled_marquee.active) {
+                    oled_marquee_step();
+                } else {
+                    oled_pager_step();
+                }
+            }
+            continue;
+        }
+
+        /* Animations run at their own frame rate, outside the governor */
+        const oled_anim_t *anim = NULL;
+        xSemaphoreTake(oled_queue_mutex, portMAX_DELAY);
+        if (oled_queue.anim_pending) {
+            anim = oled_queue.anim;
+            oled_queue.anim_pending = false;
+        }
+        xSemaphoreGive(oled_queue_mutex);
+        if (anim) {
+            oled_playback_begin(anim);
+        } else if (oled_playback.active) {
+            oled_playback_step();
+        }
+        if (oled_playback.active) {
+            /* Screens wait for a one-shot animation to finish; a looping one is replaced */
+            bool defer = !oled_playback.player.anim->loop;
+            xSemaphoreTake(oled_queue_mutex, portMAX_DELAY);
+            bool work = oled_queue.frame_pending || (oled_queue.pending && !defer);
+            xSemaphoreGive(oled_queue_mutex);
+            if (!work) {
+                continue;
+            }
+        }
+
+        /* Frame-rate governor: sleep out the rest of the slot, later requests replace the pending one */
+        TickType_t elapsed = xTaskGetTickCount() - last_frame;
+        if (elapsed < frame_ticks) {
+            vTaskDelay(frame_ticks - elapsed);
+        }
+        ulTaskNotifyTake(pdTRUE, 0);  /* requests posted meanwhile are folded into this frame */
 
-/* Refresh rate control */
-#define OLED_MIN_REFRESH_MS  100    /* Minimum interval between refreshes (ms) */
+        bool have_screen = false;
+        bool have_frame = false;
+        bool defer = oled_playback.active && !oled_playback.player.anim->loop;
+        xSemaphoreTake(oled_queue_mutex, portMAX_DELAY);
+        if (oled_queue.pending && !defer) {
+            memcpy(&screen, &oled_queue.screen, sizeof(screen));
+            oled_queue.pending = false;
+            have_screen = true;
+        }
+        have_frame = oled_queue.frame_pending;
+        oled_queue.frame_pending = false;
+        xSemaphoreGive(oled_queue_mutex);
 
-oled_context_t g_oled = {0};
-static SemaphoreHandle_t oled_mutex = NULL;
-static TickType_t last_refresh_tick = 0;
+        if ((have_screen || have_frame) && oled_marquee.active) {
+            oled_marquee_stop();
+        }
+        if ((have_screen || have_frame) && oled_playback.active) {
+            oled_playback_stop();
+        }
 
-extern const char *FETCH_URL;
+        bool scrolling = false;
+        xSemaphoreTake(oled_mutex, portMAX_DELAY);
+        if (have_screen) {
+            scrolling = OLED_SCROLL_LONG_TEXT && oled_marquee_begin(&screen);
+            if (!scrolling) {
+                oled_render_screen(&screen);
+            }
+        }
+        ssd1306_take_frame(&g_oled.front, &g_oled.display);
+        xSemaphoreGive(oled_mutex);
 
-/* 函数名：oled_init
+        if (scrolling) {
+            /* Hide the last page: it is the off-screen slot for the next line */
+            ssd1306_set_visible_rows(&g_oled.front, (uint8_t)((g_oled.front.pages - 1) * 8));
+            ssd1306_set_start_line(&g_oled.front, 0);
+        }
+
+        last_frame = xTaskGetTickCount();
+        esp_err_t ret = oled_flush_front(NULL);
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "OLED flush failed: %s", esp_err_to_name(ret));
+        } else {
+            oled_mirror_notify();
+        }
+        if (have_screen || have_frame) {
+            oled_idle_wake();
+        }
+
+        if (have_screen || have_frame) {
+            xSemaphoreTake(oled_queue_mutex, portMAX_DELAY);
+            if (have_screen) {
+                if (ret == ESP_OK) {
+                    oled_queue.stats.rendered++;
+                } else {
+                    oled_queue.stats.dropped++;
+                }
+            }
+            if (have_frame) {
+                if (ret == ESP_OK) {
+                    oled_queue.frame_stats.flushed++;
+                } else {
+                    oled_queue.frame_stats.skipped++;
+                }
+            }
+            xSemaphoreGive(oled_queue_mutex);
+        }
+    }
+}
+
+/* 函数名：oled_post
  *
- * 函数说明：初始化 I2C 总线与 SSD1306 显示屏，创建互斥并标记初始化状态。
+ * 函数说明：提交屏幕请求。直接写入待处理槽位，若已有未渲染的请求则覆盖并计入
+ *           合并次数，然后唤醒渲染任务；渲染任务不可用时同步绘制并刷新。
  * 参数：
+ *   kind  - 屏幕类型。
+ *   l1~l3 - 行文本，可为 NULL。
+ *   text  - 正文文本，可为 NULL。
+ * 返回值：
  *   无。
+ */
+static void oled_post(oled_screen_kind_t kind, const char *l1, const char *l2, const char *l3, const char *text)
+{
+    if (oled_queue_mutex == NULL) return;
+
+    xSemaphoreTake(oled_queue_mutex, portMAX_DELAY);
+    if (!g_oled.initialized) {
+        oled_queue.stats.dropped++;
+        xSemaphoreGive(oled_queue_mutex);
+        return;
+    }
+
+    oled_screen_t *scr = &oled_queue.screen;
+    if (oled_queue.pending) {
+        oled_queue.stats.coalesced++;
+    }
+    if (oled_queue.frame_pending) {
+        /* The screen is drawn over the pushed frame before it reaches the panel */
+        oled_queue.frame_pending = false;
+        oled_queue.frame_stats.skipped++;
+    }
+    if (oled_queue.anim_pending && oled_queue.anim->loop) {
+        oled_queue.anim_pending = false;    /* a one-shot animation still plays first */
+    }
+    scr->kind = kind;
+    oled_copy_str(scr->line[0], sizeof(scr->line[0]), l1);
+    oled_copy_str(scr->line[1], sizeof(scr->line[1]), l2);
+    oled_copy_str(scr->line[2], sizeof(scr->line[2]), l3);
+    oled_copy_str(scr->text, sizeof(scr->text), text);
+    oled_queue.pending = true;
+    oled_queue.stats.posted++;
+
+    if (oled_render_task_handle != NULL) {
+        xSemaphoreGive(oled_queue_mutex);
+        xTaskNotifyGive(oled_render_task_handle);
+        return;
+    }
+
+    /* Synchronous fallback: render straight from the mailbox */
+    xSemaphoreTake(oled_mutex, portMAX_DELAY);
+    oled_render_screen(scr);
+    oled_queue.pending = false;
+    bool shown = ssd1306_show(&g_oled.display) == ESP_OK;
+    if (shown) {
+        oled_queue.stats.rendered++;
+    } else {
+        oled_queue.stats.dropped++;
+    }
+    xSemaphoreGive(oled_mutex);
+    xSemaphoreGive(oled_queue_mutex);
+    if (shown) {
+        oled_mirror_notify();
+    }
+}
+
+/* 函数名：oled_get_queue_stats
+ *
+ * 函数说明：读取显示请求队列统计（深度、合并、丢弃等）。
+ * 参数：
+ *   out - 输出统计结构。
  * 返回值：
- *   ESP_OK 表示初始化成功，错误时返回对应 esp_err_t。
+ *   无。
  */
-esp_err_t oled_init(void)
+void oled_get_queue_stats(oled_queue_stats_t *out)
+{
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (oled_queue_mutex == NULL) return;
+
+    xSemaphoreTake(oled_queue_mutex, portMAX_DELAY);
+    *out = oled_queue.stats;
+    out->depth = oled_queue.pending ? 1 : 0;
+    xSemaphoreGive(oled_queue_mutex);
+}
+
+/* 函数名：oled_rx_open
+ *
+ * 函数说明：首次推送时为接收路径创建专用帧缓冲（后台帧的克隆，不刷新，因此不需要影子缓冲）。
+ *           调用方须持有 oled_rx_mutex。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   ESP_OK 表示成功，否则为 ssd1306_clone 的错误码。
+ */
+static esp_err_t oled_rx_open(void)
+{
+    if (oled_rx.buffer) return ESP_OK;
+
+    xSemaphoreTake(oled_mutex, portMAX_DELAY);
+    esp_err_t ret = ssd1306_clone(&oled_rx, &g_oled.display);
+    xSemaphoreGive(oled_mutex);
+    if (ret != ESP_OK) return ret;
+    free(oled_rx.shadow);
+    oled_rx.shadow = NULL;
+    return ESP_OK;
+}
+
+/* 函数名：oled_push_frame
+ *
+ * 函数说明：接收远程渲染的帧：请求体直接读入接收路径专用的帧缓冲（不持有 oled_mutex，
+ *           慢速或停顿的客户端不会阻塞渲染任务与其他画面），收完后在 oled_mutex 的短暂
+ *           保护下把变化的列段交给后台帧，标记帧待刷新并唤醒渲染任务（按帧率上限刷新，
+ *           期间到达的新帧覆盖旧帧并计为跳过）；尚未渲染的屏幕请求被新帧取代。
+ *           增量帧以接收缓冲中上一次推送的帧为基准，其间显示过其他画面时交出整帧；
+ *           还没有完整接收过帧或上一次接收失败时拒绝，客户端应重发完整帧。
+ * 参数：
+ *   format - 完整帧或增量帧。
+ *   len    - 请求体长度。
+ *   read   - 读取回调。
+ *   ctx    - 回调上下文。
+ * 返回值：
+ *   ESP_OK 已接收；ESP_ERR_INVALID_STATE 显示未初始化；ESP_ERR_NOT_FOUND 增量帧没有基准帧；
+ *   ESP_ERR_INVALID_SIZE 帧格式错误；ESP_ERR_NO_MEM 无法分配接收缓冲；ESP_FAIL 读取请求体失败。
+ */
+esp_err_t oled_push_frame(oled_frame_format_t format, size_t len, oled_frame_read_fn read, void *ctx)
 {
+    if (oled_queue_mutex == NULL || oled_rx_mutex == NULL || !g_oled.initialized) return ESP_ERR_INVALID_STATE;
+
     esp_err_t ret;
-    
-    if (g_oled.initialized) {
-        return ESP_OK;
+    bool flushed = false;
+    xSemaphoreTake(oled_rx_mutex, portMAX_DELAY);
+    ret = oled_rx_open();
+    if (ret == ESP_OK && format == OLED_FRAME_DELTA && !oled_rx_valid) {
+        ret = ESP_ERR_NOT_FOUND;
+    } else if (ret == ESP_OK) {
+        ret = oled_frame_recv(&oled_rx, format, len, read, ctx);
+        /* A partly received frame no longer matches the sender's previous frame */
+        oled_rx_valid = ret == ESP_OK;
     }
-    
-    /* Create mutex for thread-safe access */
-    oled_mutex = xSemaphoreCreateMutex();
-    if (oled_mutex == NULL) {
-        ESP_LOGE(TAG, "Failed to create OLED mutex");
-        return ESP_FAIL;
+
+    if (ret == ESP_OK) {
+        xSemaphoreTake(oled_mutex, portMAX_DELAY);
+        if (!oled_remote_live) {
+            /* Other content was drawn since the last push: hand over the whole frame */
+            for (uint8_t page = 0; page < oled_rx.pages; page++) {
+                ssd1306_page_span(&oled_rx, page, 0, oled_rx.width);
+            }
+        }
+        ssd1306_take_frame(&g_oled.display, &oled_rx);
+        oled_status_view.live = false;
+        oled_pager.active = false;
+        oled_remote_live = true;
+        if (oled_render_task_handle == NULL) {
+            flushed = ssd1306_show(&g_oled.display) == ESP_OK;  /* synchronous fallback */
+        }
+        xSemaphoreGive(oled_mutex);
     }
-    
+    xSemaphoreGive(oled_rx_mutex);
+
+    xSemaphoreTake(oled_queue_mutex, portMAX_DELAY);
+    if (ret != ESP_OK) {
+        oled_queue.frame_stats.rejected++;
+    } else {
+        oled_queue.frame_stats.accepted++;
+        if (oled_queue.frame_pending) {
+            oled_queue.frame_stats.skipped++;
+        }
+        if (oled_queue.pending) {
+            oled_queue.pending = false;
+            oled_queue.stats.coalesced++;
+        }
+        oled_queue.anim_pending = false;
+        if (oled_render_task_handle != NULL) {
+            oled_queue.frame_pending = true;
+        } else if (flushed) {
+            oled_queue.frame_stats.flushed++;
+        } else {
+            oled_queue.frame_stats.skipped++;
+        }
+    }
+    xSemaphoreGive(oled_queue_mutex);
+
+    if (ret == ESP_OK && oled_render_task_handle != NULL) {
+        xTaskNotifyGive(oled_render_task_handle);
+    } else if (flushed) {
+        oled_mirror_notify();
+    }
+    return ret;
+}
+
+/* 函数名：oled_get_frame_stats
+ *
+ * 函数说明：读取远程帧推送统计（接收、跳过、刷新、拒绝）。
+ * 参数：
+ *   out - 输出统计结构。
+ * 返回值：
+ *   无。
+ */
+void oled_get_frame_stats(oled_frame_stats_t *out)
+{
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (oled_queue_mutex == NULL) return;
+
+    xSemaphoreTake(oled_queue_mutex, portMAX_DELAY);
+    *out = oled_queue.frame_stats;
+    xSemaphoreGive(oled_queue_mutex);
+}
+
+/* 函数名：oled_play_anim
+ *
+ * 函数说明：请求播放 Flash 中的动画，由渲染任务按动画帧率播放。单次动画（如开机
+ *           动画）播放期间提交的屏幕请求在动画结束后显示；循环动画（如告警）被下一个
+ *           屏幕请求取代。推送的远程帧总是立即结束动画。
+ * 参数：
+ *   anim - 动画。
+ * 返回值：
+ *   ESP_OK 已提交；ESP_ERR_INVALID_ARG 参数为空；ESP_ERR_INVALID_SIZE 尺寸与屏幕不符；
+ *   ESP_ERR_INVALID_STATE 显示未初始化或没有渲染任务（动画需要后台渲染任务）。
+ */
+esp_err_t oled_play_anim(const oled_anim_t *anim)
+{
+    if (!anim || anim->fps == 0) return ESP_ERR_INVALID_ARG;
+    if (oled_queue_mutex == NULL || !g_oled.initialized ||
+        oled_render_task_handle == NULL || oled_anim_timer == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (anim->width != g_oled.display.width || anim->height != g_oled.display.height) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    xSemaphoreTake(oled_queue_mutex, portMAX_DELAY);
+    oled_queue.anim = anim;
+    oled_queue.anim_pending = true;
+    if (anim->loop && oled_queue.pending) {
+        oled_queue.pending = false;
+        oled_queue.stats.coalesced++;
+    }
+    if (oled_queue.frame_pending) {
+        oled_queue.frame_pending = false;
+        oled_queue.frame_stats.skipped++;
+    }
+    xSemaphoreGive(oled_queue_mutex);
+
+    xTaskNotifyGive(oled_render_task_handle);
+    return ESP_OK;
+}
+
+/* 函数名：oled_get_anim_stats
+ *
+ * 函数说明：读取当前（或最近一次）动画的帧节奏统计。
+ * 参数：
+ *   out - 输出统计结构。
+ * 返回值：
+ *   无。
+ */
+void oled_get_anim_stats(oled_anim_stats_t *out)
+{
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (oled_queue_mutex == NULL) return;
+
+    xSemaphoreTake(oled_queue_mutex, portMAX_DELAY);
+    *out = oled_queue.anim_stats;
+    xSemaphoreGive(oled_queue_mutex);
+}
+
+/* 函数名：oled_get_idle_stats
+ *
+ * 函数说明：读取空闲策略状态与各状态的累计时长。
+ * 参数：
+ *   out - 输出统计结构。
+ * 返回值：
+ *   无。
+ */
+void oled_get_idle_stats(oled_idle_stats_t *out)
+{
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (oled_queue_mutex == NULL) return;
+
+    xSemaphoreTake(oled_queue_mutex, portMAX_DELAY);
+    oled_idle_t idle = oled_queue.idle;
+    xSemaphoreGive(oled_queue_mutex);
+
+    int64_t now = esp_timer_get_time();
+    out->enabled = oled_render_task_handle != NULL &&
+                   (idle.cfg.dim_after_ms != 0 || idle.cfg.off_after_ms != 0);
+    out->state = idle.state;
+    out->idle_ms = (uint32_t)((now - idle.last_activity_us) / 1000);
+    out->active_ms = (uint32_t)(oled_idle_time_in(&idle, OLED_IDLE_ACTIVE, now) / 1000);
+    out->dim_ms = (uint32_t)(oled_idle_time_in(&idle, OLED_IDLE_DIM, now) / 1000);
+    out->off_ms = (uint32_t)(oled_idle_time_in(&idle, OLED_IDLE_OFF, now) / 1000);
+    out->wakes = idle.wakes;
+}
+
+/* 函数名：oled_read_frame
+ *
+ * 函数说明：在 oled_mutex 保护下把后台帧复制到新分配的缓冲，只持锁完成内存拷贝；
+ *           调用方释放锁后再从副本发送，慢速客户端不会阻塞渲染任务。
+ *           snap 只填写尺寸与 buffer，不可用于刷新屏幕。
+ * 参数：
+ *   snap - 输出：快照，调用方用 free() 释放 snap->buffer。
+ * 返回值：
+ *   ESP_OK 成功；ESP_ERR_INVALID_STATE 显示未初始化；ESP_ERR_NO_MEM 内存不足。
+ */
+esp_err_t oled_read_frame(ssd1306_t *snap)
+{
+    if (oled_mutex == NULL || !g_oled.initialized || !snap) return ESP_ERR_INVALID_STATE;
+
+    memset(snap, 0, sizeof(*snap));
+    snap->width = g_oled.display.width;
+    snap->height = g_oled.display.height;
+    snap->pages = g_oled.display.pages;
+    size_t size = (size_t)snap->width * snap->pages;
+    snap->buffer = (uint8_t *)malloc(size);
+    if (!snap->buffer) return ESP_ERR_NO_MEM;
+
+    xSemaphoreTake(oled_mutex, portMAX_DELAY);
+    memcpy(snap->buffer, g_oled.display.buffer, size);
+    xSemaphoreGive(oled_mutex);
+    return ESP_OK;
+}
+
+/* 函数名：oled_mirror_open
+ *
+ * 函数说明：为调用任务登记一个实时镜像客户端。客户端的帧副本初始为全黑，
+ *           之后每次刷新通过任务通知唤醒该任务。
+ * 参数：
+ *   out - 输出：镜像句柄。
+ * 返回值：
+ *   ESP_OK 成功；ESP_ERR_INVALID_STATE 显示未初始化；ESP_ERR_NO_MEM 内存不足或
+ *   客户端已满（OLED_MIRROR_MAX_CLIENTS）。
+ */
+esp_err_t oled_mirror_open(oled_mirror_t **out)
+{
+    if (!out || oled_queue_mutex == NULL || !g_oled.initialized) return ESP_ERR_INVALID_STATE;
+
+    oled_mirror_t *m = calloc(1, sizeof(*m));
+    uint8_t *copy = calloc((size_t)g_oled.display.width * g_oled.display.pages, 1);
+    if (!m || !copy) {
+        free(m);
+        free(copy);
+        return ESP_ERR_NO_MEM;
+    }
+    m->task = xTaskGetCurrentTaskHandle();
+    m->copy = copy;
+
+    esp_err_t ret = ESP_ERR_NO_MEM;
+    xSemaphoreTake(oled_queue_mutex, portMAX_DELAY);
+    for (int i = 0; i < OLED_MIRROR_MAX_CLIENTS; i++) {
+        if (oled_mirrors[i] == NULL) {
+            oled_mirrors[i] = m;
+            ret = ESP_OK;
+            break;
+        }
+    }
+    xSemaphoreGive(oled_queue_mutex);
+
+    if (ret != ESP_OK) {
+        free(copy);
+        free(m);
+        return ret;
+    }
+    *out = m;
+    return ESP_OK;
+}
+
+/* 函数名：oled_mirror_next
+ *
+ * 函数说明：等待下一次刷新（首次调用不等待），在 oled_mutex 保护下比较后台帧与
+ *           客户端副本，把变化的列段编码为增量记录（与 POST /api/oled/frame 的
+ *           增量格式相同）。
+ * 参数：
+ *   m          - 镜像句柄。
+ *   out        - 输出缓冲。
+ *   cap        - 输出缓冲大小，至少 OLED_FRAME_DIFF_MAX(width, pages)。
+ *   timeout_ms - 最长等待时间。
+ * 返回值：
+ *   增量长度；超时或画面无变化时返回 0。
+ */
+size_t oled_mirror_next(oled_mirror_t *m, uint8_t *out, size_t cap, uint32_t timeout_ms)
+{
+    if (m->primed && ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms)) == 0) {
+        return 0;
+    }
+    m->primed = true;
+
+    xSemaphoreTake(oled_mutex, portMAX_DELAY);
+    size_t len = oled_frame_diff(&g_oled.display, m->copy, out, cap);
+    xSemaphoreGive(oled_mutex);
+    return len;
+}
+
+/* 函数名：oled_mirror_close
+ *
+ * 函数说明：注销镜像客户端并释放其帧副本。
+ * 参数：
+ *   m - 镜像句柄，可为 NULL。
+ * 返回值：
+ *   无。
+ */
+void oled_mirror_close(oled_mirror_t *m)
+{
+    if (!m) return;
+
+    xSemaphoreTake(oled_queue_mutex, portMAX_DELAY);
+    for (int i = 0; i < OLED_MIRROR_MAX_CLIENTS; i++) {
+        if (oled_mirrors[i] == m) {
+            oled_mirrors[i] = NULL;
+        }
+    }
+    xSemaphoreGive(oled_queue_mutex);
+    free(m->copy);
+    free(m);
+}
+
+/* 函数名：oled_font_mount
+ *
+ * 函数说明：查找字体分区并整体内存映射后挂载到字体渲染器。分区不存在或映像无效时
+ *           仅记录日志，文本继续使用内置 5x8 ASCII 字体。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+static void oled_font_mount(void)
+{
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+        (esp_partition_subtype_t)OLED_FONT_PARTITION_SUBTYPE, OLED_FONT_PARTITION_LABEL);
+    if (part == NULL) {
+        ESP_LOGI(TAG, "No font partition, OLED text is ASCII only");
+        return;
+    }
+
+    const void *image = NULL;
+    esp_partition_mmap_handle_t handle;  /* mapping stays for the lifetime of the app */
+    esp_err_t ret = esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA, &image, &handle);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to map font partition: %s", esp_err_to_name(ret));
+        return;
+    }
+    if (oled_font_attach(image, part->size) != ESP_OK) {
+        ESP_LOGW(TAG, "Font partition holds no valid image, flash font/oled_font.bin");
+        esp_partition_munmap(handle);
+    }
+}
+
+#ifdef CONFIG_OLED_BUS_SPI
+/* 函数名：oled_panel_init
+ *
+ * 函数说明：初始化 SPI 总线（DMA 通道自动分配，单次传输可容纳整帧）并在其上初始化屏幕。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   ESP_OK 表示成功，错误时返回对应 esp_err_t。
+ */
+static esp_err_t oled_panel_init(void)
+{
+    ESP_LOGI(TAG, "Initializing SPI bus");
+
+    spi_bus_config_t bus_config = {
+        .mosi_io_num = OLED_SPI_MOSI_PIN,
+        .miso_io_num = -1,
+        .sclk_io_num = OLED_SPI_SCLK_PIN,
+        .quadwp_io_num = -1,
+        .quadhd_io_num = -1,
+        .max_transfer_sz = OLED_PANEL_WIDTH * OLED_PANEL_HEIGHT / 8,
+    };
+    esp_err_t ret = spi_bus_initialize(OLED_SPI_HOST, &bus_config, SPI_DMA_CH_AUTO);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize SPI bus: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    const ssd1306_spi_config_t panel_config = {
+        .host = OLED_SPI_HOST,
+        .cs_gpio = OLED_SPI_CS_PIN,
+        .dc_gpio = OLED_SPI_DC_PIN,
+        .rst_gpio = OLED_SPI_RST_PIN,
+        .clock_hz = OLED_SPI_CLOCK_HZ,
+    };
+    ret = ssd1306_init_spi(&g_oled.display, &panel_config, OLED_PANEL_WIDTH, OLED_PANEL_HEIGHT, false);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize SSD1306: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    return ESP_OK;
+}
+#else
+/* 函数名：oled_panel_init
+ *
+ * 函数说明：初始化 I2C 总线，以默认、NVS 中保存或现场校准的 SCL 频率添加屏幕设备并初始化屏幕。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   ESP_OK 表示成功，错误时返回对应 esp_err_t。
+ */
+static esp_err_t oled_panel_init(void)
+{
+    esp_err_t ret;
+
     ESP_LOGI(TAG, "Initializing I2C master bus");
     
     /* Configure I2C bus */
@@ -56,35 +1664,96 @@ esp_err_t oled_init(void)
         .flags.enable_internal_pullup = true,
     };
     
-    i2c_master_bus_handle_t bus_handle;
-    ret = i2c_new_master_bus(&i2c_bus_config, &bus_handle);
+    ret = i2c_new_master_bus(&i2c_bus_config, &oled_i2c_bus);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to create I2C master bus: %s", esp_err_to_name(ret));
         return ret;
     }
     
-    ESP_LOGI(TAG, "Adding OLED device to I2C bus");
-    
-    /* Configure SSD1306 device */
-    i2c_device_config_t device_config = {
-        .dev_addr_length = I2C_ADDR_BIT_LEN_7,
-        .device_address = OLED_I2C_ADDR,
-        .scl_speed_hz = I2C_FREQ_HZ,
-    };
+#if OLED_I2C_CALIBRATE
+    oled_i2c_hz = oled_i2c_calibrated_hz();
+#endif
+    ESP_LOGI(TAG, "Adding OLED device to I2C bus at %lu Hz", (unsigned long)oled_i2c_hz);
     
     i2c_master_dev_handle_t dev_handle;
-    ret = i2c_master_bus_add_device(bus_handle, &device_config, &dev_handle);
+    ret = oled_i2c_add_panel(oled_i2c_hz, &dev_handle);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to add SSD1306 device: %s", esp_err_to_name(ret));
         return ret;
     }
     
-    /* Initialize SSD1306 display (128x64 pixels, I2C address 0x3C) */
-    ret = ssd1306_init(&g_oled.display, dev_handle, 128, 64, OLED_I2C_ADDR, false);
+    /* Initialize the display with the panel chosen in menuconfig */
+    ret = ssd1306_init(&g_oled.display, dev_handle, OLED_PANEL_WIDTH, OLED_PANEL_HEIGHT, OLED_I2C_ADDR, false);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to initialize SSD1306: %s", esp_err_to_name(ret));
         return ret;
     }
+    return ESP_OK;
+}
+#endif
+
+/* 函数名：oled_init
+ *
+ * 函数说明：初始化显示总线（I2C 或 SPI，见 menuconfig）与 SSD1306 显示屏，创建互斥并标记初始化状态。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   ESP_OK 表示初始化成功，错误时返回对应 esp_err_t。
+ */
+esp_err_t oled_init(void)
+{
+    esp_err_t ret;
+    
+    if (g_oled.initialized) {
+        return ESP_OK;
+    }
+    
+    /* Create mutexes for thread-safe access */
+    oled_mutex = xSemaphoreCreateMutex();
+    oled_queue_mutex = xSemaphoreCreateMutex();
+    oled_rx_mutex = xSemaphoreCreateMutex();
+    if (oled_mutex == NULL || oled_queue_mutex == NULL || oled_rx_mutex == NULL) {
+        ESP_LOGE(TAG, "Failed to create OLED mutex");
+        return ESP_FAIL;
+    }
+    
+    ret = oled_panel_init();
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
+    oled_status_view_setup(&g_oled.display);
+    oled_font_mount();
+
+    const oled_idle_config_t idle_config = {
+        .dim_after_ms = OLED_DIM_AFTER_S * 1000u,
+        .off_after_ms = OLED_OFF_AFTER_S * 1000u,
+        .contrast = OLED_CONTRAST,
+        .dim_contrast = OLED_DIM_CONTRAST,
+    };
+    oled_idle_init(&oled_idle, &idle_config, esp_timer_get_time());
+    oled_queue.idle = oled_idle;
+
+    /* Front buffer for the background render task; falls back to synchronous rendering on failure */
+    if (ssd1306_clone(&g_oled.front, &g_oled.display) == ESP_OK) {
+        if (xTaskCreate(oled_render_task, "oled_render", OLED_RENDER_TASK_STACK, NULL,
+                        OLED_RENDER_TASK_PRIO, &oled_render_task_handle) != pdPASS) {
+            ESP_LOGW(TAG, "Failed to create OLED render task, using synchronous rendering");
+            ssd1306_deinit(&g_oled.front);
+            oled_render_task_handle = NULL;
+        } else {
+            const esp_timer_create_args_t timer_args = {
+                .callback = oled_anim_timer_cb,
+                .name = "oled_anim",
+            };
+            if (esp_timer_create(&timer_args, &oled_anim_timer) != ESP_OK) {
+                ESP_LOGW(TAG, "Failed to create OLED animation timer, animations disabled");
+                oled_anim_timer = NULL;
+            }
+        }
+    } else {
+        ESP_LOGW(TAG, "No memory for OLED front buffer, using synchronous rendering");
+    }
     
     g_oled.initialized = true;
     ESP_LOGI(TAG, "OLED display initialized successfully");
@@ -94,7 +1763,7 @@ esp_err_t oled_init(void)
 
 /* 函数名：oled_show_status
  *
- * 函数说明：显示三行状态文本，带刷新频率限制与互斥保护。
+ * 函数说明：显示三行状态文本。请求进入合并队列，由渲染任务按帧率上限绘制最新状态。
  * 参数：
  *   line1 - 第一行文本。
  *   line2 - 第二行文本。
@@ -104,25 +1773,7 @@ esp_err_t oled_init(void)
  */
 void oled_show_status(const char *line1, const char *line2, const char *line3)
 {
-    if (!g_oled.initialized || oled_mutex == NULL) return;
-    
-    /* Rate limiting: check if enough time has passed since last refresh */
-    TickType_t now = xTaskGetTickCount();
-    if ((now - last_refresh_tick) < pdMS_TO_TICKS(OLED_MIN_REFRESH_MS)) {
-        return;  /* Skip this refresh to avoid overloading I2C bus */
-    }
-    
-    /* Thread-safe access */
-    if (xSemaphoreTake(oled_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        ssd1306_clear(&g_oled.display);
-        ssd1306_text(&g_oled.display, line1, 0, 0, 1, 1);   /* truncate mode */
-        ssd1306_text(&g_oled.display, line2, 0, 16, 1, 1);  /* truncate mode */
-        ssd1306_text(&g_oled.display, line3, 0, 32, 1, 1);  /* truncate mode */
-        ssd1306_show(&g_oled.display);
-        
-        last_refresh_tick = xTaskGetTickCount();
-        xSemaphoreGive(oled_mutex);
-    }
+    oled_post(OLED_SCREEN_STATUS, line1, line2, line3, NULL);
 }
 
 /* 函数名：oled_show_connecting
@@ -135,16 +1786,7 @@ void oled_show_status(const char *line1, const char *line2, const char *line3)
  */
 void oled_show_connecting(void)
 {
-    if (!g_oled.initialized || oled_mutex == NULL) return;
-    
-    if (xSemaphoreTake(oled_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        ssd1306_clear(&g_oled.display);
-        ssd1306_text(&g_oled.display, "ESP32 WiFi Demo", 0, 0, 1, 1);  /* truncate mode */
-        ssd1306_text(&g_oled.display, "Connecting...", 0, 16, 1, 1);   /* truncate mode */
-        ssd1306_show(&g_oled.display);
-        last_refresh_tick = xTaskGetTickCount();
-        xSemaphoreGive(oled_mutex);
-    }
+    oled_post(OLED_SCREEN_CONNECTING, NULL, NULL, NULL, NULL);
 }
 
 /* 函数名：oled_show_connected
@@ -157,17 +1799,7 @@ void oled_show_connecting(void)
  */
 void oled_show_connected(void)
 {
-    if (!g_oled.initialized || oled_mutex == NULL) return;
-    
-    if (xSemaphoreTake(oled_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        ssd1306_clear(&g_oled.display);
-        ssd1306_text(&g_oled.display, "WiFi Connected!", 0, 0, 1, 1);   /* truncate mode */
-        ssd1306_text(&g_oled.display, "Server Running", 0, 16, 1, 1);   /* truncate mode */
-        ssd1306_text(&g_oled.display, FETCH_URL, 0, 32, 1, 0);  /* truncate mode */
-        ssd1306_show(&g_oled.display);
-        last_refresh_tick = xTaskGetTickCount();
-        xSemaphoreGive(oled_mutex);
-    }
+    oled_post(OLED_SCREEN_CONNECTED, NULL, NULL, NULL, NULL);
 }
 
 /* 函数名：oled_show_connected_with_ip
@@ -180,20 +1812,8 @@ void oled_show_connected(void)
  */
 void oled_show_connected_with_ip(const char *ip_address)
 {
-    if (!g_oled.initialized || oled_mutex == NULL) return;
-    
-    if (xSemaphoreTake(oled_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        ssd1306_clear(&g_oled.display);
-        ssd1306_text(&g_oled.display, "WiFi Connected!", 0, 0, 1, 1);   /* truncate mode */
-        ssd1306_text(&g_oled.display, "Server: Port 443", 0, 12, 1, 1);  /* truncate mode */
-        ssd1306_text(&g_oled.display, "IP Address:", 0, 24, 1, 1);       /* truncate mode */
-        ssd1306_text(&g_oled.display, ip_address ? ip_address : "N/A", 0, 36, 1, 1);  /* truncate mode */
-        ssd1306_show(&g_oled.display);
-        last_refresh_tick = xTaskGetTickCount();
-        xSemaphoreGive(oled_mutex);
-        
-        ESP_LOGI(TAG, "OLED displaying IP: %s", ip_address ? ip_address : "N/A");
-    }
+    oled_post(OLED_SCREEN_CONNECTED_IP, ip_address ? ip_address : "N/A", NULL, NULL, NULL);
+    ESP_LOGI(TAG, "OLED displaying IP: %s", ip_address ? ip_address : "N/A");
 }
 
 /* 函数名：oled_show_error
@@ -206,16 +1826,7 @@ void oled_show_connected_with_ip(const char *ip_address)
  */
 void oled_show_error(const char *error_text)
 {
-    if (!g_oled.initialized || oled_mutex == NULL) return;
-    
-    if (xSemaphoreTake(oled_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        ssd1306_clear(&g_oled.display);
-        ssd1306_text(&g_oled.display, "ERROR", 0, 0, 1, 1);             /* truncate mode */
-        ssd1306_text(&g_oled.display, error_text, 0, 16, 1, 0);         /* auto wrap mode */
-        ssd1306_show(&g_oled.display);
-        last_refresh_tick = xTaskGetTickCount();
-        xSemaphoreGive(oled_mutex);
-    }
+    oled_post(OLED_SCREEN_ERROR, NULL, NULL, NULL, error_text);
 }
 
 /* 函数名：oled_show_joke
@@ -228,19 +1839,8 @@ void oled_show_error(const char *error_text)
  */
 void oled_show_joke(const char *joke_text)
 {
-    if (!g_oled.initialized || !joke_text || oled_mutex == NULL) return;
-    
-    if (xSemaphoreTake(oled_mutex, pdMS_TO_TICKS(200)) == pdTRUE) {
-        ssd1306_clear(&g_oled.display);
-        ssd1306_text(&g_oled.display, "Joke:", 0, 0, 1, 1);  /* Title: truncate mode */
-        
-        /* Display joke text with auto wrap (mode 0) */
-        ssd1306_text(&g_oled.display, joke_text, 0, 10, 1, 0);
-        
-        ssd1306_show(&g_oled.display);
-        last_refresh_tick = xTaskGetTickCount();
-        xSemaphoreGive(oled_mutex);
-    }
+    if (!joke_text) return;
+    oled_post(OLED_SCREEN_JOKE, NULL, NULL, NULL, joke_text);
 }
 
 /* 函数名：oled_show_custom_text
@@ -253,21 +1853,7 @@ void oled_show_joke(const char *joke_text)
  */
 void oled_show_custom_text(const char *text)
 {
-    if (!g_oled.initialized || !text || oled_mutex == NULL) return;
-    
-    if (xSemaphoreTake(oled_mutex, pdMS_TO_TICKS(200)) == pdTRUE) {
-        ssd1306_clear(&g_oled.display);
-        ssd1306_text(&g_oled.display, "Web Message:", 0, 0, 1, 1);  /* Title */
-        
-        /* Display custom text with auto wrap */
-        ssd1306_text(&g_oled.display, text, 0, 12, 1, 0);
-        
-        ssd1306_show(&g_oled.display);
-        last_refresh_tick = xTaskGetTickCount();
-        xSemaphoreGive(oled_mutex);
-        
-        ESP_LOGI(TAG, "Displayed on OLED: %s", text);
-    }
+    if (!text) return;
+    oled_post(OLED_SCREEN_CUSTOM_TEXT, NULL, NULL, NULL, text);
+    ESP_LOGI(TAG, "Displayed on OLED: %s", text);
 }
-
-
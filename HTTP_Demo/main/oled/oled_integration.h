@@ -16,13 +16,58 @@
 #define OLED_INTEGRATION_H
 
 #include "ssd1306.h"
+#include "oled_frame.h"
+#include "oled_anim.h"
+#include "oled_idle.h"
 #include "esp_log.h"
 
 typedef struct {
-    ssd1306_t display;
+    ssd1306_t display;      /* back buffer: oled_show_* draws here */
+    ssd1306_t front;        /* front buffer: owned by the flush task */
     bool initialized;
 } oled_context_t;
 
+/* Display request queue statistics */
+typedef struct {
+    uint32_t posted;        /* requests accepted */
+    uint32_t rendered;      /* requests drawn and flushed to the panel */
+    uint32_t coalesced;     /* pending requests replaced by a newer one before rendering */
+    uint32_t dropped;       /* requests rejected (display not ready) or lost to a bus error */
+    uint8_t depth;          /* requests currently pending (0 or 1) */
+} oled_queue_stats_t;
+
+/* Pushed frame statistics */
+typedef struct {
+    uint32_t accepted;      /* frames received completely into the back buffer */
+    uint32_t skipped;       /* accepted frames replaced or drawn over before reaching the panel */
+    uint32_t flushed;       /* frames sent to the panel */
+    uint32_t rejected;      /* malformed or truncated bodies, deltas without a base frame */
+} oled_frame_stats_t;
+
+/* Animation frame pacing (current or last animation) */
+typedef struct {
+    const char *name;       /* NULL until an animation has been played */
+    bool playing;
+    uint8_t target_fps;
+    uint32_t shown;         /* frames flushed to the panel */
+    uint32_t dropped;       /* frames decoded but overtaken before their flush (playback fell behind) */
+    uint32_t elapsed_ms;    /* since the first frame */
+    uint32_t max_late_us;   /* worst delay from a frame's slot to the start of its flush */
+    uint32_t avg_flush_us;  /* bus time per frame */
+    uint32_t max_flush_us;
+} oled_anim_stats_t;
+
+/* Idle power policy: state and time spent in each state since boot */
+typedef struct {
+    bool enabled;           /* needs the render task and a non-zero dim or off delay */
+    oled_idle_state_t state;
+    uint32_t idle_ms;       /* since the last screen, pushed frame or animation frame */
+    uint32_t active_ms;
+    uint32_t dim_ms;
+    uint32_t off_ms;
+    uint32_t wakes;         /* dimmed or off panel brought back by new content */
+} oled_idle_stats_t;
+
 /* Global OLED context */
 extern oled_context_t g_oled;
 
@@ -38,4 +83,27 @@ void oled_show_connected_with_ip(const char *ip_address);  /* 显示IP地址 */
 void oled_show_error(const char *error_text);
 void oled_show_custom_text(const char *text);  /* 显示自定义文本 */
 
+/* Display request queue statistics */
+void oled_get_queue_stats(oled_queue_stats_t *out);
+
+/* Remote-rendered frames: the body is read straight into the back buffer */
+esp_err_t oled_push_frame(oled_frame_format_t format, size_t len, oled_frame_read_fn read, void *ctx);
+void oled_get_frame_stats(oled_frame_stats_t *out);
+
+/* Flash animations played by the render task at their own frame rate */
+esp_err_t oled_play_anim(const oled_anim_t *anim);
+void oled_get_anim_stats(oled_anim_stats_t *out);
+
+/* Auto-dim and panel-off after inactivity; any new content wakes the panel */
+void oled_get_idle_stats(oled_idle_stats_t *out);
+
+/* Snapshot: copies the back buffer into snap (geometry + malloc'd buffer, caller frees) */
+esp_err_t oled_read_frame(ssd1306_t *snap);
+
+/* Live mirror: after each flush, the changed column runs as oled_frame delta records */
+typedef struct oled_mirror oled_mirror_t;
+esp_err_t oled_mirror_open(oled_mirror_t **out);
+size_t oled_mirror_next(oled_mirror_t *m, uint8_t *out, size_t cap, uint32_t timeout_ms);
+void oled_mirror_close(oled_mirror_t *m);
+
 #endif /* OLED_INTEGRATION_H */
@@ -0,0 +1,291 @@
+#include "oled_layout.h"
+#include "oled_font.h"
+#include <string.h>
+
+#define OLED_LAYOUT_CACHE_SIZE  4
+#define OLED_LAYOUT_NO_BREAK    0xFFFF
+
+typedef struct {
+    oled_layout_t layout;
+    uint32_t stamp;         /* last use, for LRU replacement; 0 = empty */
+} oled_layout_slot_t;
+
+static oled_layout_slot_t oled_layout_cache[OLED_LAYOUT_CACHE_SIZE];
+static uint32_t oled_layout_clock = 0;
+static oled_layout_stats_t oled_layout_stats = {0};
+
+/* 函数名：oled_layout_hash
+ *
+ * 函数说明：计算文本的 64 位 FNV-1a 哈希。
+ * 参数：
+ *   text - 文本。
+ *   len  - 输出：文本长度。
+ * 返回值：
+ *   哈希值。
+ */
+static uint64_t oled_layout_hash(const char *text, uint16_t *len)
+{
+    uint64_t h = 0xcbf29ce484222325ull;
+    const unsigned char *p = (const unsigned char *)text;
+    while (*p) {
+        h ^= *p++;
+        h *= 0x100000001b3ull;
+    }
+    *len = (uint16_t)(p - (const unsigned char *)text);
+    return h;
+}
+
+/* 函数名：oled_layout_measure
+ *
+ * 函数说明：取出下一个字符并测量宽度。UTF-8 模式按字体渲染器规则，
+ *           否则按 ssd1306_text 规则（逐字节，0x20-0x7F 以外不绘制）。
+ * 参数：
+ *   p    - 输入/输出：读取位置。
+ *   utf8 - 是否 UTF-8 模式。
+ *   cp   - 输出：字符。
+ *   ink  - 输出：墨迹宽度。
+ * 返回值：
+ *   前进宽度，0 表示不绘制。
+ */
+static uint16_t oled_layout_measure(const char **p, bool utf8, uint32_t *cp, uint16_t *ink)
+{
+    if (utf8) {
+        *cp = oled_font_next_codepoint(p);
+        return oled_font_measure(*cp, ink);
+    }
+    *cp = (unsigned char)*(*p)++;
+    if (*cp < 0x20 || *cp > 0x7F) {
+        *ink = 0;
+        return 0;
+    }
+    *ink = FONT_CHAR_WIDTH;
+    return FONT_TOTAL_WIDTH;
+}
+
+/* 函数名：oled_layout_breaks_after
+ *
+ * 函数说明：判断字符之后是否允许断行（汉字、全角符号与连字符之后）。
+ * 参数：
+ *   cp - 字符。
+ * 返回值：
+ *   true 允许断行。
+ */
+static bool oled_layout_breaks_after(uint32_t cp)
+{
+    return cp == '-' || cp >= 0x2E80;
+}
+
+/* 函数名：oled_layout_emit
+ *
+ * 函数说明：追加一行（超出行数上限时标记截断）。
+ * 参数：
+ *   lay   - 排版结果。
+ *   start - 行起始偏移。
+ *   end   - 行结束偏移（不含）。
+ * 返回值：
+ *   false 表示行数已满。
+ */
+static bool oled_layout_emit(oled_layout_t *lay, size_t start, size_t end)
+{
+    if (lay->nlines >= OLED_LAYOUT_MAX_LINES) {
+        lay->truncated = true;
+        return false;
+    }
+    if (end - start > OLED_LAYOUT_LINE_BYTES) end = start + OLED_LAYOUT_LINE_BYTES;
+    lay->lines[lay->nlines].offset = (uint16_t)start;
+    lay->lines[lay->nlines].length = (uint16_t)(end - start);
+    lay->nlines++;
+    return true;
+}
+
+/* 函数名：oled_layout_wrap
+ *
+ * 函数说明：贪心换行：优先在最近的断行机会（空格、汉字之后、连字符之后）处断开，
+ *           一行内没有断行机会时在当前字符前强制断开；'\n' 强制换行，
+ *           自动换行后行首的空格被丢弃。
+ * 参数：
+ *   lay  - 排版结果（调用前已填好 max_width/utf8）。
+ *   text - 文本。
+ *   len  - 文本长度。
+ * 返回值：
+ *   无。
+ */
+static void oled_layout_wrap(oled_layout_t *lay, const char *text, size_t len)
+{
+    size_t start = 0;       /* current line start */
+    size_t pos = 0;
+    uint16_t pen = 0;       /* advance of the characters placed so far */
+    size_t brk_end = OLED_LAYOUT_NO_BREAK;
+    size_t brk_resume = 0;
+    bool wrapped = false;   /* current line was started by an automatic wrap */
+
+    while (pos < len) {
+        const char *p = text + pos;
+        uint32_t cp;
+        uint16_t ink;
+        uint16_t advance = oled_layout_measure(&p, lay->utf8, &cp, &ink);
+        size_t next = (size_t)(p - text);
+
+        if (cp == '\n') {
+            if (!oled_layout_emit(lay, start, pos)) return;
+            start = pos = next;
+            pen = 0;
+            brk_end = OLED_LAYOUT_NO_BREAK;
+            wrapped = false;
+            continue;
+        }
+        if (cp == ' ') {
+            if (wrapped && pen == 0) {
+                start = pos = next;  /* leading space of a wrapped line */
+                continue;
+            }
+            brk_end = pos;
+            brk_resume = next;
+        }
+        if (advance == 0) {
+            pos = next;
+            continue;
+        }
+
+        if (pen + ink > lay->max_width && pen > 0) {
+            if (brk_end != OLED_LAYOUT_NO_BREAK && brk_end > start) {
+                if (!oled_layout_emit(lay, start, brk_end)) return;
+                start = pos = brk_resume;  /* re-measure the carried-over word */
+            } else {
+                if (!oled_layout_emit(lay, start, pos)) return;  /* no break opportunity */
+                start = pos;
+            }
+            pen = 0;
+            brk_end = OLED_LAYOUT_NO_BREAK;
+            wrapped = true;
+            continue;
+        }
+
+        pen = (uint16_t)(pen + advance);
+        if (oled_layout_breaks_after(cp)) {
+            brk_end = next;
+            brk_resume = next;
+        }
+        pos = next;
+    }
+    if (start < len) oled_layout_emit(lay, start, len);
+}
+
+/* 函数名：oled_layout_text
+ *
+ * 函数说明：获取文本的排版结果。相同内容（哈希、长度、行宽、字体模式一致）直接
+ *           返回缓存；否则测量并换行，替换最久未使用的缓存项。
+ *           含非 ASCII 字符且已挂载字体时按字体排版，行高为字体高度。
+ * 参数：
+ *   text      - 文本，NULL 视为空串。
+ *   max_width - 行宽（像素）。
+ * 返回值：
+ *   排版结果，在下一次排版调用前有效。
+ */
+const oled_layout_t *oled_layout_text(const char *text, uint16_t max_width)
+{
+    if (!text) text = "";
+
+    uint16_t len;
+    uint64_t hash = oled_layout_hash(text, &len);
+    bool utf8 = oled_font_ready() && oled_font_needed(text);
+    uint8_t line_height = utf8 ? oled_font_height() : FONT_CHAR_HEIGHT;
+
+    oled_layout_slot_t *victim = &oled_layout_cache[0];
+    for (int i = 0; i < OLED_LAYOUT_CACHE_SIZE; i++) {
+        oled_layout_slot_t *slot = &oled_layout_cache[i];
+        oled_layout_t *lay = &slot->layout;
+        if (slot->stamp && lay->hash == hash && lay->text_len == len && lay->max_width == max_width &&
+            lay->utf8 == utf8 && lay->line_height == line_height) {
+            slot->stamp = ++oled_layout_clock;
+            oled_layout_stats.hits++;
+            return lay;
+        }
+        if (slot->stamp < victim->stamp) victim = slot;
+    }
+
+    oled_layout_stats.misses++;
+    oled_layout_t *lay = &victim->layout;
+    lay->hash = hash;
+    lay->text_len = len;
+    lay->max_width = max_width;
+    lay->line_height = line_height;
+    lay->utf8 = utf8;
+    lay->truncated = false;
+    lay->nlines = 0;
+    oled_layout_wrap(lay, text, len);
+    victim->stamp = ++oled_layout_clock;
+    return lay;
+}
+
+/* 函数名：oled_layout_pages
+ *
+ * 函数说明：计算分页数。
+ * 参数：
+ *   layout         - 排版结果。
+ *   lines_per_page - 每页行数。
+ * 返回值：
+ *   页数（至少 1）。
+ */
+uint16_t oled_layout_pages(const oled_layout_t *layout, uint16_t lines_per_page)
+{
+    if (lines_per_page == 0 || layout->nlines == 0) return 1;
+    return (uint16_t)((layout->nlines + lines_per_page - 1) / lines_per_page);
+}
+
+/* 函数名：oled_layout_draw
+ *
+ * 函数说明：绘制排版结果中的若干行，每行按截断模式绘制（排版已保证放得下）。
+ * 参数：
+ *   dev    - 设备句柄。
+ *   text   - 排版时使用的同一文本。
+ *   layout - 排版结果。
+ *   first  - 起始行。
+ *   count  - 行数。
+ *   x, y   - 第一行左上坐标。
+ * 返回值：
+ *   无。
+ */
+void oled_layout_draw(ssd1306_t *dev, const char *text, const oled_layout_t *layout,
+                      uint16_t first, uint16_t count, uint16_t x, uint16_t y)
+{
+    char line[OLED_LAYOUT_LINE_BYTES + 1];
+
+    for (uint16_t i = first; i < layout->nlines && i < first + count; i++) {
+        const oled_layout_line_t *l = &layout->lines[i];
+        memcpy(line, text + l->offset, l->length);
+        line[l->length] = '\0';
+        if (layout->utf8) {
+            oled_font_text(dev, line, x, y, 1, 1);  /* truncate mode */
+        } else {
+            ssd1306_text(dev, line, x, y, 1, 1);    /* truncate mode */
+        }
+        y = (uint16_t)(y + layout->line_height);
+    }
+}
+
+/* 函数名：oled_layout_get_stats
+ *
+ * 函数说明：读取排版缓存统计。
+ * 参数：
+ *   out - 输出统计结构。
+ * 返回值：
+ *   无。
+ */
+void oled_layout_get_stats(oled_layout_stats_t *out)
+{
+    if (out) *out = oled_layout_stats;
+}
+
+/* 函数名：oled_layout_flush_cache
+ *
+ * 函数说明：清空排版缓存（更换字体后字宽改变时调用）。
+ * 参数：
+ *   无。
+ * 返回值：
+ *   无。
+ */
+void oled_layout_flush_cache(void)
+{
+    memset(oled_layout_cache, 0, sizeof(oled_layout_cache));
+}
@@ -0,0 +1,55 @@
+/*
+ * 文本排版与分页
+ *
+ * 一次性测量文本并按单词换行（空格处断行，汉字之间可断行，超长单词强制断开），
+ * 结果按行偏移保存并以内容哈希缓存：同一段笑话或消息再次显示时直接复用，
+ * 不再逐字符测量。绘制时按页取若干行，长文本以 "1/3" 形式分页而不是被截断。
+ * 本模块不加锁，由调用方串行访问（集成层在 oled_mutex 内调用）。
+ */
+#ifndef OLED_LAYOUT_H
+#define OLED_LAYOUT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define OLED_LAYOUT_MAX_LINES   48      /* lines kept per layout; the rest is dropped */
+#define OLED_LAYOUT_LINE_BYTES  64      /* longest line in bytes (16 px CJK: 8 x 3 bytes) */
+
+typedef struct {
+    uint16_t offset;        /* byte offset into the laid-out text */
+    uint16_t length;        /* bytes, trailing break space excluded */
+} oled_layout_line_t;
+
+typedef struct {
+    uint64_t hash;          /* FNV-1a of the text */
+    uint16_t text_len;
+    uint16_t max_width;
+    uint8_t line_height;
+    bool utf8;              /* drawn with oled_font_text(), otherwise ssd1306_text() */
+    bool truncated;         /* more than OLED_LAYOUT_MAX_LINES lines */
+    uint16_t nlines;
+    oled_layout_line_t lines[OLED_LAYOUT_MAX_LINES];
+} oled_layout_t;
+
+typedef struct {
+    uint32_t hits;          /* layout served from the cache */
+    uint32_t misses;        /* text measured and wrapped */
+} oled_layout_stats_t;
+
+const oled_layout_t *oled_layout_text(const char *text, uint16_t max_width);
+uint16_t oled_layout_pages(const oled_layout_t *layout, uint16_t lines_per_page);
+void oled_layout_draw(ssd1306_t *dev, const char *text, const oled_layout_t *layout,
+                      uint16_t first, uint16_t count, uint16_t x, uint16_t y);
+void oled_layout_get_stats(oled_layout_stats_t *out);
+void oled_layout_flush_cache(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OLED_LAYOUT_H */
@@ -0,0 +1,36 @@
+/*
+ * OLED 面板总线引脚
+ *
+ * I2C 使用固定的 GPIO25（SDA）/GPIO26（SCL）；SPI 的引脚由 menuconfig 选择，
+ * CS 与 RES 可设为 -1（模块上直接接地或接复位）。
+ * OLED_PANEL_PIN_MASK 汇总面板占用的引脚，GPIO 控制（pin_registry）不得驱动这些引脚。
+ */
+#ifndef OLED_PINS_H
+#define OLED_PINS_H
+
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* I2C configuration - Hardware I2C1 */
+#define I2C_SDA_PIN       25        /* GPIO25 - Standard SDA for I2C1 */
+#define I2C_SCL_PIN       26        /* GPIO26 - Standard SCL for I2C1 */
+
+/* Bit for a panel pin; -1 (not connected) gives no bit */
+#define OLED_PIN_BIT(pin) ((1ULL << ((pin) & 63)) & ((pin) >= 0 ? ~0ULL : 0ULL))
+
+#ifdef CONFIG_OLED_BUS_SPI
+#define OLED_PANEL_PIN_MASK (OLED_PIN_BIT(CONFIG_OLED_SPI_MOSI_GPIO) | OLED_PIN_BIT(CONFIG_OLED_SPI_SCLK_GPIO) | \
+                             OLED_PIN_BIT(CONFIG_OLED_SPI_CS_GPIO) | OLED_PIN_BIT(CONFIG_OLED_SPI_DC_GPIO) | \
+                             OLED_PIN_BIT(CONFIG_OLED_SPI_RST_GPIO))
+#else
+#define OLED_PANEL_PIN_MASK (OLED_PIN_BIT(I2C_SDA_PIN) | OLED_PIN_BIT(I2C_SCL_PIN))
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OLED_PINS_H */
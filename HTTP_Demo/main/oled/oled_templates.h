@@ -0,0 +1,29 @@
+/* Generated by tools/gen_oled_templates.py - do not edit by hand */
+#ifndef OLED_TEMPLATES_H
+#define OLED_TEMPLATES_H
+
+#include <stdint.h>
+
+#define OLED_TEMPLATE_WIDTH   128
+#define OLED_TEMPLATE_HEIGHT  64
+
+/* One fixed string of a template, as passed to ssd1306_text() */
+typedef struct {
+    const char *text;
+    uint8_t x;
+    uint8_t y;
+    uint8_t wrap_mode;
+} oled_template_text_t;
+
+/* Pre-rasterized screen: framebuffer image plus the strings it was built from */
+typedef struct {
+    const uint8_t *image;                /* OLED_TEMPLATE_WIDTH * OLED_TEMPLATE_HEIGHT / 8 bytes */
+    const oled_template_text_t *texts;
+    uint8_t ntexts;
+} oled_template_t;
+
+extern const oled_template_t oled_tpl_connecting;
+extern const oled_template_t oled_tpl_connected;
+extern const oled_template_t oled_tpl_connected_ip;
+
+#endif /* OLED_TEMPLATES_H */
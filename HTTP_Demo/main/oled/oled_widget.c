@@ -0,0 +1,305 @@
+#include "oled_widget.h"
+#include <string.h>
+
+/* 函数名：oled_widget_copy_text
+ *
+ * 函数说明：比较并拷贝文本，内容相同时不改动。
+ * 参数：
+ *   dst  - 控件缓存的文本。
+ *   size - 缓冲大小。
+ *   src  - 新文本，NULL 视为空串。
+ * 返回值：
+ *   true 表示内容发生变化。
+ */
+static bool oled_widget_copy_text(char *dst, size_t size, const char *src)
+{
+    if (!src) src = "";
+    const char *end = memchr(src, '\0', size - 1);
+    size_t n = end ? (size_t)(end - src) : size - 1;
+    if (strncmp(dst, src, n) == 0 && dst[n] == '\0') return false;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+    return true;
+}
+
+/* 函数名：oled_widget_base_init
+ *
+ * 函数说明：初始化控件公共字段，新控件首次渲染时必然绘制。
+ * 参数：
+ *   widget - 控件。
+ *   type   - 控件类型。
+ *   x, y, w, h - 包围盒。
+ * 返回值：
+ *   无。
+ */
+static void oled_widget_base_init(oled_widget_t *widget, oled_widget_type_t type,
+                                  uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    memset(widget, 0, sizeof(*widget));
+    widget->type = type;
+    widget->x = x;
+    widget->y = y;
+    widget->w = w;
+    widget->h = h;
+    widget->dirty = true;
+}
+
+/* 函数名：oled_ui_init
+ *
+ * 函数说明：初始化控件树根节点。
+ * 参数：
+ *   ui  - 根节点。
+ *   dev - 绘制目标设备。
+ * 返回值：
+ *   无。
+ */
+void oled_ui_init(oled_ui_t *ui, ssd1306_t *dev)
+{
+    ui->dev = dev;
+    ui->head = NULL;
+    ui->tail = NULL;
+}
+
+/* 函数名：oled_ui_add
+ *
+ * 函数说明：把控件挂到根节点末尾（控件内存由调用方持有）。
+ * 参数：
+ *   ui     - 根节点。
+ *   widget - 已初始化的控件。
+ * 返回值：
+ *   无。
+ */
+void oled_ui_add(oled_ui_t *ui, oled_widget_t *widget)
+{
+    widget->next = NULL;
+    if (ui->tail) {
+        ui->tail->next = widget;
+    } else {
+        ui->head = widget;
+    }
+    ui->tail = widget;
+}
+
+/* 函数名：oled_ui_invalidate
+ *
+ * 函数说明：标记全部控件需要重绘（帧缓冲被其他画面覆盖后调用）。
+ * 参数：
+ *   ui - 根节点。
+ * 返回值：
+ *   无。
+ */
+void oled_ui_invalidate(oled_ui_t *ui)
+{
+    for (oled_widget_t *w = ui->head; w; w = w->next) {
+        w->dirty = true;
+    }
+}
+
+/* 函数名：oled_widget_draw
+ *
+ * 函数说明：清除控件包围盒并按类型重新绘制。
+ * 参数：
+ *   dev    - 设备句柄。
+ *   widget - 控件。
+ * 返回值：
+ *   无。
+ */
+static void oled_widget_draw(ssd1306_t *dev, const oled_widget_t *widget)
+{
+    uint16_t x = widget->x, y = widget->y, w = widget->w, h = widget->h;
+
+    switch (widget->type) {
+        case OLED_WIDGET_LABEL:
+            ssd1306_fill_rect(dev, x, y, w, h, 0);
+            ssd1306_text(dev, widget->u.label.text, x, y, 1, 1);  /* truncate mode */
+            break;
+
+        case OLED_WIDGET_STATUS_BAR: {
+            /* Inverted bar: left text flush left, right text flush right */
+            ssd1306_fill_rect(dev, x, y, w, h, 1);
+            ssd1306_text(dev, widget->u.status.left, (uint16_t)(x + 1), (uint16_t)(y + 1), 0, 1);
+            size_t len = strlen(widget->u.status.right);
+            uint16_t right_w = (uint16_t)(len * FONT_TOTAL_WIDTH);
+            if (len > 0 && right_w < w) {
+                ssd1306_text(dev, widget->u.status.right, (uint16_t)(x + w - right_w), (uint16_t)(y + 1), 0, 1);
+            }
+            break;
+        }
+
+        case OLED_WIDGET_PROGRESS:
+            ssd1306_fill_rect(dev, x, y, w, h, 0);
+            ssd1306_rect(dev, x, y, w, h, 1);
+            if (widget->u.progress.fill_px > 0) {
+                ssd1306_fill_rect(dev, (uint16_t)(x + 2), (uint16_t)(y + 2), widget->u.progress.fill_px,
+                                  (uint16_t)(h - 4), 1);
+            }
+            break;
+
+        case OLED_WIDGET_ICON: {
+            const ssd1306_image_t *img = widget->u.icon.image;
+            /* An image covering the whole box overwrites it; only a smaller one needs a clear */
+            if (!img || img->w < w || img->h < h) {
+                ssd1306_fill_rect(dev, x, y, w, h, 0);
+            }
+            if (img) {
+                ssd1306_image(dev, img, x, y, SSD1306_BLIT_OPAQUE);
+            }
+            break;
+        }
+    }
+}
+
+/* 函数名：oled_ui_render
+ *
+ * 函数说明：只重绘内容发生变化的控件，未变化的控件不触碰帧缓冲与脏区。
+ * 参数：
+ *   ui - 根节点。
+ * 返回值：
+ *   本次重绘的控件数量。
+ */
+uint16_t oled_ui_render(oled_ui_t *ui)
+{
+    uint16_t drawn = 0;
+    for (oled_widget_t *w = ui->head; w; w = w->next) {
+        if (!w->dirty) continue;
+        oled_widget_draw(ui->dev, w);
+        w->dirty = false;
+        drawn++;
+    }
+    return drawn;
+}
+
+/* 函数名：oled_label_init
+ *
+ * 函数说明：初始化单行文本标签（高度为一行字体）。
+ * 参数：
+ *   widget - 控件。
+ *   x, y   - 左上坐标。
+ *   w      - 宽度。
+ * 返回值：
+ *   无。
+ */
+void oled_label_init(oled_widget_t *widget, uint16_t x, uint16_t y, uint16_t w)
+{
+    oled_widget_base_init(widget, OLED_WIDGET_LABEL, x, y, w, FONT_CHAR_HEIGHT);
+}
+
+/* 函数名：oled_status_bar_init
+ *
+ * 函数说明：初始化反色状态栏（左右两段文本）。
+ * 参数：
+ *   widget - 控件。
+ *   y      - 顶部坐标。
+ *   w      - 宽度。
+ * 返回值：
+ *   无。
+ */
+void oled_status_bar_init(oled_widget_t *widget, uint16_t y, uint16_t w)
+{
+    oled_widget_base_init(widget, OLED_WIDGET_STATUS_BAR, 0, y, w, FONT_CHAR_HEIGHT + 2);
+}
+
+/* 函数名：oled_progress_init
+ *
+ * 函数说明：初始化带边框的进度条。
+ * 参数：
+ *   widget - 控件。
+ *   x, y, w, h - 包围盒（h 至少 5）。
+ *   max    - 满量程数值。
+ * 返回值：
+ *   无。
+ */
+void oled_progress_init(oled_widget_t *widget, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t max)
+{
+    oled_widget_base_init(widget, OLED_WIDGET_PROGRESS, x, y, w, h < 5 ? 5 : h);
+    widget->u.progress.max = max ? max : 1;
+}
+
+/* 函数名：oled_icon_init
+ *
+ * 函数说明：初始化图标控件。
+ * 参数：
+ *   widget - 控件。
+ *   x, y, w, h - 包围盒，通常与图像尺寸一致。
+ * 返回值：
+ *   无。
+ */
+void oled_icon_init(oled_widget_t *widget, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    oled_widget_base_init(widget, OLED_WIDGET_ICON, x, y, w, h);
+}
+
+/* 函数名：oled_label_set
+ *
+ * 函数说明：更新标签文本，内容未变时不标记重绘。
+ * 参数：
+ *   widget - 标签控件。
+ *   text   - 新文本。
+ * 返回值：
+ *   true 表示需要重绘。
+ */
+bool oled_label_set(oled_widget_t *widget, const char *text)
+{
+    if (oled_widget_copy_text(widget->u.label.text, sizeof(widget->u.label.text), text)) {
+        widget->dirty = true;
+    }
+    return widget->dirty;
+}
+
+/* 函数名：oled_status_bar_set
+ *
+ * 函数说明：更新状态栏左右文本，内容未变时不标记重绘。
+ * 参数：
+ *   widget - 状态栏控件。
+ *   left, right - 左/右文本。
+ * 返回值：
+ *   true 表示需要重绘。
+ */
+bool oled_status_bar_set(oled_widget_t *widget, const char *left, const char *right)
+{
+    bool changed = oled_widget_copy_text(widget->u.status.left, sizeof(widget->u.status.left), left);
+    changed |= oled_widget_copy_text(widget->u.status.right, sizeof(widget->u.status.right), right);
+    if (changed) widget->dirty = true;
+    return widget->dirty;
+}
+
+/* 函数名：oled_progress_set
+ *
+ * 函数说明：更新进度值。比较的是填充像素宽度，数值变化但像素不变时不重绘。
+ * 参数：
+ *   widget - 进度条控件。
+ *   value  - 新数值（超过满量程按满量程处理）。
+ * 返回值：
+ *   true 表示需要重绘。
+ */
+bool oled_progress_set(oled_widget_t *widget, uint16_t value)
+{
+    if (value > widget->u.progress.max) value = widget->u.progress.max;
+    widget->u.progress.value = value;
+
+    uint16_t inner = (uint16_t)(widget->w - 4);
+    uint16_t fill_px = (uint16_t)(((uint32_t)inner * value) / widget->u.progress.max);
+    if (fill_px != widget->u.progress.fill_px) {
+        widget->u.progress.fill_px = fill_px;
+        widget->dirty = true;
+    }
+    return widget->dirty;
+}
+
+/* 函数名：oled_icon_set
+ *
+ * 函数说明：更换图标图像，指针相同时不重绘。
+ * 参数：
+ *   widget - 图标控件。
+ *   image  - 图像（常量，需在控件生命周期内有效）。
+ * 返回值：
+ *   true 表示需要重绘。
+ */
+bool oled_icon_set(oled_widget_t *widget, const ssd1306_image_t *image)
+{
+    if (widget->u.icon.image != image) {
+        widget->u.icon.image = image;
+        widget->dirty = true;
+    }
+    return widget->dirty;
+}
@@ -0,0 +1,78 @@
+/*
+ * 保留模式 OLED 控件层
+ *
+ * 控件（标签、状态栏、进度条、图标）记住上次绘制的内容与包围盒，
+ * 只有内容变化的控件才会重新光栅化并标记脏区，配合 ssd1306_show()
+ * 的差分刷新，更新一个数值只会在总线上发送该控件的字节。
+ */
+#ifndef OLED_WIDGET_H
+#define OLED_WIDGET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define OLED_WIDGET_TEXT_MAX  32
+
+typedef enum {
+    OLED_WIDGET_LABEL,
+    OLED_WIDGET_STATUS_BAR,
+    OLED_WIDGET_PROGRESS,
+    OLED_WIDGET_ICON,
+} oled_widget_type_t;
+
+typedef struct oled_widget {
+    oled_widget_type_t type;
+    uint16_t x, y, w, h;              /* bounding box, cleared before each redraw */
+    bool dirty;                       /* content changed since the last render */
+    union {
+        struct {
+            char text[OLED_WIDGET_TEXT_MAX];
+        } label;
+        struct {
+            char left[OLED_WIDGET_TEXT_MAX];
+            char right[OLED_WIDGET_TEXT_MAX];
+        } status;
+        struct {
+            uint16_t value;
+            uint16_t max;
+            uint16_t fill_px;         /* drawn fill width; value changes within a pixel are free */
+        } progress;
+        struct {
+            const ssd1306_image_t *image; /* raw or PackBits, drawn opaque at the box origin */
+        } icon;
+    } u;
+    struct oled_widget *next;
+} oled_widget_t;
+
+/* Root of the widget tree: children are drawn in insertion order */
+typedef struct {
+    ssd1306_t *dev;
+    oled_widget_t *head;
+    oled_widget_t *tail;
+} oled_ui_t;
+
+void oled_ui_init(oled_ui_t *ui, ssd1306_t *dev);
+void oled_ui_add(oled_ui_t *ui, oled_widget_t *widget);
+void oled_ui_invalidate(oled_ui_t *ui);
+uint16_t oled_ui_render(oled_ui_t *ui);
+
+void oled_label_init(oled_widget_t *widget, uint16_t x, uint16_t y, uint16_t w);
+void oled_status_bar_init(oled_widget_t *widget, uint16_t y, uint16_t w);
+void oled_progress_init(oled_widget_t *widget, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t max);
+void oled_icon_init(oled_widget_t *widget, uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+
+bool oled_label_set(oled_widget_t *widget, const char *text);
+bool oled_status_bar_set(oled_widget_t *widget, const char *left, const char *right);
+bool oled_progress_set(oled_widget_t *widget, uint16_t value);
+bool oled_icon_set(oled_widget_t *widget, const ssd1306_image_t *image);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OLED_WIDGET_H */
@@ -2,9 +2,36 @@
 #include <string.h>
 #include <stdlib.h>
 #include <esp_log.h>
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "esp_rom_sys.h"
+#include "driver/gpio.h"
 
 static const char *TAG __attribute__((unused)) = "ssd1306";
 
+/* Geometry used by the drawing and flush paths. With a fixed panel these are constants, so
+ * row strides, clipping and page loops compile to immediates; ssd1306_init() guarantees the
+ * struct fields agree. */
+#ifdef SSD1306_FIXED_WIDTH
+#define PANEL_W(dev)        ((uint16_t)SSD1306_FIXED_WIDTH)
+#define PANEL_H(dev)        ((uint16_t)SSD1306_FIXED_HEIGHT)
+#define PANEL_PAGES(dev)    ((uint8_t)(SSD1306_FIXED_HEIGHT / 8))
+#else
+#define PANEL_W(dev)        ((dev)->width)
+#define PANEL_H(dev)        ((dev)->height)
+#define PANEL_PAGES(dev)    ((dev)->pages)
+#endif
+
+/* Window setup bytes per flushed region: SSD1306 sets a column + page window once per run,
+ * SH1106 has no window commands and sets page + column (with offset) for every page */
+#if SSD1306_PANEL_SH1106
+#define PANEL_WINDOW_CMDS   3
+#define PANEL_PAIRS(pages)  ((size_t)(pages))
+#else
+#define PANEL_WINDOW_CMDS   6
+#define PANEL_PAIRS(pages)  ((size_t)1)
+#endif
+
 /* 5x8 Monospace Font (ASCII 0x20-0x7F) */
 static const uint8_t font_5x8[96][5] = {
     {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5f, 0x00, 0x00}, {0x00, 0x07, 0x00, 0x07, 0x00}, {0x14, 0x7f, 0x14, 0x7f, 0x14}, {0x24, 0x2a, 0x7f, 0x2a, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62}, {0x36, 0x49, 0x55, 0x22, 0x50}, {0x00, 0x05, 0x03, 0x00, 0x00},
@@ -21,69 +48,371 @@ static const uint8_t font_5x8[96][5] = {
     {0x44, 0x28, 0x10, 0x28, 0x44}, {0x0c, 0x50, 0x50, 0x50, 0x3c}, {0x44, 0x64, 0x54, 0x4c, 0x44}, {0x08, 0x36, 0x41, 0x41, 0x00}, {0x00, 0x00, 0x7f, 0x00, 0x00}, {0x00, 0x41, 0x41, 0x36, 0x08}, {0x08, 0x04, 0x08, 0x10, 0x08},
 };
 
+/* One piece of a bus write; framebuffer rows are sent in place, without copying */
+typedef struct {
+    const uint8_t *buf;
+    size_t len;
+} ssd1306_seg_t;
+
+/* Per-transaction state read by the SPI callbacks: D/C level, and the flush callback on the
+ * last transaction of a flush. Short command strings are copied here so the caller's stack
+ * buffer may go away while the transaction is queued. */
+typedef struct {
+    struct ssd1306_spi_bus *bus;
+    ssd1306_t *dev;
+    uint8_t dc;
+    ssd1306_flush_cb_t cb;
+    void *arg;
+    uint8_t cmd[SSD1306_SPI_CMD_MAX];
+} ssd1306_spi_slot_t;
+
+/* SPI device and its ring of transactions; the driver completes them in queue order, so the
+ * oldest in-flight slot is always the one at next */
+struct ssd1306_spi_bus {
+    spi_device_handle_t spi;
+    int dc_gpio;
+    uint8_t next;
+    uint8_t in_flight;              /* queued, result not fetched yet */
+    spi_transaction_t trans[SSD1306_SPI_QUEUE];
+    ssd1306_spi_slot_t slot[SSD1306_SPI_QUEUE];
+};
+
+/* 函数名：ssd1306_spi_pre_cb
+ *
+ * 函数说明：SPI 传输开始前（中断上下文）按事务类型设置 D/C 引脚：0 命令，1 数据。
+ * 参数：
+ *   t - SPI 事务。
+ * 返回值：
+ *   无。
+ */
+static void IRAM_ATTR ssd1306_spi_pre_cb(spi_transaction_t *t)
+{
+    const ssd1306_spi_slot_t *slot = (const ssd1306_spi_slot_t *)t->user;
+    gpio_set_level(slot->bus->dc_gpio, slot->dc);
+}
+
+/* 函数名：ssd1306_spi_post_cb
+ *
+ * 函数说明：SPI 传输完成后（中断上下文）调用刷新完成回调（仅一次刷新的最后一个事务带回调）。
+ * 参数：
+ *   t - SPI 事务。
+ * 返回值：
+ *   无。
+ */
+static void IRAM_ATTR ssd1306_spi_post_cb(spi_transaction_t *t)
+{
+    const ssd1306_spi_slot_t *slot = (const ssd1306_spi_slot_t *)t->user;
+    if (slot->cb) {
+        slot->cb(slot->dev, slot->arg);
+    }
+}
+
+/* 函数名：ssd1306_spi_reap
+ *
+ * 函数说明：取回最早一个已排队事务的结果（必要时等待其 DMA 完成），释放其槽位。
+ * 参数：
+ *   bus - SPI 传输状态。
+ * 返回值：
+ *   ESP_OK 成功，其他为 SPI 驱动错误码。
+ */
+static esp_err_t ssd1306_spi_reap(struct ssd1306_spi_bus *bus)
+{
+    spi_transaction_t *done;
+    esp_err_t ret = spi_device_get_trans_result(bus->spi, &done, portMAX_DELAY);
+    if (ret == ESP_OK) {
+        bus->in_flight--;
+    }
+    return ret;
+}
+
+/* 函数名：ssd1306_spi_send
+ *
+ * 函数说明：为每个分段排队一个 SPI DMA 事务后立即返回。命令分段拷贝到槽位中，数据分段
+ *           直接引用帧缓冲；槽位用尽时先取回最早的事务。cb 挂在最后一个事务上，在其
+ *           传输完成时由中断调用。
+ * 参数：
+ *   dev   - 设备句柄。
+ *   data  - true 为显示数据，false 为命令。
+ *   segs  - 分段数组（命令分段不超过 SSD1306_SPI_CMD_MAX 字节）。
+ *   nsegs - 分段数。
+ *   cb, arg - 完成回调，可为 NULL。
+ * 返回值：
+ *   ESP_OK 已排队，其他为 SPI 驱动错误码。
+ */
+static esp_err_t ssd1306_spi_send(ssd1306_t *dev, bool data, const ssd1306_seg_t *segs, size_t nsegs,
+                                  ssd1306_flush_cb_t cb, void *arg)
+{
+    struct ssd1306_spi_bus *bus = dev->spi;
+
+    for (size_t i = 0; i < nsegs; i++) {
+        if (bus->in_flight == SSD1306_SPI_QUEUE) {
+            esp_err_t ret = ssd1306_spi_reap(bus);
+            if (ret != ESP_OK) return ret;
+        }
+
+        spi_transaction_t *t = &bus->trans[bus->next];
+        ssd1306_spi_slot_t *slot = &bus->slot[bus->next];
+        slot->bus = bus;
+        slot->dev = dev;
+        slot->dc = data ? 1 : 0;
+        slot->cb = (i == nsegs - 1) ? cb : NULL;
+        slot->arg = arg;
+
+        memset(t, 0, sizeof(*t));
+        if (data) {
+            t->tx_buffer = segs[i].buf;
+        } else {
+            memcpy(slot->cmd, segs[i].buf, segs[i].len);
+            t->tx_buffer = slot->cmd;
+        }
+        t->length = segs[i].len * 8;
+        t->user = slot;
+
+        esp_err_t ret = spi_device_queue_trans(bus->spi, t, portMAX_DELAY);
+        if (ret != ESP_OK) return ret;
+        bus->next = (uint8_t)((bus->next + 1) % SSD1306_SPI_QUEUE);
+        bus->in_flight++;
+        dev->bus_stats.transactions++;
+        dev->bus_stats.bytes += segs[i].len;
+    }
+    return ESP_OK;
+}
+
+/* 函数名：ssd1306_i2c_send
+ *
+ * 函数说明：发送一次 I2C 写事务，控制字节与各分段作为多个缓冲段发送，避免拼包拷贝；
+ *           I2C 传输是同步的，返回前调用完成回调。
+ * 参数：
+ *   dev   - 设备句柄。
+ *   data  - true 为显示数据（控制字节 0x40），false 为命令流（0x00）。
+ *   segs  - 分段数组（不超过 SSD1306_MAX_PAGES 段）。
+ *   nsegs - 分段数。
+ *   cb, arg - 完成回调，可为 NULL。
+ * 返回值：
+ *   ESP_OK 表示发送成功，其他为 I2C 相关错误码。
+ */
+static esp_err_t ssd1306_i2c_send(ssd1306_t *dev, bool data, const ssd1306_seg_t *segs, size_t nsegs,
+                                  ssd1306_flush_cb_t cb, void *arg)
+{
+    i2c_master_transmit_multi_buffer_info_t bufs[1 + SSD1306_MAX_PAGES];
+    uint8_t control = data ? I2C_DATA_BYTE : I2C_CMD_STREAM;
+    size_t total = 1;
+
+    bufs[0].write_buffer = &control;
+    bufs[0].buffer_size = 1;
+    for (size_t i = 0; i < nsegs; i++) {
+        bufs[1 + i].write_buffer = (uint8_t *)segs[i].buf;
+        bufs[1 + i].buffer_size = segs[i].len;
+        total += segs[i].len;
+    }
+
+    dev->bus_stats.transactions++;
+    dev->bus_stats.bytes += total;
+    esp_err_t ret = i2c_master_multi_buffer_transmit(dev->i2c_dev, bufs, 1 + nsegs, data ? 200 : 100);
+    if (ret == ESP_OK && cb) {
+        cb(dev, arg);
+    }
+    return ret;
+}
+
+/* 函数名：ssd1306_bus_send
+ *
+ * 函数说明：按设备所用总线把分段交给对应的传输实现（I2C 同步，SPI 排队 DMA）。
+ * 参数：
+ *   dev   - 设备句柄。
+ *   data  - true 为显示数据，false 为命令。
+ *   segs  - 分段数组。
+ *   nsegs - 分段数。
+ *   cb, arg - 完成回调，可为 NULL。
+ * 返回值：
+ *   ESP_OK 表示成功（SPI 为已排队），其他为总线错误码。
+ */
+static esp_err_t ssd1306_bus_send(ssd1306_t *dev, bool data, const ssd1306_seg_t *segs, size_t nsegs,
+                                  ssd1306_flush_cb_t cb, void *arg)
+{
+    if (dev->bus == SSD1306_BUS_SPI) {
+        return ssd1306_spi_send(dev, data, segs, nsegs, cb, arg);
+    }
+    return ssd1306_i2c_send(dev, data, segs, nsegs, cb, arg);
+}
+
+/* 函数名：ssd1306_write_cmds
+ *
+ * 函数说明：发送命令流。I2C 为单个事务（控制字节 0x00 后跟全部命令字节）；SPI 按
+ *           SSD1306_SPI_CMD_MAX 字节分成若干排队事务（命令参数可跨事务，控制器按字节解析）。
+ * 参数：
+ *   dev  - 设备句柄。
+ *   cmds - 命令字节数组。
+ *   len  - 命令字节数。
+ * 返回值：
+ *   ESP_OK 表示发送成功，其他为总线错误码。
+ */
+static esp_err_t ssd1306_write_cmds(ssd1306_t *dev, const uint8_t *cmds, size_t len)
+{
+    if (dev->bus == SSD1306_BUS_I2C) {
+        ssd1306_seg_t seg = { cmds, len };
+        return ssd1306_i2c_send(dev, false, &seg, 1, NULL, NULL);
+    }
+
+    ssd1306_seg_t segs[4];
+    size_t nsegs = 0;
+    while (len > 0) {
+        size_t n = len < SSD1306_SPI_CMD_MAX ? len : SSD1306_SPI_CMD_MAX;
+        segs[nsegs++] = (ssd1306_seg_t){ cmds, n };
+        cmds += n;
+        len -= n;
+        if (nsegs == sizeof(segs) / sizeof(segs[0]) || len == 0) {
+            esp_err_t ret = ssd1306_spi_send(dev, false, segs, nsegs, NULL, NULL);
+            if (ret != ESP_OK) return ret;
+            nsegs = 0;
+        }
+    }
+    return ESP_OK;
+}
+
 /* 函数名：ssd1306_write_cmd
  *
- * 函数说明：向 SSD1306 发送单条命令（I2C 控制字节 0x00）。
+ * 函数说明：向控制器发送单条命令。
  * 参数：
- *   dev - 设备句柄，包含 I2C 设备信息。
+ *   dev - 设备句柄。
  *   cmd - 要发送的命令字节。
  * 返回值：
- *   ESP_OK 表示发送成功，其他为 I2C 相关错误码。
+ *   ESP_OK 表示发送成功，其他为总线错误码。
  */
 static esp_err_t ssd1306_write_cmd(ssd1306_t *dev, uint8_t cmd)
 {
-    uint8_t data[2] = {I2C_CMD_BYTE, cmd};
-    return i2c_master_transmit(dev->i2c_dev, data, 2, 100);
+    return ssd1306_write_cmds(dev, &cmd, 1);
 }
 
-/* 函数名：ssd1306_write_data
+/* 函数名：ssd1306_write_pages
  *
- * 函数说明：向 SSD1306 发送数据流，自动按块分段并添加数据前缀 0x40。
+ * 函数说明：以一次数据写入发送若干页中同一列区间的数据，每页直接引用帧缓冲中的
+ *           对应行，无需中间拷贝（整行宽度时各页在帧缓冲中连续，合为一段）。
+ * 参数：
+ *   dev        - 设备句柄。
+ *   first_page - 起始页。
+ *   last_page  - 结束页（含）。
+ *   start_col  - 起始列。
+ *   len        - 每页发送的列数。
+ *   cb, arg    - 完成回调，可为 NULL。
+ * 返回值：
+ *   ESP_OK 表示成功，其他为总线错误码。
+ */
+static esp_err_t ssd1306_write_pages(ssd1306_t *dev, uint8_t first_page, uint8_t last_page,
+                                     uint8_t start_col, size_t len, ssd1306_flush_cb_t cb, void *arg)
+{
+    ssd1306_seg_t segs[SSD1306_MAX_PAGES];
+    size_t nsegs = 0;
+
+    if (start_col == 0 && len == PANEL_W(dev)) {
+        /* Full-width rows are contiguous in the framebuffer */
+        segs[nsegs].buf = dev->buffer + (size_t)first_page * PANEL_W(dev);
+        segs[nsegs].len = (size_t)(last_page - first_page + 1) * PANEL_W(dev);
+        nsegs++;
+    } else {
+        for (uint8_t page = first_page; page <= last_page; ++page) {
+            segs[nsegs].buf = dev->buffer + (size_t)page * PANEL_W(dev) + start_col;
+            segs[nsegs].len = len;
+            nsegs++;
+        }
+    }
+    return ssd1306_bus_send(dev, true, segs, nsegs, cb, arg);
+}
+
+#if SSD1306_PANEL_SH1106
+/* 函数名：ssd1306_write_region
+ *
+ * 函数说明：把页 p0..p1、列 c0..c1 的帧缓冲内容写入 SH1106。SH1106 只支持页寻址：
+ *           每页一个命令事务设置页号与列地址（加上列偏移），再跟一个数据事务。
  * 参数：
  *   dev - 设备句柄。
- *   buf - 数据缓冲区指针。
- *   len - 数据长度。
+ *   r   - 待写入的区域。
+ *   cb, arg - 完成回调（挂在最后一页的数据上），可为 NULL。
  * 返回值：
- *   ESP_OK 表示发送成功，其他为 I2C 相关错误码。
+ *   ESP_OK 表示成功，其他为总线错误码。
  */
-static esp_err_t ssd1306_write_data(ssd1306_t *dev, uint8_t *buf, size_t len)
-{
-    /* Send data in safe chunks, each transaction prefixed with one data-control byte (0x40) */
-    const size_t CHUNK = 32;  /* tune: 16~64 typically fine for I2C controller */
-    size_t sent = 0;
-    while (sent < len) {
-        size_t n = len - sent;
-        if (n > CHUNK) n = CHUNK;
-        uint8_t txbuf[1 + CHUNK];
-        txbuf[0] = I2C_DATA_BYTE; /* 0x40: Co=0, D/C#=1 (data stream) */
-        memcpy(&txbuf[1], buf + sent, n);
-        esp_err_t ret = i2c_master_transmit(dev->i2c_dev, txbuf, (size_t)(1 + n), 200);
+static esp_err_t ssd1306_write_region(ssd1306_t *dev, const ssd1306_run_t *r, ssd1306_flush_cb_t cb, void *arg)
+{
+    uint8_t col = (uint8_t)(r->c0 + SSD1306_PANEL_COL_OFFSET);
+    size_t len = (size_t)(r->c1 - r->c0 + 1);
+
+    for (uint8_t page = r->p0; page <= r->p1; ++page) {
+        const uint8_t cmds[] = {
+            (uint8_t)(SET_PAGE_START | page),
+            (uint8_t)(SET_LOW_COLUMN | (col & 0x0F)),
+            (uint8_t)(SET_HIGH_COLUMN | (col >> 4)),
+        };
+        esp_err_t ret = ssd1306_write_cmds(dev, cmds, sizeof(cmds));
+        if (ret != ESP_OK) return ret;
+        ret = ssd1306_write_pages(dev, page, page, r->c0, len, page == r->p1 ? cb : NULL, arg);
         if (ret != ESP_OK) return ret;
-        sent += n;
     }
     return ESP_OK;
 }
+#else
+/* 函数名：ssd1306_write_region
+ *
+ * 函数说明：用一个命令事务设置水平寻址模式下的列/页窗口，再以一个数据事务写入
+ *           页 p0..p1、列 c0..c1 的帧缓冲内容。
+ * 参数：
+ *   dev - 设备句柄。
+ *   r   - 待写入的区域。
+ *   cb, arg - 完成回调，可为 NULL。
+ * 返回值：
+ *   ESP_OK 表示成功，其他为总线错误码。
+ */
+static esp_err_t ssd1306_write_region(ssd1306_t *dev, const ssd1306_run_t *r, ssd1306_flush_cb_t cb, void *arg)
+{
+    const uint8_t cmds[] = {
+        SET_COL_ADDR, r->c0, r->c1,
+        SET_PAGE_ADDR, r->p0, r->p1,
+    };
+    esp_err_t ret = ssd1306_write_cmds(dev, cmds, sizeof(cmds));
+    if (ret != ESP_OK) return ret;
+    return ssd1306_write_pages(dev, r->p0, r->p1, r->c0, (size_t)(r->c1 - r->c0 + 1), cb, arg);
+}
+#endif
 
 /* 函数名：ssd1306_init_display
  *
- * 函数说明：向 SSD1306 下发初始化指令序列，并清屏显示。
+ * 函数说明：向控制器下发初始化指令序列，并清屏显示。SH1106 没有寻址模式与电荷泵命令，
+ *           改用 DC-DC 控制（0xAD），复位后即为页寻址。
  * 参数：
  *   dev - 设备句柄。
  * 返回值：
- *   ESP_OK 表示初始化成功，其他为 I2C/设备错误码。
+ *   ESP_OK 表示初始化成功，其他为总线/设备错误码。
  */
 static esp_err_t ssd1306_init_display(ssd1306_t *dev)
 {
     esp_err_t ret;
+#if SSD1306_PANEL_SH1106
+    uint8_t init_cmds[] = {
+        SET_DISP | 0x00,
+        SET_DISP_START_LINE | 0x00,
+        SET_SEG_REMAP | 0x01,
+        SET_MUX_RATIO, PANEL_H(dev) - 1,
+        SET_COM_OUT_DIR | 0x08,
+        SET_DISP_OFFSET, 0x00,
+        SET_COM_PIN_CFG, 0x12,
+        SET_DISP_CLK_DIV, 0x80,
+        SET_PRECHARGE, dev->external_vcc ? 0x22 : 0x1f,
+        SET_VCOM_DESEL, 0x35,
+        SET_CONTRAST, 0xff,
+        SET_ENTIRE_ON,
+        SET_NORM_INV,
+        SET_DCDC, dev->external_vcc ? 0x8a : 0x8b,
+        SET_DISP | 0x01,
+    };
+#else
     uint8_t init_cmds[] = {
         SET_DISP | 0x00,
         SET_MEM_ADDR, 0x00,
         SET_DISP_START_LINE | 0x00,
         SET_SEG_REMAP | 0x01,
-        SET_MUX_RATIO, dev->height - 1,
+        SET_MUX_RATIO, PANEL_H(dev) - 1,
         SET_COM_OUT_DIR | 0x08,
         SET_DISP_OFFSET, 0x00,
-        SET_COM_PIN_CFG, dev->height == 32 ? 0x02 : 0x12,
+        SET_COM_PIN_CFG, PANEL_H(dev) == 32 ? 0x02 : 0x12,
         SET_DISP_CLK_DIV, 0x80,
         SET_PRECHARGE, dev->external_vcc ? 0x22 : 0xf1,
         SET_VCOM_DESEL, 0x30,
@@ -93,11 +422,10 @@ static esp_err_t ssd1306_init_display(ssd1306_t *dev)
         SET_CHARGE_PUMP, dev->external_vcc ? 0x10 : 0x14,
         SET_DISP | 0x01,
     };
+#endif
     
-    for (size_t i = 0; i < sizeof(init_cmds); i++) {
-        ret = ssd1306_write_cmd(dev, init_cmds[i]);
-        if (ret != ESP_OK) return ret;
-    }
+    ret = ssd1306_write_cmds(dev, init_cmds, sizeof(init_cmds));
+    if (ret != ESP_OK) return ret;
     
     ssd1306_fill(dev, 0);
     return ssd1306_show(dev);
@@ -114,13 +442,33 @@ static esp_err_t ssd1306_init_display(ssd1306_t *dev)
 static inline void ssd1306_reset_dirty(ssd1306_t *dev)
 {
     dev->dirty_flags = 0;
-    for (uint8_t p = 0; p < dev->pages && p < 8; ++p) {
+    for (uint8_t p = 0; p < PANEL_PAGES(dev); ++p) {
         dev->page_dirty[p] = 0;
         dev->dirty_col_start[p] = 0xFF;
         dev->dirty_col_end[p] = 0;
     }
 }
 
+/* 函数名：ssd1306_mark_dirty_span
+ *
+ * 函数说明：将指定页的列区间 [x0, x1] 合并进脏区记录，每页只更新一次。
+ * 参数：
+ *   dev  - 设备句柄。
+ *   page - 页号。
+ *   x0   - 起始列（含）。
+ *   x1   - 结束列（含），调用方保证 x0 <= x1 < width。
+ * 返回值：
+ *   无。
+ */
+static inline void ssd1306_mark_dirty_span(ssd1306_t *dev, uint8_t page, uint16_t x0, uint16_t x1)
+{
+    if (page >= PANEL_PAGES(dev)) return;
+    dev->dirty_flags |= 0x01;
+    dev->page_dirty[page] = 1;
+    if (dev->dirty_col_start[page] == 0xFF || x0 < dev->dirty_col_start[page]) dev->dirty_col_start[page] = (uint8_t)x0;
+    if (x1 > dev->dirty_col_end[page]) dev->dirty_col_end[page] = (uint8_t)x1;
+}
+
 /* 函数名：ssd1306_mark_dirty
  *
  * 函数说明：标记指定像素所在页与列区间为脏，用于增量刷新。
@@ -133,18 +481,128 @@ static inline void ssd1306_reset_dirty(ssd1306_t *dev)
  */
 static inline void ssd1306_mark_dirty(ssd1306_t *dev, uint16_t x, uint16_t y)
 {
-    if (x >= dev->width || y >= dev->height) return;
-    uint8_t page = y / 8;
-    if (page >= 8) return;
-    dev->dirty_flags |= 0x01;
-    dev->page_dirty[page] = 1;
-    if (dev->dirty_col_start[page] == 0xFF || x < dev->dirty_col_start[page]) dev->dirty_col_start[page] = (uint8_t)x;
-    if (x > dev->dirty_col_end[page]) dev->dirty_col_end[page] = (uint8_t)x;
+    if (x >= PANEL_W(dev) || y >= PANEL_H(dev)) return;
+    ssd1306_mark_dirty_span(dev, (uint8_t)(y / 8), x, x);
+}
+
+/* 函数名：ssd1306_fill_span
+ *
+ * 函数说明：按页字节填充矩形区域。先裁剪到屏幕范围，再为每页计算一次垂直掩码，
+ *           对列区间整体做 OR（置 1）或 AND（清 0），整页覆盖时直接 memset，
+ *           每页只更新一次脏区。
+ * 参数：
+ *   dev - 设备句柄。
+ *   x, y - 左上坐标。
+ *   width, height - 区域尺寸。
+ *   color - 非 0 置 1，0 置 0。
+ * 返回值：
+ *   无。
+ */
+static void ssd1306_fill_span(ssd1306_t *dev, uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint8_t color)
+{
+    if (width == 0 || height == 0 || x >= PANEL_W(dev) || y >= PANEL_H(dev)) return;
+
+    uint32_t x_end = (uint32_t)x + width;    /* exclusive */
+    uint32_t y_end = (uint32_t)y + height;   /* exclusive */
+    if (x_end > PANEL_W(dev)) x_end = PANEL_W(dev);
+    if (y_end > PANEL_H(dev)) y_end = PANEL_H(dev);
+
+    size_t span = (size_t)(x_end - x);
+    uint8_t first_page = (uint8_t)(y / 8);
+    uint8_t last_page = (uint8_t)((y_end - 1) / 8);
+
+    for (uint8_t page = first_page; page <= last_page; ++page) {
+        uint8_t mask = 0xFF;
+        if (page == first_page) mask &= (uint8_t)(0xFF << (y & 7));
+        if (page == last_page) mask &= (uint8_t)(0xFF >> (7 - ((y_end - 1) & 7)));
+
+        uint8_t *row = dev->buffer + (size_t)page * PANEL_W(dev) + x;
+        if (mask == 0xFF) {
+            memset(row, color ? 0xFF : 0x00, span);
+        } else if (color) {
+            for (size_t i = 0; i < span; i++) row[i] |= mask;
+        } else {
+            uint8_t keep = (uint8_t)~mask;
+            for (size_t i = 0; i < span; i++) row[i] &= keep;
+        }
+
+        ssd1306_mark_dirty_span(dev, page, x, (uint16_t)(x_end - 1));
+    }
+}
+
+/* 函数名：ssd1306_check_geometry
+ *
+ * 函数说明：检查屏幕尺寸是否受支持：整页高度、不超过 SSD1306_MAX_PAGES 页与
+ *           SSD1306_MAX_WIDTH 列，且与编译时选定的面板一致。
+ * 参数：
+ *   width, height - 屏幕尺寸（像素）。
+ * 返回值：
+ *   ESP_OK 支持；ESP_ERR_INVALID_SIZE 不支持。
+ */
+static esp_err_t ssd1306_check_geometry(uint16_t width, uint16_t height)
+{
+#ifdef SSD1306_FIXED_WIDTH
+    if (width != SSD1306_FIXED_WIDTH || height != SSD1306_FIXED_HEIGHT) {
+        ESP_LOGE(TAG, "Panel is built for %dx%d, not %dx%d",
+                 SSD1306_FIXED_WIDTH, SSD1306_FIXED_HEIGHT, width, height);
+        return ESP_ERR_INVALID_SIZE;
+    }
+#endif
+    if (width == 0 || width > SSD1306_MAX_WIDTH || height == 0 || height % 8 != 0 ||
+        height / 8 > SSD1306_MAX_PAGES) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    return ESP_OK;
+}
+
+/* 函数名：ssd1306_setup
+ *
+ * 函数说明：总线就绪后的公共初始化：分配帧缓冲（DMA 可访问内存，SPI 可直接发送），
+ *           下发初始化序列并清屏，随后建立影子缓冲。
+ * 参数：
+ *   dev - 已设置好总线的设备句柄。
+ *   width, height - 屏幕尺寸（像素，已校验）。
+ *   external_vcc - 是否使用外部供电。
+ * 返回值：
+ *   ESP_OK 表示成功，分配或初始化失败返回对应错误码。
+ */
+static esp_err_t ssd1306_setup(ssd1306_t *dev, uint16_t width, uint16_t height, bool external_vcc)
+{
+    dev->width = width;
+    dev->height = height;
+    dev->pages = (uint8_t)(height / 8);
+    dev->external_vcc = external_vcc;
+    
+    size_t buffer_size = PANEL_PAGES(dev) * PANEL_W(dev);
+    dev->buffer = (uint8_t *)heap_caps_malloc(buffer_size, MALLOC_CAP_DMA);
+    if (!dev->buffer) {
+        ESP_LOGE(TAG, "Failed to allocate framebuffer");
+        return ESP_ERR_NO_MEM;
+    }
+    
+    memset(dev->buffer, 0, buffer_size);
+    memset(&dev->bus_stats, 0, sizeof(dev->bus_stats));
+    dev->shadow = NULL;  /* first flush must send everything: panel RAM is unknown */
+    ESP_LOGI(TAG, "Initializing %s %dx%d on %s", SSD1306_PANEL_SH1106 ? "SH1106" : "SSD1306",
+             width, height, dev->bus == SSD1306_BUS_SPI ? "SPI" : "I2C");
+    ssd1306_reset_dirty(dev);
+    
+    esp_err_t ret = ssd1306_init_display(dev);
+    if (ret != ESP_OK) return ret;
+
+    /* Shadow now mirrors panel GDDRAM; without it show() falls back to dirty-range flushing */
+    dev->shadow = (uint8_t *)malloc(buffer_size);
+    if (dev->shadow) {
+        memcpy(dev->shadow, dev->buffer, buffer_size);
+    } else {
+        ESP_LOGW(TAG, "No memory for shadow framebuffer, diff flush disabled");
+    }
+    return ESP_OK;
 }
 
 /* 函数名：ssd1306_init
  *
- * 函数说明：初始化 SSD1306 结构，分配帧缓冲并完成硬件初始化。
+ * 函数说明：初始化 I2C 连接的屏幕：分配帧缓冲并完成硬件初始化。
  * 参数：
  *   dev - 设备句柄指针。
  *   i2c_dev - 已创建的 I2C 设备句柄。
@@ -153,38 +611,155 @@ static inline void ssd1306_mark_dirty(ssd1306_t *dev, uint16_t x, uint16_t y)
  *   i2c_addr - I2C 地址。
  *   external_vcc - 是否使用外部供电。
  * 返回值：
- *   ESP_OK 表示成功，参数错误或分配/初始化失败返回对应错误码。
+ *   ESP_OK 表示成功；ESP_ERR_INVALID_SIZE 尺寸不受支持或与编译时选定的面板不符；
+ *   参数错误或分配/初始化失败返回对应错误码。
  */
 esp_err_t ssd1306_init(ssd1306_t *dev, i2c_master_dev_handle_t i2c_dev,
                        uint16_t width, uint16_t height, uint8_t i2c_addr,
                        bool external_vcc)
 {
     if (!dev || !i2c_dev) return ESP_ERR_INVALID_ARG;
-    
-    dev->width = width;
-    dev->height = height;
-    dev->pages = height / 8;
+    esp_err_t ret = ssd1306_check_geometry(width, height);
+    if (ret != ESP_OK) return ret;
+
+    dev->bus = SSD1306_BUS_I2C;
     dev->i2c_dev = i2c_dev;
     dev->i2c_addr = i2c_addr;
-    dev->external_vcc = external_vcc;
-    
-    size_t buffer_size = dev->pages * dev->width;
-    dev->buffer = (uint8_t *)malloc(buffer_size);
-    if (!dev->buffer) {
+    dev->spi = NULL;
+    return ssd1306_setup(dev, width, height, external_vcc);
+}
+
+/* 函数名：ssd1306_init_spi
+ *
+ * 函数说明：初始化 4 线 SPI 连接的屏幕：配置 D/C 与复位引脚并复位面板，在已初始化
+ *           （带 DMA 通道）的 SPI 总线上添加设备，随后分配帧缓冲并完成硬件初始化。
+ *           此后的刷新以排队 DMA 事务发送，D/C 电平在每个事务开始前由回调设置。
+ * 参数：
+ *   dev - 设备句柄指针。
+ *   cfg - SPI 主机、CS/DC/RST 引脚与时钟频率。
+ *   width, height - 屏幕尺寸（像素）。
+ *   external_vcc - 是否使用外部供电。
+ * 返回值：
+ *   ESP_OK 表示成功；ESP_ERR_INVALID_SIZE 尺寸不受支持；其他为 GPIO/SPI/分配错误码。
+ */
+esp_err_t ssd1306_init_spi(ssd1306_t *dev, const ssd1306_spi_config_t *cfg,
+                           uint16_t width, uint16_t height, bool external_vcc)
+{
+    if (!dev || !cfg || cfg->dc_gpio < 0 || cfg->clock_hz <= 0) return ESP_ERR_INVALID_ARG;
+    esp_err_t ret = ssd1306_check_geometry(width, height);
+    if (ret != ESP_OK) return ret;
+
+    struct ssd1306_spi_bus *bus = (struct ssd1306_spi_bus *)calloc(1, sizeof(*bus));
+    if (!bus) return ESP_ERR_NO_MEM;
+    bus->dc_gpio = cfg->dc_gpio;
+
+    gpio_config_t io = {
+        .pin_bit_mask = (1ULL << cfg->dc_gpio) | (cfg->rst_gpio >= 0 ? 1ULL << cfg->rst_gpio : 0),
+        .mode = GPIO_MODE_OUTPUT,
+    };
+    ret = gpio_config(&io);
+    if (ret == ESP_OK && cfg->rst_gpio >= 0) {
+        /* RES# low for at least 3 us, then release */
+        gpio_set_level(cfg->rst_gpio, 0);
+        esp_rom_delay_us(10);
+        gpio_set_level(cfg->rst_gpio, 1);
+        esp_rom_delay_us(10);
+    }
+    if (ret == ESP_OK) {
+        spi_device_interface_config_t devcfg = {
+            .mode = 0,
+            .clock_speed_hz = cfg->clock_hz,
+            .spics_io_num = cfg->cs_gpio,
+            .queue_size = SSD1306_SPI_QUEUE,
+            .pre_cb = ssd1306_spi_pre_cb,
+            .post_cb = ssd1306_spi_post_cb,
+        };
+        ret = spi_bus_add_device(cfg->host, &devcfg, &bus->spi);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "SPI panel setup failed: %s", esp_err_to_name(ret));
+        free(bus);
+        return ret;
+    }
+
+    dev->bus = SSD1306_BUS_SPI;
+    dev->i2c_dev = NULL;
+    dev->i2c_addr = 0;
+    dev->spi = bus;
+    return ssd1306_setup(dev, width, height, external_vcc);
+}
+
+/* 函数名：ssd1306_clone
+ *
+ * 函数说明：为已初始化的设备创建第二个帧缓冲实例（共享总线设备与几何参数），
+ *           不重复下发初始化序列，用于双缓冲刷新。
+ * 参数：
+ *   dst - 待初始化的设备句柄。
+ *   src - 已初始化的源设备句柄。
+ * 返回值：
+ *   ESP_OK 表示成功，参数错误或分配失败返回对应错误码。
+ */
+esp_err_t ssd1306_clone(ssd1306_t *dst, const ssd1306_t *src)
+{
+    if (!dst || !src || !src->buffer) return ESP_ERR_INVALID_ARG;
+
+    *dst = *src;
+    size_t buffer_size = (size_t)PANEL_PAGES(src) * PANEL_W(src);
+    dst->buffer = (uint8_t *)heap_caps_malloc(buffer_size, MALLOC_CAP_DMA);
+    if (!dst->buffer) {
         ESP_LOGE(TAG, "Failed to allocate framebuffer");
         return ESP_ERR_NO_MEM;
     }
-    
-    memset(dev->buffer, 0, buffer_size);
-    ESP_LOGI(TAG, "Initializing SSD1306 %dx%d at 0x%02x", width, height, i2c_addr);
-    ssd1306_reset_dirty(dev);
-    
-    return ssd1306_init_display(dev);
+
+    memcpy(dst->buffer, src->buffer, buffer_size);
+    memset(&dst->bus_stats, 0, sizeof(dst->bus_stats));
+    ssd1306_reset_dirty(dst);
+
+    /* Only one of src/dst should flush afterwards, otherwise the other's shadow goes stale */
+    dst->shadow = NULL;
+    if (src->shadow) {
+        dst->shadow = (uint8_t *)malloc(buffer_size);
+        if (dst->shadow) {
+            memcpy(dst->shadow, src->shadow, buffer_size);
+        } else {
+            ESP_LOGW(TAG, "No memory for shadow framebuffer, diff flush disabled");
+        }
+    }
+    return ESP_OK;
+}
+
+/* 函数名：ssd1306_take_frame
+ *
+ * 函数说明：将 src 中的脏区拷贝到 dst，并把脏区记录合并进 dst、清空 src 的脏标记。
+ *           两者须为同一几何尺寸（通常 dst 由 ssd1306_clone 创建）。dst 的异步刷新
+ *           尚未完成时先等待，避免改写 DMA 正在发送的帧缓冲。
+ * 参数：
+ *   dst - 目标（前台）帧。
+ *   src - 源（后台）帧。
+ * 返回值：
+ *   无。
+ */
+void ssd1306_take_frame(ssd1306_t *dst, ssd1306_t *src)
+{
+    if (!(src->dirty_flags & 0x01)) return;
+    ssd1306_wait(dst);
+
+    for (uint8_t page = 0; page < PANEL_PAGES(src); ++page) {
+        uint8_t start_col = src->dirty_col_start[page];
+        uint8_t end_col = src->dirty_col_end[page];
+        if (!src->page_dirty[page] || start_col == 0xFF || end_col < start_col) continue;
+
+        size_t offset = (size_t)page * PANEL_W(src) + start_col;
+        memcpy(dst->buffer + offset, src->buffer + offset, (size_t)(end_col - start_col + 1));
+        ssd1306_mark_dirty_span(dst, page, start_col, end_col);
+    }
+    ssd1306_reset_dirty(src);
 }
 
 /* 函数名：ssd1306_deinit
  *
- * 函数说明：释放帧缓冲等资源，不做 I2C 反初始化。
+ * 函数说明：等待进行中的刷新完成后释放帧缓冲与影子缓冲。总线设备（I2C 设备、SPI 设备
+ *           与事务状态）由同一面板的各帧共享，不在此释放。
  * 参数：
  *   dev - 设备句柄。
  * 返回值：
@@ -192,10 +767,12 @@ esp_err_t ssd1306_init(ssd1306_t *dev, i2c_master_dev_handle_t i2c_dev,
  */
 void ssd1306_deinit(ssd1306_t *dev)
 {
-    if (dev && dev->buffer) {
-        free(dev->buffer);
-        dev->buffer = NULL;
-    }
+    if (!dev) return;
+    ssd1306_wait(dev);
+    free(dev->buffer);
+    dev->buffer = NULL;
+    free(dev->shadow);
+    dev->shadow = NULL;
 }
 
 /* 函数名：ssd1306_power_on
@@ -231,13 +808,12 @@ esp_err_t ssd1306_power_off(ssd1306_t *dev)
  *   dev - 设备句柄。
  *   contrast - 对比度值（0-255）。
  * 返回值：
- *   ESP_OK 表示成功，否则为 I2C 错误码。
+ *   ESP_OK 表示成功，否则为总线错误码。
  */
 esp_err_t ssd1306_set_contrast(ssd1306_t *dev, uint8_t contrast)
 {
-    esp_err_t ret = ssd1306_write_cmd(dev, SET_CONTRAST);
-    if (ret != ESP_OK) return ret;
-    return ssd1306_write_cmd(dev, contrast);
+    const uint8_t cmds[] = { SET_CONTRAST, contrast };
+    return ssd1306_write_cmds(dev, cmds, sizeof(cmds));
 }
 
 /* 函数名：ssd1306_invert
@@ -247,66 +823,258 @@ esp_err_t ssd1306_set_contrast(ssd1306_t *dev, uint8_t contrast)
  *   dev - 设备句柄。
  *   invert - true 为反显，false 为正显。
  * 返回值：
- *   ESP_OK 表示成功，否则为 I2C 错误码。
+ *   ESP_OK 表示成功，否则为总线错误码。
  */
 esp_err_t ssd1306_invert(ssd1306_t *dev, bool invert)
 {
     return ssd1306_write_cmd(dev, SET_NORM_INV | (invert ? 1 : 0));
 }
 
-/* 函数名：ssd1306_show
+/* 函数名：ssd1306_collect_runs
  *
- * 函数说明：将脏矩形区域写回屏幕，实现增量刷新。
+ * 函数说明：在各页脏列区间内对比帧缓冲与影子缓冲，找出实际变化的列段。相邻段的
+ *           间隙不超过一次窗口+数据事务的开销时合并为一段（多发几个字节比多开一
+ *           次事务更省）。无影子缓冲时直接以脏列区间作为列段。
+ * 参数：
+ *   dev      - 设备句柄。
+ *   runs     - 输出列段数组。
+ *   max_runs - 数组容量，超出时并入最后一段。
+ *   gap      - 允许合并的最大间隙（字节）。
+ * 返回值：
+ *   列段数量。
+ */
+static size_t ssd1306_collect_runs(ssd1306_t *dev, ssd1306_run_t *runs, size_t max_runs, size_t gap)
+{
+    size_t n = 0;
+
+    for (uint8_t page = 0; page < PANEL_PAGES(dev); ++page) {
+        uint8_t start_col = dev->dirty_col_start[page];
+        uint8_t end_col = dev->dirty_col_end[page];
+        if (!dev->page_dirty[page] || start_col == 0xFF || end_col < start_col) continue;
+
+        if (!dev->shadow) {
+            if (n == max_runs) {
+                runs[n - 1].c0 = 0;
+                runs[n - 1].c1 = (uint8_t)(PANEL_W(dev) - 1);
+                runs[n - 1].p1 = page;
+                continue;
+            }
+            runs[n++] = (ssd1306_run_t){ page, page, start_col, end_col };
+            continue;
+        }
+
+        const uint8_t *cur = dev->buffer + (size_t)page * PANEL_W(dev);
+        const uint8_t *old = dev->shadow + (size_t)page * PANEL_W(dev);
+        bool open = false;
+        uint16_t run_start = 0, run_end = 0;
+
+        for (uint16_t col = start_col; col <= end_col; ++col) {
+            if (cur[col] == old[col]) continue;
+
+            if (open && (size_t)(col - run_end - 1) <= gap) {
+                run_end = col;  /* gap is cheaper to resend than a new transaction pair */
+                continue;
+            }
+            if (open) {
+                if (n < max_runs) {
+                    runs[n++] = (ssd1306_run_t){ page, page, (uint8_t)run_start, (uint8_t)run_end };
+                } else {
+                    /* Out of slots: widen the last run to cover this one */
+                    runs[n - 1].c0 = 0;
+                    runs[n - 1].c1 = (uint8_t)(PANEL_W(dev) - 1);
+                    runs[n - 1].p1 = page;
+                }
+            }
+            open = true;
+            run_start = col;
+            run_end = col;
+        }
+
+        if (open) {
+            if (n < max_runs) {
+                runs[n++] = (ssd1306_run_t){ page, page, (uint8_t)run_start, (uint8_t)run_end };
+            } else {
+                runs[n - 1].c0 = 0;
+                runs[n - 1].c1 = (uint8_t)(PANEL_W(dev) - 1);
+                runs[n - 1].p1 = page;
+            }
+        }
+    }
+    return n;
+}
+
+/* 函数名：ssd1306_set_start_line
+ *
+ * 函数说明：设置显示起始行（硬件行偏移），面板从 GDDRAM 的该行开始循环显示，
+ *           可用于硬件垂直滚动，每次只需一条命令。
+ * 参数：
+ *   dev  - 设备句柄。
+ *   line - 起始行（0 ~ height-1）。
+ * 返回值：
+ *   ESP_OK 表示成功，否则为总线错误码。
+ */
+esp_err_t ssd1306_set_start_line(ssd1306_t *dev, uint8_t line)
+{
+    return ssd1306_write_cmd(dev, (uint8_t)(SET_DISP_START_LINE | (line & 0x3F)));
+}
+
+/* 函数名：ssd1306_set_visible_rows
+ *
+ * 函数说明：设置复用率（MUX ratio），只驱动前 rows 行，其余 GDDRAM 行不显示，
+ *           可作为滚动时的屏外缓冲区。
+ * 参数：
+ *   dev  - 设备句柄。
+ *   rows - 可见行数（16 ~ height）。
+ * 返回值：
+ *   ESP_OK 表示成功，参数越界返回 ESP_ERR_INVALID_ARG，否则为总线错误码。
+ */
+esp_err_t ssd1306_set_visible_rows(ssd1306_t *dev, uint8_t rows)
+{
+    if (rows < 16 || rows > PANEL_H(dev)) return ESP_ERR_INVALID_ARG;
+    const uint8_t cmds[] = { SET_MUX_RATIO, (uint8_t)(rows - 1) };
+    return ssd1306_write_cmds(dev, cmds, sizeof(cmds));
+}
+
+/* 函数名：ssd1306_show_async
+ *
+ * 函数说明：将变化区域写回屏幕，实现增量刷新。先用影子缓冲（上次已发送到面板的
+ *           内容）对脏区做差分，得到每页若干变化列段；再按总线字节代价在两种方案
+ *           中择优：逐段发送（每段一个窗口命令事务 + 一个数据事务，SH1106 为每页一对），
+ *           或以全部列段的外接矩形为窗口整体突发发送。内容未变化时不产生任何总线传输。
+ *           SPI 面板只把事务排队给 DMA 即返回，最后一个事务完成时调用 cb；此前不得改写
+ *           帧缓冲。I2C 面板同步发送，返回前调用 cb。
  * 参数：
  *   dev - 设备句柄。
+ *   cb  - 刷新完成回调，可为 NULL；没有需要发送的内容时立即调用。
+ *   arg - 回调参数。
  * 返回值：
- *   ESP_OK 表示成功，其他为 I2C 错误码。
+ *   ESP_OK 表示成功（SPI 为已排队），其他为总线错误码（此时不调用 cb）。
  */
-esp_err_t ssd1306_show(ssd1306_t *dev)
+esp_err_t ssd1306_show_async(ssd1306_t *dev, ssd1306_flush_cb_t cb, void *arg)
 {
     esp_err_t ret;
     if (!(dev->dirty_flags & 0x01)) {
+        if (cb) cb(dev, arg);
         return ESP_OK; /* Nothing to update */
     }
 
-    for (uint8_t page = 0; page < dev->pages && page < 8; ++page) {
-        if (!dev->page_dirty[page]) continue;
+    /* Cost of one window-setup + data pair, excluding the payload itself */
+    const size_t pair_overhead = 2 * (SSD1306_I2C_TXN_OVERHEAD + 1) + PANEL_WINDOW_CMDS;
 
-        uint8_t start_col = dev->dirty_col_start[page];
-        uint8_t end_col = dev->dirty_col_end[page];
-        if (start_col == 0xFF || end_col < start_col) continue;
+    ssd1306_run_t runs[SSD1306_MAX_RUNS];
+    size_t nruns = ssd1306_collect_runs(dev, runs, SSD1306_MAX_RUNS, pair_overhead);
 
-        /* Set column address range */
-        ret = ssd1306_write_cmd(dev, SET_COL_ADDR);
-        if (ret != ESP_OK) return ret;
-        ret = ssd1306_write_cmd(dev, start_col);
-        if (ret != ESP_OK) return ret;
-        ret = ssd1306_write_cmd(dev, end_col);
-        if (ret != ESP_OK) return ret;
+    if (nruns > 0) {
+        uint8_t first_page = 0xFF, last_page = 0;
+        uint8_t min_col = 0xFF, max_col = 0;
+        size_t per_run_cost = 0;
 
-        /* Set page address to this page only */
-        ret = ssd1306_write_cmd(dev, SET_PAGE_ADDR);
-        if (ret != ESP_OK) return ret;
-        ret = ssd1306_write_cmd(dev, page);
-        if (ret != ESP_OK) return ret;
-        ret = ssd1306_write_cmd(dev, page);
-        if (ret != ESP_OK) return ret;
+        for (size_t i = 0; i < nruns; i++) {
+            if (runs[i].p0 < first_page) first_page = runs[i].p0;
+            if (runs[i].p1 > last_page) last_page = runs[i].p1;
+            if (runs[i].c0 < min_col) min_col = runs[i].c0;
+            if (runs[i].c1 > max_col) max_col = runs[i].c1;
+            size_t run_pages = (size_t)(runs[i].p1 - runs[i].p0 + 1);
+            per_run_cost += PANEL_PAIRS(run_pages) * pair_overhead +
+                            run_pages * (size_t)(runs[i].c1 - runs[i].c0 + 1);
+        }
 
-        size_t len = (size_t)(end_col - start_col + 1);
-        size_t offset = (size_t)page * dev->width + start_col;
-        ret = ssd1306_write_data(dev, dev->buffer + offset, len);
-        if (ret != ESP_OK) return ret;
+        size_t burst_pages = (size_t)(last_page - first_page + 1);
+        size_t burst_cost = PANEL_PAIRS(burst_pages) * pair_overhead +
+                            burst_pages * (size_t)(max_col - min_col + 1);
+        if (burst_cost <= per_run_cost) {
+            runs[0] = (ssd1306_run_t){ first_page, last_page, min_col, max_col };
+            nruns = 1;
+            dev->bus_stats.bursts++;
+        }
+
+        for (size_t i = 0; i < nruns; i++) {
+            const ssd1306_run_t *r = &runs[i];
+            size_t len = (size_t)(r->c1 - r->c0 + 1);
 
-        /* Clear dirty for this page */
-        dev->page_dirty[page] = 0;
-        dev->dirty_col_start[page] = 0xFF;
-        dev->dirty_col_end[page] = 0;
+            ret = ssd1306_write_region(dev, r, i == nruns - 1 ? cb : NULL, arg);
+            if (ret != ESP_OK) return ret;
+
+            if (dev->shadow) {
+                for (uint8_t page = r->p0; page <= r->p1; ++page) {
+                    size_t offset = (size_t)page * PANEL_W(dev) + r->c0;
+                    memcpy(dev->shadow + offset, dev->buffer + offset, len);
+                }
+            }
+        }
+        dev->bus_stats.runs += (uint32_t)nruns;
+        dev->bus_stats.flushes++;
+    } else if (cb) {
+        cb(dev, arg);   /* dirty, but nothing differs from the panel */
     }
 
-    dev->dirty_flags &= ~0x01;
+    ssd1306_reset_dirty(dev);
     return ESP_OK;
 }
 
+/* 函数名：ssd1306_wait
+ *
+ * 函数说明：等待该面板已排队的 SPI 事务全部完成（I2C 面板的刷新本身是同步的，直接返回）。
+ * 参数：
+ *   dev - 设备句柄。
+ * 返回值：
+ *   ESP_OK 表示成功，其他为 SPI 驱动错误码。
+ */
+esp_err_t ssd1306_wait(ssd1306_t *dev)
+{
+    if (!dev || dev->bus != SSD1306_BUS_SPI || !dev->spi) return ESP_OK;
+    while (dev->spi->in_flight > 0) {
+        esp_err_t ret = ssd1306_spi_reap(dev->spi);
+        if (ret != ESP_OK) return ret;
+    }
+    return ESP_OK;
+}
+
+/* 函数名：ssd1306_show
+ *
+ * 函数说明：同步增量刷新：排队发送变化区域（见 ssd1306_show_async）并等待传输完成，
+ *           返回后即可继续绘制。
+ * 参数：
+ *   dev - 设备句柄。
+ * 返回值：
+ *   ESP_OK 表示成功，其他为总线错误码。
+ */
+esp_err_t ssd1306_show(ssd1306_t *dev)
+{
+    esp_err_t ret = ssd1306_show_async(dev, NULL, NULL);
+    if (ret != ESP_OK) return ret;
+    return ssd1306_wait(dev);
+}
+
+/* 函数名：ssd1306_get_bus_stats
+ *
+ * 函数说明：读取总线事务/字节统计。
+ * 参数：
+ *   dev - 设备句柄。
+ *   out - 输出统计结构。
+ * 返回值：
+ *   无。
+ */
+void ssd1306_get_bus_stats(const ssd1306_t *dev, ssd1306_bus_stats_t *out)
+{
+    if (!dev || !out) return;
+    *out = dev->bus_stats;
+}
+
+/* 函数名：ssd1306_reset_bus_stats
+ *
+ * 函数说明：清零总线统计计数。
+ * 参数：
+ *   dev - 设备句柄。
+ * 返回值：
+ *   无。
+ */
+void ssd1306_reset_bus_stats(ssd1306_t *dev)
+{
+    if (!dev) return;
+    memset(&dev->bus_stats, 0, sizeof(dev->bus_stats));
+}
+
 /* 函数名：ssd1306_fill
  *
  * 函数说明：填充整个缓冲区为指定颜色，并标记全部为脏。
@@ -318,13 +1086,13 @@ esp_err_t ssd1306_show(ssd1306_t *dev)
  */
 void ssd1306_fill(ssd1306_t *dev, uint8_t color)
 {
-    memset(dev->buffer, color ? 0xff : 0x00, dev->pages * dev->width);
+    memset(dev->buffer, color ? 0xff : 0x00, PANEL_PAGES(dev) * PANEL_W(dev));
     /* Mark all pages and columns as dirty */
     dev->dirty_flags |= 0x01;
-    for (uint8_t p = 0; p < dev->pages && p < 8; ++p) {
+    for (uint8_t p = 0; p < PANEL_PAGES(dev); ++p) {
         dev->page_dirty[p] = 1;
         dev->dirty_col_start[p] = 0;
-        dev->dirty_col_end[p] = (uint8_t)(dev->width - 1);
+        dev->dirty_col_end[p] = (uint8_t)(PANEL_W(dev) - 1);
     }
 }
 
@@ -341,6 +1109,43 @@ void ssd1306_clear(ssd1306_t *dev)
     ssd1306_fill(dev, 0);
 }
 
+/* 函数名：ssd1306_load_frame
+ *
+ * 函数说明：用整帧图像（如 Flash 中的预渲染模板）覆盖帧缓冲，并标记全部为脏；
+ *           实际发送量由 ssd1306_show() 的差分决定。
+ * 参数：
+ *   dev   - 设备句柄。
+ *   image - 帧图像，pages * width 字节，布局与帧缓冲相同。
+ * 返回值：
+ *   无。
+ */
+void ssd1306_load_frame(ssd1306_t *dev, const uint8_t *image)
+{
+    memcpy(dev->buffer, image, (size_t)PANEL_PAGES(dev) * PANEL_W(dev));
+    for (uint8_t p = 0; p < PANEL_PAGES(dev); ++p) {
+        ssd1306_mark_dirty_span(dev, p, 0, (uint16_t)(PANEL_W(dev) - 1));
+    }
+}
+
+/* 函数名：ssd1306_page_span
+ *
+ * 函数说明：返回帧缓冲中某页一段列的可写指针并标记为脏，调用方随后直接写入
+ *           （例如从网络接收缓冲直接收包），无需中间拷贝。
+ * 参数：
+ *   dev  - 设备句柄。
+ *   page - 页号。
+ *   col  - 起始列。
+ *   len  - 字节数（列数）。
+ * 返回值：
+ *   可写指针；越界或 len 为 0 时返回 NULL。
+ */
+uint8_t *ssd1306_page_span(ssd1306_t *dev, uint8_t page, uint16_t col, uint16_t len)
+{
+    if (page >= PANEL_PAGES(dev) || len == 0 || col >= PANEL_W(dev) || len > PANEL_W(dev) - col) return NULL;
+    ssd1306_mark_dirty_span(dev, page, col, (uint16_t)(col + len - 1));
+    return dev->buffer + (size_t)page * PANEL_W(dev) + col;
+}
+
 /* 函数名：ssd1306_pixel
  *
  * 函数说明：设置单个像素并标记脏区。
@@ -354,9 +1159,9 @@ void ssd1306_clear(ssd1306_t *dev)
  */
 void ssd1306_pixel(ssd1306_t *dev, uint16_t x, uint16_t y, uint8_t color)
 {
-    if (x >= dev->width || y >= dev->height) return;
+    if (x >= PANEL_W(dev) || y >= PANEL_H(dev)) return;
     
-    uint16_t pos = (y / 8) * dev->width + x;
+    uint16_t pos = (y / 8) * PANEL_W(dev) + x;
     uint8_t bit = 1 << (y % 8);
     
     if (color) {
@@ -382,9 +1187,7 @@ void ssd1306_pixel(ssd1306_t *dev, uint16_t x, uint16_t y, uint8_t color)
  */
 void ssd1306_h_line(ssd1306_t *dev, uint16_t x, uint16_t y, uint16_t width, uint8_t color)
 {
-    for (uint16_t i = 0; i < width; i++) {
-        ssd1306_pixel(dev, x + i, y, color);
-    }
+    ssd1306_fill_span(dev, x, y, width, 1, color);
 }
 
 /* 函数名：ssd1306_v_line
@@ -401,9 +1204,7 @@ void ssd1306_h_line(ssd1306_t *dev, uint16_t x, uint16_t y, uint16_t width, uint
  */
 void ssd1306_v_line(ssd1306_t *dev, uint16_t x, uint16_t y, uint16_t height, uint8_t color)
 {
-    for (uint16_t i = 0; i < height; i++) {
-        ssd1306_pixel(dev, x, y + i, color);
-    }
+    ssd1306_fill_span(dev, x, y, 1, height, color);
 }
 
 /* 函数名：ssd1306_rect
@@ -429,7 +1230,7 @@ void ssd1306_rect(ssd1306_t *dev, uint16_t x, uint16_t y, uint16_t width, uint16
 
 /* 函数名：ssd1306_fill_rect
  *
- * 函数说明：绘制实心矩形（逐行填充）。
+ * 函数说明：绘制实心矩形（按页字节批量填充）。
  * 参数：
  *   dev - 设备句柄。
  *   x   - 左上 X 坐标。
@@ -442,9 +1243,327 @@ void ssd1306_rect(ssd1306_t *dev, uint16_t x, uint16_t y, uint16_t width, uint16
  */
 void ssd1306_fill_rect(ssd1306_t *dev, uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint8_t color)
 {
-    for (uint16_t i = 0; i < height; i++) {
-        ssd1306_h_line(dev, x, y + i, width, color);
+    ssd1306_fill_span(dev, x, y, width, height, color);
+}
+
+/* Destination geometry of one blit, shared by the raw and RLE paths */
+typedef struct {
+    ssd1306_t *dev;
+    uint16_t x;             /* left column */
+    uint16_t cols;          /* visible columns */
+    uint8_t page;           /* page of the first bitmap row */
+    uint8_t shift;          /* y & 7 */
+    uint8_t last_page;      /* last page touched (bitmap bottom or panel bottom) */
+    uint8_t last_clip;      /* rows of last_page inside the bitmap */
+    ssd1306_blit_mode_t mode;
+} ssd1306_blit_ctx_t;
+
+/* 函数名：ssd1306_blit_prepare
+ *
+ * 函数说明：计算位图在帧缓冲中的目标页、位移与裁剪掩码。
+ * 参数：
+ *   ctx  - 输出：位图几何信息。
+ *   dev  - 设备句柄。
+ *   x, y - 左上坐标。
+ *   w, h - 位图宽高。
+ *   mode - 绘制模式。
+ * 返回值：
+ *   false 表示位图完全在屏幕外。
+ */
+static inline bool ssd1306_blit_prepare(ssd1306_blit_ctx_t *ctx, ssd1306_t *dev, uint16_t x, uint16_t y,
+                                        uint16_t w, uint16_t h, ssd1306_blit_mode_t mode)
+{
+    if (w == 0 || h == 0 || x >= PANEL_W(dev) || y >= PANEL_H(dev)) return false;
+
+    uint16_t y_end = (uint16_t)(y + h);
+    if (y_end > PANEL_H(dev)) y_end = PANEL_H(dev);
+
+    ctx->dev = dev;
+    ctx->x = x;
+    ctx->cols = (x + w > PANEL_W(dev)) ? (uint16_t)(PANEL_W(dev) - x) : w;
+    ctx->page = (uint8_t)(y / 8);
+    ctx->shift = (uint8_t)(y & 7);
+    ctx->last_page = (uint8_t)((y_end - 1) / 8);
+    /* Rows past the bitmap bottom (or the panel bottom) inside the last page stay untouched */
+    ctx->last_clip = (uint8_t)(0xFF >> (7 - ((y_end - 1) & 7)));
+    ctx->mode = mode;
+    return true;
+}
+
+/* 函数名：ssd1306_blit_span
+ *
+ * 函数说明：按模式把 n 个源字节移位后写入上下两个目标页。mode 在调用处为常量，
+ *           内联后每种模式各得到一个不含分支的内层循环。
+ * 参数：
+ *   upper, lower - 目标页中的起始字节。
+ *   src    - 源字节。
+ *   step   - 源步长（1 逐字节，0 重复同一字节）。
+ *   n      - 字节数。
+ *   shift  - 行位移。
+ *   um, lm - 上/下页掩码，lm 为 0 时不写下页。
+ *   mode   - 绘制模式。
+ * 返回值：
+ *   无。
+ */
+static inline void ssd1306_blit_span(uint8_t *upper, uint8_t *lower, const uint8_t *src, size_t step,
+                                     uint16_t n, uint8_t shift, uint8_t um, uint8_t lm,
+                                     ssd1306_blit_mode_t mode)
+{
+    for (uint16_t i = 0; i < n; i++, src += step) {
+        uint8_t hi = (uint8_t)((*src << shift) & um);
+        switch (mode) {
+            case SSD1306_BLIT_SET:    upper[i] |= hi; break;
+            case SSD1306_BLIT_CLEAR:  upper[i] &= (uint8_t)~hi; break;
+            case SSD1306_BLIT_XOR:    upper[i] ^= hi; break;
+            case SSD1306_BLIT_OPAQUE: upper[i] = (uint8_t)((upper[i] & ~um) | hi); break;
+        }
+        if (lm) {
+            uint8_t lo = (uint8_t)((*src >> (8 - shift)) & lm);
+            switch (mode) {
+                case SSD1306_BLIT_SET:    lower[i] |= lo; break;
+                case SSD1306_BLIT_CLEAR:  lower[i] &= (uint8_t)~lo; break;
+                case SSD1306_BLIT_XOR:    lower[i] ^= lo; break;
+                case SSD1306_BLIT_OPAQUE: lower[i] = (uint8_t)((lower[i] & ~lm) | lo); break;
+            }
+        }
+    }
+}
+
+/* 函数名：ssd1306_blit_row
+ *
+ * 函数说明：写入位图第 sp 页中从 col0 开始的 n 个字节。y 非 8 对齐时每字节按位移
+ *           拆分到上下两个目标页；页对齐的不透明写入直接按字节拷贝。
+ * 参数：
+ *   ctx  - 位图几何信息。
+ *   sp   - 位图内的页号。
+ *   col0 - 起始列（位图内坐标）。
+ *   src  - 源字节；为 NULL 时所有列都使用 fill。
+ *   fill - 重复字节（RLE 重复段）。
+ *   n    - 字节数。
+ * 返回值：
+ *   无。
+ */
+static inline void ssd1306_blit_row(const ssd1306_blit_ctx_t *ctx, uint16_t sp, uint16_t col0,
+                                    const uint8_t *src, uint8_t fill, uint16_t n)
+{
+    ssd1306_t *dev = ctx->dev;
+    uint16_t dp = (uint16_t)(ctx->page + sp);
+    if (dp > ctx->last_page || col0 >= ctx->cols) return;
+    if (n > ctx->cols - col0) n = (uint16_t)(ctx->cols - col0);
+
+    uint8_t shift = ctx->shift;
+    uint8_t upper_mask = (uint8_t)((0xFF << shift) & (dp == ctx->last_page ? ctx->last_clip : 0xFF));
+    /* The lower half only exists when the row straddles a page boundary */
+    bool has_lower = shift != 0 && dp < ctx->last_page;
+    uint8_t lower_mask = has_lower ?
+        (uint8_t)((0xFF >> (8 - shift)) & (dp + 1 == ctx->last_page ? ctx->last_clip : 0xFF)) : 0;
+
+    uint8_t *upper = dev->buffer + (size_t)dp * PANEL_W(dev) + ctx->x + col0;
+    uint8_t *lower = upper + PANEL_W(dev);
+    size_t step = src ? 1 : 0;
+    if (!src) src = &fill;
+
+    switch (ctx->mode) {
+        case SSD1306_BLIT_OPAQUE:
+            if (upper_mask == 0xFF) {
+                if (step) memcpy(upper, src, n);
+                else memset(upper, fill, n);
+            } else {
+                ssd1306_blit_span(upper, lower, src, step, n, shift, upper_mask, lower_mask, SSD1306_BLIT_OPAQUE);
+            }
+            break;
+        case SSD1306_BLIT_SET:
+            ssd1306_blit_span(upper, lower, src, step, n, shift, upper_mask, lower_mask, SSD1306_BLIT_SET);
+            break;
+        case SSD1306_BLIT_CLEAR:
+            ssd1306_blit_span(upper, lower, src, step, n, shift, upper_mask, lower_mask, SSD1306_BLIT_CLEAR);
+            break;
+        case SSD1306_BLIT_XOR:
+            ssd1306_blit_span(upper, lower, src, step, n, shift, upper_mask, lower_mask, SSD1306_BLIT_XOR);
+            break;
     }
+
+    uint16_t x0 = (uint16_t)(ctx->x + col0);
+    uint16_t x1 = (uint16_t)(x0 + n - 1);
+    ssd1306_mark_dirty_span(dev, (uint8_t)dp, x0, x1);
+    if (has_lower) ssd1306_mark_dirty_span(dev, (uint8_t)(dp + 1), x0, x1);
+}
+
+/* 函数名：ssd1306_blit
+ *
+ * 函数说明：将页格式位图（每列一字节、bit0 为最上方像素，按页依次排列）按指定模式
+ *           写入帧缓冲，支持任意 y（非 8 对齐时跨页拆分），按屏幕宽高裁剪。
+ * 参数：
+ *   dev    - 设备句柄。
+ *   bitmap - 位图数据（w * ceil(h/8) 字节）。
+ *   x, y   - 左上坐标。
+ *   w, h   - 位图宽高（像素）。
+ *   mode   - 绘制模式：不透明拷贝、置位（透明）、清除（透明）或异或。
+ * 返回值：
+ *   无。
+ */
+void ssd1306_blit(ssd1306_t *dev, const uint8_t *bitmap, uint16_t x, uint16_t y,
+                  uint16_t w, uint16_t h, ssd1306_blit_mode_t mode)
+{
+    ssd1306_blit_ctx_t ctx;
+    if (!bitmap || !ssd1306_blit_prepare(&ctx, dev, x, y, w, h, mode)) return;
+
+    uint16_t src_pages = (uint16_t)((h + 7) / 8);
+    for (uint16_t sp = 0; sp < src_pages; sp++) {
+        ssd1306_blit_row(&ctx, sp, 0, bitmap + (size_t)sp * w, 0, w);
+    }
+}
+
+/* 函数名：ssd1306_rle_decode
+ *
+ * 函数说明：逐段解码 PackBits 数据：控制字节 0..127 表示其后 n+1 个字面字节，128..255 表示
+ *           下一个字节重复 n-125 次。每段交给 sink 处理（字面段 src 指向压缩数据，重复段
+ *           src 为 NULL、fill 为重复字节），解码恰好 total 字节后停止。越界的段不交给 sink。
+ * 参数：
+ *   rle   - 压缩数据。
+ *   len   - 压缩数据可用长度。
+ *   total - 期望解出的字节数。
+ *   used  - 输出：消耗的压缩字节数；为 NULL 时要求恰好用完 len 字节。
+ *   sink  - 段处理回调。
+ *   ctx   - 回调上下文。
+ * 返回值：
+ *   ESP_OK 成功；ESP_ERR_INVALID_SIZE 数据截断、段越过 total 或（used 为 NULL 时）有多余数据
+ *   （之前的段已交给 sink）。
+ */
+esp_err_t ssd1306_rle_decode(const uint8_t *rle, size_t len, size_t total, size_t *used,
+                             ssd1306_rle_sink_t sink, void *ctx)
+{
+    size_t out = 0;
+    size_t in = 0;
+
+    while (out < total) {
+        if (in >= len) return ESP_ERR_INVALID_SIZE;
+        uint8_t ctl = rle[in++];
+        const uint8_t *src = NULL;
+        uint8_t fill = 0;
+        size_t n;
+
+        if (ctl < 128) {
+            n = (size_t)ctl + 1;
+            if (n > len - in) return ESP_ERR_INVALID_SIZE;
+            src = rle + in;
+            in += n;
+        } else {
+            n = (size_t)ctl - 125;
+            if (in >= len) return ESP_ERR_INVALID_SIZE;
+            fill = rle[in++];
+        }
+        if (n > total - out) return ESP_ERR_INVALID_SIZE;
+        sink(ctx, out, src, fill, n);
+        out += n;
+    }
+    if (used) {
+        *used = in;
+        return ESP_OK;
+    }
+    return in == len ? ESP_OK : ESP_ERR_INVALID_SIZE;
+}
+
+/* RLE blit sink state */
+typedef struct {
+    ssd1306_blit_ctx_t blit;
+    uint16_t w;
+    bool visible;
+} ssd1306_rle_blit_t;
+
+/* 函数名：ssd1306_rle_blit_sink
+ *
+ * 函数说明：ssd1306_blit_rle 的解码回调：把一段解出的字节按位图的页/列顺序写入帧缓冲，
+ *           跨越位图页边界的段拆开绘制。
+ * 参数：
+ *   ctx  - ssd1306_rle_blit_t。
+ *   out  - 该段在位图中的字节偏移。
+ *   src  - 字面字节；重复段为 NULL。
+ *   fill - 重复字节。
+ *   n    - 字节数。
+ * 返回值：
+ *   无。
+ */
+static void ssd1306_rle_blit_sink(void *ctx, size_t out, const uint8_t *src, uint8_t fill, size_t n)
+{
+    const ssd1306_rle_blit_t *b = (const ssd1306_rle_blit_t *)ctx;
+    if (!b->visible) return;
+
+    while (n > 0) {
+        uint16_t sp = (uint16_t)(out / b->w);
+        uint16_t col = (uint16_t)(out % b->w);
+        uint16_t chunk = (uint16_t)((n < (size_t)(b->w - col)) ? n : (size_t)(b->w - col));
+        ssd1306_blit_row(&b->blit, sp, col, src, fill, chunk);
+        if (src) src += chunk;
+        out += chunk;
+        n -= chunk;
+    }
+}
+
+/* 函数名：ssd1306_blit_rle
+ *
+ * 函数说明：边解码边绘制 PackBits 压缩的页格式位图，不使用临时缓冲：
+ *           解出的字节按位图的页/列顺序直接写入帧缓冲（解码见 ssd1306_rle_decode）。
+ * 参数：
+ *   dev  - 设备句柄。
+ *   rle  - 压缩数据。
+ *   len  - 压缩数据长度。
+ *   x, y - 左上坐标。
+ *   w, h - 位图宽高（像素）。
+ *   mode - 绘制模式。
+ * 返回值：
+ *   ESP_OK 成功；ESP_ERR_INVALID_ARG 参数为空；ESP_ERR_INVALID_SIZE 数据长度与位图
+ *   尺寸不符（已解出的部分仍会绘制）。
+ */
+esp_err_t ssd1306_blit_rle(ssd1306_t *dev, const uint8_t *rle, size_t len, uint16_t x, uint16_t y,
+                           uint16_t w, uint16_t h, ssd1306_blit_mode_t mode)
+{
+    if (!dev || !rle || w == 0 || h == 0) return ESP_ERR_INVALID_ARG;
+
+    ssd1306_rle_blit_t b = { .w = w };
+    b.visible = ssd1306_blit_prepare(&b.blit, dev, x, y, w, h, mode);
+    return ssd1306_rle_decode(rle, len, (size_t)w * ((h + 7) / 8), NULL, ssd1306_rle_blit_sink, &b);
+}
+
+/* 函数名：ssd1306_image
+ *
+ * 函数说明：绘制常量图像，按图像的压缩标志选择直接拷贝或边解码边绘制。
+ * 参数：
+ *   dev  - 设备句柄。
+ *   img  - 图像。
+ *   x, y - 左上坐标。
+ *   mode - 绘制模式。
+ * 返回值：
+ *   ESP_OK 成功；ESP_ERR_INVALID_ARG 参数为空；ESP_ERR_INVALID_SIZE 数据与尺寸不符。
+ */
+esp_err_t ssd1306_image(ssd1306_t *dev, const ssd1306_image_t *img, uint16_t x, uint16_t y,
+                        ssd1306_blit_mode_t mode)
+{
+    if (!dev || !img || !img->data) return ESP_ERR_INVALID_ARG;
+    if (img->rle) {
+        return ssd1306_blit_rle(dev, img->data, img->len, x, y, img->w, img->h, mode);
+    }
+    if (img->len != (size_t)img->w * ((img->h + 7) / 8)) return ESP_ERR_INVALID_SIZE;
+    ssd1306_blit(dev, img->data, x, y, img->w, img->h, mode);
+    return ESP_OK;
+}
+
+/* 函数名：ssd1306_bitmap
+ *
+ * 函数说明：透明绘制页格式位图：位图中为 1 的位按颜色置 1 或清 0，其余像素不变。
+ * 参数：
+ *   dev    - 设备句柄。
+ *   bitmap - 位图数据（w * ceil(h/8) 字节）。
+ *   x, y   - 左上坐标。
+ *   w, h   - 位图宽高（像素）。
+ *   color  - 非 0 置 1，0 置 0。
+ * 返回值：
+ *   无。
+ */
+void ssd1306_bitmap(ssd1306_t *dev, const uint8_t *bitmap, uint16_t x, uint16_t y,
+                    uint16_t w, uint16_t h, uint8_t color)
+{
+    ssd1306_blit(dev, bitmap, x, y, w, h, color ? SSD1306_BLIT_SET : SSD1306_BLIT_CLEAR);
 }
 
 /* 函数名：ssd1306_text
@@ -474,14 +1593,14 @@ void ssd1306_text(ssd1306_t *dev, const char *str, uint16_t x, uint16_t y, uint8
         }
         
         /* Check if character will exceed screen width */
-        if (cur_x + FONT_CHAR_WIDTH > dev->width) {
+        if (cur_x + FONT_CHAR_WIDTH > PANEL_W(dev)) {
             if (wrap_mode == 0) {
                 /* Auto wrap: move to next line */
                 cur_x = start_x;
                 cur_y += FONT_CHAR_HEIGHT;
                 
                 /* Check if we exceed screen height */
-                if (cur_y + FONT_CHAR_HEIGHT > dev->height) {
+                if (cur_y + FONT_CHAR_HEIGHT > PANEL_H(dev)) {
                     break;  /* Stop drawing if no more vertical space */
                 }
             } else {
@@ -491,16 +1610,7 @@ void ssd1306_text(ssd1306_t *dev, const char *str, uint16_t x, uint16_t y, uint8
         }
         
         uint8_t char_idx = *str - 0x20;
-        const uint8_t *char_data = font_5x8[char_idx];
-        
-        for (uint8_t i = 0; i < FONT_CHAR_WIDTH; i++) {
-            uint8_t col = char_data[i];
-            for (uint8_t bit = 0; bit < FONT_CHAR_HEIGHT; bit++) {
-                if (col & (1 << bit)) {
-                    ssd1306_pixel(dev, cur_x + i, cur_y + bit, color);
-                }
-            }
-        }
+        ssd1306_bitmap(dev, font_5x8[char_idx], cur_x, cur_y, FONT_CHAR_WIDTH, FONT_CHAR_HEIGHT, color);
         
         cur_x += FONT_TOTAL_WIDTH;
         str++;
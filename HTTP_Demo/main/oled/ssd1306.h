@@ -4,11 +4,40 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "driver/i2c_master.h"
+#include "driver/spi_master.h"
+#include "sdkconfig.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Panel selection (menuconfig: Example Configuration -> OLED panel).
+ * CONFIG_OLED_PANEL_SH1106: the SH1106 has a 132-column GDDRAM with the 128 visible columns
+ * starting at CONFIG_OLED_PANEL_COL_OFFSET, and only supports page addressing.
+ * CONFIG_OLED_PANEL_WIDTH/HEIGHT: ssd1306_init() only accepts this geometry and the drawing
+ * code is compiled for constant dimensions. Without them (host tests) any geometry up to
+ * 128x64 is accepted at run time. */
+#ifdef CONFIG_OLED_PANEL_SH1106
+#define SSD1306_PANEL_SH1106      1
+#ifdef CONFIG_OLED_PANEL_COL_OFFSET
+#define SSD1306_PANEL_COL_OFFSET  CONFIG_OLED_PANEL_COL_OFFSET
+#else
+#define SSD1306_PANEL_COL_OFFSET  2
+#endif
+#else
+#define SSD1306_PANEL_SH1106      0
+#define SSD1306_PANEL_COL_OFFSET  0
+#endif
+
+#if defined(CONFIG_OLED_PANEL_WIDTH) && defined(CONFIG_OLED_PANEL_HEIGHT)
+#define SSD1306_FIXED_WIDTH       CONFIG_OLED_PANEL_WIDTH
+#define SSD1306_FIXED_HEIGHT      CONFIG_OLED_PANEL_HEIGHT
+#define SSD1306_MAX_PAGES         (SSD1306_FIXED_HEIGHT / 8)
+#else
+#define SSD1306_MAX_PAGES         8
+#endif
+#define SSD1306_MAX_WIDTH         128   /* dirty columns are tracked as uint8_t */
+
 /* SSD1306 Display Commands */
 #define SET_CONTRAST        0x81
 #define SET_ENTIRE_ON       0xa4
@@ -28,6 +57,12 @@ extern "C" {
 #define SET_VCOM_DESEL      0xdb
 #define SET_CHARGE_PUMP     0x8d
 
+/* SH1106 page-mode addressing and DC-DC control */
+#define SET_LOW_COLUMN      0x00
+#define SET_HIGH_COLUMN     0x10
+#define SET_PAGE_START      0xb0
+#define SET_DCDC            0xad
+
 /* Font configuration - can be customized */
 #define FONT_CHAR_WIDTH     5       /* Character bitmap width (pixels) */
 #define FONT_CHAR_HEIGHT    8       /* Character bitmap height (pixels) */
@@ -35,41 +70,134 @@ extern "C" {
 #define FONT_TOTAL_WIDTH    (FONT_CHAR_WIDTH + FONT_CHAR_SPACING)  /* Total width per char *//* I2C Control Bytes */
 #define I2C_CMD_BYTE        0x80  /* Co=1, D/C#=0 */
 #define I2C_DATA_BYTE       0x40  /* Co=0, D/C#=1 */
+#define I2C_CMD_STREAM      0x00  /* Co=0, D/C#=0: all following bytes are commands */
+
+/* Approximate per-transaction bus cost (start + address + stop), in byte times */
+#define SSD1306_I2C_TXN_OVERHEAD  2
+
+/* Bus statistics, accumulated since init or the last ssd1306_reset_bus_stats() */
+typedef struct {
+    uint32_t transactions;            /* I2C write transactions issued */
+    uint32_t bytes;                   /* bytes written, including control bytes */
+    uint32_t flushes;                 /* ssd1306_show() calls that sent data */
+    uint32_t bursts;                  /* flushes sent as one bounding-window burst */
+    uint32_t runs;                    /* window + data transaction pairs sent */
+} ssd1306_bus_stats_t;
+
+/* Upper bound on changed column runs sent separately in one ssd1306_show() */
+#define SSD1306_MAX_RUNS    32
+
+/* SPI transport: transactions kept queued for DMA, and command bytes one queued transaction can carry */
+#define SSD1306_SPI_QUEUE       16
+#define SSD1306_SPI_CMD_MAX     8
+
+/* Panel bus */
+typedef enum {
+    SSD1306_BUS_I2C,
+    SSD1306_BUS_SPI,        /* 4-wire: MOSI, SCLK, CS and a D/C GPIO */
+} ssd1306_bus_t;
 
+/* 4-wire SPI panel. The bus must already be initialised with spi_bus_initialize() and a DMA
+ * channel, max_transfer_sz at least width * pages */
 typedef struct {
+    spi_host_device_t host;
+    int cs_gpio;
+    int dc_gpio;
+    int rst_gpio;           /* -1 when RES# is not wired */
+    int clock_hz;           /* SSD1306 up to 10 MHz, SH1106 up to 4 MHz */
+} ssd1306_spi_config_t;
+
+struct ssd1306_t;
+struct ssd1306_spi_bus;
+
+/* Flush completion. Runs in the SPI interrupt for SPI panels (ISR-safe calls only) and in the
+ * calling task for I2C panels */
+typedef void (*ssd1306_flush_cb_t)(struct ssd1306_t *dev, void *arg);
+
+/* Bitmap blit modes */
+typedef enum {
+    SSD1306_BLIT_OPAQUE,    /* copy: bitmap 1 -> pixel on, 0 -> pixel off */
+    SSD1306_BLIT_SET,       /* transparent: bitmap 1 -> pixel on */
+    SSD1306_BLIT_CLEAR,     /* transparent: bitmap 1 -> pixel off */
+    SSD1306_BLIT_XOR,       /* bitmap 1 -> pixel inverted */
+} ssd1306_blit_mode_t;
+
+/* Constant page-major image, optionally PackBits-compressed (see tools/gen_oled_icons.py) */
+typedef struct {
+    const uint8_t *data;
+    uint16_t len;           /* bytes in data */
+    uint8_t w;
+    uint8_t h;
+    bool rle;               /* data is PackBits, decoded while drawing */
+} ssd1306_image_t;
+
+/* One rectangular region of GDDRAM to resend: pages p0..p1, columns c0..c1 (inclusive) */
+typedef struct {
+    uint8_t p0;
+    uint8_t p1;
+    uint8_t c0;
+    uint8_t c1;
+} ssd1306_run_t;
+
+typedef struct ssd1306_t {
     uint16_t width;
     uint16_t height;
     uint8_t pages;
     uint8_t *buffer;
+    uint8_t *shadow;                  /* copy of what the panel GDDRAM holds, NULL disables diffing */
+    ssd1306_bus_t bus;
     i2c_master_dev_handle_t i2c_dev;
     uint8_t i2c_addr;
+    struct ssd1306_spi_bus *spi;      /* SPI device and transaction pool, shared with clones */
     bool external_vcc;
     /* Dirty tracking for incremental refresh */
     uint8_t dirty_flags;              /* bit0: any dirty, other bits reserved */
-    uint8_t page_dirty[8];            /* per-page dirty flag (max 8 pages for 64px height) */
-    uint8_t dirty_col_start[8];       /* per-page first dirty column */
-    uint8_t dirty_col_end[8];         /* per-page last dirty column */
+    uint8_t page_dirty[SSD1306_MAX_PAGES];      /* per-page dirty flag */
+    uint8_t dirty_col_start[SSD1306_MAX_PAGES]; /* per-page first dirty column */
+    uint8_t dirty_col_end[SSD1306_MAX_PAGES];   /* per-page last dirty column */
+    ssd1306_bus_stats_t bus_stats;
 } ssd1306_t;
 
 /* Initialization and Control */
 esp_err_t ssd1306_init(ssd1306_t *dev, i2c_master_dev_handle_t i2c_dev,
                        uint16_t width, uint16_t height, uint8_t i2c_addr,
                        bool external_vcc);
+esp_err_t ssd1306_init_spi(ssd1306_t *dev, const ssd1306_spi_config_t *cfg,
+                           uint16_t width, uint16_t height, bool external_vcc);
 
 void ssd1306_deinit(ssd1306_t *dev);
 
+/* Double buffering: clone a second framebuffer and move dirty regions between them */
+esp_err_t ssd1306_clone(ssd1306_t *dst, const ssd1306_t *src);
+void ssd1306_take_frame(ssd1306_t *dst, ssd1306_t *src);
+
 esp_err_t ssd1306_power_on(ssd1306_t *dev);
 esp_err_t ssd1306_power_off(ssd1306_t *dev);
 
 esp_err_t ssd1306_set_contrast(ssd1306_t *dev, uint8_t contrast);
 esp_err_t ssd1306_invert(ssd1306_t *dev, bool invert);
 
+/* Hardware vertical scroll: display start line and visible row count (MUX ratio) */
+esp_err_t ssd1306_set_start_line(ssd1306_t *dev, uint8_t line);
+esp_err_t ssd1306_set_visible_rows(ssd1306_t *dev, uint8_t rows);
+
 /* Display Update */
 esp_err_t ssd1306_show(ssd1306_t *dev);
+/* Queue the flush and return; on SPI the framebuffer is read by DMA until cb runs, so do not
+ * draw into dev before then or before ssd1306_wait() (ssd1306_take_frame() waits for its dst).
+ * Only the task that started the flush may use the panel until it completes. */
+esp_err_t ssd1306_show_async(ssd1306_t *dev, ssd1306_flush_cb_t cb, void *arg);
+esp_err_t ssd1306_wait(ssd1306_t *dev);
+
+void ssd1306_get_bus_stats(const ssd1306_t *dev, ssd1306_bus_stats_t *out);
+void ssd1306_reset_bus_stats(ssd1306_t *dev);
 
 /* Framebuffer Operations */
 void ssd1306_fill(ssd1306_t *dev, uint8_t color);
 void ssd1306_clear(ssd1306_t *dev);
+void ssd1306_load_frame(ssd1306_t *dev, const uint8_t *image);
+/* Writable pointer to len columns of one page, marked dirty; NULL when out of range */
+uint8_t *ssd1306_page_span(ssd1306_t *dev, uint8_t page, uint16_t col, uint16_t len);
 
 void ssd1306_pixel(ssd1306_t *dev, uint16_t x, uint16_t y, uint8_t color);
 void ssd1306_h_line(ssd1306_t *dev, uint16_t x, uint16_t y, uint16_t width, uint8_t color);
@@ -78,6 +206,22 @@ void ssd1306_v_line(ssd1306_t *dev, uint16_t x, uint16_t y, uint16_t height, uin
 void ssd1306_rect(ssd1306_t *dev, uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint8_t color);
 void ssd1306_fill_rect(ssd1306_t *dev, uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint8_t color);
 
+/* Page-major 1bpp bitmaps (bit0 = top row of each page), any x/y */
+void ssd1306_blit(ssd1306_t *dev, const uint8_t *bitmap, uint16_t x, uint16_t y,
+                  uint16_t w, uint16_t h, ssd1306_blit_mode_t mode);
+/* PackBits (0..127: n+1 literal bytes, 128..255: next byte repeated n-125 times), decoded run by
+ * run into a caller sink; src is NULL for a repeat run. Shared by blits, font glyphs and animations */
+typedef void (*ssd1306_rle_sink_t)(void *ctx, size_t out, const uint8_t *src, uint8_t fill, size_t n);
+esp_err_t ssd1306_rle_decode(const uint8_t *rle, size_t len, size_t total, size_t *used,
+                             ssd1306_rle_sink_t sink, void *ctx);
+esp_err_t ssd1306_blit_rle(ssd1306_t *dev, const uint8_t *rle, size_t len, uint16_t x, uint16_t y,
+                           uint16_t w, uint16_t h, ssd1306_blit_mode_t mode);
+esp_err_t ssd1306_image(ssd1306_t *dev, const ssd1306_image_t *img, uint16_t x, uint16_t y,
+                        ssd1306_blit_mode_t mode);
+/* Transparent: set bits are drawn in color, clear bits leave the framebuffer untouched */
+void ssd1306_bitmap(ssd1306_t *dev, const uint8_t *bitmap, uint16_t x, uint16_t y,
+                    uint16_t w, uint16_t h, uint8_t color);
+
 /* Text Rendering (5x8 font) */
 void ssd1306_text(ssd1306_t *dev, const char *str, uint16_t x, uint16_t y, uint8_t color, uint8_t wrap_mode);
 /* wrap_mode: 0 = auto wrap to next line, 1 = truncate (no wrap) */
@@ -0,0 +1,196 @@
+#!/usr/bin/env python
+#
+# Render the OLED animations below and store them as keyframes plus per-page
+# XOR deltas for oled_anim_next().
+#
+# Every frame is
+#   u8 flags (bit0 = keyframe: clear the frame first), u8 record count,
+#   records {u8 page, u8 col, u8 len, PackBits data unpacking to len bytes}
+# and each record is XORed into the framebuffer. A delta frame has one record
+# per changed page, trimmed to the changed columns, so pages that did not
+# change are never touched. Frame 0 is always a keyframe; later frames fall
+# back to a keyframe when that is smaller (scene cuts). Writes
+# main/oled/oled_anims.{c,h}; re-run after editing ANIMS:
+#   python tools/gen_oled_anims.py
+import math
+import os
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, HERE)
+from gen_oled_icons import ICONS  # noqa: E402
+from oled_packbits import packbits  # noqa: E402
+
+OLED_DIR = os.path.join(HERE, '..', 'main', 'oled')
+WIDTH, HEIGHT = 128, 64
+PAGES = HEIGHT // 8
+KEYFRAME = 0x01
+
+
+class Canvas(object):
+    """128x64 1bpp drawing surface, clipped like the SSD1306 driver."""
+
+    def __init__(self):
+        self.px = [[0] * WIDTH for _ in range(HEIGHT)]
+
+    def pixel(self, x, y, on=1):
+        if 0 <= x < WIDTH and 0 <= y < HEIGHT:
+            self.px[y][x] = on
+
+    def fill_rect(self, x, y, w, h, on=1):
+        for yy in range(y, y + h):
+            for xx in range(x, x + w):
+                self.pixel(xx, yy, on)
+
+    def rect(self, x, y, w, h, on=1):
+        self.fill_rect(x, y, w, 1, on)
+        self.fill_rect(x, y + h - 1, w, 1, on)
+        self.fill_rect(x, y, 1, h, on)
+        self.fill_rect(x + w - 1, y, 1, h, on)
+
+    def circle(self, cx, cy, r, on=1):
+        for a in range(0, 360, 2):
+            t = math.radians(a)
+            self.pixel(int(round(cx + r * math.cos(t))), int(round(cy + r * math.sin(t))), on)
+
+    def icon(self, name, x, y, scale=1):
+        rows = dict(ICONS)[name]
+        for iy, r in enumerate(rows):
+            for ix, ch in enumerate(r):
+                if ch == '#':
+                    self.fill_rect(x + ix * scale, y + iy * scale, scale, scale)
+
+    def pages(self):
+        out = bytearray(WIDTH * PAGES)
+        for y in range(HEIGHT):
+            for x in range(WIDTH):
+                if self.px[y][x]:
+                    out[(y // 8) * WIDTH + x] |= 1 << (y % 8)
+        return bytes(out)
+
+
+def boot(t):
+    """Chip drops in, then a progress bar fills under it (one-shot)."""
+    c = Canvas()
+    y = min(16, -16 + t * 3)
+    c.icon('chip', 48, y)
+    if t >= 11:
+        c.rect(14, 44, 100, 8)
+        fill = min(96, (t - 11) * 4)
+        c.fill_rect(16, 46, fill, 4)
+    return c.pages()
+
+
+def alert(t):
+    """Large warning sign with a ring pulsing around it and a blinking border (loops)."""
+    c = Canvas()
+    c.icon('warning', 51, 20, 3)
+    c.circle(64, 32, 20 + (t % 8) * 1.5)
+    if t % 8 < 4:
+        c.rect(0, 0, WIDTH, HEIGHT)
+    return c.pages()
+
+
+# name, render function, frame count, frames per second, loop
+ANIMS = [
+    ('boot', boot, 36, 25, False),
+    ('alert', alert, 16, 12, True),
+]
+
+
+def encode_frame(prev, cur):
+    """Return the shorter of the keyframe and XOR-delta encodings of cur (keyframe when prev is None)."""
+    def records(base):
+        out = bytearray()
+        n = 0
+        for page in range(PAGES):
+            row = bytes(a ^ b for a, b in zip(base[page * WIDTH:(page + 1) * WIDTH],
+                                              cur[page * WIDTH:(page + 1) * WIDTH]))
+            cols = [i for i, b in enumerate(row) if b]
+            if not cols:
+                continue
+            c0, c1 = cols[0], cols[-1] + 1
+            out += bytes([page, c0, c1 - c0]) + packbits(row[c0:c1])
+            n += 1
+        return n, bytes(out)
+
+    n, key = records(bytes(len(cur)))
+    key = bytes([KEYFRAME, n]) + key
+    if prev is None:
+        return key
+    n, delta = records(prev)
+    delta = bytes([0, n]) + delta
+    return delta if len(delta) < len(key) else key
+
+
+def main():
+    out_c = [
+        '/* Generated by tools/gen_oled_anims.py - do not edit by hand */',
+        '#include "oled_anims.h"',
+        '',
+    ]
+    out_h = [
+        '/* Generated by tools/gen_oled_anims.py - do not edit by hand */',
+        '#ifndef OLED_ANIMS_H',
+        '#define OLED_ANIMS_H',
+        '',
+        '#include "oled_anim.h"',
+        '',
+    ]
+    names = []
+    for name, render, frames, fps, loop in ANIMS:
+        data = bytearray()
+        prev = None
+        keyframes = 0
+        for t in range(frames):
+            cur = render(t)
+            enc = encode_frame(prev, cur)
+            keyframes += enc[0] & KEYFRAME
+            data += enc
+            prev = cur
+        raw = frames * WIDTH * PAGES
+        out_c.append('/* %d frames at %d fps, %d keyframe(s), %d -> %d bytes */' %
+                     (frames, fps, keyframes, raw, len(data)))
+        out_c.append('static const uint8_t %s_data[%d] = {' % (name, len(data)))
+        for i in range(0, len(data), 16):
+            out_c.append('    ' + ' '.join('0x%02x,' % b for b in data[i:i + 16]))
+        out_c.append('};')
+        out_c.append('')
+        out_c.append('const oled_anim_t oled_anim_%s = {' % name)
+        out_c.append('    .name = "%s",' % name)
+        out_c.append('    .data = %s_data,' % name)
+        out_c.append('    .len = %d,' % len(data))
+        out_c.append('    .frames = %d,' % frames)
+        out_c.append('    .width = %d,' % WIDTH)
+        out_c.append('    .height = %d,' % HEIGHT)
+        out_c.append('    .fps = %d,' % fps)
+        out_c.append('    .loop = %s,' % ('true' if loop else 'false'))
+        out_c.append('};')
+        out_c.append('')
+        out_h.append('extern const oled_anim_t oled_anim_%s;' % name)
+        names.append(name)
+
+    out_c.append('const oled_anim_t *const oled_anim_list[] = {')
+    for name in names:
+        out_c.append('    &oled_anim_%s,' % name)
+    out_c.append('};')
+    out_c.append('const size_t oled_anim_count = %d;' % len(names))
+    out_c.append('')
+    out_h += [
+        '',
+        '/* All animations, for lookup by name */',
+        'extern const oled_anim_t *const oled_anim_list[];',
+        'extern const size_t oled_anim_count;',
+        '',
+        '#endif /* OLED_ANIMS_H */',
+        '',
+    ]
+
+    with open(os.path.join(OLED_DIR, 'oled_anims.c'), 'w', encoding='utf-8', newline='\n') as f:
+        f.write('\n'.join(out_c))
+    with open(os.path.join(OLED_DIR, 'oled_anims.h'), 'w', encoding='utf-8', newline='\n') as f:
+        f.write('\n'.join(out_h))
+
+
+if __name__ == '__main__':
+    main()
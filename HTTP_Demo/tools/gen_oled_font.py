@@ -0,0 +1,151 @@
+#!/usr/bin/env python
+#
+# Convert a BDF bitmap font into the OLED font image read by main/oled/oled_font.c.
+#
+# Glyphs are re-rendered into cells of the font's full line height, stored
+# page-major 1bpp (the SSD1306 framebuffer layout), PackBits-compressed when
+# that is smaller, and indexed by code point. The image is flashed to the
+# "font" partition (see partitions.csv); the build picks up font/oled_font.bin
+# automatically when it exists:
+#   python tools/gen_oled_font.py unifont.bdf                 # ASCII + GB2312
+#   python tools/gen_oled_font.py wqy12.bdf --charset all -o font/oled_font.bin
+import argparse
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from oled_packbits import packbits  # noqa: E402
+
+MAGIC = b'OFN1'
+VERSION = 1
+MAX_WIDTH = 16
+MAX_HEIGHT = 16
+ENC_RAW = 0
+ENC_PACKBITS = 1
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+DEFAULT_OUT = os.path.join(HERE, '..', 'font', 'oled_font.bin')
+PARTITION_SIZE = 0x70000
+
+
+def parse_bdf(path):
+    """Return (ascent, descent, {codepoint: (dwidth, bbx, rows)})."""
+    ascent = descent = None
+    bbox = None
+    glyphs = {}
+    with open(path, encoding='latin-1') as f:
+        lines = iter(f.read().splitlines())
+    for line in lines:
+        key, _, rest = line.partition(' ')
+        if key == 'FONTBOUNDINGBOX':
+            bbox = [int(v) for v in rest.split()]
+        elif key == 'FONT_ASCENT':
+            ascent = int(rest)
+        elif key == 'FONT_DESCENT':
+            descent = int(rest)
+        elif key == 'STARTCHAR':
+            cp, dwidth, bbx, rows = -1, None, None, []
+            for line in lines:
+                key, _, rest = line.partition(' ')
+                if key == 'ENCODING':
+                    cp = int(rest.split()[0])
+                elif key == 'DWIDTH':
+                    dwidth = int(rest.split()[0])
+                elif key == 'BBX':
+                    bbx = [int(v) for v in rest.split()]
+                elif key == 'BITMAP':
+                    for line in lines:
+                        if line.startswith('ENDCHAR'):
+                            break
+                        rows.append(int(line, 16) if line.strip() else 0)
+                    break
+            if cp >= 0 and bbx is not None:
+                glyphs[cp] = (dwidth if dwidth is not None else bbx[0], bbx, rows)
+    if ascent is None or descent is None:
+        if bbox is None:
+            raise SystemExit('%s: no FONT_ASCENT/FONT_DESCENT or FONTBOUNDINGBOX' % path)
+        ascent, descent = bbox[1] + bbox[3], -bbox[3]
+    return ascent, descent, glyphs
+
+
+def render(ascent, height, dwidth, bbx, rows):
+    """Render one BDF glyph into a page-major cell of dwidth x height."""
+    bw, bh, xoff, yoff = bbx
+    width = min(dwidth, MAX_WIDTH)
+    pages = (height + 7) // 8
+    out = bytearray(width * pages)
+    row_bits = (bw + 7) // 8 * 8
+    for r, bits in enumerate(rows[:bh]):
+        y = ascent - (yoff + bh) + r
+        if y < 0 or y >= height:
+            continue
+        for c in range(bw):
+            x = xoff + c
+            if 0 <= x < width and bits & (1 << (row_bits - 1 - c)):
+                out[(y // 8) * width + x] |= 1 << (y % 8)
+    return width, bytes(out)
+
+
+def wanted(cp, charset):
+    if 0x20 <= cp <= 0x7e:
+        return True
+    if charset == 'all':
+        return cp > 0x7e
+    if charset == 'gb2312':
+        try:
+            chr(cp).encode('gb2312')
+            return cp > 0x7e
+        except UnicodeEncodeError:
+            return False
+    return False
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Build the OLED UTF-8 font image")
+    ap.add_argument('bdf', help='source BDF font (glyphs up to %dx%d)' % (MAX_WIDTH, MAX_HEIGHT))
+    ap.add_argument('--charset', choices=('ascii', 'gb2312', 'all'), default='gb2312',
+                    help='code points to keep (ASCII is always kept)')
+    ap.add_argument('-o', '--output', default=DEFAULT_OUT)
+    args = ap.parse_args()
+
+    ascent, descent, glyphs = parse_bdf(args.bdf)
+    height = ascent + descent
+    if height > MAX_HEIGHT:
+        raise SystemExit('font is %d px high, the OLED renderer supports at most %d' % (height, MAX_HEIGHT))
+
+    records = []
+    for cp in sorted(glyphs):
+        if not wanted(cp, args.charset):
+            continue
+        dwidth, bbx, rows = glyphs[cp]
+        if dwidth <= 0:
+            continue
+        width, data = render(ascent, height, dwidth, bbx, rows)
+        packed = packbits(data)
+        if len(packed) < len(data):
+            records.append((cp, width, ENC_PACKBITS, packed))
+        else:
+            records.append((cp, width, ENC_RAW, data))
+
+    index_off = 16
+    data_off = index_off + 8 * len(records)
+    index = bytearray()
+    body = bytearray()
+    for cp, width, enc, data in records:
+        index += struct.pack('<II', cp, data_off + len(body))
+        body += struct.pack('<BBH', width, enc, len(data)) + data
+    image = struct.pack('<4sHBBII', MAGIC, VERSION, height, 0, len(records), index_off) + index + body
+
+    if len(image) > PARTITION_SIZE:
+        raise SystemExit('image is %d bytes, the font partition holds %d' % (len(image), PARTITION_SIZE))
+    os.makedirs(os.path.dirname(os.path.abspath(args.output)), exist_ok=True)
+    with open(args.output, 'wb') as f:
+        f.write(image)
+    raw = sum(len(r[3]) if r[2] == ENC_RAW else r[1] * ((height + 7) // 8) for r in records)
+    print('wrote %s: %d glyphs, %d px high, %d bytes (glyph data %d -> %d)' % (
+        args.output, len(records), height, len(image), raw, len(body) - 4 * len(records)))
+
+
+if __name__ == '__main__':
+    main()
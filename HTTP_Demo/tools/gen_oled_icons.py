@@ -0,0 +1,128 @@
+#!/usr/bin/env python
+#
+# Convert the ASCII-art icons below into page-major 1bpp images.
+#
+# Each icon is stored like the SSD1306 framebuffer (one byte per column and
+# page, bit0 = top row) and PackBits-compressed when that is smaller, so
+# ssd1306_image() can decode it straight into the framebuffer. Writes
+# main/oled/oled_icons.{c,h}; re-run after editing ICONS:
+#   python tools/gen_oled_icons.py
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from oled_packbits import packbits  # noqa: E402
+
+# name -> rows; '#' = pixel on, anything else = off. All rows of an icon have the same width.
+ICONS = [
+    ('wifi', [
+        '...#####...',
+        '.##.....##.',
+        '#...###...#',
+        '..##...##..',
+        '.#..###..#.',
+        '...#...#...',
+        '.....#.....',
+        '....###....',
+    ]),
+    ('lock', [
+        '..###..',
+        '.#...#.',
+        '.#...#.',
+        '#######',
+        '###.###',
+        '###.###',
+        '#######',
+    ]),
+    ('warning', [
+        '....#....',
+        '...#.#...',
+        '..#.#.#..',
+        '..#.#.#..',
+        '.#..#..#.',
+        '.#.....#.',
+        '#...#...#',
+        '#########',
+    ]),
+    ('chip', [
+        '................................',
+        '....########################....',
+        '....########################....',
+        '##..##.#####################..##',
+        '....########################....',
+        '....########################....',
+        '##..########################..##',
+        '....########################....',
+        '....########################....',
+        '##..########################..##',
+        '....########################....',
+        '....########################....',
+        '##..########################..##',
+        '....########################....',
+        '....########################....',
+        '................................',
+    ]),
+]
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+OLED_DIR = os.path.join(HERE, '..', 'main', 'oled')
+
+
+def rasterize(rows):
+    """Return (w, h, page-major bytes) for one ASCII-art icon."""
+    w, h = len(rows[0]), len(rows)
+    for r in rows:
+        if len(r) != w:
+            raise SystemExit('icon rows must all be %d wide: %r' % (w, r))
+    out = bytearray(w * ((h + 7) // 8))
+    for y, r in enumerate(rows):
+        for x, ch in enumerate(r):
+            if ch == '#':
+                out[(y // 8) * w + x] |= 1 << (y % 8)
+    return w, h, bytes(out)
+
+
+def main():
+    out_c = [
+        '/* Generated by tools/gen_oled_icons.py - do not edit by hand */',
+        '#include "oled_icons.h"',
+        '',
+    ]
+    out_h = [
+        '/* Generated by tools/gen_oled_icons.py - do not edit by hand */',
+        '#ifndef OLED_ICONS_H',
+        '#define OLED_ICONS_H',
+        '',
+        '#include "ssd1306.h"',
+        '',
+    ]
+    for name, rows in ICONS:
+        w, h, raw = rasterize(rows)
+        packed = packbits(raw)
+        rle = len(packed) < len(raw)
+        data = packed if rle else raw
+        out_c.append('/* %dx%d, %s */' % (w, h, 'PackBits %d -> %d bytes' % (len(raw), len(packed)) if rle else 'raw'))
+        out_c.append('static const uint8_t %s_data[%d] = {' % (name, len(data)))
+        for i in range(0, len(data), 16):
+            out_c.append('    ' + ' '.join('0x%02x,' % b for b in data[i:i + 16]))
+        out_c.append('};')
+        out_c.append('')
+        out_c.append('const ssd1306_image_t oled_icon_%s = {' % name)
+        out_c.append('    .data = %s_data,' % name)
+        out_c.append('    .len = %d,' % len(data))
+        out_c.append('    .w = %d,' % w)
+        out_c.append('    .h = %d,' % h)
+        out_c.append('    .rle = %s,' % ('true' if rle else 'false'))
+        out_c.append('};')
+        out_c.append('')
+        out_h.append('extern const ssd1306_image_t oled_icon_%s;' % name)
+    out_h += ['', '#endif /* OLED_ICONS_H */', '']
+
+    with open(os.path.join(OLED_DIR, 'oled_icons.c'), 'w', encoding='utf-8', newline='\n') as f:
+        f.write('\n'.join(out_c))
+    with open(os.path.join(OLED_DIR, 'oled_icons.h'), 'w', encoding='utf-8', newline='\n') as f:
+        f.write('\n'.join(out_h))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,137 @@
+#!/usr/bin/env python
+#
+# Pre-rasterize the fixed OLED screens into framebuffer images.
+#
+# Reads font_5x8 from main/oled/ssd1306.c, renders each screen's fixed strings
+# exactly like ssd1306_text() does, and writes main/oled/oled_templates.{c,h}.
+# Re-run after editing SCREENS or the font:
+#   python tools/gen_oled_templates.py
+import os
+import re
+
+WIDTH = 128
+HEIGHT = 64
+FONT_CHAR_WIDTH = 5
+FONT_CHAR_HEIGHT = 8
+FONT_TOTAL_WIDTH = 6
+
+# name -> list of (text, x, y, wrap_mode); wrap_mode 0 = auto wrap, 1 = truncate
+SCREENS = [
+    ('connecting', [
+        ('ESP32 WiFi Demo', 0, 0, 1),
+        ('Connecting...', 0, 16, 1),
+    ]),
+    ('connected', [
+        ('WiFi Connected!', 0, 0, 1),
+        ('Server Running', 0, 16, 1),
+    ]),
+    ('connected_ip', [
+        ('WiFi Connected!', 0, 0, 1),
+        ('Server: Port 443', 0, 12, 1),
+        ('IP Address:', 0, 24, 1),
+    ]),
+]
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+OLED_DIR = os.path.join(HERE, '..', 'main', 'oled')
+
+
+def load_font():
+    with open(os.path.join(OLED_DIR, 'ssd1306.c'), encoding='utf-8') as f:
+        src = f.read()
+    table = src[src.index('font_5x8[96][5]'):]
+    table = table[:table.index('};')]
+    glyphs = [[int(v, 16) for v in g.split(',')] for g in re.findall(r'\{\s*(0x[0-9a-fA-F]{2}(?:\s*,\s*0x[0-9a-fA-F]{2}){4})\s*\}', table)]
+    glyphs += [[0] * FONT_CHAR_WIDTH] * (96 - len(glyphs))
+    return glyphs
+
+
+def render_text(buf, font, text, x, y, wrap_mode):
+    """Mirror of ssd1306_text(): same wrap/truncate rules, color 1."""
+    cur_x, cur_y, start_x = x, y, x
+    for ch in text.encode('ascii'):
+        if ch < 0x20 or ch > 0x7f:
+            continue
+        if cur_x + FONT_CHAR_WIDTH > WIDTH:
+            if wrap_mode != 0:
+                break
+            cur_x = start_x
+            cur_y += FONT_CHAR_HEIGHT
+            if cur_y + FONT_CHAR_HEIGHT > HEIGHT:
+                break
+        for i, col in enumerate(font[ch - 0x20]):
+            for bit in range(FONT_CHAR_HEIGHT):
+                px, py = cur_x + i, cur_y + bit
+                if col & (1 << bit) and px < WIDTH and py < HEIGHT:
+                    buf[(py // 8) * WIDTH + px] |= 1 << (py % 8)
+        cur_x += FONT_TOTAL_WIDTH
+
+
+def c_string(s):
+    return '"' + s.replace('\\', '\\\\').replace('"', '\\"') + '"'
+
+
+def main():
+    font = load_font()
+    out_c = [
+        '/* Generated by tools/gen_oled_templates.py - do not edit by hand */',
+        '#include "oled_templates.h"',
+        '',
+    ]
+    out_h = [
+        '/* Generated by tools/gen_oled_templates.py - do not edit by hand */',
+        '#ifndef OLED_TEMPLATES_H',
+        '#define OLED_TEMPLATES_H',
+        '',
+        '#include <stdint.h>',
+        '',
+        '#define OLED_TEMPLATE_WIDTH   %d' % WIDTH,
+        '#define OLED_TEMPLATE_HEIGHT  %d' % HEIGHT,
+        '',
+        '/* One fixed string of a template, as passed to ssd1306_text() */',
+        'typedef struct {',
+        '    const char *text;',
+        '    uint8_t x;',
+        '    uint8_t y;',
+        '    uint8_t wrap_mode;',
+        '} oled_template_text_t;',
+        '',
+        '/* Pre-rasterized screen: framebuffer image plus the strings it was built from */',
+        'typedef struct {',
+        '    const uint8_t *image;                /* OLED_TEMPLATE_WIDTH * OLED_TEMPLATE_HEIGHT / 8 bytes */',
+        '    const oled_template_text_t *texts;',
+        '    uint8_t ntexts;',
+        '} oled_template_t;',
+        '',
+    ]
+    for name, texts in SCREENS:
+        buf = bytearray(WIDTH * HEIGHT // 8)
+        for text, x, y, wrap in texts:
+            render_text(buf, font, text, x, y, wrap)
+        out_c.append('static const uint8_t %s_image[%d] = {' % (name, len(buf)))
+        for i in range(0, len(buf), 16):
+            out_c.append('    ' + ' '.join('0x%02x,' % b for b in buf[i:i + 16]))
+        out_c.append('};')
+        out_c.append('')
+        out_c.append('static const oled_template_text_t %s_texts[] = {' % name)
+        for text, x, y, wrap in texts:
+            out_c.append('    { %s, %d, %d, %d },' % (c_string(text), x, y, wrap))
+        out_c.append('};')
+        out_c.append('')
+        out_c.append('const oled_template_t oled_tpl_%s = {' % name)
+        out_c.append('    .image = %s_image,' % name)
+        out_c.append('    .texts = %s_texts,' % name)
+        out_c.append('    .ntexts = %d,' % len(texts))
+        out_c.append('};')
+        out_c.append('')
+        out_h.append('extern const oled_template_t oled_tpl_%s;' % name)
+    out_h += ['', '#endif /* OLED_TEMPLATES_H */', '']
+
+    with open(os.path.join(OLED_DIR, 'oled_templates.c'), 'w', encoding='utf-8', newline='\n') as f:
+        f.write('\n'.join(out_c))
+    with open(os.path.join(OLED_DIR, 'oled_templates.h'), 'w', encoding='utf-8', newline='\n') as f:
+        f.write('\n'.join(out_h))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,33 @@
+#!/usr/bin/env python
+#
+# PackBits encoder shared by the OLED generators (icons, font, animations).
+#
+# Matches ssd1306_rle_decode() in main/oled/ssd1306.c: a control byte 0..127
+# is followed by n+1 literal bytes, 128..255 repeats the next byte n-125
+# times (3..130). Fix the format here and there, nowhere else.
+
+
+def packbits(data):
+    """Encode bytes; runs of 3 or more become repeats, everything else literals."""
+    out = bytearray()
+    i = 0
+    literal = bytearray()
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and run < 130 and data[i + run] == data[i]:
+            run += 1
+        if run >= 3:
+            if literal:
+                out += bytes([len(literal) - 1]) + literal
+                literal = bytearray()
+            out += bytes([run + 125, data[i]])
+            i += run
+        else:
+            literal.append(data[i])
+            i += 1
+            if len(literal) == 128:
+                out += bytes([127]) + literal
+                literal = bytearray()
+    if literal:
+        out += bytes([len(literal) - 1]) + literal
+    return bytes(out)